@@ -49,19 +49,16 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // internal headers
 #include "AssetLib/Assbin/AssbinLoader.h"
+#include "Common/InflateIOStream.h"
 #include "Common/assbin_chunks.h"
-#include <assimp/MemoryIOWrapper.h>
+#include <assimp/IOSystem.hpp>
 #include <assimp/anim.h>
 #include <assimp/importerdesc.h>
 #include <assimp/mesh.h>
 #include <assimp/scene.h>
 #include <memory>
-
-#ifdef ASSIMP_BUILD_NO_OWN_ZLIB
-#include <zlib.h>
-#else
-#include <contrib/zlib/zlib.h>
-#endif
+#include <type_traits>
+#include <vector>
 
 using namespace Assimp;
 
@@ -193,12 +190,42 @@ aiQuatKey Read<aiQuatKey>(IOStream *stream) {
     return v;
 }
 
+// -----------------------------------------------------------------------------------
+// Types written member by member without any padding in between, so an array of them
+// looks the same in the file as in memory.
+template <typename T>
+struct IsPacked {
+    static const bool value = std::is_arithmetic<T>::value;
+};
+template <>
+struct IsPacked<aiVector3D> {
+    static const bool value = sizeof(aiVector3D) == 3 * sizeof(ai_real);
+};
+template <>
+struct IsPacked<aiColor4D> {
+    static const bool value = sizeof(aiColor4D) == 4 * sizeof(ai_real);
+};
+template <>
+struct IsPacked<aiVertexWeight> {
+    static const bool value = sizeof(aiVertexWeight) == sizeof(unsigned int) + sizeof(ai_real);
+};
+template <>
+struct IsPacked<aiQuatKey> {
+    static const bool value = sizeof(aiQuatKey) == sizeof(double) + 4 * sizeof(ai_real);
+};
+
 // -----------------------------------------------------------------------------------
 template <typename T>
 void ReadArray(IOStream *stream, T *out, unsigned int size) {
     ai_assert(nullptr != stream);
     ai_assert(nullptr != out);
 
+    if (IsPacked<T>::value) {
+        if (stream->Read(out, sizeof(T), size) != size) {
+            throw DeadlyImportError("Unexpected EOF");
+        }
+        return;
+    }
     for (unsigned int i = 0; i < size; i++) {
         out[i] = Read<T>(stream);
     }
@@ -231,10 +258,8 @@ void AssbinImporter::ReadBinaryNode(IOStream *stream, aiNode **onode, aiNode *pa
 
     if (numMeshes) {
         node->mMeshes = new unsigned int[numMeshes];
-        for (unsigned int i = 0; i < numMeshes; ++i) {
-            node->mMeshes[i] = Read<unsigned int>(stream);
-            node->mNumMeshes++;
-        }
+        ReadArray<unsigned int>(stream, node->mMeshes, numMeshes);
+        node->mNumMeshes = numMeshes;
     }
 
     if (numChildren) {
@@ -397,6 +422,8 @@ void AssbinImporter::ReadBinaryMesh(IOStream *stream, aiMesh *mesh) {
     } else {
         // else write as usual
         // if there are less than 2^16 vertices, we can simply use 16 bit integers ...
+        const bool shortIndices = fitsIntoUI16(mesh->mNumVertices);
+        std::vector<uint16_t> indices16;
         mesh->mFaces = new aiFace[mesh->mNumFaces];
         for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
             aiFace &f = mesh->mFaces[i];
@@ -405,13 +432,13 @@ void AssbinImporter::ReadBinaryMesh(IOStream *stream, aiMesh *mesh) {
             f.mNumIndices = Read<uint16_t>(stream);
             f.mIndices = new unsigned int[f.mNumIndices];
 
-            for (unsigned int a = 0; a < f.mNumIndices; ++a) {
-                // Check if unsigned  short ( 16 bit  ) are big enought for the indices
-                if (fitsIntoUI16(mesh->mNumVertices)) {
-                    f.mIndices[a] = Read<uint16_t>(stream);
-                } else {
-                    f.mIndices[a] = Read<unsigned int>(stream);
-                }
+            // Check if unsigned  short ( 16 bit  ) are big enought for the indices
+            if (shortIndices && f.mNumIndices) {
+                indices16.resize(f.mNumIndices);
+                ReadArray<uint16_t>(stream, indices16.data(), f.mNumIndices);
+                std::copy(indices16.begin(), indices16.end(), f.mIndices);
+            } else {
+                ReadArray<unsigned int>(stream, f.mIndices, f.mNumIndices);
             }
         }
     }
@@ -669,10 +696,11 @@ void AssbinImporter::ReadBinaryScene(IOStream *stream, aiScene *scene) {
 
 // -----------------------------------------------------------------------------------
 void AssbinImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSystem *pIOHandler) {
-    IOStream *stream = pIOHandler->Open(pFile, "rb");
-    if (nullptr == stream) {
+    std::unique_ptr<IOStream> file(pIOHandler->Open(pFile, "rb"));
+    if (nullptr == file) {
         return;
     }
+    IOStream *stream = file.get();
 
     // signature
     stream->Seek(44, aiOrigin_CUR);
@@ -697,34 +725,15 @@ void AssbinImporter::InternReadFile(const std::string &pFile, aiScene *pScene, I
     stream->Seek(64, aiOrigin_CUR); // padding
 
     if (compressed) {
-        uLongf uncompressedSize = Read<uint32_t>(stream);
-        uLongf compressedSize = static_cast<uLongf>(stream->FileSize() - stream->Tell());
-
-        unsigned char *compressedData = new unsigned char[compressedSize];
-        size_t len = stream->Read(compressedData, 1, compressedSize);
-        ai_assert(len == compressedSize);
-
-        unsigned char *uncompressedData = new unsigned char[uncompressedSize];
-
-        int res = uncompress(uncompressedData, &uncompressedSize, compressedData, (uLong)len);
-        if (res != Z_OK) {
-            delete[] uncompressedData;
-            delete[] compressedData;
-            pIOHandler->Close(stream);
-            throw DeadlyImportError("Zlib decompression failed.");
-        }
-
-        MemoryIOStream io(uncompressedData, uncompressedSize);
+        // inflate while reading instead of holding the compressed and the
+        // uncompressed data in memory at once
+        const uint32_t uncompressedSize = Read<uint32_t>(stream);
+        InflateIOStream io(stream, uncompressedSize);
 
         ReadBinaryScene(&io, pScene);
-
-        delete[] uncompressedData;
-        delete[] compressedData;
     } else {
         ReadBinaryScene(stream, pScene);
     }
-
-    pIOHandler->Close(stream);
 }
 
 #endif // !! ASSIMP_BUILD_NO_ASSBIN_IMPORTER
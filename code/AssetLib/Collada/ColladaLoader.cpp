@@ -58,6 +58,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/Importer.hpp>
 
+#include <algorithm>
 #include <numeric>
 
 namespace Assimp {
@@ -104,6 +105,7 @@ ColladaLoader::ColladaLoader() :
         noSkeletonMesh(false),
         ignoreUpDirection(false),
         useColladaName(false),
+        streamingThreshold(AI_IMPORT_COLLADA_DEFAULT_STREAMING_THRESHOLD),
         mNodeNameCounter(0) {
     // empty
 }
@@ -153,6 +155,7 @@ void ColladaLoader::SetupProperties(const Importer *pImp) {
     noSkeletonMesh = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_NO_SKELETON_MESHES, 0) != 0;
     ignoreUpDirection = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_COLLADA_IGNORE_UP_DIRECTION, 0) != 0;
     useColladaName = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_COLLADA_USE_COLLADA_NAMES, 0) != 0;
+    streamingThreshold = static_cast<size_t>(std::max(0, pImp->GetPropertyInteger(AI_CONFIG_IMPORT_COLLADA_STREAMING_THRESHOLD, AI_IMPORT_COLLADA_DEFAULT_STREAMING_THRESHOLD)));
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -178,7 +181,7 @@ void ColladaLoader::InternReadFile(const std::string &pFile, aiScene *pScene, IO
     mAnims.clear();
 
     // parse the input file
-    ColladaParser parser(pIOHandler, pFile);
+    ColladaParser parser(pIOHandler, pFile, streamingThreshold);
 
     if (!parser.mRootNode) {
         throw DeadlyImportError("Collada: File came out empty. Something is wrong here.");
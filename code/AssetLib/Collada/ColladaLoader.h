@@ -247,6 +247,9 @@ protected:
     bool ignoreUpDirection;
     bool useColladaName;
 
+    /** Files from this size on are streamed by the parser */
+    size_t streamingThreshold;
+
     /** Used by FindNameForNode() to generate unique node names */
     unsigned int mNodeNameCounter;
 };
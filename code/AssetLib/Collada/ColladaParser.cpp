@@ -54,6 +54,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/light.h>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/IOSystem.hpp>
+#include <assimp/XmlStreamReader.h>
 
 using namespace Assimp;
 using namespace Assimp::Collada;
@@ -85,6 +86,61 @@ static bool FindCommonKey(const std::string &collada_key, const MetaKeyPairVecto
     return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Reads up to count whitespace-separated indices into out. Returns the number of indices read,
+// which is less than count only if the end of the text was reached.
+static size_t ReadIndexArray(const char *&content, size_t *out, size_t count) {
+    size_t n = 0;
+    for (SkipSpacesAndLineEnd(&content); n < count && *content != 0; SkipSpacesAndLineEnd(&content)) {
+        // Hack: (thom) Some exporters put negative indices sometimes. We just try to carry on anyways.
+        out[n++] = static_cast<size_t>(std::max(0, strtol10(content, &content)));
+    }
+    return n;
+}
+
+// Attribute which links an element of the skeleton document to the array streamed from its content
+static const char *StreamedAttribute = "assimp-streamed";
+
+// ------------------------------------------------------------------------------------------------
+// Elements whose <p> children hold primitive indices
+static bool IsPrimitiveElement(const std::string &name) {
+    return name == "lines" || name == "linestrips" || name == "polygons" || name == "polylist" ||
+           name == "triangles" || name == "trifans" || name == "tristrips";
+}
+
+// ------------------------------------------------------------------------------------------------
+// UTF-16 and UTF-32 documents start with a byte order mark or have zero bytes in their first characters
+static bool IsUtf8Document(const char *head, size_t size) {
+    if (size >= 2 && (0 == ::memcmp(head, "\xFF\xFE", 2) || 0 == ::memcmp(head, "\xFE\xFF", 2))) {
+        return false;
+    }
+    return std::find(head, head + size, '\0') == head + size;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Appends text to a document, escaping the characters which would be read as markup
+static void AppendEscaped(std::string &out, const char *text, size_t length) {
+    for (const char *end = text + length; text != end; ++text) {
+        switch (*text) {
+        case '&':
+            out += "&amp;";
+            break;
+        case '<':
+            out += "&lt;";
+            break;
+        case '>':
+            out += "&gt;";
+            break;
+        case '"':
+            out += "&quot;";
+            break;
+        default:
+            out.push_back(*text);
+            break;
+        }
+    }
+}
+
 static void readUrlAttribute(XmlNode &node, std::string &url) {
     url.clear();
     if (!XmlParser::getStdStrAttribute(node, "url", url)) {
@@ -98,9 +154,11 @@ static void readUrlAttribute(XmlNode &node, std::string &url) {
 
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
-ColladaParser::ColladaParser(IOSystem *pIOHandler, const std::string &pFile) :
+ColladaParser::ColladaParser(IOSystem *pIOHandler, const std::string &pFile, size_t streamingThreshold) :
         mFileName(pFile),
         mXmlParser(),
+        mStreamedValues(),
+        mStreamedIndices(),
         mDataLibrary(),
         mAccessorLibrary(),
         mMeshLibrary(),
@@ -148,10 +206,23 @@ ColladaParser::ColladaParser(IOSystem *pIOHandler, const std::string &pFile) :
         }
     }
 
-    // generate a XML reader for it
-    if (!mXmlParser.parse(daefile.get())) {
+    // In large files the arrays are read while streaming the file, only the rest of it is parsed into
+    // a DOM. Smaller files are parsed as a whole, which saves the second pass over the skeleton.
+    // The stream reader expects UTF-8, documents in other encodings are always parsed as a whole.
+    char head[4] = {};
+    const size_t headSize = daefile->Read(head, 1, sizeof(head));
+    daefile->Seek(0, aiOrigin_SET);
+    if (daefile->FileSize() >= streamingThreshold && IsUtf8Document(head, headSize)) {
+        std::string skeleton;
+        StreamDocument(daefile.get(), skeleton);
+        daefile.reset();
+        if (!mXmlParser.parse(std::move(skeleton))) {
+            throw DeadlyImportError("Unable to read file, malformed XML");
+        }
+    } else if (!mXmlParser.parse(daefile.get())) {
         throw DeadlyImportError("Unable to read file, malformed XML");
     }
+
     // start reading
     XmlNode node = mXmlParser.getRootNode();
     XmlNode colladaNode = node.child("COLLADA");
@@ -160,6 +231,10 @@ ColladaParser::ColladaParser(IOSystem *pIOHandler, const std::string &pFile) :
     }
     ReadContents(colladaNode);
 
+    // arrays which nothing referred to
+    std::vector<std::vector<ai_real>>().swap(mStreamedValues);
+    std::vector<std::vector<size_t>>().swap(mStreamedIndices);
+
     // read embedded textures
     if (zip_archive && zip_archive->isOpen()) {
         ReadEmbeddedTextures(*zip_archive);
@@ -215,6 +290,101 @@ std::string ColladaParser::ReadZaeManifest(ZipArchiveIOSystem &zip_archive) {
     return std::string();
 }
 
+// ------------------------------------------------------------------------------------------------
+// Reads the document with the stream reader. The values of <float_array> elements in a <source>
+// and the indices of <p> elements in a primitive element are parsed straight into mStreamedValues
+// and mStreamedIndices. Everything else is copied into the skeleton document, where these
+// elements refer to their array by index instead of holding the text. Comments and processing
+// instructions are not copied, the parser does not read them.
+void ColladaParser::StreamDocument(IOStream *stream, std::string &skeleton) {
+    XmlStreamReader reader(stream);
+    std::vector<std::string> parents;
+    std::string piece;
+
+    // the element whose content is streamed, its depth and the number of values read so far
+    enum { Stream_None, Stream_Values, Stream_Indices } streamed = Stream_None;
+    size_t streamedDepth = 0, numValues = 0;
+
+    for (;;) {
+        switch (reader.next()) {
+        case XmlStreamReader::Event_StartElement: {
+            const std::string &name = reader.getName();
+            const bool inParent = !parents.empty() && Stream_None == streamed;
+            skeleton += '<';
+            skeleton += name;
+            for (size_t i = 0; i < reader.getNumAttributes(); ++i) {
+                skeleton += ' ';
+                skeleton += reader.getAttributeName(i);
+                skeleton += "=\"";
+                const std::string &value = reader.getAttributeValue(i);
+                AppendEscaped(skeleton, value.data(), value.size());
+                skeleton += '"';
+            }
+
+            size_t index = SIZE_MAX;
+            if (inParent && name == "float_array" && parents.back() == "source") {
+                const char *count = reader.getAttribute("count");
+                streamed = Stream_Values;
+                index = mStreamedValues.size();
+                mStreamedValues.emplace_back(nullptr != count ? strtoul10(count) : 0);
+                numValues = 0;
+            } else if (inParent && name == "p" && IsPrimitiveElement(parents.back())) {
+                streamed = Stream_Indices;
+                index = mStreamedIndices.size();
+                mStreamedIndices.emplace_back();
+            }
+            if (SIZE_MAX != index) {
+                streamedDepth = reader.getDepth();
+                skeleton += ' ';
+                skeleton += StreamedAttribute;
+                skeleton += "=\"" + std::to_string(index) + "\"";
+            }
+            skeleton += '>';
+            parents.push_back(name);
+        } break;
+
+        case XmlStreamReader::Event_EndElement:
+            if (Stream_Values == streamed && reader.getDepth() + 1 == streamedDepth) {
+                // fewer values than announced are reported when the array is read
+                mStreamedValues.back().resize(numValues);
+            }
+            if (reader.getDepth() + 1 == streamedDepth) {
+                streamed = Stream_None;
+                streamedDepth = 0;
+            }
+            skeleton += "</";
+            skeleton += reader.getName();
+            skeleton += '>';
+            parents.pop_back();
+            break;
+
+        case XmlStreamReader::Event_Text: {
+            if (Stream_None == streamed || reader.getDepth() != streamedDepth) {
+                AppendEscaped(skeleton, reader.getText(), reader.getTextLength());
+                break;
+            }
+
+            // pieces end at whitespace, so each one holds complete numbers
+            piece.assign(reader.getText(), reader.getTextLength());
+            const char *content = piece.c_str();
+            if (Stream_Values == streamed) {
+                std::vector<ai_real> &values = mStreamedValues.back();
+                numValues += fast_atoreal_array<ai_real>(content, values.data() + numValues, values.size() - numValues);
+            } else {
+                std::vector<size_t> &indices = mStreamedIndices.back();
+                size_t index;
+                while (ReadIndexArray(content, &index, 1)) {
+                    indices.push_back(index);
+                }
+            }
+        } break;
+
+        case XmlStreamReader::Event_EndOfDocument:
+            return;
+        }
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 // Convert a path read from a collada file to the usual representation
 void ColladaParser::UriDecodePath(aiString &ss) {
@@ -1417,10 +1587,6 @@ void ColladaParser::ReadDataArray(XmlNode &node) {
     XmlParser::getStdStrAttribute(node, "id", id);
     unsigned int count = 0;
     XmlParser::getUIntAttribute(node, "count", count);
-    std::string v;
-    XmlParser::getValueAsString(node, v);
-    trim(v);
-    const char *content = v.c_str();
 
     // read values and store inside an array in the data library
     mDataLibrary[id] = Data();
@@ -1428,39 +1594,42 @@ void ColladaParser::ReadDataArray(XmlNode &node) {
     data.mIsStringArray = isStringArray;
 
     // some exporters write empty data arrays, but we need to conserve them anyways because others might reference them
-    if (content) {
-        if (isStringArray) {
-            data.mStrings.reserve(count);
-            std::string s;
-
-            for (unsigned int a = 0; a < count; a++) {
-                if (*content == 0) {
-                    throw DeadlyImportError("Expected more values while reading IDREF_array contents.");
-                }
-
-                s.clear();
-                while (!IsSpaceOrNewLine(*content))
-                    s += *content++;
-                data.mStrings.push_back(s);
+    if (isStringArray) {
+        std::string v;
+        XmlParser::getValueAsString(node, v);
+        trim(v);
+        const char *content = v.c_str();
+        data.mStrings.reserve(count);
+        std::string s;
 
-                SkipSpacesAndLineEnd(&content);
+        for (unsigned int a = 0; a < count; a++) {
+            if (*content == 0) {
+                throw DeadlyImportError("Expected more values while reading IDREF_array contents.");
             }
-        } else {
-            data.mValues.reserve(count);
 
-            for (unsigned int a = 0; a < count; a++) {
-                if (*content == 0) {
-                    throw DeadlyImportError("Expected more values while reading float_array contents.");
-                }
+            s.clear();
+            while (!IsSpaceOrNewLine(*content))
+                s += *content++;
+            data.mStrings.push_back(s);
 
-                ai_real value;
-                // read a number
-                //SkipSpacesAndLineEnd(&content);
-                content = fast_atoreal_move<ai_real>(content, value);
-                data.mValues.push_back(value);
-                // skip whitespace after it
-                SkipSpacesAndLineEnd(&content);
+            SkipSpacesAndLineEnd(&content);
+        }
+    } else {
+        unsigned int streamed = 0;
+        if (XmlParser::getUIntAttribute(node, StreamedAttribute, streamed) && streamed < mStreamedValues.size()) {
+            // read while streaming the document
+            data.mValues.swap(mStreamedValues[streamed]);
+            if (data.mValues.size() < count) {
+                throw DeadlyImportError("Expected more values while reading float_array contents.");
             }
+            return;
+        }
+
+        // numbers are parsed straight from the document into storage sized by the count attribute
+        const char *content = XmlParser::getValueAsCString(node);
+        data.mValues.resize(count);
+        if (fast_atoreal_array<ai_real>(content, data.mValues.data(), count) < count) {
+            throw DeadlyImportError("Expected more values while reading float_array contents.");
         }
     }
 }
@@ -1572,6 +1741,47 @@ void ColladaParser::ReadVertexData(XmlNode &node, Mesh &pMesh) {
     }
 }
 
+// ------------------------------------------------------------------------------------------------
+// Makes room for count more elements. Capacity grows geometrically, so reserving for many
+// small primitives one after another does not reallocate every time.
+template <typename T>
+static void ReserveAdditional(std::vector<T> &v, size_t count) {
+    if (v.capacity() < v.size() + count) {
+        v.reserve(std::max(v.size() + count, 2 * v.capacity()));
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Makes room for numVertices more vertices in the mesh data array an input channel is stored in
+static void ReserveChannel(Mesh &pMesh, const InputChannel &pInput, size_t numVertices) {
+    switch (pInput.mType) {
+    case IT_Position:
+        ReserveAdditional(pMesh.mPositions, numVertices);
+        break;
+    case IT_Normal:
+        ReserveAdditional(pMesh.mNormals, numVertices);
+        break;
+    case IT_Tangent:
+        ReserveAdditional(pMesh.mTangents, numVertices);
+        break;
+    case IT_Bitangent:
+        ReserveAdditional(pMesh.mBitangents, numVertices);
+        break;
+    case IT_Texcoord:
+        if (pInput.mIndex < AI_MAX_NUMBER_OF_TEXTURECOORDS) {
+            ReserveAdditional(pMesh.mTexCoords[pInput.mIndex], numVertices);
+        }
+        break;
+    case IT_Color:
+        if (pInput.mIndex < AI_MAX_NUMBER_OF_COLOR_SETS) {
+            ReserveAdditional(pMesh.mColors[pInput.mIndex], numVertices);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 // Reads input declarations of per-index mesh data into the given mesh
 void ColladaParser::ReadIndexData(XmlNode &node, Mesh &pMesh) {
@@ -1624,18 +1834,10 @@ void ColladaParser::ReadIndexData(XmlNode &node, Mesh &pMesh) {
                 if (numPrimitives) // It is possible to define a mesh without any primitives
                 {
                     // case <polylist> - specifies the number of indices for each polygon
-                    std::string v;
-                    XmlParser::getValueAsString(currentNode, v);
-                    const char *content = v.c_str();
-                    vcount.reserve(numPrimitives);
-                    for (unsigned int a = 0; a < numPrimitives; a++) {
-                        if (*content == 0) {
-                            throw DeadlyImportError("Expected more values while reading <vcount> contents.");
-                        }
-                        // read a number
-                        vcount.push_back((size_t)strtoul10(content, &content));
-                        // skip whitespace after it
-                        SkipSpacesAndLineEnd(&content);
+                    const char *content = XmlParser::getValueAsCString(currentNode);
+                    vcount.resize(numPrimitives);
+                    if (ReadIndexArray(content, vcount.data(), numPrimitives) < numPrimitives) {
+                        throw DeadlyImportError("Expected more values while reading <vcount> contents.");
                     }
                 }
             }
@@ -1741,18 +1943,19 @@ size_t ColladaParser::ReadPrimitives(XmlNode &node, Mesh &pMesh, std::vector<Inp
     if (expectedPointCount > 0)
         indices.reserve(expectedPointCount * numOffsets);
 
-    if (pNumPrimitives > 0) // It is possible to not contain any indices
+    unsigned int streamed = 0;
+    if (pNumPrimitives > 0 && XmlParser::getUIntAttribute(node, StreamedAttribute, streamed) && streamed < mStreamedIndices.size()) {
+        // read while streaming the document
+        indices.swap(mStreamedIndices[streamed]);
+    } else if (pNumPrimitives > 0) // It is possible to not contain any indices
     {
-        std::string v;
-        XmlParser::getValueAsString(node, v);
-        const char *content = v.c_str();
-        while (*content != 0) {
-            // read a value.
-            // Hack: (thom) Some exporters put negative indices sometimes. We just try to carry on anyways.
-            int value = std::max(0, strtol10(content, &content));
-            indices.push_back(size_t(value));
-            // skip whitespace after it
-            SkipSpacesAndLineEnd(&content);
+        // read the expected number of indices in one go, then whatever else follows
+        const char *content = XmlParser::getValueAsCString(node);
+        indices.resize(expectedPointCount * numOffsets);
+        indices.resize(ReadIndexArray(content, indices.data(), indices.size()));
+        size_t index;
+        while (ReadIndexArray(content, &index, 1)) {
+            indices.push_back(index);
         }
     }
 
@@ -1819,8 +2022,32 @@ size_t ColladaParser::ReadPrimitives(XmlNode &node, Mesh &pMesh, std::vector<Inp
         numPrimitives = numberOfVertices - 1;
     }
 
-    pMesh.mFaceSize.reserve(numPrimitives);
-    pMesh.mFacePosIndices.reserve(indices.size() / numOffsets);
+    // determine the number of vertices the primitives add to the mesh
+    size_t numNewVertices = 0;
+    switch (pPrimType) {
+    case Prim_Lines:
+    case Prim_LineStrip:
+        numNewVertices = 2 * numPrimitives;
+        break;
+    case Prim_Triangles:
+    case Prim_TriStrips:
+        numNewVertices = 3 * numPrimitives;
+        break;
+    case Prim_Polylist:
+        numNewVertices = expectedPointCount;
+        break;
+    default:
+        numNewVertices = numPrimitives * (indices.size() / numOffsets);
+        break;
+    }
+
+    // make room for them up front, so the vertices are appended without reallocating
+    ReserveAdditional(pMesh.mFaceSize, numPrimitives);
+    ReserveAdditional(pMesh.mFacePosIndices, numNewVertices);
+    for (const InputChannel &input : pMesh.mPerVertexData)
+        ReserveChannel(pMesh, input, numNewVertices);
+    for (const InputChannel &input : pPerIndexChannels)
+        ReserveChannel(pMesh, input, numNewVertices);
 
     size_t polylistStartVertex = 0;
     for (size_t currentPrimitive = 0; currentPrimitive < numPrimitives; currentPrimitive++) {
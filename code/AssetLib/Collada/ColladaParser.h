@@ -73,8 +73,8 @@ protected:
     /** Map for generic metadata as aiString */
     typedef std::map<std::string, aiString> StringMetaData;
 
-    /** Constructor from XML file */
-    ColladaParser(IOSystem *pIOHandler, const std::string &pFile);
+    /** Constructor from XML file. Files of at least streamingThreshold bytes are streamed. */
+    ColladaParser(IOSystem *pIOHandler, const std::string &pFile, size_t streamingThreshold);
 
     /** Destructor */
     ~ColladaParser();
@@ -82,6 +82,9 @@ protected:
     /** Attempts to read the ZAE manifest and returns the DAE to open */
     static std::string ReadZaeManifest(ZipArchiveIOSystem &zip_archive);
 
+    /** Streams the document, reading the large data arrays directly and copying the rest into a skeleton document */
+    void StreamDocument(IOStream *stream, std::string &skeleton);
+
     /** Reads the contents of the file */
     void ReadContents(XmlNode &node);
 
@@ -260,6 +263,11 @@ protected:
     // XML reader, member for everyday use
     XmlParser mXmlParser;
 
+    /** Contents of the <float_array> and <p> elements, read while streaming the document.
+         The elements in the DOM refer to them by index. */
+    std::vector<std::vector<ai_real>> mStreamedValues;
+    std::vector<std::vector<size_t>> mStreamedIndices;
+
     /** All data arrays found in the file by ID. Might be referred to by actually
          everyone. Collada, you are a steaming pile of indirection. */
     using DataLibrary = std::map<std::string, Collada::Data> ;
@@ -49,12 +49,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "FBXTokenizer.h"
 #include "FBXUtil.h"
+#include "Common/ThreadPool.h"
 #include <assimp/defs.h>
 #include <stdint.h>
 #include <assimp/Exceptional.h>
 #include <assimp/ByteSwapper.h>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/StringUtils.h>
+#include <algorithm>
 
 namespace Assimp {
 namespace FBX {
@@ -341,7 +343,30 @@ void ReadData(const char*& sbegin_out, const char*& send_out, const char* input,
 
 
 // ------------------------------------------------------------------------------------------------
-bool ReadScope(TokenList& output_tokens, const char* input, const char*& cursor, const char* end, bool const is64bits)
+// check whether a data token is a zlib-compressed array of a type the parser reads
+bool IsCompressedArray(const char* sbegin, const char* send)
+{
+    if (send - sbegin < 13) {
+        return false;
+    }
+    switch (*sbegin) {
+    case 'f':
+    case 'd':
+    case 'l':
+    case 'i':
+        break;
+    default:
+        return false;
+    }
+    uint32_t encoding;
+    ::memcpy(&encoding, sbegin + 5, 4);
+    AI_SWAP4(encoding);
+    return encoding == 1;
+}
+
+
+// ------------------------------------------------------------------------------------------------
+bool ReadScope(TokenList& output_tokens, std::vector<TokenPtr>* compressed, const char* input, const char*& cursor, const char* end, bool const is64bits)
 {
     // the first word contains the offset at which this block ends
 	const uint64_t end_offset = is64bits ? ReadDoubleWord(input, cursor, end) : ReadWord(input, cursor, end);
@@ -383,7 +408,11 @@ bool ReadScope(TokenList& output_tokens, const char* input, const char*& cursor,
     for (unsigned int i = 0; i < prop_count; ++i) {
         ReadData(sbeg, send, input, cursor, begin_cursor + prop_length);
 
-        output_tokens.push_back(new_Token(sbeg, send, TokenType_DATA, Offset(input, cursor) ));
+        Token* const token = new_Token(sbeg, send, TokenType_DATA, Offset(input, cursor) );
+        output_tokens.push_back(token);
+        if (compressed && IsCompressedArray(sbeg, send)) {
+            compressed->push_back(token);
+        }
 
         if(i != prop_count-1) {
             output_tokens.push_back(new_Token(cursor, cursor + 1, TokenType_COMMA, Offset(input, cursor) ));
@@ -408,7 +437,7 @@ bool ReadScope(TokenList& output_tokens, const char* input, const char*& cursor,
 
         // XXX this is vulnerable to stack overflowing ..
         while(Offset(input, cursor) < end_offset - sentinel_block_length) {
-			ReadScope(output_tokens, input, cursor, input + end_offset - sentinel_block_length, is64bits);
+			ReadScope(output_tokens, compressed, input, cursor, input + end_offset - sentinel_block_length, is64bits);
         }
         output_tokens.push_back(new_Token(cursor, cursor + 1, TokenType_CLOSE_BRACKET, Offset(input, cursor) ));
 
@@ -429,9 +458,47 @@ bool ReadScope(TokenList& output_tokens, const char* input, const char*& cursor,
 
 } // anonymous namespace
 
+// ------------------------------------------------------------------------------------------------
+// inflate the arrays into buffers of their final size, spread over the worker threads
+void InflatedArrays::Inflate(const std::vector<TokenPtr>& compressed, ThreadPool* pool)
+{
+    tokens = compressed;
+    data.clear();
+    data.resize(tokens.size());
+    ParallelFor(pool, static_cast<unsigned int>(tokens.size()), [this](unsigned int i) {
+        const char* begin = tokens[i]->begin();
+
+        uint32_t count, comp_len;
+        ::memcpy(&count, begin + 1, 4);
+        ::memcpy(&comp_len, begin + 9, 4);
+        AI_SWAP4(count);
+        AI_SWAP4(comp_len);
+
+        const size_t stride = (*begin == 'f' || *begin == 'i') ? 4 : 8;
+        std::vector<char>& buff = data[i];
+        buff.resize(stride * count);
+        if (!buff.empty() && !Util::Inflate(begin + 13, comp_len, &buff[0], buff.size())) {
+            TokenizeError("failure decompressing compressed data array", tokens[i]->Offset());
+        }
+    });
+}
+
+// ------------------------------------------------------------------------------------------------
+void InflatedArrays::Take(const Token& token, std::vector<char>& out)
+{
+    out.clear();
+
+    // the tokens are in the order of the file, so their offsets are sorted
+    const std::vector<TokenPtr>::const_iterator it = std::lower_bound(tokens.begin(), tokens.end(), token.Offset(),
+        [](TokenPtr t, size_t offset) { return t->Offset() < offset; });
+    if (it != tokens.end() && *it == &token) {
+        out.swap(data[it - tokens.begin()]);
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 // TODO: Test FBX Binary files newer than the 7500 version to check if the 64 bits address behaviour is consistent
-void TokenizeBinary(TokenList& output_tokens, const char* input, size_t length)
+void TokenizeBinary(TokenList& output_tokens, const char* input, size_t length, ThreadPool* pool, InflatedArrays* inflated)
 {
 	ai_assert(input);
 	ASSIMP_LOG_DEBUG("Tokenizing binary FBX file");
@@ -462,10 +529,13 @@ void TokenizeBinary(TokenList& output_tokens, const char* input, size_t length)
 	ASSIMP_LOG_DEBUG_F("FBX version: ", version);
 	const bool is64bits = version >= 7500;
     const char *end = input + length;
+    // without worker threads the arrays are inflated one by one while parsing
+    const bool inflateAhead = pool && inflated;
+    std::vector<TokenPtr> compressed;
     try
     {
         while (cursor < end ) {
-		    if (!ReadScope(output_tokens, input, cursor, input + length, is64bits)) {
+		    if (!ReadScope(output_tokens, inflateAhead ? &compressed : nullptr, input, cursor, input + length, is64bits)) {
                 break;
             }
         }
@@ -477,6 +547,10 @@ void TokenizeBinary(TokenList& output_tokens, const char* input, size_t length)
         }
         throw;
     }
+
+    if (inflateAhead) {
+        inflated->Inflate(compressed, pool);
+    }
 }
 
 } // !FBX
@@ -54,6 +54,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "FBXImportSettings.h"
 #include "FBXDocumentUtil.h"
 #include "FBXProperties.h"
+#include "Common/ThreadPool.h"
 
 #include <assimp/DefaultLogger.hpp>
 
@@ -66,12 +67,26 @@ namespace FBX {
 
 using namespace Util;
 
+namespace {
+
+// set while Document::ConstructObjects() builds objects ahead of the converter
+thread_local bool prebuilding = false;
+
+// Thrown while prebuilding if the result of a construction would depend on the
+// order in which objects are built, i.e. if it runs into a cycle or a failure.
+// All objects on the stack are reset and left to the converter, which builds
+// them one after the other as it does without prebuilding.
+struct DeferConstruction {};
+
+} // !anon
+
 // ------------------------------------------------------------------------------------------------
 LazyObject::LazyObject(uint64_t id, const Element& element, const Document& doc)
 : doc(doc)
 , element(element)
 , id(id)
-, flags() {
+, flags(0)
+, builder() {
     // empty
 }
 
@@ -84,13 +99,14 @@ LazyObject::~LazyObject()
 // ------------------------------------------------------------------------------------------------
 const Object* LazyObject::Get(bool dieOnError)
 {
-    if(IsBeingConstructed() || FailedToConstruct()) {
-        return nullptr;
-    }
-
-    if (object.get()) {
+    // fast path, the object is complete already
+    const unsigned int state = flags.load(std::memory_order_acquire);
+    if (state & CONSTRUCTED) {
         return object.get();
     }
+    if (state & FAILED_TO_CONSTRUCT) {
+        return nullptr;
+    }
 
     const Token& key = element.KeyToken();
     const TokenList& tokens = element.Tokens();
@@ -123,8 +139,32 @@ const Object* LazyObject::Get(bool dieOnError)
         DOMError(err,&element);
     }
 
-    // prevent recursive calls
-    flags |= BEING_CONSTRUCTED;
+    {
+        std::unique_lock<std::mutex> lock(doc.constructionMutex);
+        const std::thread::id self = std::this_thread::get_id();
+        while (flags.load(std::memory_order_relaxed) & BEING_CONSTRUCTED) {
+            // prevent recursive calls. If another thread is constructing the
+            // object, wait for it unless it is itself waiting for an object
+            // this thread is constructing.
+            if (builder == self || doc.WouldDeadlock(*this)) {
+                if (prebuilding) {
+                    throw DeferConstruction();
+                }
+                return nullptr;
+            }
+            doc.waitingFor[self] = this;
+            doc.constructionDone.wait(lock);
+            doc.waitingFor.erase(self);
+        }
+
+        const unsigned int current = flags.load(std::memory_order_relaxed);
+        if (current & (CONSTRUCTED | FAILED_TO_CONSTRUCT)) {
+            lock.unlock();
+            return Get(dieOnError);
+        }
+        builder = self;
+        flags.store(BEING_CONSTRUCTED, std::memory_order_relaxed);
+    }
 
     try {
         // this needs to be relatively fast since it happens a lot,
@@ -209,9 +249,21 @@ const Object* LazyObject::Get(bool dieOnError)
             object.reset(new AnimationCurveNode(id,element,name,doc));
         }
     }
+    catch(const DeferConstruction&) {
+        Reset();
+        throw;
+    }
     catch(std::exception& ex) {
-        flags &= ~BEING_CONSTRUCTED;
-        flags |= FAILED_TO_CONSTRUCT;
+        if (prebuilding) {
+            Reset();
+            throw DeferConstruction();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(doc.constructionMutex);
+            flags.store(FAILED_TO_CONSTRUCT, std::memory_order_release);
+        }
+        doc.constructionDone.notify_all();
 
         if(dieOnError || doc.Settings().strictMode) {
             throw;
@@ -228,10 +280,26 @@ const Object* LazyObject::Get(bool dieOnError)
         //DOMError("failed to convert element to DOM object, class: " + classtag + ", name: " + name,&element);
     }
 
-    flags &= ~BEING_CONSTRUCTED;
+    {
+        std::lock_guard<std::mutex> lock(doc.constructionMutex);
+        flags.store(CONSTRUCTED, std::memory_order_release);
+    }
+    doc.constructionDone.notify_all();
     return object.get();
 }
 
+// ------------------------------------------------------------------------------------------------
+void LazyObject::Reset()
+{
+    {
+        std::lock_guard<std::mutex> lock(doc.constructionMutex);
+        object.reset();
+        builder = std::thread::id();
+        flags.store(0, std::memory_order_release);
+    }
+    doc.constructionDone.notify_all();
+}
+
 // ------------------------------------------------------------------------------------------------
 Object::Object(uint64_t id, const Element& element, const std::string& name)
 : element(element)
@@ -285,6 +353,52 @@ Document::Document(const Parser& parser, const ImportSettings& settings)
     ReadConnections();
 }
 
+// ------------------------------------------------------------------------------------------------
+void Document::ConstructObjects(ThreadPool* pool) const
+{
+    // the Objects scope itself is registered under id 0, skip it
+    std::vector<LazyObject*> lazy;
+    lazy.reserve(objects.size());
+    for (const ObjectMap::value_type& v : objects) {
+        if (v.first != 0L) {
+            lazy.push_back(v.second);
+        }
+    }
+
+    ParallelFor(pool, static_cast<unsigned int>(lazy.size()), [&lazy](unsigned int i) {
+        prebuilding = true;
+        try {
+            lazy[i]->Get();
+        }
+        catch(const DeferConstruction&) {
+            // left to the converter
+        }
+        catch(std::exception&) {
+            // raised before construction started, the converter runs into it again
+        }
+        prebuilding = false;
+    });
+}
+
+// ------------------------------------------------------------------------------------------------
+bool Document::WouldDeadlock(const LazyObject& object) const
+{
+    // follow the chain of threads waiting for each other, starting at the
+    // thread constructing the object this thread is about to wait for
+    const std::thread::id self = std::this_thread::get_id();
+    std::thread::id owner = object.builder;
+    for (;;) {
+        if (owner == self) {
+            return true;
+        }
+        std::map<std::thread::id, const LazyObject*>::const_iterator it = waitingFor.find(owner);
+        if (it == waitingFor.end()) {
+            return false;
+        }
+        owner = it->second->builder;
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 Document::~Document()
 {
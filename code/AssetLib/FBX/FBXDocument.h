@@ -49,6 +49,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <numeric>
 #include <stdint.h>
 #include <assimp/mesh.h>
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
 #include "FBXProperties.h"
 #include "FBXParser.h"
 
@@ -56,6 +61,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define  AI_CONCAT(a,b)  _AI_CONCAT(a,b)
 
 namespace Assimp {
+
+class ThreadPool;
+
 namespace FBX {
 
 class Parser;
@@ -84,7 +92,11 @@ class Cluster;
 
 /** Represents a delay-parsed FBX objects. Many objects in the scene
  *  are not needed by assimp, so it makes no sense to parse them
- *  upfront. */
+ *  upfront.
+ *
+ *  Get() is thread-safe: if another thread is constructing the object
+ *  already, the call waits for it to finish. Recursive requests, also
+ *  across threads, return nullptr as for a serial import. */
 class LazyObject {
 public:
     LazyObject(uint64_t id, const Element& element, const Document& doc);
@@ -104,11 +116,11 @@ public:
     }
 
     bool IsBeingConstructed() const {
-        return (flags & BEING_CONSTRUCTED) != 0;
+        return (flags.load(std::memory_order_acquire) & BEING_CONSTRUCTED) != 0;
     }
 
     bool FailedToConstruct() const {
-        return (flags & FAILED_TO_CONSTRUCT) != 0;
+        return (flags.load(std::memory_order_acquire) & FAILED_TO_CONSTRUCT) != 0;
     }
 
     const Element& GetElement() const {
@@ -120,6 +132,11 @@ public:
     }
 
 private:
+    friend class Document;
+
+    // back to the unconstructed state, after an aborted construction
+    void Reset();
+
     const Document& doc;
     const Element& element;
     std::unique_ptr<const Object> object;
@@ -128,10 +145,14 @@ private:
 
     enum Flags {
         BEING_CONSTRUCTED = 0x1,
-        FAILED_TO_CONSTRUCT = 0x2
+        FAILED_TO_CONSTRUCT = 0x2,
+        CONSTRUCTED = 0x4
     };
 
-    unsigned int flags;
+    std::atomic<unsigned int> flags;
+
+    // thread running the constructor while BEING_CONSTRUCTED is set
+    std::thread::id builder;
 };
 
 /** Base class for in-memory (DOM) representations of FBX objects */
@@ -1143,7 +1164,19 @@ public:
 
     const std::vector<const AnimationStack*>& AnimationStacks() const;
 
+    /** Construct all objects upfront instead of on first use, distributing
+     *  them across the given worker threads. Objects which fail or are part
+     *  of a cycle are left unconstructed, so the converter builds them as it
+     *  would without this call and reports their errors as usual. */
+    void ConstructObjects(ThreadPool* pool) const;
+
 private:
+    friend class LazyObject;
+
+    // check whether waiting for the object would close a cycle of threads
+    // waiting for each other. Requires the construction mutex to be locked.
+    bool WouldDeadlock(const LazyObject& object) const;
+
     std::vector<const Connection*> GetConnectionsSequenced(uint64_t id, const ConnectionMap&) const;
     std::vector<const Connection*> GetConnectionsSequenced(uint64_t id, bool is_src,
         const ConnectionMap&,
@@ -1173,6 +1206,11 @@ private:
     mutable std::vector<const AnimationStack*> animationStacksResolved;
 
     std::unique_ptr<FileGlobalSettings> globals;
+
+    // synchronizes LazyObject::Get() across threads
+    mutable std::mutex constructionMutex;
+    mutable std::condition_variable constructionDone;
+    mutable std::map<std::thread::id, const LazyObject*> waitingFor;
 };
 
 } // Namespace FBX
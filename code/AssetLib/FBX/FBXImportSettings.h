@@ -64,7 +64,8 @@ struct ImportSettings {
             optimizeEmptyAnimationCurves(true),
             useLegacyEmbeddedTextureNaming(false),
             removeEmptyBones(true),
-            convertToMeters(false) {
+            convertToMeters(false),
+            parallelObjects(false) {
         // empty
     }
 
@@ -150,6 +151,12 @@ struct ImportSettings {
     /** Set to true to perform a conversion from cm to meter after the import
     */
     bool convertToMeters;
+
+    /** Set to true to construct all document objects up front, spread
+     *  across the importer's thread pool, instead of lazily during
+     *  conversion. The default value is false.
+    */
+    bool parallelObjects;
 };
 
 } // namespace FBX
@@ -54,6 +54,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "FBXUtil.h"
 
 #include <assimp/MemoryIOWrapper.h>
+#include <assimp/Profiler.h>
 #include <assimp/StreamReader.h>
 #include <assimp/importerdesc.h>
 #include <assimp/Importer.hpp>
@@ -137,6 +138,7 @@ void FBXImporter::SetupProperties(const Importer *pImp) {
 	settings.useLegacyEmbeddedTextureNaming = pImp->GetPropertyBool(AI_CONFIG_IMPORT_FBX_EMBEDDED_TEXTURES_LEGACY_NAMING, false);
 	settings.removeEmptyBones = pImp->GetPropertyBool(AI_CONFIG_IMPORT_REMOVE_EMPTY_BONES, true);
 	settings.convertToMeters = pImp->GetPropertyBool(AI_CONFIG_FBX_CONVERT_TO_M, false);
+	settings.parallelObjects = pImp->GetPropertyBool(AI_CONFIG_IMPORT_FBX_PARALLEL_OBJECTS, false);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -157,34 +159,55 @@ void FBXImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSy
 	// then becomes very large, too. Assimp doesn't support
 	// streaming for its output data structures so the net win with
 	// streaming input data would be very low.
+	// Binary files are tokenized directly from the stream contents if
+	// they are already in memory, the ASCII tokenizer needs a terminator.
 	std::vector<char> contents;
-	contents.resize(stream->FileSize() + 1);
-	stream->Read(&*contents.begin(), 1, contents.size() - 1);
-	contents[contents.size() - 1] = 0;
-	const char *const begin = &*contents.begin();
+	const char *begin = static_cast<const char *>(stream->GetMappedData());
+	size_t length = stream->FileSize();
+	if (nullptr == begin || length < 18 || strncmp(begin, "Kaydara FBX Binary", 18)) {
+		contents.resize(length + 1);
+		stream->Read(&*contents.begin(), 1, length);
+		contents[length] = 0;
+		begin = &*contents.begin();
+		length = contents.size();
+	}
 
 	// broadphase tokenizing pass in which we identify the core
 	// syntax elements of FBX (brackets, commas, key:value mappings)
 	TokenList tokens;
+	InflatedArrays inflated;
 	try {
 
 		bool is_binary = false;
-		if (!strncmp(begin, "Kaydara FBX Binary", 18)) {
-			is_binary = true;
-			TokenizeBinary(tokens, begin, contents.size());
-		} else {
-			Tokenize(tokens, begin);
+		{
+			Profiling::ScopedRegion region(m_profiler, "tokenize");
+			if (!strncmp(begin, "Kaydara FBX Binary", 18)) {
+				is_binary = true;
+				TokenizeBinary(tokens, begin, length, m_threadPool, &inflated);
+			} else {
+				Tokenize(tokens, begin);
+			}
 		}
 
 		// use this information to construct a very rudimentary
 		// parse-tree representing the FBX scope structure
-		Parser parser(tokens, is_binary);
+		Profiling::ScopedRegion parseRegion(m_profiler, "parse");
+		Parser parser(tokens, is_binary, &inflated);
+		parseRegion.End();
 
 		// take the raw parse-tree and convert it to a FBX DOM
+		Profiling::ScopedRegion documentRegion(m_profiler, "document");
 		Document doc(parser, settings);
+		if (settings.parallelObjects) {
+			doc.ConstructObjects(m_threadPool);
+		}
+		documentRegion.End();
 
 		// convert the FBX DOM to aiScene
-		ConvertToAssimpScene(pScene, doc, settings.removeEmptyBones);
+		{
+			Profiling::ScopedRegion region(m_profiler, "convert");
+			ConvertToAssimpScene(pScene, doc, settings.removeEmptyBones);
+		}
 
 		// size relative to cm
 		float size_relative_to_cm = doc.GlobalSettings().UnitScaleFactor();
@@ -124,7 +124,7 @@ MeshGeometry::MeshGeometry(uint64_t id, const Element& element, const std::strin
         FBXImporter::LogWarn("encountered mesh with no faces");
     }
 
-    m_vertices.reserve(tempFaces.size());
+    m_vertices.resize(tempFaces.size());
     m_faces.reserve(tempFaces.size() / 3);
 
     m_mapping_offsets.resize(tempVerts.size());
@@ -136,13 +136,14 @@ MeshGeometry::MeshGeometry(uint64_t id, const Element& element, const std::strin
     // generate output vertices, computing an adjacency table to
     // preserve the mapping from fbx indices to *this* indexing.
     unsigned int count = 0;
+    aiVector3D *vertex = m_vertices.data();
     for(int index : tempFaces) {
         const int absi = index < 0 ? (-index - 1) : index;
         if(static_cast<size_t>(absi) >= vertex_count) {
             DOMError("polygon vertex index out of range",&PolygonVertexIndex);
         }
 
-        m_vertices.push_back(tempVerts[absi]);
+        *vertex++ = tempVerts[absi];
         ++count;
 
         ++m_mapping_counts[absi];
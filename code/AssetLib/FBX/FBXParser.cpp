@@ -46,12 +46,6 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #ifndef ASSIMP_BUILD_NO_FBX_IMPORTER
 
-#ifdef ASSIMP_BUILD_NO_OWN_ZLIB
-#   include <zlib.h>
-#else
-#   include "../contrib/zlib/zlib.h"
-#endif
-
 #include "FBXTokenizer.h"
 #include "FBXParser.h"
 #include "FBXUtil.h"
@@ -61,6 +55,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/ByteSwapper.h>
 #include <assimp/DefaultLogger.hpp>
 
+#include <cstring>
 #include <iostream>
 
 using namespace Assimp;
@@ -109,6 +104,21 @@ namespace {
         ::memcpy(&result, data, sizeof(T));
         return result;
     }
+
+    // ------------------------------------------------------------------------------------------------
+    // parse an ASCII number token in place. Next in the fbx token stream usually
+    // comes ',', so fast_atof must not interpret commas as decimal point.
+    float ParseAsciiFloat(const Token& t)
+    {
+        static const size_t MaxFloatLength = 31;
+        if (static_cast<size_t>(t.end() - t.begin()) > MaxFloatLength) {
+            return 0.f;
+        }
+
+        ai_real result;
+        fast_atoreal_move<ai_real>(t.begin(), result, false);
+        return static_cast<float>(result);
+    }
 }
 
 namespace Assimp {
@@ -116,7 +126,8 @@ namespace FBX {
 
 // ------------------------------------------------------------------------------------------------
 Element::Element(const Token& key_token, Parser& parser)
-: key_token(key_token)
+: parser(parser)
+, key_token(key_token)
 {
     TokenPtr n = nullptr;
     do {
@@ -170,6 +181,12 @@ Element::~Element()
      // no need to delete tokens, they are owned by the parser
 }
 
+// ------------------------------------------------------------------------------------------------
+InflatedArrays* Element::Inflated() const
+{
+    return parser.Inflated();
+}
+
 // ------------------------------------------------------------------------------------------------
 Scope::Scope(Parser& parser,bool topLevel)
 {
@@ -214,12 +231,13 @@ Scope::~Scope()
 }
 
 // ------------------------------------------------------------------------------------------------
-Parser::Parser (const TokenList& tokens, bool is_binary)
+Parser::Parser (const TokenList& tokens, bool is_binary, InflatedArrays* inflated)
 : tokens(tokens)
 , last()
 , current()
 , cursor(tokens.begin())
 , is_binary(is_binary)
+, inflated(inflated)
 {
     ASSIMP_LOG_DEBUG("Parsing FBX tokens");
     root.reset(new Scope(*this,true));
@@ -365,20 +383,7 @@ float ParseTokenAsFloat(const Token& t, const char*& err_out)
         }
     }
 
-    // need to copy the input string to a temporary buffer
-    // first - next in the fbx token stream comes ',',
-    // which fast_atof could interpret as decimal point.
-#define MAX_FLOAT_LENGTH 31
-    const size_t length = static_cast<size_t>(t.end()-t.begin());
-    if (length > MAX_FLOAT_LENGTH) {
-        return 0.f;
-    }
-
-    char temp[MAX_FLOAT_LENGTH + 1];
-    std::copy(t.begin(), t.end(), temp);
-    temp[std::min(static_cast<size_t>(MAX_FLOAT_LENGTH),length)] = '\0';
-
-    return fast_atof(temp);
+    return ParseAsciiFloat(t);
 }
 
 
@@ -521,10 +526,14 @@ void ReadBinaryDataArrayHead(const char*& data, const char* end, char& type, uin
 
 
 // ------------------------------------------------------------------------------------------------
-// read binary data array, assume cursor points to the 'compression mode' field (i.e. behind the header)
-void ReadBinaryDataArray(char type, uint32_t count, const char*& data, const char* end,
+// read binary data array, assume cursor points to the 'compression mode' field (i.e. behind the header).
+// Returns a pointer to the stride*count bytes of the array: the token data itself for plain arrays,
+// buff for compressed ones, which receives the data inflated during tokenization if there is any
+// or is inflated here otherwise.
+// The result may be unaligned, use ReadArrayValue() to access it.
+const char* ReadBinaryDataArray(const Token& token, char type, uint32_t count, const char*& data, const char* end,
     std::vector<char>& buff,
-    const Element& /*el*/)
+    const Element& el)
 {
     BE_NCONST uint32_t encmode = SafeParse<uint32_t>(data, end);
     AI_SWAP4(encmode);
@@ -555,53 +564,63 @@ void ReadBinaryDataArray(char type, uint32_t count, const char*& data, const cha
             ai_assert(false);
     };
 
-    const uint32_t full_length = stride * count;
-    buff.resize(full_length);
+    const uint64_t full_length = static_cast<uint64_t>(stride) * count;
+    const char* result = nullptr;
 
     if(encmode == 0) {
-        ai_assert(full_length == comp_len);
+        if (full_length != comp_len) {
+            ParseError("Invalid read size (binary)",&el);
+        }
 
         // plain data, no compression
-        std::copy(data, end, buff.begin());
+        result = data;
     }
     else if(encmode == 1) {
-        // zlib/deflate, next comes ZIP head (0x78 0x01)
-        // see http://www.ietf.org/rfc/rfc1950.txt
-
-        z_stream zstream;
-        zstream.opaque = Z_NULL;
-        zstream.zalloc = Z_NULL;
-        zstream.zfree  = Z_NULL;
-        zstream.data_type = Z_BINARY;
-
-        // http://hewgill.com/journal/entries/349-how-to-decompress-gzip-stream-with-zlib
-        if(Z_OK != inflateInit(&zstream)) {
-            ParseError("failure initializing zlib");
+        // take over the data inflated by the tokenizer, it is freed together with buff
+        buff.clear();
+        if (InflatedArrays* inflated = el.Inflated()) {
+            inflated->Take(token, buff);
         }
-
-        zstream.next_in   = reinterpret_cast<Bytef*>( const_cast<char*>(data) );
-        zstream.avail_in  = comp_len;
-
-        zstream.avail_out = static_cast<uInt>(buff.size());
-        zstream.next_out = reinterpret_cast<Bytef*>(&*buff.begin());
-        const int ret = inflate(&zstream, Z_FINISH);
-
-        if (ret != Z_STREAM_END && ret != Z_OK) {
-            ParseError("failure decompressing compressed data section");
+        if (buff.size() != full_length) {
+            buff.resize(static_cast<size_t>(full_length));
+            if (!buff.empty() && !Util::Inflate(data, comp_len, &buff[0], buff.size())) {
+                ParseError("failure decompressing compressed data section");
+            }
         }
-
-        // terminate zlib
-        inflateEnd(&zstream);
+        result = buff.empty() ? data : &buff[0];
     }
-#ifdef ASSIMP_BUILD_DEBUG
     else {
         // runtime check for this happens at tokenization stage
-        ai_assert(false);
+        ParseError("unknown encoding of binary data array",&el);
     }
-#endif
 
     data += comp_len;
     ai_assert(data == end);
+    return result;
+}
+
+// ------------------------------------------------------------------------------------------------
+// read a single value from a binary data array, which is not necessarily aligned
+template <typename T>
+T ReadArrayValue(const char* p)
+{
+    T value;
+    ::memcpy(&value, p, sizeof(T));
+    return value;
+}
+
+// ------------------------------------------------------------------------------------------------
+// read the ASCII number at 'it' and advance to the next token of the data array
+ai_real ReadAsciiNumber(TokenList::const_iterator& it)
+{
+    const Token& t = **it++;
+    if (t.Type() != TokenType_DATA) {
+        ParseError("expected TOK_DATA token", &t);
+    }
+    if (t.IsBinary()) {
+        ParseError("expected ASCII number", &t);
+    }
+    return static_cast<ai_real>(ParseAsciiFloat(t));
 }
 
 } // !anon
@@ -638,49 +657,32 @@ void ParseVectorDataArray(std::vector<aiVector3D>& out, const Element& el)
         }
 
         std::vector<char> buff;
-        ReadBinaryDataArray(type, count, data, end, buff, el);
-
+        const char* values = ReadBinaryDataArray(*tok[0], type, count, data, end, buff, el);
         ai_assert(data == end);
-        uint64_t dataToRead = static_cast<uint64_t>(count) * (type == 'd' ? 8 : 4);
-        ai_assert(buff.size() == dataToRead);
-        if (dataToRead > buff.size()) {
-            ParseError("Invalid read size (binary)",&el);
-        }
 
         const uint32_t count3 = count / 3;
-        out.reserve(count3);
+        out.resize(count3);
 
         if (type == 'd') {
-            const double* d = reinterpret_cast<const double*>(&buff[0]);
-            for (unsigned int i = 0; i < count3; ++i, d += 3) {
-                out.push_back(aiVector3D(static_cast<ai_real>(d[0]),
-                    static_cast<ai_real>(d[1]),
-                    static_cast<ai_real>(d[2])));
+            for (unsigned int i = 0; i < count3; ++i, values += 24) {
+                out[i] = aiVector3D(static_cast<ai_real>(ReadArrayValue<double>(values)),
+                    static_cast<ai_real>(ReadArrayValue<double>(values + 8)),
+                    static_cast<ai_real>(ReadArrayValue<double>(values + 16)));
             }
-            // for debugging
-            /*for ( size_t i = 0; i < out.size(); i++ ) {
-                aiVector3D vec3( out[ i ] );
-                std::stringstream stream;
-                stream << " vec3.x = " << vec3.x << " vec3.y = " << vec3.y << " vec3.z = " << vec3.z << std::endl;
-                DefaultLogger::get()->info( stream.str() );
-            }*/
         }
         else if (type == 'f') {
-            const float* f = reinterpret_cast<const float*>(&buff[0]);
-            for (unsigned int i = 0; i < count3; ++i, f += 3) {
-                out.push_back(aiVector3D(f[0],f[1],f[2]));
+            for (unsigned int i = 0; i < count3; ++i, values += 12) {
+                out[i] = aiVector3D(ReadArrayValue<float>(values),
+                    ReadArrayValue<float>(values + 4),
+                    ReadArrayValue<float>(values + 8));
             }
         }
 
         return;
     }
 
-    const size_t dim = ParseTokenAsDim(*tok[0]);
-
-    // may throw bad_alloc if the input is rubbish, but this need
-    // not to be prevented - importing would fail but we wouldn't
-    // crash since assimp handles this case properly.
-    out.reserve(dim);
+    // still validate the declared dimension
+    ParseTokenAsDim(*tok[0]);
 
     const Scope& scope = GetRequiredScope(el);
     const Element& a = GetRequiredElement(scope,"a",&el);
@@ -688,13 +690,18 @@ void ParseVectorDataArray(std::vector<aiVector3D>& out, const Element& el)
     if (a.Tokens().size() % 3 != 0) {
         ParseError("number of floats is not a multiple of three (3)",&el);
     }
-    for (TokenList::const_iterator it = a.Tokens().begin(), end = a.Tokens().end(); it != end; ) {
-        aiVector3D v;
-        v.x = ParseTokenAsFloat(**it++);
-        v.y = ParseTokenAsFloat(**it++);
-        v.z = ParseTokenAsFloat(**it++);
+    if (a.Tokens().empty()) {
+        return;
+    }
 
-        out.push_back(v);
+    // the number of values comes from the actual tokens rather than the
+    // declared dimension, so rubbish input can not make us overallocate.
+    out.resize(a.Tokens().size() / 3);
+    TokenList::const_iterator it = a.Tokens().begin();
+    for (aiVector3D& v : out) {
+        v.x = ReadAsciiNumber(it);
+        v.y = ReadAsciiNumber(it);
+        v.z = ReadAsciiNumber(it);
     }
 }
 
@@ -729,40 +736,32 @@ void ParseVectorDataArray(std::vector<aiColor4D>& out, const Element& el)
         }
 
         std::vector<char> buff;
-        ReadBinaryDataArray(type, count, data, end, buff, el);
-
+        const char* values = ReadBinaryDataArray(*tok[0], type, count, data, end, buff, el);
         ai_assert(data == end);
-        uint64_t dataToRead = static_cast<uint64_t>(count) * (type == 'd' ? 8 : 4);
-        ai_assert(buff.size() == dataToRead);
-        if (dataToRead > buff.size()) {
-            ParseError("Invalid read size (binary)",&el);
-        }
 
         const uint32_t count4 = count / 4;
-        out.reserve(count4);
+        out.resize(count4);
 
         if (type == 'd') {
-            const double* d = reinterpret_cast<const double*>(&buff[0]);
-            for (unsigned int i = 0; i < count4; ++i, d += 4) {
-                out.push_back(aiColor4D(static_cast<float>(d[0]),
-                    static_cast<float>(d[1]),
-                    static_cast<float>(d[2]),
-                    static_cast<float>(d[3])));
+            for (unsigned int i = 0; i < count4; ++i, values += 32) {
+                out[i] = aiColor4D(static_cast<float>(ReadArrayValue<double>(values)),
+                    static_cast<float>(ReadArrayValue<double>(values + 8)),
+                    static_cast<float>(ReadArrayValue<double>(values + 16)),
+                    static_cast<float>(ReadArrayValue<double>(values + 24)));
             }
         }
         else if (type == 'f') {
-            const float* f = reinterpret_cast<const float*>(&buff[0]);
-            for (unsigned int i = 0; i < count4; ++i, f += 4) {
-                out.push_back(aiColor4D(f[0],f[1],f[2],f[3]));
+            for (unsigned int i = 0; i < count4; ++i, values += 16) {
+                out[i] = aiColor4D(ReadArrayValue<float>(values),
+                    ReadArrayValue<float>(values + 4),
+                    ReadArrayValue<float>(values + 8),
+                    ReadArrayValue<float>(values + 12));
             }
         }
         return;
     }
 
-    const size_t dim = ParseTokenAsDim(*tok[0]);
-
-    //  see notes in ParseVectorDataArray() above
-    out.reserve(dim);
+    ParseTokenAsDim(*tok[0]);
 
     const Scope& scope = GetRequiredScope(el);
     const Element& a = GetRequiredElement(scope,"a",&el);
@@ -770,14 +769,18 @@ void ParseVectorDataArray(std::vector<aiColor4D>& out, const Element& el)
     if (a.Tokens().size() % 4 != 0) {
         ParseError("number of floats is not a multiple of four (4)",&el);
     }
-    for (TokenList::const_iterator it = a.Tokens().begin(), end = a.Tokens().end(); it != end; ) {
-        aiColor4D v;
-        v.r = ParseTokenAsFloat(**it++);
-        v.g = ParseTokenAsFloat(**it++);
-        v.b = ParseTokenAsFloat(**it++);
-        v.a = ParseTokenAsFloat(**it++);
+    if (a.Tokens().empty()) {
+        return;
+    }
 
-        out.push_back(v);
+    //  see notes in ParseVectorDataArray() above
+    out.resize(a.Tokens().size() / 4);
+    TokenList::const_iterator it = a.Tokens().begin();
+    for (aiColor4D& c : out) {
+        c.r = ReadAsciiNumber(it);
+        c.g = ReadAsciiNumber(it);
+        c.b = ReadAsciiNumber(it);
+        c.a = ReadAsciiNumber(it);
     }
 }
 
@@ -812,39 +815,29 @@ void ParseVectorDataArray(std::vector<aiVector2D>& out, const Element& el)
         }
 
         std::vector<char> buff;
-        ReadBinaryDataArray(type, count, data, end, buff, el);
-
+        const char* values = ReadBinaryDataArray(*tok[0], type, count, data, end, buff, el);
         ai_assert(data == end);
-        uint64_t dataToRead = static_cast<uint64_t>(count) * (type == 'd' ? 8 : 4);
-        ai_assert(buff.size() == dataToRead);
-        if (dataToRead > buff.size()) {
-            ParseError("Invalid read size (binary)",&el);
-        }
 
         const uint32_t count2 = count / 2;
-        out.reserve(count2);
+        out.resize(count2);
 
         if (type == 'd') {
-            const double* d = reinterpret_cast<const double*>(&buff[0]);
-            for (unsigned int i = 0; i < count2; ++i, d += 2) {
-                out.push_back(aiVector2D(static_cast<float>(d[0]),
-                    static_cast<float>(d[1])));
+            for (unsigned int i = 0; i < count2; ++i, values += 16) {
+                out[i] = aiVector2D(static_cast<float>(ReadArrayValue<double>(values)),
+                    static_cast<float>(ReadArrayValue<double>(values + 8)));
             }
         }
         else if (type == 'f') {
-            const float* f = reinterpret_cast<const float*>(&buff[0]);
-            for (unsigned int i = 0; i < count2; ++i, f += 2) {
-                out.push_back(aiVector2D(f[0],f[1]));
+            for (unsigned int i = 0; i < count2; ++i, values += 8) {
+                out[i] = aiVector2D(ReadArrayValue<float>(values),
+                    ReadArrayValue<float>(values + 4));
             }
         }
 
         return;
     }
 
-    const size_t dim = ParseTokenAsDim(*tok[0]);
-
-    // see notes in ParseVectorDataArray() above
-    out.reserve(dim);
+    ParseTokenAsDim(*tok[0]);
 
     const Scope& scope = GetRequiredScope(el);
     const Element& a = GetRequiredElement(scope,"a",&el);
@@ -852,12 +845,16 @@ void ParseVectorDataArray(std::vector<aiVector2D>& out, const Element& el)
     if (a.Tokens().size() % 2 != 0) {
         ParseError("number of floats is not a multiple of two (2)",&el);
     }
-    for (TokenList::const_iterator it = a.Tokens().begin(), end = a.Tokens().end(); it != end; ) {
-        aiVector2D v;
-        v.x = ParseTokenAsFloat(**it++);
-        v.y = ParseTokenAsFloat(**it++);
+    if (a.Tokens().empty()) {
+        return;
+    }
 
-        out.push_back(v);
+    // see notes in ParseVectorDataArray() above
+    out.resize(a.Tokens().size() / 2);
+    TokenList::const_iterator it = a.Tokens().begin();
+    for (aiVector2D& v : out) {
+        v.x = ReadAsciiNumber(it);
+        v.y = ReadAsciiNumber(it);
     }
 }
 
@@ -888,22 +885,15 @@ void ParseVectorDataArray(std::vector<int>& out, const Element& el)
         }
 
         std::vector<char> buff;
-        ReadBinaryDataArray(type, count, data, end, buff, el);
-
+        const char* values = ReadBinaryDataArray(*tok[0], type, count, data, end, buff, el);
         ai_assert(data == end);
-        uint64_t dataToRead = static_cast<uint64_t>(count) * 4;
-        ai_assert(buff.size() == dataToRead);
-        if (dataToRead > buff.size()) {
-            ParseError("Invalid read size (binary)",&el);
-        }
 
-        out.reserve(count);
+        out.resize(count);
 
-        const int32_t* ip = reinterpret_cast<const int32_t*>(&buff[0]);
-        for (unsigned int i = 0; i < count; ++i, ++ip) {
-            BE_NCONST int32_t val = *ip;
+        for (unsigned int i = 0; i < count; ++i, values += 4) {
+            BE_NCONST int32_t val = ReadArrayValue<int32_t>(values);
             AI_SWAP4(val);
-            out.push_back(val);
+            out[i] = val;
         }
 
         return;
@@ -950,42 +940,36 @@ void ParseVectorDataArray(std::vector<float>& out, const Element& el)
         }
 
         std::vector<char> buff;
-        ReadBinaryDataArray(type, count, data, end, buff, el);
-
+        const char* values = ReadBinaryDataArray(*tok[0], type, count, data, end, buff, el);
         ai_assert(data == end);
-        uint64_t dataToRead = static_cast<uint64_t>(count) * (type == 'd' ? 8 : 4);
-        ai_assert(buff.size() == dataToRead);
-        if (dataToRead > buff.size()) {
-            ParseError("Invalid read size (binary)",&el);
-        }
+
+        out.resize(count);
 
         if (type == 'd') {
-            const double* d = reinterpret_cast<const double*>(&buff[0]);
-            for (unsigned int i = 0; i < count; ++i, ++d) {
-                out.push_back(static_cast<float>(*d));
+            for (unsigned int i = 0; i < count; ++i, values += 8) {
+                out[i] = static_cast<float>(ReadArrayValue<double>(values));
             }
         }
         else if (type == 'f') {
-            const float* f = reinterpret_cast<const float*>(&buff[0]);
-            for (unsigned int i = 0; i < count; ++i, ++f) {
-                out.push_back(*f);
-            }
+            ::memcpy(&out[0], values, count * sizeof(float));
         }
 
         return;
     }
 
-    const size_t dim = ParseTokenAsDim(*tok[0]);
-
-    // see notes in ParseVectorDataArray()
-    out.reserve(dim);
+    ParseTokenAsDim(*tok[0]);
 
     const Scope& scope = GetRequiredScope(el);
     const Element& a = GetRequiredElement(scope,"a",&el);
+    if (a.Tokens().empty()) {
+        return;
+    }
 
-    for (TokenList::const_iterator it = a.Tokens().begin(), end = a.Tokens().end(); it != end; ) {
-        const float ival = ParseTokenAsFloat(**it++);
-        out.push_back(ival);
+    // see notes in ParseVectorDataArray()
+    out.resize(a.Tokens().size());
+    TokenList::const_iterator it = a.Tokens().begin();
+    for (float& f : out) {
+        f = static_cast<float>(ReadAsciiNumber(it));
     }
 }
 
@@ -1015,26 +999,19 @@ void ParseVectorDataArray(std::vector<unsigned int>& out, const Element& el)
         }
 
         std::vector<char> buff;
-        ReadBinaryDataArray(type, count, data, end, buff, el);
-
+        const char* values = ReadBinaryDataArray(*tok[0], type, count, data, end, buff, el);
         ai_assert(data == end);
-        uint64_t dataToRead = static_cast<uint64_t>(count) * 4;
-        ai_assert(buff.size() == dataToRead);
-        if (dataToRead > buff.size()) {
-            ParseError("Invalid read size (binary)",&el);
-        }
 
-        out.reserve(count);
+        out.resize(count);
 
-        const int32_t* ip = reinterpret_cast<const int32_t*>(&buff[0]);
-        for (unsigned int i = 0; i < count; ++i, ++ip) {
-            BE_NCONST int32_t val = *ip;
+        for (unsigned int i = 0; i < count; ++i, values += 4) {
+            BE_NCONST int32_t val = ReadArrayValue<int32_t>(values);
             if(val < 0) {
                 ParseError("encountered negative integer index (binary)");
             }
 
             AI_SWAP4(val);
-            out.push_back(val);
+            out[i] = val;
         }
 
         return;
@@ -1084,22 +1061,15 @@ void ParseVectorDataArray(std::vector<uint64_t>& out, const Element& el)
         }
 
         std::vector<char> buff;
-        ReadBinaryDataArray(type, count, data, end, buff, el);
-
+        const char* values = ReadBinaryDataArray(*tok[0], type, count, data, end, buff, el);
         ai_assert(data == end);
-        uint64_t dataToRead = static_cast<uint64_t>(count) * 8;
-        ai_assert(buff.size() == dataToRead);
-        if (dataToRead > buff.size()) {
-            ParseError("Invalid read size (binary)",&el);
-        }
 
-        out.reserve(count);
+        out.resize(count);
 
-        const uint64_t* ip = reinterpret_cast<const uint64_t*>(&buff[0]);
-        for (unsigned int i = 0; i < count; ++i, ++ip) {
-            BE_NCONST uint64_t val = *ip;
+        for (unsigned int i = 0; i < count; ++i, values += 8) {
+            BE_NCONST uint64_t val = ReadArrayValue<uint64_t>(values);
             AI_SWAP8(val);
-            out.push_back(val);
+            out[i] = val;
         }
 
         return;
@@ -1146,22 +1116,15 @@ void ParseVectorDataArray(std::vector<int64_t>& out, const Element& el)
         }
 
         std::vector<char> buff;
-        ReadBinaryDataArray(type, count, data, end, buff, el);
-
+        const char* values = ReadBinaryDataArray(*tok[0], type, count, data, end, buff, el);
         ai_assert(data == end);
-        uint64_t dataToRead = static_cast<uint64_t>(count) * 8;
-        ai_assert(buff.size() == dataToRead);
-        if (dataToRead > buff.size()) {
-            ParseError("Invalid read size (binary)",&el);
-        }
 
-        out.reserve(count);
+        out.resize(count);
 
-        const int64_t* ip = reinterpret_cast<const int64_t*>(&buff[0]);
-        for (unsigned int i = 0; i < count; ++i, ++ip) {
-            BE_NCONST int64_t val = *ip;
+        for (unsigned int i = 0; i < count; ++i, values += 8) {
+            BE_NCONST int64_t val = ReadArrayValue<int64_t>(values);
             AI_SWAP8(val);
-            out.push_back(val);
+            out[i] = val;
         }
 
         return;
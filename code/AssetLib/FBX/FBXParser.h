@@ -101,7 +101,11 @@ public:
         return tokens;
     }
 
+    /** Binary data arrays inflated ahead of parsing, may be nullptr */
+    InflatedArrays* Inflated() const;
+
 private:
+    const Parser& parser;
     const Token& key_token;
     TokenList tokens;
     std::unique_ptr<Scope> compound;
@@ -158,8 +162,9 @@ class Parser
 {
 public:
     /** Parse given a token list. Does not take ownership of the tokens -
-     *  the objects must persist during the entire parser lifetime */
-    Parser (const TokenList& tokens,bool is_binary);
+     *  the objects must persist during the entire parser lifetime. The same
+     *  holds for the arrays inflated by TokenizeBinary(), if any. */
+    Parser (const TokenList& tokens,bool is_binary, InflatedArrays* inflated = nullptr);
     ~Parser();
 
     const Scope& GetRootScope() const {
@@ -170,6 +175,10 @@ public:
         return is_binary;
     }
 
+    InflatedArrays* Inflated() const {
+        return inflated;
+    }
+
 private:
     friend class Scope;
     friend class Element;
@@ -186,6 +195,7 @@ private:
     std::unique_ptr<Scope> root;
 
     const bool is_binary;
+    InflatedArrays* const inflated;
 };
 
 
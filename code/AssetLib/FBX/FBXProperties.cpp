@@ -212,33 +212,39 @@ PropertyTable::~PropertyTable()
 // ------------------------------------------------------------------------------------------------
 const Property* PropertyTable::Get(const std::string& name) const
 {
-    PropertyMap::const_iterator it = props.find(name);
-    if (it == props.end()) {
-        // hasn't been parsed yet?
-        LazyPropertyMap::const_iterator lit = lazyProps.find(name);
-        if(lit != lazyProps.end()) {
-            props[name] = ReadTypedProperty(*(*lit).second);
-            it = props.find(name);
-
-            ai_assert(it != props.end());
-        }
-
+    {
+        // templates are shared by many objects, which may be constructed
+        // on different threads
+        std::lock_guard<std::mutex> lock(mutex);
+        PropertyMap::const_iterator it = props.find(name);
         if (it == props.end()) {
-            // check property template
-            if(templateProps) {
-                return templateProps->Get(name);
+            // hasn't been parsed yet?
+            LazyPropertyMap::const_iterator lit = lazyProps.find(name);
+            if(lit != lazyProps.end()) {
+                props[name] = ReadTypedProperty(*(*lit).second);
+                it = props.find(name);
+
+                ai_assert(it != props.end());
             }
+        }
 
-            return nullptr;
+        if (it != props.end()) {
+            return (*it).second;
         }
     }
 
-    return (*it).second;
+    // check property template
+    if(templateProps) {
+        return templateProps->Get(name);
+    }
+
+    return nullptr;
 }
 
 DirectPropertyMap PropertyTable::GetUnparsedProperties() const
 {
     DirectPropertyMap result;
+    std::lock_guard<std::mutex> lock(mutex);
 
     // Loop through all the lazy properties (which is all the properties)
     for(const LazyPropertyMap::value_type& currentElement : lazyProps) {
@@ -48,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "FBXCompileConfig.h"
 #include <memory>
+#include <mutex>
 #include <string>
 
 namespace Assimp {
@@ -124,6 +125,7 @@ public:
 private:
     LazyPropertyMap lazyProps;
     mutable PropertyMap props;
+    mutable std::mutex mutex;
     const std::shared_ptr<const PropertyTable> templateProps;
     const Element* const element;
 };
@@ -53,9 +53,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "FBXTokenizer.h"
 #include "FBXUtil.h"
+#include "Common/simd.h"
 #include <assimp/Exceptional.h>
 #include <assimp/DefaultLogger.hpp>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define ASSIMP_FBX_TOKENIZER_SSE2
+#   include <emmintrin.h>
+#endif
+
 namespace Assimp {
 namespace FBX {
 
@@ -130,6 +136,152 @@ void ProcessDataToken( TokenList& output_tokens, const char*& start, const char*
     start = end = nullptr;
 }
 
+// ------------------------------------------------------------------------------------------------
+// true if 'c' always ends a data token: whitespace, control characters or punctuation
+inline bool IsTokenDelimiter(const char c)
+{
+    return static_cast<unsigned char>(c) <= ' ' || c == ',' || c == ';' || c == ':' ||
+        c == '{' || c == '}' || c == '\"';
+}
+
+// ------------------------------------------------------------------------------------------------
+// true if 'c' may end a run of quoted text or comment: control characters or double quotes
+inline bool IsTextDelimiter(const char c)
+{
+    return static_cast<unsigned char>(c) < ' ' || c == '\"';
+}
+
+#ifdef ASSIMP_FBX_TOKENIZER_SSE2
+
+// The block loads below may read past the terminating zero, which AddressSanitizer
+// cannot tell apart from an overflow. They never cross into the next page.
+#if defined(__GNUC__) || defined(__clang__)
+#   define AI_FBX_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#else
+#   define AI_FBX_NO_SANITIZE_ADDRESS
+#endif
+
+// ------------------------------------------------------------------------------------------------
+// true if 16 bytes can be loaded from 'cur' without touching the next memory page.
+// The input is only known to be zero-terminated, so we must not fault past its end.
+inline bool CanLoad16(const char* cur)
+{
+    return (reinterpret_cast<uintptr_t>(cur) & 4095) <= 4096 - 16;
+}
+
+// ------------------------------------------------------------------------------------------------
+// bit mask of the bytes in 'v' which are equal to 'c'
+inline __m128i Match(const __m128i v, const char c)
+{
+    return _mm_cmpeq_epi8(v, _mm_set1_epi8(c));
+}
+
+// ------------------------------------------------------------------------------------------------
+inline unsigned int FirstBit(unsigned int mask)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned int>(index);
+#else
+    return static_cast<unsigned int>(__builtin_ctz(mask));
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+AI_FBX_NO_SANITIZE_ADDRESS
+const char* SkipTokenSSE2(const char* cur)
+{
+    // bytes above ' ' are those for which max(v, '!') == v, compared unsigned
+    const __m128i printable = _mm_set1_epi8('!');
+    while (CanLoad16(cur)) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur));
+        __m128i stop = _mm_xor_si128(_mm_cmpeq_epi8(_mm_max_epu8(v, printable), v), _mm_set1_epi8(-1));
+        stop = _mm_or_si128(stop, _mm_or_si128(Match(v, ','), Match(v, ';')));
+        stop = _mm_or_si128(stop, _mm_or_si128(Match(v, ':'), Match(v, '\"')));
+        stop = _mm_or_si128(stop, _mm_or_si128(Match(v, '{'), Match(v, '}')));
+
+        const unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(stop));
+        if (mask) {
+            return cur + FirstBit(mask);
+        }
+        cur += 16;
+    }
+    while (!IsTokenDelimiter(*cur)) {
+        ++cur;
+    }
+    return cur;
+}
+
+// ------------------------------------------------------------------------------------------------
+AI_FBX_NO_SANITIZE_ADDRESS
+const char* SkipTextSSE2(const char* cur)
+{
+    const __m128i printable = _mm_set1_epi8(' ');
+    while (CanLoad16(cur)) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur));
+        __m128i stop = _mm_xor_si128(_mm_cmpeq_epi8(_mm_max_epu8(v, printable), v), _mm_set1_epi8(-1));
+        stop = _mm_or_si128(stop, Match(v, '\"'));
+
+        const unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(stop));
+        if (mask) {
+            return cur + FirstBit(mask);
+        }
+        cur += 16;
+    }
+    while (!IsTextDelimiter(*cur)) {
+        ++cur;
+    }
+    return cur;
+}
+
+#endif // ASSIMP_FBX_TOKENIZER_SSE2
+
+// ------------------------------------------------------------------------------------------------
+// Character scanners used by the tokenizer to skip the bulk of the input. Both
+// return the first character at or after 'cur' matching their delimiter class.
+// The class is a superset of the characters the tokenizer needs to look at, so
+// stopping early is always safe.
+class Scanner {
+public:
+    Scanner()
+#ifdef ASSIMP_FBX_TOKENIZER_SSE2
+    : sse2(CPUSupportsSSE2())
+#endif
+    {
+        // empty
+    }
+
+    const char* SkipToken(const char* cur) const {
+#ifdef ASSIMP_FBX_TOKENIZER_SSE2
+        if (sse2) {
+            return SkipTokenSSE2(cur);
+        }
+#endif
+        while (!IsTokenDelimiter(*cur)) {
+            ++cur;
+        }
+        return cur;
+    }
+
+    const char* SkipText(const char* cur) const {
+#ifdef ASSIMP_FBX_TOKENIZER_SSE2
+        if (sse2) {
+            return SkipTextSSE2(cur);
+        }
+#endif
+        while (!IsTextDelimiter(*cur)) {
+            ++cur;
+        }
+        return cur;
+    }
+
+private:
+#ifdef ASSIMP_FBX_TOKENIZER_SSE2
+    const bool sse2;
+#endif
+};
+
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -146,6 +298,8 @@ void Tokenize(TokenList& output_tokens, const char* input)
     bool in_double_quotes = false;
     bool pending_data_token = false;
 
+    const Scanner scanner;
+
     const char *token_begin = nullptr, *token_end = nullptr;
     for (const char* cur = input;*cur;column += (*cur == '\t' ? ASSIMP_FBX_TAB_WIDTH : 1), ++cur) {
         const char c = *cur;
@@ -157,18 +311,21 @@ void Tokenize(TokenList& output_tokens, const char* input)
             ++line;
         }
 
-        if(comment) {
-            continue;
-        }
-
-        if(in_double_quotes) {
-            if (c == '\"') {
+        if(comment || in_double_quotes) {
+            if (in_double_quotes && c == '\"') {
                 in_double_quotes = false;
                 token_end = cur;
 
                 ProcessDataToken(output_tokens,token_begin,token_end,line,column);
                 pending_data_token = false;
             }
+            else if (c != '\t') {
+                // jump to the next character which could change our state. All
+                // characters skipped are one column wide, as is the current one.
+                const char* next = scanner.SkipText(cur + 1);
+                column += static_cast<unsigned int>(next - cur - 1);
+                cur = next - 1;
+            }
             continue;
         }
 
@@ -234,11 +391,16 @@ void Tokenize(TokenList& output_tokens, const char* input)
             pending_data_token = false;
         }
         else {
-            token_end = cur;
             if (!token_begin) {
                 token_begin = cur;
             }
 
+            // consume the rest of the token at once
+            const char* next = scanner.SkipToken(cur + 1);
+            column += static_cast<unsigned int>(next - cur - 1);
+            cur = next - 1;
+
+            token_end = cur;
             pending_data_token = true;
         }
     }
@@ -53,6 +53,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <string>
 
 namespace Assimp {
+
+class ThreadPool;
+
 namespace FBX {
 
 /** Rough classification for text FBX tokens used for constructing the
@@ -161,6 +164,28 @@ typedef std::vector< TokenPtr > TokenList;
 #define new_Token new Token
 
 
+/** Zlib-compressed binary data arrays which were inflated ahead of parsing.
+ *  They are kept aside of their tokens, in the order of the file. */
+class InflatedArrays
+{
+public:
+    /** Inflate the arrays of the given tokens, in parallel if a thread pool is given.
+     *  The tokens must be in the order of the file.
+     * @throw DeadlyImportError if an array cannot be inflated */
+    void Inflate(const std::vector<TokenPtr>& compressed, ThreadPool* pool);
+
+    /** Moves the inflated contents of the array of token into out, so they are
+     *  released together with the caller's buffer. out is left empty if the
+     *  array was not inflated ahead or was taken before. Different tokens may
+     *  be taken concurrently. */
+    void Take(const Token& token, std::vector<char>& out);
+
+private:
+    std::vector<TokenPtr> tokens;
+    std::vector<std::vector<char> > data;
+};
+
+
 /** Main FBX tokenizer function. Transform input buffer into a list of preprocessed tokens.
  *
  *  Skips over comments and generates line and column numbers.
@@ -175,11 +200,19 @@ void Tokenize(TokenList& output_tokens, const char* input);
  *
  *  Emits a token list suitable for direct parsing.
  *
+ *  If a thread pool is given, compressed data arrays are collected while
+ *  tokenizing and inflated afterwards in parallel into inflated. Without a
+ *  pool the parser inflates each array when it reads it, so only one of
+ *  them is held at a time.
+ *
  * @param output_tokens Receives a list of all tokens in the input data.
  * @param input_buffer Binary input buffer to be processed.
  * @param length Length of input buffer, in bytes. There is no 0-terminal.
+ * @param pool Worker threads for inflating the data arrays, may be nullptr.
+ * @param inflated Receives the arrays inflated ahead, may be nullptr if pool is.
  * @throw DeadlyImportError if something goes wrong */
-void TokenizeBinary(TokenList& output_tokens, const char* input, size_t length);
+void TokenizeBinary(TokenList& output_tokens, const char* input, size_t length,
+    ThreadPool* pool = nullptr, InflatedArrays* inflated = nullptr);
 
 
 } // ! FBX
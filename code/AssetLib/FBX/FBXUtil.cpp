@@ -53,6 +53,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #ifndef ASSIMP_BUILD_NO_FBX_IMPORTER
 
+#ifdef ASSIMP_BUILD_NO_OWN_ZLIB
+#   include <zlib.h>
+#else
+#   include "../contrib/zlib/zlib.h"
+#endif
+
 namespace Assimp {
 namespace FBX {
 namespace Util {
@@ -234,6 +240,35 @@ std::string EncodeBase64(const char* data, size_t length)
     return encoded_string;
 }
 
+// ------------------------------------------------------------------------------------------------
+bool Inflate(const char* in, size_t inLength, char* out, size_t outLength)
+{
+    // zlib/deflate, next comes ZIP head (0x78 0x01)
+    // see http://www.ietf.org/rfc/rfc1950.txt
+    z_stream zstream;
+    zstream.opaque = Z_NULL;
+    zstream.zalloc = Z_NULL;
+    zstream.zfree  = Z_NULL;
+    zstream.data_type = Z_BINARY;
+
+    // http://hewgill.com/journal/entries/349-how-to-decompress-gzip-stream-with-zlib
+    if(Z_OK != inflateInit(&zstream)) {
+        return false;
+    }
+
+    zstream.next_in   = reinterpret_cast<Bytef*>( const_cast<char*>(in) );
+    zstream.avail_in  = static_cast<uInt>(inLength);
+
+    zstream.avail_out = static_cast<uInt>(outLength);
+    zstream.next_out  = reinterpret_cast<Bytef*>(out);
+    const int ret = inflate(&zstream, Z_FINISH);
+
+    // terminate zlib
+    inflateEnd(&zstream);
+
+    return ret == Z_STREAM_END || ret == Z_OK;
+}
+
 } // !Util
 } // !FBX
 } // !Assimp
@@ -123,6 +123,15 @@ char EncodeBase64(char byte);
 *  @return base64-encoded string*/
 std::string EncodeBase64(const char* data, size_t length);
 
+/** Inflate a zlib-compressed block, as used for binary data arrays.
+*
+*  @param in Compressed data.
+*  @param inLength Number of compressed bytes.
+*  @param out Buffer receiving the inflated data.
+*  @param outLength Size of the output buffer, the expected size of the inflated data.
+*  @return true on success, false if the data is corrupt*/
+bool Inflate(const char* in, size_t inLength, char* out, size_t outLength);
+
 }
 }
 }
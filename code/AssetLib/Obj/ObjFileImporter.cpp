@@ -68,6 +68,9 @@ static const aiImporterDesc desc = {
 
 static const unsigned int ObjMinSize = 16;
 
+// Files below this size are not worth splitting across threads
+static const size_t ObjParallelMinSize = 1024 * 1024;
+
 namespace Assimp {
 
 using namespace std;
@@ -123,8 +126,18 @@ void ObjFileImporter::InternReadFile(const std::string &file, aiScene *pScene, I
         throw DeadlyImportError("OBJ-file is too small.");
     }
 
+    // Large files are parsed in chunks on the thread pool, which needs the whole
+    // file in memory. Only memory mapped streams are used that way, all others
+    // are streamed so the file never has to fit into memory at once.
+    const char *data = nullptr;
+    if (nullptr != m_threadPool && fileSize >= ObjParallelMinSize) {
+        data = static_cast<const char *>(fileStream->GetMappedData());
+    }
+
     IOStreamBuffer<char> streamedBuffer;
-    streamedBuffer.open(fileStream.get());
+    if (nullptr == data) {
+        streamedBuffer.open(fileStream.get());
+    }
 
     // Allocate buffer and read file into it
     //TextFileToBuffer( fileStream.get(),m_Buffer);
@@ -143,10 +156,12 @@ void ObjFileImporter::InternReadFile(const std::string &file, aiScene *pScene, I
     }
 
     // parse the file into a temporary representation
-    ObjFileParser parser(streamedBuffer, modelName, pIOHandler, m_progress, file);
+    std::unique_ptr<ObjFileParser> parser(nullptr != data ?
+            new ObjFileParser(data, fileSize, modelName, pIOHandler, m_progress, file, m_threadPool) :
+            new ObjFileParser(streamedBuffer, modelName, pIOHandler, m_progress, file));
 
     // And create the proper return structures out of it
-    CreateDataFromImport(parser.GetModel(), pScene);
+    CreateDataFromImport(parser->GetModel(), pScene);
 
     streamedBuffer.close();
 
@@ -356,37 +371,36 @@ aiMesh *ObjFileImporter::createTopology(const ObjFile::Model *pModel, const ObjF
 
     unsigned int uiIdxCount(0u);
     if (pMesh->mNumFaces > 0) {
-        pMesh->mFaces = new aiFace[pMesh->mNumFaces];
         if (pObjMesh->m_uiMaterialIndex != ObjFile::Mesh::NoMaterial) {
             pMesh->mMaterialIndex = pObjMesh->m_uiMaterialIndex;
         }
 
-        unsigned int outIndex(0);
-
-        // Copy all data from all stored meshes
+        // Collect the number of indices of all faces, lines and points are split up
+        std::vector<unsigned int> numIndices;
+        numIndices.reserve(pMesh->mNumFaces);
         for (auto &face : pObjMesh->m_Faces) {
             ObjFile::Face *const inp = face;
             if (inp->m_PrimitiveType == aiPrimitiveType_LINE) {
-                for (size_t i = 0; i < inp->m_vertices.size() - 1; ++i) {
-                    aiFace &f = pMesh->mFaces[outIndex++];
-                    uiIdxCount += f.mNumIndices = 2;
-                    f.mIndices = new unsigned int[2];
-                }
-                continue;
+                numIndices.insert(numIndices.end(), inp->m_vertices.size() - 1, 2u);
             } else if (inp->m_PrimitiveType == aiPrimitiveType_POINT) {
-                for (size_t i = 0; i < inp->m_vertices.size(); ++i) {
-                    aiFace &f = pMesh->mFaces[outIndex++];
-                    uiIdxCount += f.mNumIndices = 1;
-                    f.mIndices = new unsigned int[1];
-                }
-                continue;
+                numIndices.insert(numIndices.end(), inp->m_vertices.size(), 1u);
+            } else {
+                numIndices.push_back((unsigned int)inp->m_vertices.size());
             }
+        }
+        ai_assert(numIndices.size() == pMesh->mNumFaces);
 
-            aiFace *pFace = &pMesh->mFaces[outIndex++];
-            const unsigned int uiNumIndices = (unsigned int)face->m_vertices.size();
-            uiIdxCount += pFace->mNumIndices = (unsigned int)uiNumIndices;
-            if (pFace->mNumIndices > 0) {
-                pFace->mIndices = new unsigned int[uiNumIndices];
+        if (m_poolFaceIndices) {
+            pMesh->AllocateFaces(pMesh->mNumFaces, numIndices.data());
+            uiIdxCount = pMesh->mNumFaceIndices;
+        } else {
+            pMesh->mFaces = new aiFace[pMesh->mNumFaces];
+            for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
+                aiFace &f = pMesh->mFaces[i];
+                uiIdxCount += f.mNumIndices = numIndices[i];
+                if (f.mNumIndices > 0) {
+                    f.mIndices = new unsigned int[f.mNumIndices];
+                }
             }
         }
     }
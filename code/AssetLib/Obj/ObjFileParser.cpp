@@ -44,12 +44,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ObjFileData.h"
 #include "ObjFileMtlImporter.h"
 #include "ObjTools.h"
+#include "Common/ThreadPool.h"
 #include <assimp/BaseImporter.h>
 #include <assimp/DefaultIOSystem.h>
 #include <assimp/ParsingUtils.h>
 #include <assimp/material.h>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/Importer.hpp>
+#include <algorithm>
 #include <cstdlib>
 #include <memory>
 #include <utility>
@@ -63,6 +65,9 @@ ObjFileParser::ObjFileParser() :
         m_DataItEnd(),
         m_pModel(nullptr),
         m_uiLine(0),
+        m_vertexBase(0),
+        m_texCoordBase(0),
+        m_normalBase(0),
         m_buffer(),
         m_pIO(nullptr),
         m_progress(nullptr),
@@ -77,26 +82,43 @@ ObjFileParser::ObjFileParser(IOStreamBuffer<char> &streamBuffer, const std::stri
         m_DataItEnd(),
         m_pModel(nullptr),
         m_uiLine(0),
+        m_vertexBase(0),
+        m_texCoordBase(0),
+        m_normalBase(0),
         m_buffer(),
         m_pIO(io),
         m_progress(progress),
         m_originalObjFileName(originalObjFileName) {
     std::fill_n(m_buffer, Buffersize, '\0');
 
-    // Create the model instance to store all the data
-    m_pModel.reset(new ObjFile::Model());
-    m_pModel->m_ModelName = modelName;
-
-    // create default material and store it
-    m_pModel->m_pDefaultMaterial = new ObjFile::Material;
-    m_pModel->m_pDefaultMaterial->MaterialName.Set(DEFAULT_MATERIAL);
-    m_pModel->m_MaterialLib.push_back(DEFAULT_MATERIAL);
-    m_pModel->m_MaterialMap[DEFAULT_MATERIAL] = m_pModel->m_pDefaultMaterial;
+    createModel(modelName);
 
     // Start parsing the file
     parseFile(streamBuffer);
 }
 
+ObjFileParser::ObjFileParser(const char *data, size_t length, const std::string &modelName,
+        IOSystem *io, ProgressHandler *progress,
+        const std::string &originalObjFileName, ThreadPool *pool) :
+        m_DataIt(),
+        m_DataItEnd(),
+        m_pModel(nullptr),
+        m_uiLine(0),
+        m_vertexBase(0),
+        m_texCoordBase(0),
+        m_normalBase(0),
+        m_buffer(),
+        m_pIO(io),
+        m_progress(progress),
+        m_originalObjFileName(originalObjFileName) {
+    std::fill_n(m_buffer, Buffersize, '\0');
+
+    createModel(modelName);
+
+    // Start parsing the file
+    parseFileParallel(data, length, pool);
+}
+
 ObjFileParser::~ObjFileParser() {
 }
 
@@ -109,6 +131,18 @@ ObjFile::Model *ObjFileParser::GetModel() const {
     return m_pModel.get();
 }
 
+void ObjFileParser::createModel(const std::string &modelName) {
+    // Create the model instance to store all the data
+    m_pModel.reset(new ObjFile::Model());
+    m_pModel->m_ModelName = modelName;
+
+    // create default material and store it
+    m_pModel->m_pDefaultMaterial = new ObjFile::Material;
+    m_pModel->m_pDefaultMaterial->MaterialName.Set(DEFAULT_MATERIAL);
+    m_pModel->m_MaterialLib.push_back(DEFAULT_MATERIAL);
+    m_pModel->m_MaterialMap[DEFAULT_MATERIAL] = m_pModel->m_pDefaultMaterial;
+}
+
 void ObjFileParser::parseFile(IOStreamBuffer<char> &streamBuffer) {
     // only update every 100KB or it'll be too slow
     //const unsigned int updateProgressEveryBytes = 100 * 1024;
@@ -132,100 +166,371 @@ void ObjFileParser::parseFile(IOStreamBuffer<char> &streamBuffer) {
             m_progress->UpdateFileRead(processed, progressTotal);
         }
 
-        // parse line
-        switch (*m_DataIt) {
-        case 'v': // Parse a vertex texture coordinate
-        {
-            ++m_DataIt;
-            if (*m_DataIt == ' ' || *m_DataIt == '\t') {
-                size_t numComponents = getNumComponentsInDataDefinition();
-                if (numComponents == 3) {
-                    // read in vertex definition
-                    getVector3(m_pModel->m_Vertices);
-                } else if (numComponents == 4) {
-                    // read in vertex definition (homogeneous coords)
-                    getHomogeneousVector3(m_pModel->m_Vertices);
-                } else if (numComponents == 6) {
-                    // read vertex and vertex-color
-                    getTwoVectors3(m_pModel->m_Vertices, m_pModel->m_VertexColors);
-                }
-            } else if (*m_DataIt == 't') {
-                // read in texture coordinate ( 2D or 3D )
-                ++m_DataIt;
-                size_t dim = getTexCoordVector(m_pModel->m_TextureCoord);
-                m_pModel->m_TextureCoordDim = std::max(m_pModel->m_TextureCoordDim, (unsigned int)dim);
-            } else if (*m_DataIt == 'n') {
-                // Read in normal vector definition
-                ++m_DataIt;
-                getVector3(m_pModel->m_Normals);
+        parseLine();
+    }
+}
+
+void ObjFileParser::parseLine() {
+    switch (*m_DataIt) {
+    case 'v': // Parse a vertex texture coordinate
+    {
+        parseVertexData();
+    } break;
+
+    case 'p': // Parse a face, line or point statement
+    case 'l':
+    case 'f': {
+        getFace(*m_DataIt == 'f' ? aiPrimitiveType_POLYGON : (*m_DataIt == 'l' ? aiPrimitiveType_LINE : aiPrimitiveType_POINT));
+    } break;
+
+    case '#': // Parse a comment
+    {
+        getComment();
+    } break;
+
+    case 'u': // Parse a material desc. setter
+    {
+        std::string name;
+
+        getNameNoSpace(m_DataIt, m_DataItEnd, name);
+
+        size_t nextSpace = name.find(' ');
+        if (nextSpace != std::string::npos)
+            name = name.substr(0, nextSpace);
+
+        if (name == "usemtl") {
+            getMaterialDesc();
+        }
+    } break;
+
+    case 'm': // Parse a material library or merging group ('mg')
+    {
+        std::string name;
+
+        getNameNoSpace(m_DataIt, m_DataItEnd, name);
+
+        size_t nextSpace = name.find(' ');
+        if (nextSpace != std::string::npos)
+            name = name.substr(0, nextSpace);
+
+        if (name == "mg")
+            getGroupNumberAndResolution();
+        else if (name == "mtllib")
+            getMaterialLib();
+        else
+            goto pf_skip_line;
+    } break;
+
+    case 'g': // Parse group name
+    {
+        getGroupName();
+    } break;
+
+    case 's': // Parse group number
+    {
+        getGroupNumber();
+    } break;
+
+    case 'o': // Parse object name
+    {
+        getObjectName();
+    } break;
+
+    default: {
+    pf_skip_line:
+        m_DataIt = skipLine<DataArrayIt>(m_DataIt, m_DataItEnd, m_uiLine);
+    } break;
+    }
+}
+
+void ObjFileParser::parseVertexData() {
+    ++m_DataIt;
+    if (*m_DataIt == ' ' || *m_DataIt == '\t') {
+        size_t numComponents = getNumComponentsInDataDefinition();
+        if (numComponents == 3) {
+            // read in vertex definition
+            getVector3(m_pModel->m_Vertices);
+        } else if (numComponents == 4) {
+            // read in vertex definition (homogeneous coords)
+            getHomogeneousVector3(m_pModel->m_Vertices);
+        } else if (numComponents == 6) {
+            // read vertex and vertex-color
+            getTwoVectors3(m_pModel->m_Vertices, m_pModel->m_VertexColors);
+        }
+    } else if (*m_DataIt == 't') {
+        // read in texture coordinate ( 2D or 3D )
+        ++m_DataIt;
+        size_t dim = getTexCoordVector(m_pModel->m_TextureCoord);
+        m_pModel->m_TextureCoordDim = std::max(m_pModel->m_TextureCoordDim, (unsigned int)dim);
+    } else if (*m_DataIt == 'n') {
+        // Read in normal vector definition
+        ++m_DataIt;
+        getVector3(m_pModel->m_Normals);
+    }
+}
+
+namespace {
+
+// Smallest chunk worth handing to another thread
+const size_t MinChunkSize = 256 * 1024;
+
+// Copy the line starting at 'cur' into 'buffer' the way IOStreamBuffer::getNextDataLine()
+// does: continued lines are joined and the line is terminated by '\n'. The zeros behind
+// it keep the parsing helpers, which treat the last character as end of buffer, from
+// stopping early. Returns false at the end of the data.
+bool getNextChunkLine(const char *&cur, const char *end, std::vector<char> &buffer) {
+    if (cur >= end) {
+        return false;
+    }
+
+    buffer.clear();
+    for (;;) {
+        if ('\\' == *cur && cur + 1 < end && IsLineEnd(cur[1])) {
+            ++cur;
+            while (cur < end && *cur != '\n') {
+                ++cur;
             }
-        } break;
+            ++cur;
+            if (cur >= end) {
+                break;
+            }
+        } else if (IsLineEnd(*cur)) {
+            break;
+        }
 
-        case 'p': // Parse a face, line or point statement
-        case 'l':
-        case 'f': {
-            getFace(*m_DataIt == 'f' ? aiPrimitiveType_POLYGON : (*m_DataIt == 'l' ? aiPrimitiveType_LINE : aiPrimitiveType_POINT));
-        } break;
+        buffer.push_back(*cur);
+        if (++cur >= end) {
+            break;
+        }
+    }
+    buffer.push_back('\n');
+    buffer.push_back('\0');
+    buffer.push_back('\0');
+    ++cur;
 
-        case '#': // Parse a comment
-        {
-            getComment();
-        } break;
+    return true;
+}
 
-        case 'u': // Parse a material desc. setter
-        {
-            std::string name;
+// Find the start of the first line behind 'cur', skipping line ends which are
+// part of a line continuation. 'begin' is the start of the current line.
+const char *findLineStart(const char *begin, const char *cur, const char *end) {
+    while (cur < end) {
+        const char *lineEnd = std::find(cur, end, '\n');
+        if (lineEnd == end) {
+            return end;
+        }
 
-            getNameNoSpace(m_DataIt, m_DataItEnd, name);
+        const char *last = lineEnd;
+        while (last > begin && IsLineEnd(last[-1])) {
+            --last;
+        }
+        cur = lineEnd + 1;
+        if (last == begin || last[-1] != '\\') {
+            return cur;
+        }
+    }
+    return end;
+}
 
-            size_t nextSpace = name.find(' ');
-            if (nextSpace != std::string::npos)
-                name = name.substr(0, nextSpace);
+// Append the vertex data of a chunk and release it. The first chunk hands over
+// its storage, the others are copied into the space reserved for all of them.
+template <class T>
+void appendVertexData(std::vector<T> &out, std::vector<T> &chunk, size_t total) {
+    if (out.empty() && chunk.size() == total) {
+        out.swap(chunk);
+    } else {
+        out.reserve(total);
+        out.insert(out.end(), chunk.begin(), chunk.end());
+    }
+    std::vector<T>().swap(chunk);
+}
+
+} // namespace
+
+// A part of the file parsed by one thread, starting at a line boundary
+struct ObjFileParser::Chunk {
+    // A face parsed on the worker thread or a statement which is replayed in order
+    struct Record {
+        std::unique_ptr<ObjFile::Face> face;
+        const char *begin;
+        const char *end;
+        unsigned int line;
+    };
+
+    const char *begin;
+    const char *end;
+    size_t numVertices;
+    size_t numVertexColors;
+    size_t numTexCoords;
+    size_t numNormals;
+    size_t numFaces;
+    unsigned int numLines;
+    std::unique_ptr<ObjFile::Model> model;
+    std::vector<Record> records;
+
+    Chunk(const char *b, const char *e) :
+            begin(b), end(e), numVertices(0), numVertexColors(0), numTexCoords(0), numNormals(0), numFaces(0), numLines(0), model(), records() {
+        // empty
+    }
+};
+
+void ObjFileParser::parseFileParallel(const char *data, size_t length, ThreadPool *pool) {
+    const char *end = data + length;
+
+    // split at line boundaries, a few chunks per thread to even out the load
+    const size_t numThreads = nullptr != pool ? pool->GetNumThreads() : 1;
+    const size_t chunkSize = std::max(MinChunkSize, length / (numThreads * 4) + 1);
+    std::vector<Chunk> chunks;
+    for (const char *cur = data; cur < end;) {
+        const char *next = cur + std::min(chunkSize, static_cast<size_t>(end - cur));
+        next = findLineStart(cur, next, end);
+        chunks.emplace_back(cur, next);
+        cur = next;
+    }
+    const unsigned int numChunks = static_cast<unsigned int>(chunks.size());
+
+    // first pass: count the vertex data to find out where each chunk starts
+    ParallelFor(pool, numChunks, [&chunks](unsigned int i) {
+        ObjFileParser worker;
+        worker.countChunk(chunks[i]);
+    });
+
+    size_t numVertices = 0, numVertexColors = 0, numTexCoords = 0, numNormals = 0;
+    unsigned int numLines = 0;
+    for (Chunk &chunk : chunks) {
+        chunk.model.reset(new ObjFile::Model());
+        chunk.model->m_Vertices.reserve(chunk.numVertices);
+        chunk.model->m_VertexColors.reserve(chunk.numVertexColors);
+        chunk.model->m_TextureCoord.reserve(chunk.numTexCoords);
+        chunk.model->m_Normals.reserve(chunk.numNormals);
+
+        // abuse the counters to pass the global base of the chunk to the workers
+        std::swap(numVertices, chunk.numVertices);
+        std::swap(numTexCoords, chunk.numTexCoords);
+        std::swap(numNormals, chunk.numNormals);
+        std::swap(numLines, chunk.numLines);
+        numVertices += chunk.numVertices;
+        numTexCoords += chunk.numTexCoords;
+        numNormals += chunk.numNormals;
+        numLines += chunk.numLines;
+        numVertexColors += chunk.numVertexColors;
+    }
+
+    // second pass: parse vertex data and faces
+    ParallelFor(pool, numChunks, [&chunks](unsigned int i) {
+        ObjFileParser worker;
+        worker.parseChunk(chunks[i]);
+    });
+    m_progress->UpdateFileRead(static_cast<unsigned int>(length), static_cast<unsigned int>(length));
+
+    // merge the vertex data in file order, each chunk is released as soon as it
+    // has been appended so the vertex data is not held twice
+    for (Chunk &chunk : chunks) {
+        ObjFile::Model &model = *chunk.model;
+        appendVertexData(m_pModel->m_Vertices, model.m_Vertices, numVertices);
+        appendVertexData(m_pModel->m_VertexColors, model.m_VertexColors, numVertexColors);
+        appendVertexData(m_pModel->m_TextureCoord, model.m_TextureCoord, numTexCoords);
+        appendVertexData(m_pModel->m_Normals, model.m_Normals, numNormals);
+        m_pModel->m_TextureCoordDim = std::max(m_pModel->m_TextureCoordDim, model.m_TextureCoordDim);
+        chunk.model.reset();
+    }
 
-            if (name == "usemtl") {
-                getMaterialDesc();
+    // replay faces and all other statements, which depend on the parser state
+    std::vector<char> buffer;
+    for (Chunk &chunk : chunks) {
+        for (Chunk::Record &record : chunk.records) {
+            m_uiLine = record.line;
+            if (record.face) {
+                storeFace(record.face.release());
+                continue;
             }
-        } break;
 
-        case 'm': // Parse a material library or merging group ('mg')
-        {
-            std::string name;
+            getNextChunkLine(record.begin, record.end, buffer);
+            m_DataIt = buffer.begin();
+            m_DataItEnd = buffer.end();
+            parseLine();
+        }
+        std::vector<Chunk::Record>().swap(chunk.records);
+    }
+    m_uiLine = numLines;
+}
 
-            getNameNoSpace(m_DataIt, m_DataItEnd, name);
+void ObjFileParser::countChunk(Chunk &chunk) {
+    std::vector<char> buffer;
+    for (const char *cur = chunk.begin; getNextChunkLine(cur, chunk.end, buffer);) {
+        ++chunk.numLines;
+        m_DataIt = buffer.begin();
+        m_DataItEnd = buffer.end();
 
-            size_t nextSpace = name.find(' ');
-            if (nextSpace != std::string::npos)
-                name = name.substr(0, nextSpace);
+        // mirror the records parseVertexData() adds
+        if ('v' == buffer[0]) {
+            if (' ' == buffer[1] || '\t' == buffer[1]) {
+                ++m_DataIt;
+                const size_t numComponents = getNumComponentsInDataDefinition();
+                if (numComponents == 3 || numComponents == 4 || numComponents == 6) {
+                    ++chunk.numVertices;
+                }
+                if (numComponents == 6) {
+                    ++chunk.numVertexColors;
+                }
+            } else if ('t' == buffer[1]) {
+                ++chunk.numTexCoords;
+            } else if ('n' == buffer[1]) {
+                ++chunk.numNormals;
+            }
+        } else if ('f' == buffer[0] || 'l' == buffer[0] || 'p' == buffer[0]) {
+            ++chunk.numFaces;
+        }
+    }
+}
 
-            if (name == "mg")
-                getGroupNumberAndResolution();
-            else if (name == "mtllib")
-                getMaterialLib();
-            else
-                goto pf_skip_line;
-        } break;
+void ObjFileParser::parseChunk(Chunk &chunk) {
+    m_pModel.reset(chunk.model.release());
+    m_vertexBase = chunk.numVertices;
+    m_texCoordBase = chunk.numTexCoords;
+    m_normalBase = chunk.numNormals;
+    chunk.records.reserve(chunk.numFaces);
 
-        case 'g': // Parse group name
-        {
-            getGroupName();
-        } break;
+    // line numbers continue where the previous chunk stopped, as in a serial run
+    std::vector<char> buffer;
+    unsigned int line = chunk.numLines;
+    for (const char *cur = chunk.begin; cur < chunk.end; ++line) {
+        m_uiLine = line;
+        const char *lineBegin = cur;
+        getNextChunkLine(cur, chunk.end, buffer);
+        m_DataIt = buffer.begin();
+        m_DataItEnd = buffer.end();
 
-        case 's': // Parse group number
-        {
-            getGroupNumber();
-        } break;
+        switch (buffer[0]) {
+        case 'v':
+            parseVertexData();
+            break;
 
-        case 'o': // Parse object name
-        {
-            getObjectName();
+        case 'p':
+        case 'l':
+        case 'f': {
+            ObjFile::Face *face = parseFace('f' == buffer[0] ? aiPrimitiveType_POLYGON : ('l' == buffer[0] ? aiPrimitiveType_LINE : aiPrimitiveType_POINT));
+            if (nullptr != face) {
+                chunk.records.push_back(Chunk::Record());
+                chunk.records.back().face.reset(face);
+                chunk.records.back().line = line;
+            }
         } break;
 
-        default: {
-        pf_skip_line:
-            m_DataIt = skipLine<DataArrayIt>(m_DataIt, m_DataItEnd, m_uiLine);
-        } break;
+        case '#':
+        case '\n':
+            // comments and empty lines do not change the parser state
+            break;
+
+        default:
+            chunk.records.push_back(Chunk::Record());
+            chunk.records.back().begin = lineBegin;
+            chunk.records.back().end = cur;
+            chunk.records.back().line = line;
+            break;
         }
     }
+    chunk.model.reset(m_pModel.release());
 }
 
 void ObjFileParser::copyNextWord(char *pBuffer, size_t length) {
@@ -407,20 +712,26 @@ void ObjFileParser::getVector2(std::vector<aiVector2D> &point2d_array) {
 static const std::string DefaultObjName = "defaultobject";
 
 void ObjFileParser::getFace(aiPrimitiveType type) {
+    ObjFile::Face *face = parseFace(type);
+    if (nullptr != face) {
+        storeFace(face);
+    }
+}
+
+ObjFile::Face *ObjFileParser::parseFace(aiPrimitiveType type) {
     m_DataIt = getNextToken<DataArrayIt>(m_DataIt, m_DataItEnd);
     if (m_DataIt == m_DataItEnd || *m_DataIt == '\0') {
-        return;
+        return nullptr;
     }
 
     ObjFile::Face *face = new ObjFile::Face(type);
-    bool hasNormal = false;
 
-    const int vSize = static_cast<unsigned int>(m_pModel->m_Vertices.size());
-    const int vtSize = static_cast<unsigned int>(m_pModel->m_TextureCoord.size());
-    const int vnSize = static_cast<unsigned int>(m_pModel->m_Normals.size());
+    const int vSize = static_cast<unsigned int>(m_vertexBase + m_pModel->m_Vertices.size());
+    const int vtSize = static_cast<unsigned int>(m_texCoordBase + m_pModel->m_TextureCoord.size());
+    const int vnSize = static_cast<unsigned int>(m_normalBase + m_pModel->m_Normals.size());
 
-    const bool vt = (!m_pModel->m_TextureCoord.empty());
-    const bool vn = (!m_pModel->m_Normals.empty());
+    const bool vt = (vtSize != 0);
+    const bool vn = (vnSize != 0);
     int iPos = 0;
     while (m_DataIt != m_DataItEnd) {
         int iStep = 1;
@@ -460,7 +771,6 @@ void ObjFileParser::getFace(aiPrimitiveType type) {
                     face->m_texturCoords.push_back(iVal - 1);
                 } else if (2 == iPos) {
                     face->m_normals.push_back(iVal - 1);
-                    hasNormal = true;
                 } else {
                     reportErrorTokenInFace();
                 }
@@ -472,7 +782,6 @@ void ObjFileParser::getFace(aiPrimitiveType type) {
                     face->m_texturCoords.push_back(vtSize + iVal);
                 } else if (2 == iPos) {
                     face->m_normals.push_back(vnSize + iVal);
-                    hasNormal = true;
                 } else {
                     reportErrorTokenInFace();
                 }
@@ -490,9 +799,15 @@ void ObjFileParser::getFace(aiPrimitiveType type) {
         // skip line and clean up
         m_DataIt = skipLine<DataArrayIt>(m_DataIt, m_DataItEnd, m_uiLine);
         delete face;
-        return;
+        return nullptr;
     }
 
+    // Skip the rest of the line
+    m_DataIt = skipLine<DataArrayIt>(m_DataIt, m_DataItEnd, m_uiLine);
+    return face;
+}
+
+void ObjFileParser::storeFace(ObjFile::Face *face) {
     // Set active material, if one set
     if (nullptr != m_pModel->m_pCurrentMaterial) {
         face->m_pMaterial = m_pModel->m_pCurrentMaterial;
@@ -514,11 +829,9 @@ void ObjFileParser::getFace(aiPrimitiveType type) {
     m_pModel->m_pCurrentMesh->m_Faces.push_back(face);
     m_pModel->m_pCurrentMesh->m_uiNumIndices += (unsigned int)face->m_vertices.size();
     m_pModel->m_pCurrentMesh->m_uiUVCoordinates[0] += (unsigned int)face->m_texturCoords.size();
-    if (!m_pModel->m_pCurrentMesh->m_hasNormals && hasNormal) {
+    if (!m_pModel->m_pCurrentMesh->m_hasNormals && !face->m_normals.empty()) {
         m_pModel->m_pCurrentMesh->m_hasNormals = true;
     }
-    // Skip the rest of the line
-    m_DataIt = skipLine<DataArrayIt>(m_DataIt, m_DataItEnd, m_uiLine);
 }
 
 void ObjFileParser::getMaterialDesc() {
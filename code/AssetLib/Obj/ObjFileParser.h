@@ -58,11 +58,13 @@ struct Object;
 struct Material;
 struct Point3;
 struct Point2;
+struct Face;
 } // namespace ObjFile
 
 class ObjFileImporter;
 class IOSystem;
 class ProgressHandler;
+class ThreadPool;
 
 /// \class  ObjFileParser
 /// \brief  Parser for a obj waveform file
@@ -78,6 +80,10 @@ public:
     ObjFileParser();
     /// @brief  Constructor with data array.
     ObjFileParser(IOStreamBuffer<char> &streamBuffer, const std::string &modelName, IOSystem *io, ProgressHandler *progress, const std::string &originalObjFileName);
+    /// @brief  Constructor with the whole file in memory. The file is split into chunks
+    ///         which are parsed on the given thread pool.
+    ObjFileParser(const char *data, size_t length, const std::string &modelName, IOSystem *io, ProgressHandler *progress,
+            const std::string &originalObjFileName, ThreadPool *pool);
     /// @brief  Destructor
     ~ObjFileParser();
     /// @brief  If you want to load in-core data.
@@ -89,8 +95,22 @@ public:
     ObjFileParser &operator=(const ObjFileParser& ) = delete;
 
 protected:
+    struct Chunk;
+
+    /// Create the model instance with its default material
+    void createModel(const std::string &modelName);
     /// Parse the loaded file
     void parseFile(IOStreamBuffer<char> &streamBuffer);
+    /// Parse the file in chunks on a thread pool
+    void parseFileParallel(const char *data, size_t length, ThreadPool *pool);
+    /// Count the lines and vertex data records of a chunk
+    void countChunk(Chunk &chunk);
+    /// Parse the vertex data and faces of a chunk, defer all other statements
+    void parseChunk(Chunk &chunk);
+    /// Parse the current line
+    void parseLine();
+    /// Parse a vertex data line, which starts with 'v'
+    void parseVertexData();
     /// Method to copy the new delimited word in the current line.
     void copyNextWord(char *pBuffer, size_t length);
     /// Method to copy the new line.
@@ -109,6 +129,10 @@ protected:
     void getVector2(std::vector<aiVector2D> &point2d_array);
     /// Stores the following face.
     void getFace(aiPrimitiveType type);
+    /// Reads the following face, returns nullptr for an empty face.
+    ObjFile::Face *parseFace(aiPrimitiveType type);
+    /// Adds a face to the current mesh.
+    void storeFace(ObjFile::Face *face);
     /// Reads the material description.
     void getMaterialDesc();
     /// Gets a comment.
@@ -150,6 +174,11 @@ private:
     std::unique_ptr<ObjFile::Model> m_pModel;
     //! Current line (for debugging)
     unsigned int m_uiLine;
+    //! Number of vertices, texture coordinates and normals declared before the
+    //! model's own arrays, nonzero when parsing one chunk of a larger file
+    size_t m_vertexBase;
+    size_t m_texCoordBase;
+    size_t m_normalBase;
     //! Helper buffer
     char m_buffer[Buffersize];
     /// Pointer to IO system instance.
@@ -47,10 +47,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // internal headers
 #include "PlyLoader.h"
+#include "Common/ThreadPool.h"
 #include <assimp/IOStreamBuffer.h>
 #include <assimp/importerdesc.h>
 #include <assimp/scene.h>
 #include <assimp/IOSystem.hpp>
+#include <algorithm>
 #include <memory>
 
 using namespace ::Assimp;
@@ -81,6 +83,9 @@ inline const T &GetProperty(const std::vector<T> &props, int idx) {
 
     return props[idx];
 }
+
+// Number of binary vertices decoded by one task
+static const unsigned int BinaryVerticesPerChunk = 8192;
 } // namespace
 
 // ------------------------------------------------------------------------------------------------
@@ -88,8 +93,10 @@ inline const T &GetProperty(const std::vector<T> &props, int idx) {
 PLYImporter::PLYImporter() :
         mBuffer(nullptr),
         pcDOM(nullptr),
-        mGeneratedMesh(nullptr) {
-    // empty
+        mGeneratedMesh(nullptr),
+        mVertexStride(0) {
+    std::fill(mVertexOffsets, mVertexOffsets + VC_Count, 0xFFFFFFFF);
+    std::fill(mVertexTypes, mVertexTypes + VC_Count, EDT_Char);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -394,14 +401,16 @@ void PLYImporter::LoadVertex(const PLY::Element *pcElement, const PLY::ElementIn
         }
 
         //Colors
+        // any color channel creates vertex colors, alpha included; the binary
+        // path in LoadVerticesBinary() uses the same condition
         aiColor4D cOut;
-        bool haveColor = false;
+        const bool haveColor = 0xFFFFFFFF != aiColors[0] || 0xFFFFFFFF != aiColors[1] ||
+                               0xFFFFFFFF != aiColors[2] || 0xFFFFFFFF != aiColors[3];
         if (0xFFFFFFFF != aiColors[0]) {
             cOut.r = NormalizeColorValue(GetProperty(instElement->alProperties,
                                                  aiColors[0])
                                                  .avList.front(),
                     aiColorsTypes[0]);
-            haveColor = true;
         }
 
         if (0xFFFFFFFF != aiColors[1]) {
@@ -409,7 +418,6 @@ void PLYImporter::LoadVertex(const PLY::Element *pcElement, const PLY::ElementIn
                                                  aiColors[1])
                                                  .avList.front(),
                     aiColorsTypes[1]);
-            haveColor = true;
         }
 
         if (0xFFFFFFFF != aiColors[2]) {
@@ -417,7 +425,6 @@ void PLYImporter::LoadVertex(const PLY::Element *pcElement, const PLY::ElementIn
                                                  aiColors[2])
                                                  .avList.front(),
                     aiColorsTypes[2]);
-            haveColor = true;
         }
 
         // assume 1.0 for the alpha channel if it is not set
@@ -428,8 +435,6 @@ void PLYImporter::LoadVertex(const PLY::Element *pcElement, const PLY::ElementIn
                                                  aiColors[3])
                                                  .avList.front(),
                     aiColorsTypes[3]);
-
-            haveColor = true;
         }
 
         //Texture coordinates
@@ -483,6 +488,138 @@ void PLYImporter::LoadVertex(const PLY::Element *pcElement, const PLY::ElementIn
     }
 }
 
+// ------------------------------------------------------------------------------------------------
+unsigned int PLYImporter::GetBinaryVertexStride(const PLY::Element *pcElement) {
+    ai_assert(nullptr != pcElement);
+
+    std::fill(mVertexOffsets, mVertexOffsets + VC_Count, 0xFFFFFFFF);
+    mVertexStride = 0;
+
+    // map the properties to the channels the same way LoadVertex() does
+    unsigned int cnt = 0;
+    for (const PLY::Property &prop : pcElement->alProperties) {
+        const unsigned int size = PLY::PropertyInstance::GetValueSize(prop.eType);
+        if (prop.bIsList || 0 == size) {
+            return mVertexStride = 0;
+        }
+
+        int channel = -1;
+        switch (prop.Semantic) {
+        case PLY::EST_XCoord: channel = VC_PosX; break;
+        case PLY::EST_YCoord: channel = VC_PosY; break;
+        case PLY::EST_ZCoord: channel = VC_PosZ; break;
+        case PLY::EST_XNormal: channel = VC_NormalX; break;
+        case PLY::EST_YNormal: channel = VC_NormalY; break;
+        case PLY::EST_ZNormal: channel = VC_NormalZ; break;
+        case PLY::EST_Red: channel = VC_Red; break;
+        case PLY::EST_Green: channel = VC_Green; break;
+        case PLY::EST_Blue: channel = VC_Blue; break;
+        case PLY::EST_Alpha: channel = VC_Alpha; break;
+        case PLY::EST_UTextureCoord: channel = VC_U; break;
+        case PLY::EST_VTextureCoord: channel = VC_V; break;
+        default: break;
+        }
+        if (channel >= 0) {
+            ++cnt;
+            mVertexOffsets[channel] = mVertexStride;
+            mVertexTypes[channel] = prop.eType;
+        }
+        mVertexStride += size;
+    }
+
+    // without any vertex data LoadVertex() skips the element
+    if (0 == cnt) {
+        mVertexStride = 0;
+    }
+    return mVertexStride;
+}
+
+// ------------------------------------------------------------------------------------------------
+void PLYImporter::LoadVerticesBinary(const PLY::Element *pcElement, const char *data,
+        unsigned int first, unsigned int count, bool p_bBE) {
+    ai_assert(nullptr != pcElement);
+    ai_assert(nullptr != data);
+    ai_assert(0 != mVertexStride);
+
+    //create aiMesh and its channels if needed
+    if (nullptr == mGeneratedMesh) {
+        mGeneratedMesh = new aiMesh();
+        mGeneratedMesh->mMaterialIndex = 0;
+    }
+
+    if (nullptr == mGeneratedMesh->mVertices) {
+        mGeneratedMesh->mNumVertices = pcElement->NumOccur;
+        mGeneratedMesh->mVertices = new aiVector3D[mGeneratedMesh->mNumVertices];
+    }
+
+    const unsigned int *offsets = mVertexOffsets;
+    const PLY::EDataType *types = mVertexTypes;
+    auto has = [offsets](unsigned int channel) {
+        return 0xFFFFFFFF != offsets[channel];
+    };
+
+    const bool haveNormal = has(VC_NormalX) || has(VC_NormalY) || has(VC_NormalZ);
+    if (haveNormal && nullptr == mGeneratedMesh->mNormals) {
+        mGeneratedMesh->mNormals = new aiVector3D[mGeneratedMesh->mNumVertices];
+    }
+    // any color channel creates vertex colors, as in LoadVertex()
+    const bool haveColor = has(VC_Red) || has(VC_Green) || has(VC_Blue) || has(VC_Alpha);
+    if (haveColor && nullptr == mGeneratedMesh->mColors[0]) {
+        mGeneratedMesh->mColors[0] = new aiColor4D[mGeneratedMesh->mNumVertices];
+    }
+    const bool haveTextureCoords = has(VC_U) || has(VC_V);
+    if (haveTextureCoords && nullptr == mGeneratedMesh->mTextureCoords[0]) {
+        mGeneratedMesh->mNumUVComponents[0] = 2;
+        mGeneratedMesh->mTextureCoords[0] = new aiVector3D[mGeneratedMesh->mNumVertices];
+    }
+
+    aiVector3D *const positions = mGeneratedMesh->mVertices;
+    aiVector3D *const normals = haveNormal ? mGeneratedMesh->mNormals : nullptr;
+    aiColor4D *const colors = haveColor ? mGeneratedMesh->mColors[0] : nullptr;
+    aiVector3D *const texcoords = haveTextureCoords ? mGeneratedMesh->mTextureCoords[0] : nullptr;
+    const unsigned int stride = mVertexStride;
+
+    const unsigned int numChunks = (count + BinaryVerticesPerChunk - 1) / BinaryVerticesPerChunk;
+    ParallelFor(m_threadPool, numChunks, [&](unsigned int chunk) {
+        const unsigned int begin = chunk * BinaryVerticesPerChunk;
+        const unsigned int end = std::min(count, begin + BinaryVerticesPerChunk);
+
+        PLY::PropertyInstance::ValueUnion v;
+        auto real = [&](const char *vertex, unsigned int channel) -> ai_real {
+            if (!has(channel)) {
+                return 0.0f;
+            }
+            PLY::PropertyInstance::DecodeValueBinary(vertex + offsets[channel], types[channel], &v, p_bBE);
+            return PLY::PropertyInstance::ConvertTo<ai_real>(v, types[channel]);
+        };
+        auto color = [&](const char *vertex, unsigned int channel, ai_real def) -> ai_real {
+            if (!has(channel)) {
+                return def;
+            }
+            PLY::PropertyInstance::DecodeValueBinary(vertex + offsets[channel], types[channel], &v, p_bBE);
+            return NormalizeColorValue(v, types[channel]);
+        };
+
+        for (unsigned int i = begin; i < end; ++i) {
+            const char *vertex = data + static_cast<size_t>(i) * stride;
+            const unsigned int pos = first + i;
+
+            positions[pos] = aiVector3D(real(vertex, VC_PosX), real(vertex, VC_PosY), real(vertex, VC_PosZ));
+            if (normals) {
+                normals[pos] = aiVector3D(real(vertex, VC_NormalX), real(vertex, VC_NormalY), real(vertex, VC_NormalZ));
+            }
+            if (colors) {
+                // assume 1.0 for the alpha channel if it is not set
+                colors[pos] = aiColor4D(color(vertex, VC_Red, 0.0f), color(vertex, VC_Green, 0.0f),
+                        color(vertex, VC_Blue, 0.0f), color(vertex, VC_Alpha, 1.0f));
+            }
+            if (texcoords) {
+                texcoords[pos] = aiVector3D(real(vertex, VC_U), real(vertex, VC_V), 0.0f);
+            }
+        }
+    });
+}
+
 // ------------------------------------------------------------------------------------------------
 // Convert a color component to [0...1]
 ai_real PLYImporter::NormalizeColorValue(PLY::PropertyInstance::ValueUnion val, PLY::EDataType eType) {
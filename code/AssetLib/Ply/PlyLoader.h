@@ -83,6 +83,20 @@ public:
     */
     void LoadFace(const PLY::Element *pcElement, const PLY::ElementInstance *instElement, unsigned int pos);
 
+    // -------------------------------------------------------------------
+    /** Prepare the fixed-stride decoding of a binary vertex element.
+     * @return The size of one vertex in bytes, or 0 if the element has list
+     *   properties or no vertex data and must be parsed by LoadVertex()
+     */
+    unsigned int GetBinaryVertexStride(const PLY::Element *pcElement);
+
+    // -------------------------------------------------------------------
+    /** Decode count consecutive binary vertices starting with vertex first.
+     * GetBinaryVertexStride() must have been called for the element before.
+     */
+    void LoadVerticesBinary(const PLY::Element *pcElement, const char *data,
+            unsigned int first, unsigned int count, bool p_bBE);
+
 protected:
     // -------------------------------------------------------------------
     /** Return importer meta information.
@@ -127,6 +141,23 @@ protected:
 
     /** Mesh generated by loader */
     aiMesh *mGeneratedMesh;
+
+    /** Vertex channels filled by LoadVerticesBinary() */
+    enum VertexChannel {
+        VC_PosX, VC_PosY, VC_PosZ,
+        VC_NormalX, VC_NormalY, VC_NormalZ,
+        VC_Red, VC_Green, VC_Blue, VC_Alpha,
+        VC_U, VC_V,
+        VC_Count
+    };
+
+    /** Byte offset and type of the property feeding each vertex channel,
+     * 0xFFFFFFFF for channels without a property */
+    unsigned int mVertexOffsets[VC_Count];
+    PLY::EDataType mVertexTypes[VC_Count];
+
+    /** Size of one binary vertex, 0 if it cannot be decoded at a fixed stride */
+    unsigned int mVertexStride;
 };
 
 } // end of namespace Assimp
@@ -48,9 +48,26 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/ByteSwapper.h>
 #include <assimp/fast_atof.h>
 #include <assimp/DefaultLogger.hpp>
+#include <algorithm>
 
 using namespace Assimp;
 
+// ------------------------------------------------------------------------------------------------
+// Moves the unread rest of the binary buffer to its front and appends the next block of the file
+static void ReadNextBinaryBlock(IOStreamBuffer<char> &streamBuffer, std::vector<char> &buffer,
+        const char *&pCur, unsigned int &bufferSize) {
+    std::vector<char> nbuffer;
+    if (!streamBuffer.getNextBlock(nbuffer)) {
+        throw DeadlyImportError("Invalid .ply file: File corrupted");
+    }
+
+    //concat buffer contents
+    buffer = std::vector<char>(buffer.end() - bufferSize, buffer.end());
+    buffer.insert(buffer.end(), nbuffer.begin(), nbuffer.end());
+    bufferSize = static_cast<unsigned int>(buffer.size());
+    pCur = (char *)&buffer[0];
+}
+
 // ------------------------------------------------------------------------------------------------
 PLY::EDataType PLY::Property::ParseDataType(std::vector<char> &buffer) {
     ai_assert(!buffer.empty());
@@ -595,6 +612,26 @@ bool PLY::ElementInstanceList::ParseInstanceListBinary(
         bool p_bBE /* = false */) {
     ai_assert(nullptr != pcElement);
 
+    // vertices without list properties have a fixed size, so all vertices of
+    // the current block can be handed to the loader at once
+    const unsigned int stride = (loader && pcElement->eSemantic == EEST_Vertex) ?
+            loader->GetBinaryVertexStride(pcElement) : 0;
+    if (stride) {
+        for (unsigned int i = 0; i < pcElement->NumOccur;) {
+            const unsigned int count = std::min(pcElement->NumOccur - i, bufferSize / stride);
+            if (!count) {
+                ReadNextBinaryBlock(streamBuffer, buffer, pCur, bufferSize);
+                continue;
+            }
+
+            loader->LoadVerticesBinary(pcElement, pCur, i, count, p_bBE);
+            pCur += count * stride;
+            bufferSize -= count * stride;
+            i += count;
+        }
+        return true;
+    }
+
     // we can add special handling code for unknown element semantics since
     // we can't skip it as a whole block (we don't know its exact size
     // due to the fact that lists could be contained in the property list
@@ -821,55 +858,57 @@ bool PLY::PropertyInstance::ParseValueBinary(IOStreamBuffer<char> &streamBuffer,
         bool p_bBE) {
     ai_assert(nullptr != out);
 
-    //calc element size
-    unsigned int lsize = 0;
+    //read the next file block if needed
+    const unsigned int lsize = GetValueSize(eType);
+    if (bufferSize < lsize) {
+        ReadNextBinaryBlock(streamBuffer, buffer, pCur, bufferSize);
+    }
+
+    const bool ret = DecodeValueBinary(pCur, eType, out, p_bBE);
+    pCur += lsize;
+    bufferSize -= lsize;
+
+    return ret;
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int PLY::PropertyInstance::GetValueSize(PLY::EDataType eType) {
     switch (eType) {
     case EDT_Char:
     case EDT_UChar:
-        lsize = 1;
-        break;
+        return 1;
 
     case EDT_UShort:
     case EDT_Short:
-        lsize = 2;
-        break;
+        return 2;
 
     case EDT_UInt:
     case EDT_Int:
     case EDT_Float:
-        lsize = 4;
-        break;
+        return 4;
 
     case EDT_Double:
-        lsize = 8;
-        break;
+        return 8;
 
     case EDT_INVALID:
     default:
         break;
     }
+    return 0;
+}
 
-    //read the next file block if needed
-    if (bufferSize < lsize) {
-        std::vector<char> nbuffer;
-        if (streamBuffer.getNextBlock(nbuffer)) {
-            //concat buffer contents
-            buffer = std::vector<char>(buffer.end() - bufferSize, buffer.end());
-            buffer.insert(buffer.end(), nbuffer.begin(), nbuffer.end());
-            nbuffer.clear();
-            bufferSize = static_cast<unsigned int>(buffer.size());
-            pCur = (char *)&buffer[0];
-        } else {
-            throw DeadlyImportError("Invalid .ply file: File corrupted");
-        }
-    }
+// ------------------------------------------------------------------------------------------------
+bool PLY::PropertyInstance::DecodeValueBinary(const char *pCur,
+        PLY::EDataType eType,
+        PLY::PropertyInstance::ValueUnion *out,
+        bool p_bBE) {
+    ai_assert(nullptr != out);
 
     bool ret = true;
     switch (eType) {
     case EDT_UInt: {
         uint32_t t;
         memcpy(&t, pCur, sizeof(uint32_t));
-        pCur += sizeof(uint32_t);
 
         // Swap endianness
         if (p_bBE) ByteSwap::Swap(&t);
@@ -880,7 +919,6 @@ bool PLY::PropertyInstance::ParseValueBinary(IOStreamBuffer<char> &streamBuffer,
     case EDT_UShort: {
         uint16_t t;
         memcpy(&t, pCur, sizeof(uint16_t));
-        pCur += sizeof(uint16_t);
 
         // Swap endianness
         if (p_bBE) ByteSwap::Swap(&t);
@@ -891,7 +929,6 @@ bool PLY::PropertyInstance::ParseValueBinary(IOStreamBuffer<char> &streamBuffer,
     case EDT_UChar: {
         uint8_t t;
         memcpy(&t, pCur, sizeof(uint8_t));
-        pCur += sizeof(uint8_t);
         out->iUInt = t;
         break;
     }
@@ -899,7 +936,6 @@ bool PLY::PropertyInstance::ParseValueBinary(IOStreamBuffer<char> &streamBuffer,
     case EDT_Int: {
         int32_t t;
         memcpy(&t, pCur, sizeof(int32_t));
-        pCur += sizeof(int32_t);
 
         // Swap endianness
         if (p_bBE) ByteSwap::Swap(&t);
@@ -910,7 +946,6 @@ bool PLY::PropertyInstance::ParseValueBinary(IOStreamBuffer<char> &streamBuffer,
     case EDT_Short: {
         int16_t t;
         memcpy(&t, pCur, sizeof(int16_t));
-        pCur += sizeof(int16_t);
 
         // Swap endianness
         if (p_bBE) ByteSwap::Swap(&t);
@@ -921,7 +956,6 @@ bool PLY::PropertyInstance::ParseValueBinary(IOStreamBuffer<char> &streamBuffer,
     case EDT_Char: {
         int8_t t;
         memcpy(&t, pCur, sizeof(int8_t));
-        pCur += sizeof(int8_t);
         out->iInt = t;
         break;
     }
@@ -929,7 +963,6 @@ bool PLY::PropertyInstance::ParseValueBinary(IOStreamBuffer<char> &streamBuffer,
     case EDT_Float: {
         float t;
         memcpy(&t, pCur, sizeof(float));
-        pCur += sizeof(float);
 
         // Swap endianness
         if (p_bBE) ByteSwap::Swap(&t);
@@ -939,7 +972,6 @@ bool PLY::PropertyInstance::ParseValueBinary(IOStreamBuffer<char> &streamBuffer,
     case EDT_Double: {
         double t;
         memcpy(&t, pCur, sizeof(double));
-        pCur += sizeof(double);
 
         // Swap endianness
         if (p_bBE) ByteSwap::Swap(&t);
@@ -950,8 +982,6 @@ bool PLY::PropertyInstance::ParseValueBinary(IOStreamBuffer<char> &streamBuffer,
         ret = false;
     }
 
-    bufferSize -= lsize;
-
     return ret;
 }
 
@@ -348,6 +348,15 @@ public:
     static bool ParseValueBinary(IOStreamBuffer<char> &streamBuffer, std::vector<char> &buffer,
         const char* &pCur, unsigned int &bufferSize, EDataType eType, ValueUnion* out, bool p_bBE);
 
+    // -------------------------------------------------------------------
+    //! Decode a binary value from memory which holds at least
+    //! GetValueSize(eType) bytes
+    static bool DecodeValueBinary(const char* pCur, EDataType eType, ValueUnion* out, bool p_bBE);
+
+    // -------------------------------------------------------------------
+    //! Get the size of a binary value in bytes, 0 for EDT_INVALID
+    static unsigned int GetValueSize(EDataType eType);
+
     // -------------------------------------------------------------------
     //! Convert a property value to a given type TYPE
     template <typename TYPE>
@@ -45,13 +45,17 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // internal headers
 #include "STLLoader.h"
+#include "Common/ThreadPool.h"
 #include <assimp/ParsingUtils.h>
 #include <assimp/fast_atof.h>
 #include <assimp/importerdesc.h>
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
+#include <assimp/Importer.hpp>
 #include <assimp/IOSystem.hpp>
+#include <algorithm>
 #include <memory>
+#include <unordered_map>
 
 using namespace Assimp;
 
@@ -74,7 +78,7 @@ static const aiImporterDesc desc = {
 // 1) 80 byte header
 // 2) 4 byte face count
 // 3) 50 bytes per face
-static bool IsBinarySTL(const char *buffer, unsigned int fileSize) {
+static bool IsBinarySTL(const char *buffer, size_t fileSize) {
     if (fileSize < 84) {
         return false;
     }
@@ -82,7 +86,7 @@ static bool IsBinarySTL(const char *buffer, unsigned int fileSize) {
     const char *facecount_pos = buffer + 80;
     uint32_t faceCount(0);
     ::memcpy(&faceCount, facecount_pos, sizeof(uint32_t));
-    const uint32_t expectedBinaryFileSize = faceCount * 50 + 84;
+    const size_t expectedBinaryFileSize = static_cast<size_t>(faceCount) * 50 + 84;
 
     return expectedBinaryFileSize == fileSize;
 }
@@ -93,7 +97,7 @@ static const char UnicodeBoundary = 127;
 // An ascii STL buffer will begin with "solid NAME", where NAME is optional.
 // Note: The "solid NAME" check is necessary, but not sufficient, to determine
 // if the buffer is ASCII; a binary header could also begin with "solid NAME".
-static bool IsAsciiSTL(const char *buffer, unsigned int fileSize) {
+static bool IsAsciiSTL(const char *buffer, size_t fileSize) {
     if (IsBinarySTL(buffer, fileSize))
         return false;
 
@@ -122,6 +126,130 @@ static bool IsAsciiSTL(const char *buffer, unsigned int fileSize) {
     }
     return isASCII;
 }
+
+// Size of one binary facet: a normal, three vertices and the attribute word
+static const size_t BinaryFacetSize = 50;
+
+// Number of binary facets unpacked by one task
+static const unsigned int BinaryFacetsPerBlock = 1u << 15;
+
+// Unpacks the binary facets [first, last) into positions and per-vertex normals.
+// Returns whether the color bit is set in the attribute word of any of them.
+static bool UnpackBinaryFacets(const unsigned char *facets, unsigned int first, unsigned int last,
+        aiVector3D *vp, aiVector3D *vn) {
+    bool hasColor = false;
+    float v[12];
+    uint16_t color;
+    for (unsigned int i = first; i < last; ++i) {
+        const unsigned char *facet = facets + i * BinaryFacetSize;
+        ::memcpy(v, facet, sizeof(v));
+        ::memcpy(&color, facet + sizeof(v), sizeof(color));
+
+        // NOTE: Blender sometimes writes empty normals ... this is not
+        // our fault ... the RemoveInvalidData helper step should fix that
+
+        // There's one normal for the face in the STL; use it three times
+        // for vertex normals
+        aiVector3D *n = vn + i * 3;
+        n[0] = n[1] = n[2] = aiVector3D(v[0], v[1], v[2]);
+
+        aiVector3D *p = vp + i * 3;
+        p[0] = aiVector3D(v[3], v[4], v[5]);
+        p[1] = aiVector3D(v[6], v[7], v[8]);
+        p[2] = aiVector3D(v[9], v[10], v[11]);
+
+        hasColor |= (color & (1 << 15)) != 0;
+    }
+    return hasColor;
+}
+
+// Assigns the colors of the binary facets [first, last) which have one to their vertices
+static void UnpackBinaryColors(const unsigned char *facets, unsigned int first, unsigned int last,
+        aiColor4D *colors, bool bIsMaterialise) {
+    const ai_real invVal((ai_real)1.0 / (ai_real)31.0);
+    uint16_t color;
+    for (unsigned int i = first; i < last; ++i) {
+        ::memcpy(&color, facets + i * BinaryFacetSize + 48, sizeof(color));
+        if (!(color & (1 << 15))) {
+            continue;
+        }
+
+        aiColor4D *clr = &colors[i * 3];
+        clr->a = 1.0;
+        if (bIsMaterialise) // this is reversed
+        {
+            clr->r = (color & 0x31u) * invVal;
+            clr->g = ((color & (0x31u << 5)) >> 5u) * invVal;
+            clr->b = ((color & (0x31u << 10)) >> 10u) * invVal;
+        } else {
+            clr->b = (color & 0x31u) * invVal;
+            clr->g = ((color & (0x31u << 5)) >> 5u) * invVal;
+            clr->r = ((color & (0x31u << 10)) >> 10u) * invVal;
+        }
+        // assign the color to all vertices of the face
+        *(clr + 1) = *clr;
+        *(clr + 2) = *clr;
+    }
+}
+
+struct PositionHash {
+    size_t operator()(const aiVector3D &v) const {
+        std::hash<ai_real> hasher;
+        size_t seed = hasher(v.x);
+        seed ^= hasher(v.y) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        seed ^= hasher(v.z) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        return seed;
+    }
+};
+
+// Sets up the triangles of a mesh, their indices are still undefined
+static void AllocateTriangles(aiMesh *pMesh, bool pooled) {
+    if (pooled) {
+        pMesh->AllocateFaces(pMesh->mNumFaces, 3);
+        return;
+    }
+
+    pMesh->mFaces = new aiFace[pMesh->mNumFaces];
+    for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
+        aiFace &face = pMesh->mFaces[i];
+        face.mIndices = new unsigned int[face.mNumIndices = 3];
+    }
+}
+
+// Joins the vertices with identical positions of a mesh with three vertices
+// per face, sets up its faces and drops its normals
+static void WeldVertices(aiMesh *pMesh, bool pooled) {
+    std::unordered_map<aiVector3D, unsigned int, PositionHash> unique;
+    unique.reserve(pMesh->mNumVertices / 4);
+
+    std::vector<unsigned int> remap(pMesh->mNumVertices);
+    unsigned int numUnique = 0;
+    for (unsigned int i = 0; i < pMesh->mNumVertices; ++i) {
+        auto it = unique.emplace(pMesh->mVertices[i], numUnique);
+        if (it.second) {
+            pMesh->mVertices[numUnique++] = pMesh->mVertices[i];
+        }
+        remap[i] = it.first->second;
+    }
+
+    aiVector3D *vertices = new aiVector3D[numUnique];
+    ::memcpy(vertices, pMesh->mVertices, numUnique * sizeof(aiVector3D));
+    delete[] pMesh->mVertices;
+    pMesh->mVertices = vertices;
+    delete[] pMesh->mNormals;
+    pMesh->mNormals = nullptr;
+
+    AllocateTriangles(pMesh, pooled);
+    for (unsigned int i = 0, p = 0; i < pMesh->mNumFaces; ++i) {
+        aiFace &face = pMesh->mFaces[i];
+        for (unsigned int o = 0; o < 3; ++o, ++p) {
+            face.mIndices[o] = remap[p];
+        }
+    }
+
+    ASSIMP_LOG_DEBUG_F("STL: Welded ", pMesh->mNumVertices, " vertices into ", numUnique);
+    pMesh->mNumVertices = numUnique;
+}
 } // namespace
 
 // ------------------------------------------------------------------------------------------------
@@ -129,6 +257,7 @@ static bool IsAsciiSTL(const char *buffer, unsigned int fileSize) {
 STLImporter::STLImporter() :
         mBuffer(),
         mFileSize(0),
+        mWeldVertices(false),
         mScene() {
    // empty
 }
@@ -157,17 +286,21 @@ bool STLImporter::CanRead(const std::string &pFile, IOSystem *pIOHandler, bool c
     return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+void STLImporter::SetupProperties(const Importer *pImp) {
+    mWeldVertices = pImp->GetPropertyBool(AI_CONFIG_IMPORT_STL_WELD_VERTICES, false);
+}
+
 // ------------------------------------------------------------------------------------------------
 const aiImporterDesc *STLImporter::GetInfo() const {
     return &desc;
 }
 
-void addFacesToMesh(aiMesh *pMesh) {
-    pMesh->mFaces = new aiFace[pMesh->mNumFaces];
+void addFacesToMesh(aiMesh *pMesh, bool pooled) {
+    AllocateTriangles(pMesh, pooled);
     for (unsigned int i = 0, p = 0; i < pMesh->mNumFaces; ++i) {
 
         aiFace &face = pMesh->mFaces[i];
-        face.mIndices = new unsigned int[face.mNumIndices = 3];
         for (unsigned int o = 0; o < 3; ++o, ++p) {
             face.mIndices[o] = p;
         }
@@ -184,15 +317,21 @@ void STLImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSy
         throw DeadlyImportError("Failed to open STL file ", pFile, ".");
     }
 
-    mFileSize = (unsigned int)file->FileSize();
+    mFileSize = file->FileSize();
 
-    // allocate storage and copy the contents of the file to a memory buffer
-    // (terminate it with zero)
+    // binary files are read in place if the stream holds them in memory already,
+    // otherwise allocate storage and copy the contents of the file to a memory
+    // buffer (terminate it with zero)
     std::vector<char> buffer2;
-    TextFileToBuffer(file.get(), buffer2);
+    const char *mapped = static_cast<const char *>(file->GetMappedData());
+    if (nullptr != mapped && IsBinarySTL(mapped, mFileSize)) {
+        mBuffer = mapped;
+    } else {
+        TextFileToBuffer(file.get(), buffer2);
+        mBuffer = &buffer2[0];
+    }
 
     mScene = pScene;
-    mBuffer = &buffer2[0];
 
     // the default vertex color is light gray.
     mClrColorDefault.r = mClrColorDefault.g = mClrColorDefault.b = mClrColorDefault.a = (ai_real)0.6;
@@ -245,11 +384,11 @@ void STLImporter::LoadASCIIFile(aiNode *root) {
 
     // try to guess how many vertices we could have
     // assume we'll need 160 bytes for each face
-    size_t sizeEstimate = std::max(1u, mFileSize / 160u) * 3;
+    size_t sizeEstimate = std::max<size_t>(1, mFileSize / 160) * 3;
     positionBuffer.reserve(sizeEstimate);
     normalBuffer.reserve(sizeEstimate);
 
-    while (IsAsciiSTL(sz, static_cast<unsigned int>(bufferEnd - sz))) {
+    while (IsAsciiSTL(sz, static_cast<size_t>(bufferEnd - sz))) {
         std::vector<unsigned int> meshIndices;
         aiMesh *pMesh = new aiMesh();
         pMesh->mMaterialIndex = 0;
@@ -389,7 +528,7 @@ void STLImporter::LoadASCIIFile(aiNode *root) {
         }
 
         // now copy faces
-        addFacesToMesh(pMesh);
+        addFacesToMesh(pMesh, m_poolFaceIndices);
 
         // assign the meshes to the current node
         pushMeshesToNode(meshIndices, node);
@@ -448,10 +587,10 @@ bool STLImporter::LoadBinaryFile() {
     // now read the number of facets
     mScene->mRootNode->mName.Set("<STL_BINARY>");
 
-    pMesh->mNumFaces = *((uint32_t *)sz);
+    ::memcpy(&pMesh->mNumFaces, sz, sizeof(uint32_t));
     sz += 4;
 
-    if (mFileSize < 84 + pMesh->mNumFaces * 50) {
+    if (mFileSize < 84 + static_cast<size_t>(pMesh->mNumFaces) * BinaryFacetSize) {
         throw DeadlyImportError("STL: file is too small to hold all facets");
     }
 
@@ -464,87 +603,37 @@ bool STLImporter::LoadBinaryFile() {
     aiVector3D *vp = pMesh->mVertices = new aiVector3D[pMesh->mNumVertices];
     aiVector3D *vn = pMesh->mNormals = new aiVector3D[pMesh->mNumVertices];
 
-    typedef aiVector3t<float> aiVector3F;
-    aiVector3F *theVec;
-    aiVector3F theVec3F;
-
-    for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
-        // NOTE: Blender sometimes writes empty normals ... this is not
-        // our fault ... the RemoveInvalidData helper step should fix that
-
-        // There's one normal for the face in the STL; use it three times
-        // for vertex normals
-        theVec = (aiVector3F *)sz;
-        ::memcpy(&theVec3F, theVec, sizeof(aiVector3F));
-        vn->x = theVec3F.x;
-        vn->y = theVec3F.y;
-        vn->z = theVec3F.z;
-        *(vn + 1) = *vn;
-        *(vn + 2) = *vn;
-        ++theVec;
-        vn += 3;
-
-        // vertex 1
-        ::memcpy(&theVec3F, theVec, sizeof(aiVector3F));
-        vp->x = theVec3F.x;
-        vp->y = theVec3F.y;
-        vp->z = theVec3F.z;
-        ++theVec;
-        ++vp;
-
-        // vertex 2
-        ::memcpy(&theVec3F, theVec, sizeof(aiVector3F));
-        vp->x = theVec3F.x;
-        vp->y = theVec3F.y;
-        vp->z = theVec3F.z;
-        ++theVec;
-        ++vp;
-
-        // vertex 3
-        ::memcpy(&theVec3F, theVec, sizeof(aiVector3F));
-        vp->x = theVec3F.x;
-        vp->y = theVec3F.y;
-        vp->z = theVec3F.z;
-        ++theVec;
-        ++vp;
-
-        sz = (const unsigned char *)theVec;
-
-        uint16_t color = *((uint16_t *)sz);
-        sz += 2;
-
-        if (color & (1 << 15)) {
-            // seems we need to take the color
-            if (!pMesh->mColors[0]) {
-                pMesh->mColors[0] = new aiColor4D[pMesh->mNumVertices];
-                for (unsigned int j = 0; j < pMesh->mNumVertices; ++j) {
-                    *pMesh->mColors[0]++ = mClrColorDefault;
-                }
-                pMesh->mColors[0] -= pMesh->mNumVertices;
-
-                ASSIMP_LOG_INFO("STL: Mesh has vertex colors");
+    // the facets are unpacked in independent blocks, colors are only
+    // unpacked in a second pass over the blocks which have one
+    const unsigned int numFaces = pMesh->mNumFaces;
+    const unsigned int numBlocks = (numFaces + BinaryFacetsPerBlock - 1) / BinaryFacetsPerBlock;
+    std::vector<char> blockHasColor(numBlocks, 0);
+    ParallelFor(m_threadPool, numBlocks, [&](unsigned int block) {
+        const unsigned int first = block * BinaryFacetsPerBlock;
+        const unsigned int last = std::min(numFaces, first + BinaryFacetsPerBlock);
+        blockHasColor[block] = UnpackBinaryFacets(sz, first, last, vp, vn);
+    });
+
+    if (std::find(blockHasColor.begin(), blockHasColor.end(), 1) != blockHasColor.end()) {
+        aiColor4D *colors = pMesh->mColors[0] = new aiColor4D[pMesh->mNumVertices];
+        std::fill(colors, colors + pMesh->mNumVertices, mClrColorDefault);
+        ASSIMP_LOG_INFO("STL: Mesh has vertex colors");
+
+        ParallelFor(m_threadPool, numBlocks, [&](unsigned int block) {
+            if (blockHasColor[block]) {
+                const unsigned int first = block * BinaryFacetsPerBlock;
+                const unsigned int last = std::min(numFaces, first + BinaryFacetsPerBlock);
+                UnpackBinaryColors(sz, first, last, colors, bIsMaterialise);
             }
-            aiColor4D *clr = &pMesh->mColors[0][i * 3];
-            clr->a = 1.0;
-            const ai_real invVal((ai_real)1.0 / (ai_real)31.0);
-            if (bIsMaterialise) // this is reversed
-            {
-                clr->r = (color & 0x31u) * invVal;
-                clr->g = ((color & (0x31u << 5)) >> 5u) * invVal;
-                clr->b = ((color & (0x31u << 10)) >> 10u) * invVal;
-            } else {
-                clr->b = (color & 0x31u) * invVal;
-                clr->g = ((color & (0x31u << 5)) >> 5u) * invVal;
-                clr->r = ((color & (0x31u << 10)) >> 10u) * invVal;
-            }
-            // assign the color to all vertices of the face
-            *(clr + 1) = *clr;
-            *(clr + 2) = *clr;
-        }
+        });
     }
 
     // now copy faces
-    addFacesToMesh(pMesh);
+    if (mWeldVertices && !pMesh->mColors[0]) {
+        WeldVertices(pMesh, m_poolFaceIndices);
+    } else {
+        addFacesToMesh(pMesh, m_poolFaceIndices);
+    }
 
     aiNode *root = mScene->mRootNode;
 
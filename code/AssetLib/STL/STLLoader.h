@@ -76,6 +76,11 @@ public:
      */
     bool CanRead( const std::string& pFile, IOSystem* pIOHandler, bool checkSig) const;
 
+    /**
+     * @brief   Reads the importer settings, see BaseImporter::SetupProperties().
+     */
+    void SetupProperties(const Importer* pImp);
+
 protected:
 
     /**
@@ -110,7 +115,10 @@ protected:
     const char* mBuffer;
 
     /** Size of the file, in bytes */
-    unsigned int mFileSize;
+    size_t mFileSize;
+
+    /** Join identical vertices of binary files, see #AI_CONFIG_IMPORT_STL_WELD_VERTICES */
+    bool mWeldVertices;
 
     /** Output scene */
     aiScene* mScene;
@@ -0,0 +1,137 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  SceneImage.h
+ *  @brief Layout of the relocatable scene image format (.assimg)
+ *
+ *  A scene image is a flat copy of the in-memory aiScene: every struct and
+ *  array of the scene is stored exactly as the running build lays it out,
+ *  with pointers replaced by offsets from the start of the image. A table
+ *  lists the offset of every pointer field, so loading the image is just
+ *  mapping the file and adding its base address to those fields.
+ *
+ *  Images are a cache format and only portable between builds that share
+ *  the struct layout: the header stores a signature of that layout and the
+ *  importer rejects images written with a different one.
+ */
+#ifndef AI_SCENEIMAGE_H_INC
+#define AI_SCENEIMAGE_H_INC
+
+#include <assimp/anim.h>
+#include <assimp/camera.h>
+#include <assimp/light.h>
+#include <assimp/material.h>
+#include <assimp/mesh.h>
+#include <assimp/metadata.h>
+#include <assimp/scene.h>
+#include <assimp/texture.h>
+#include <assimp/version.h>
+
+#include <stdint.h>
+
+namespace Assimp {
+namespace SceneImage {
+
+/** Magic string at the start of every image */
+static const char Magic[8] = { 'A', 'S', 'S', 'I', 'M', 'G', '\0', '\0' };
+
+/** Version of the image format */
+static const uint32_t Version = 2;
+
+/** Alignment of every struct and array inside the image */
+static const size_t Alignment = 16;
+
+// ---------------------------------------------------------------------------
+/** Header at offset 0 of an image. All offsets are relative to the
+ *  start of the image. */
+struct Header {
+    char mMagic[8];
+    uint32_t mVersion;
+    uint32_t mReserved;
+
+    /** Layout signature of the build that wrote the image */
+    uint64_t mLayout;
+
+    /** Size of the whole image in bytes */
+    uint64_t mSize;
+
+    /** Offset of the aiScene */
+    uint64_t mScene;
+
+    /** Offset and length of the relocation table, an array of uint64_t
+     *  offsets of pointer fields. */
+    uint64_t mRelocations;
+    uint64_t mNumRelocations;
+};
+
+// ---------------------------------------------------------------------------
+/** Computes a signature of the struct layout of this build.
+ *
+ *  Covers pointer size, precision, byte order and the size of every struct
+ *  stored in an image. */
+inline uint64_t ComputeLayoutSignature() {
+    const uint64_t values[] = {
+        aiGetVersionMajor(), aiGetVersionMinor(),
+        sizeof(void *), sizeof(ai_real), alignof(double),
+        sizeof(aiString), sizeof(aiScene), sizeof(aiNode),
+        sizeof(aiMesh), sizeof(aiFace), sizeof(aiMeshlet), sizeof(aiBone), sizeof(aiAnimMesh),
+        sizeof(aiMaterial), sizeof(aiMaterialProperty), sizeof(aiAnimation),
+        sizeof(aiNodeAnim), sizeof(aiVectorKey), sizeof(aiQuatKey),
+        sizeof(aiMeshAnim), sizeof(aiMeshKey), sizeof(aiMeshMorphAnim),
+        sizeof(aiMeshMorphKey), sizeof(aiTexture), sizeof(aiTexel),
+        sizeof(aiLight), sizeof(aiCamera), sizeof(aiMetadata),
+        sizeof(aiMetadataEntry)
+    };
+
+    // FNV-1a over the raw bytes, so the byte order is part of the signature
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(values);
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < sizeof(values); ++i) {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+} // namespace SceneImage
+} // namespace Assimp
+
+#endif // AI_SCENEIMAGE_H_INC
@@ -0,0 +1,446 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  SceneImageExporter.cpp
+ *  @brief Writes relocatable scene images (.assimg)
+ */
+
+#ifndef ASSIMP_BUILD_NO_EXPORT
+#ifndef ASSIMP_BUILD_NO_SCENEIMAGE_EXPORTER
+
+#include "AssetLib/SceneImage/SceneImageExporter.h"
+#include "AssetLib/SceneImage/SceneImage.h"
+
+#include <assimp/Exceptional.h>
+#include <assimp/Exporter.hpp>
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
+
+#include <cstring>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace Assimp {
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Builds the image in memory. Every object is copied verbatim, then each of
+// its pointer fields is overwritten with the offset of the copied target and
+// recorded in the relocation table.
+class ImageWriter {
+public:
+    ImageWriter() :
+            mBuffer(sizeof(SceneImage::Header)),
+            mRelocations(),
+            mNodes() {
+        // empty
+    }
+
+    // -------------------------------------------------------------------
+    void WriteImage(const aiScene *scene, IOStream *out) {
+        const uint64_t sceneOffset = WriteScene(scene);
+
+        const uint64_t table = Allocate<uint64_t>(mRelocations.size());
+        if (!mRelocations.empty()) {
+            ::memcpy(&mBuffer[table], mRelocations.data(), mRelocations.size() * sizeof(uint64_t));
+        }
+
+        SceneImage::Header header;
+        ::memset(&header, 0, sizeof(header));
+        ::memcpy(header.mMagic, SceneImage::Magic, sizeof(header.mMagic));
+        header.mVersion = SceneImage::Version;
+        header.mLayout = SceneImage::ComputeLayoutSignature();
+        header.mSize = mBuffer.size();
+        header.mScene = sceneOffset;
+        header.mRelocations = table;
+        header.mNumRelocations = mRelocations.size();
+        ::memcpy(&mBuffer[0], &header, sizeof(header));
+
+        if (out->Write(mBuffer.data(), 1, mBuffer.size()) != mBuffer.size()) {
+            throw DeadlyExportError("Failed to write the scene image");
+        }
+    }
+
+private:
+    // -------------------------------------------------------------------
+    // Reserve zeroed and aligned room for count objects, returns its offset
+    template <typename T>
+    uint64_t Allocate(size_t count) {
+        const size_t offset = (mBuffer.size() + SceneImage::Alignment - 1) & ~(SceneImage::Alignment - 1);
+        mBuffer.resize(offset + sizeof(T) * count);
+        return offset;
+    }
+
+    // -------------------------------------------------------------------
+    // Copy count objects into the image, returns 0 for empty arrays
+    template <typename T>
+    uint64_t Store(const T *data, size_t count) {
+        if (nullptr == data || 0 == count) {
+            return 0;
+        }
+        const uint64_t offset = Allocate<T>(count);
+        ::memcpy(&mBuffer[offset], static_cast<const void *>(data), sizeof(T) * count);
+        return offset;
+    }
+
+    // -------------------------------------------------------------------
+    // Point a pointer field at the given offset, 0 stores a null pointer
+    void SetPointer(uint64_t offset, uint64_t target) {
+        const uintptr_t value = static_cast<uintptr_t>(target);
+        ::memcpy(&mBuffer[offset], &value, sizeof(value));
+        if (0 != target) {
+            mRelocations.push_back(offset);
+        }
+    }
+
+    // -------------------------------------------------------------------
+    // Point a field of source, stored at offset object, at target
+    template <typename T>
+    void Link(uint64_t object, const T *source, const void *field, uint64_t target) {
+        SetPointer(object + (static_cast<const char *>(field) - reinterpret_cast<const char *>(source)), target);
+    }
+
+    // -------------------------------------------------------------------
+    // Overwrite a plain field of source, stored at offset object
+    template <typename T, typename V>
+    void Set(uint64_t object, const T *source, const V *field, V value) {
+        const uint64_t offset = object + (reinterpret_cast<const char *>(field) - reinterpret_cast<const char *>(source));
+        ::memcpy(&mBuffer[offset], &value, sizeof(V));
+    }
+
+    // -------------------------------------------------------------------
+    // Write an array of pointers and the objects they point to
+    template <typename T>
+    uint64_t WriteArray(T *const *items, unsigned int count, uint64_t (ImageWriter::*write)(const T *)) {
+        if (nullptr == items || 0 == count) {
+            return 0;
+        }
+        const uint64_t array = Allocate<T *>(count);
+        for (unsigned int i = 0; i < count; ++i) {
+            SetPointer(array + i * sizeof(T *), nullptr != items[i] ? (this->*write)(items[i]) : 0);
+        }
+        return array;
+    }
+
+    // -------------------------------------------------------------------
+    uint64_t WriteScene(const aiScene *scene) {
+        const uint64_t out = Store(scene, 1);
+
+        // nodes go first, bones refer to them
+        Link(out, scene, &scene->mRootNode, nullptr != scene->mRootNode ? WriteNode(scene->mRootNode, 0) : 0);
+        Link(out, scene, &scene->mMeshes, WriteArray(scene->mMeshes, scene->mNumMeshes, &ImageWriter::WriteMesh));
+        Link(out, scene, &scene->mMaterials, WriteArray(scene->mMaterials, scene->mNumMaterials, &ImageWriter::WriteMaterial));
+        Link(out, scene, &scene->mAnimations, WriteArray(scene->mAnimations, scene->mNumAnimations, &ImageWriter::WriteAnimation));
+        Link(out, scene, &scene->mTextures, WriteArray(scene->mTextures, scene->mNumTextures, &ImageWriter::WriteTexture));
+        Link(out, scene, &scene->mLights, WriteArray(scene->mLights, scene->mNumLights, &ImageWriter::WriteLight));
+        Link(out, scene, &scene->mCameras, WriteArray(scene->mCameras, scene->mNumCameras, &ImageWriter::WriteCamera));
+        Link(out, scene, &scene->mMetaData, WriteMetadata(scene->mMetaData));
+        Link(out, scene, &scene->mPrivate, 0);
+        return out;
+    }
+
+    // -------------------------------------------------------------------
+    uint64_t WriteNode(const aiNode *node, uint64_t parent) {
+        const uint64_t out = Store(node, 1);
+        mNodes[node] = out;
+
+        Link(out, node, &node->mParent, parent);
+        Link(out, node, &node->mMeshes, Store(node->mMeshes, node->mNumMeshes));
+        Link(out, node, &node->mMetaData, WriteMetadata(node->mMetaData));
+
+        uint64_t children = 0;
+        if (nullptr != node->mChildren && 0 != node->mNumChildren) {
+            children = Allocate<aiNode *>(node->mNumChildren);
+            for (unsigned int i = 0; i < node->mNumChildren; ++i) {
+                const aiNode *child = node->mChildren[i];
+                SetPointer(children + i * sizeof(aiNode *), nullptr != child ? WriteNode(child, out) : 0);
+            }
+        }
+        Link(out, node, &node->mChildren, children);
+        return out;
+    }
+
+    // -------------------------------------------------------------------
+    uint64_t WriteMetadata(const aiMetadata *meta) {
+        if (nullptr == meta) {
+            return 0;
+        }
+        const uint64_t out = Store(meta, 1);
+        Link(out, meta, &meta->mKeys, Store(meta->mKeys, meta->mNumProperties));
+
+        const uint64_t values = Store(meta->mValues, meta->mNumProperties);
+        Link(out, meta, &meta->mValues, values);
+        for (unsigned int i = 0; 0 != values && i < meta->mNumProperties; ++i) {
+            const aiMetadataEntry &entry = meta->mValues[i];
+            uint64_t data = 0;
+            if (nullptr != entry.mData) {
+                switch (entry.mType) {
+                case AI_BOOL:
+                    data = Store(static_cast<const bool *>(entry.mData), 1);
+                    break;
+                case AI_INT32:
+                    data = Store(static_cast<const int32_t *>(entry.mData), 1);
+                    break;
+                case AI_UINT64:
+                    data = Store(static_cast<const uint64_t *>(entry.mData), 1);
+                    break;
+                case AI_FLOAT:
+                    data = Store(static_cast<const float *>(entry.mData), 1);
+                    break;
+                case AI_DOUBLE:
+                    data = Store(static_cast<const double *>(entry.mData), 1);
+                    break;
+                case AI_AISTRING:
+                    data = Store(static_cast<const aiString *>(entry.mData), 1);
+                    break;
+                case AI_AIVECTOR3D:
+                    data = Store(static_cast<const aiVector3D *>(entry.mData), 1);
+                    break;
+                case AI_AIMETADATA:
+                    data = WriteMetadata(static_cast<const aiMetadata *>(entry.mData));
+                    break;
+                default:
+                    break;
+                }
+            }
+            Link(values + i * sizeof(aiMetadataEntry), &entry, &entry.mData, data);
+        }
+        return out;
+    }
+
+    // -------------------------------------------------------------------
+    uint64_t WriteMesh(const aiMesh *mesh) {
+        const uint64_t out = Store(mesh, 1);
+        const unsigned int num = mesh->mNumVertices;
+
+        Link(out, mesh, &mesh->mVertices, Store(mesh->mVertices, num));
+        Link(out, mesh, &mesh->mNormals, Store(mesh->mNormals, num));
+        Link(out, mesh, &mesh->mTangents, Store(mesh->mTangents, num));
+        Link(out, mesh, &mesh->mBitangents, Store(mesh->mBitangents, num));
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i) {
+            Link(out, mesh, &mesh->mColors[i], Store(mesh->mColors[i], num));
+        }
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+            Link(out, mesh, &mesh->mTextureCoords[i], Store(mesh->mTextureCoords[i], num));
+        }
+        uint64_t pool = 0;
+        unsigned int numIndices = 0;
+        Link(out, mesh, &mesh->mFaces, WriteFaces(mesh->mFaces, mesh->mNumFaces, pool, numIndices));
+        Link(out, mesh, &mesh->mFaceIndices, pool);
+        Set(out, mesh, &mesh->mNumFaceIndices, numIndices);
+        Link(out, mesh, &mesh->mMeshlets, Store(mesh->mMeshlets, mesh->mNumMeshlets));
+        Link(out, mesh, &mesh->mMeshletVertices, Store(mesh->mMeshletVertices, mesh->mNumMeshletVertices));
+        Link(out, mesh, &mesh->mMeshletTriangles, Store(mesh->mMeshletTriangles, size_t(mesh->mNumMeshletTriangles) * 3));
+        Link(out, mesh, &mesh->mBones, WriteArray(mesh->mBones, mesh->mNumBones, &ImageWriter::WriteBone));
+        Link(out, mesh, &mesh->mAnimMeshes, WriteArray(mesh->mAnimMeshes, mesh->mNumAnimMeshes, &ImageWriter::WriteAnimMesh));
+        return out;
+    }
+
+    // -------------------------------------------------------------------
+    // The indices of all faces share one pool, which becomes aiMesh::mFaceIndices
+    uint64_t WriteFaces(const aiFace *faces, unsigned int count, uint64_t &pool, unsigned int &total) {
+        const uint64_t out = Store(faces, count);
+        if (0 == out) {
+            return 0;
+        }
+
+        for (unsigned int i = 0; i < count; ++i) {
+            if (nullptr != faces[i].mIndices) {
+                total += faces[i].mNumIndices;
+            }
+        }
+        if (0 == total) {
+            return out;
+        }
+
+        pool = Allocate<unsigned int>(total);
+        uint64_t pos = pool;
+        for (unsigned int i = 0; i < count; ++i) {
+            const aiFace &face = faces[i];
+            uint64_t indices = 0;
+            if (nullptr != face.mIndices && 0 != face.mNumIndices) {
+                indices = pos;
+                ::memcpy(&mBuffer[pos], face.mIndices, face.mNumIndices * sizeof(unsigned int));
+                pos += face.mNumIndices * sizeof(unsigned int);
+            }
+            Link(out + i * sizeof(aiFace), &face, &face.mIndices, indices);
+        }
+        return out;
+    }
+
+    // -------------------------------------------------------------------
+    uint64_t FindNode(const aiNode *node) const {
+        const std::map<const aiNode *, uint64_t>::const_iterator it = mNodes.find(node);
+        return it != mNodes.end() ? it->second : 0;
+    }
+
+    // -------------------------------------------------------------------
+    uint64_t WriteBone(const aiBone *bone) {
+        const uint64_t out = Store(bone, 1);
+        Link(out, bone, &bone->mArmature, FindNode(bone->mArmature));
+        Link(out, bone, &bone->mNode, FindNode(bone->mNode));
+        Link(out, bone, &bone->mWeights, Store(bone->mWeights, bone->mNumWeights));
+        return out;
+    }
+
+    // -------------------------------------------------------------------
+    uint64_t WriteAnimMesh(const aiAnimMesh *mesh) {
+        const uint64_t out = Store(mesh, 1);
+        const unsigned int num = mesh->mNumVertices;
+
+        Link(out, mesh, &mesh->mVertices, Store(mesh->mVertices, num));
+        Link(out, mesh, &mesh->mNormals, Store(mesh->mNormals, num));
+        Link(out, mesh, &mesh->mTangents, Store(mesh->mTangents, num));
+        Link(out, mesh, &mesh->mBitangents, Store(mesh->mBitangents, num));
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i) {
+            Link(out, mesh, &mesh->mColors[i], Store(mesh->mColors[i], num));
+        }
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+            Link(out, mesh, &mesh->mTextureCoords[i], Store(mesh->mTextureCoords[i], num));
+        }
+        return out;
+    }
+
+    // -------------------------------------------------------------------
+    uint64_t WriteMaterial(const aiMaterial *mat) {
+        const uint64_t out = Store(mat, 1);
+        Link(out, mat, &mat->mProperties, WriteArray(mat->mProperties, mat->mNumProperties, &ImageWriter::WriteProperty));
+        Set(out, mat, &mat->mNumAllocated, mat->mNumProperties);
+        return out;
+    }
+
+    // -------------------------------------------------------------------
+    uint64_t WriteProperty(const aiMaterialProperty *prop) {
+        const uint64_t out = Store(prop, 1);
+        Link(out, prop, &prop->mData, Store(prop->mData, prop->mDataLength));
+        return out;
+    }
+
+    // -------------------------------------------------------------------
+    uint64_t WriteAnimation(const aiAnimation *anim) {
+        const uint64_t out = Store(anim, 1);
+        Link(out, anim, &anim->mChannels, WriteArray(anim->mChannels, anim->mNumChannels, &ImageWriter::WriteNodeAnim));
+        Link(out, anim, &anim->mMeshChannels, WriteArray(anim->mMeshChannels, anim->mNumMeshChannels, &ImageWriter::WriteMeshAnim));
+        Link(out, anim, &anim->mMorphMeshChannels,
+                WriteArray(anim->mMorphMeshChannels, anim->mNumMorphMeshChannels, &ImageWriter::WriteMorphMeshAnim));
+        return out;
+    }
+
+    // -------------------------------------------------------------------
+    uint64_t WriteNodeAnim(const aiNodeAnim *anim) {
+        const uint64_t out = Store(anim, 1);
+        Link(out, anim, &anim->mPositionKeys, Store(anim->mPositionKeys, anim->mNumPositionKeys));
+        Link(out, anim, &anim->mRotationKeys, Store(anim->mRotationKeys, anim->mNumRotationKeys));
+        Link(out, anim, &anim->mScalingKeys, Store(anim->mScalingKeys, anim->mNumScalingKeys));
+        return out;
+    }
+
+    // -------------------------------------------------------------------
+    uint64_t WriteMeshAnim(const aiMeshAnim *anim) {
+        const uint64_t out = Store(anim, 1);
+        Link(out, anim, &anim->mKeys, Store(anim->mKeys, anim->mNumKeys));
+        return out;
+    }
+
+    // -------------------------------------------------------------------
+    uint64_t WriteMorphMeshAnim(const aiMeshMorphAnim *anim) {
+        const uint64_t out = Store(anim, 1);
+        const uint64_t keys = Store(anim->mKeys, anim->mNumKeys);
+        Link(out, anim, &anim->mKeys, keys);
+        for (unsigned int i = 0; 0 != keys && i < anim->mNumKeys; ++i) {
+            const aiMeshMorphKey &key = anim->mKeys[i];
+            const uint64_t stored = keys + i * sizeof(aiMeshMorphKey);
+            Link(stored, &key, &key.mValues, Store(key.mValues, key.mNumValuesAndWeights));
+            Link(stored, &key, &key.mWeights, Store(key.mWeights, key.mNumValuesAndWeights));
+        }
+        return out;
+    }
+
+    // -------------------------------------------------------------------
+    uint64_t WriteTexture(const aiTexture *tex) {
+        const uint64_t out = Store(tex, 1);
+        uint64_t data = 0;
+        if (0 == tex->mHeight) {
+            // compressed texture, mWidth is the size in bytes
+            data = Store(reinterpret_cast<const char *>(tex->pcData), tex->mWidth);
+        } else {
+            data = Store(tex->pcData, static_cast<size_t>(tex->mWidth) * tex->mHeight);
+        }
+        Link(out, tex, &tex->pcData, data);
+        return out;
+    }
+
+    // -------------------------------------------------------------------
+    uint64_t WriteLight(const aiLight *light) {
+        return Store(light, 1);
+    }
+
+    // -------------------------------------------------------------------
+    uint64_t WriteCamera(const aiCamera *cam) {
+        return Store(cam, 1);
+    }
+
+private:
+    std::vector<char> mBuffer;
+    std::vector<uint64_t> mRelocations;
+    std::map<const aiNode *, uint64_t> mNodes;
+};
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+void ExportSceneImage(const char *pFile, IOSystem *pIOSystem, const aiScene *pScene, const ExportProperties * /*pProperties*/) {
+    std::unique_ptr<IOStream> out(pIOSystem->Open(pFile, "wb"));
+    if (nullptr == out) {
+        throw DeadlyExportError("Could not open output file ", pFile);
+    }
+
+    ImageWriter writer;
+    writer.WriteImage(pScene, out.get());
+}
+
+} // namespace Assimp
+
+#endif // ASSIMP_BUILD_NO_SCENEIMAGE_EXPORTER
+#endif // ASSIMP_BUILD_NO_EXPORT
@@ -0,0 +1,446 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  SceneImageImporter.cpp
+ *  @brief Implementation of the relocatable scene image importer
+ */
+
+#ifndef ASSIMP_BUILD_NO_SCENEIMAGE_IMPORTER
+
+#include "AssetLib/SceneImage/SceneImageImporter.h"
+#include "AssetLib/SceneImage/SceneImage.h"
+#include "Common/ScenePrivate.h"
+
+#include <assimp/DefaultIOSystem.h>
+#include <assimp/Exceptional.h>
+#include <assimp/Importer.hpp>
+#include <assimp/IOSystem.hpp>
+#include <assimp/MemoryMappedIOSystem.h>
+#include <assimp/importerdesc.h>
+
+#include <cstring>
+#include <memory>
+#include <set>
+
+using namespace Assimp;
+
+static const aiImporterDesc desc = {
+    "Assimp Scene Image Importer",
+    "",
+    "",
+    "Images are only readable by builds with the same struct layout",
+    aiImporterFlags_SupportBinaryFlavour,
+    0,
+    0,
+    0,
+    0,
+    "assimg"
+};
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Walks a relocated scene and checks that every array it links, as given by the
+// counts stored next to it, lies inside the image. Pointer fields missing from
+// the relocation table are caught the same way.
+class ImageChecker {
+public:
+    ImageChecker(const char *begin, const char *end) :
+            mBegin(begin),
+            mEnd(end) {
+        // empty
+    }
+
+    void CheckScene(const aiScene *scene) {
+        CheckObject(scene);
+        CheckNode(scene->mRootNode);
+        CheckPointers(scene->mMeshes, scene->mNumMeshes, &ImageChecker::CheckMesh);
+        CheckPointers(scene->mMaterials, scene->mNumMaterials, &ImageChecker::CheckMaterial);
+        CheckPointers(scene->mAnimations, scene->mNumAnimations, &ImageChecker::CheckAnimation);
+        CheckPointers(scene->mTextures, scene->mNumTextures, &ImageChecker::CheckTexture);
+        CheckPointers(scene->mLights, scene->mNumLights, &ImageChecker::CheckObject<aiLight>);
+        CheckPointers(scene->mCameras, scene->mNumCameras, &ImageChecker::CheckObject<aiCamera>);
+        CheckMetadata(scene->mMetaData);
+    }
+
+private:
+    static void Fail() {
+        throw DeadlyImportError("Scene image is truncated or corrupt");
+    }
+
+    // count objects at data must be inside the image, a null array must be empty
+    template <typename T>
+    void CheckArray(const T *data, uint64_t count) {
+        if (nullptr == data) {
+            return;
+        }
+        const char *begin = reinterpret_cast<const char *>(data);
+        if (begin < mBegin || begin > mEnd || 0 != reinterpret_cast<uintptr_t>(begin) % alignof(T) ||
+                count > static_cast<uint64_t>(mEnd - begin) / sizeof(T)) {
+            Fail();
+        }
+    }
+
+    template <typename T>
+    void CheckObject(const T *object) {
+        CheckArray(object, 1);
+    }
+
+    // an array of pointers, each pointing to an object checked by check
+    template <typename T>
+    void CheckPointers(T *const *items, unsigned int count, void (ImageChecker::*check)(const T *)) {
+        CheckArray(items, nullptr != items ? count : 0);
+        for (unsigned int i = 0; nullptr != items && i < count; ++i) {
+            if (nullptr != items[i]) {
+                (this->*check)(items[i]);
+            }
+        }
+    }
+
+    void CheckNode(const aiNode *node) {
+        if (nullptr == node) {
+            return;
+        }
+        // the hierarchy is a tree, a node seen twice would never end the recursion
+        CheckObject(node);
+        if (!mNodes.insert(node).second) {
+            Fail();
+        }
+        CheckArray(node->mMeshes, node->mNumMeshes);
+        CheckMetadata(node->mMetaData);
+        CheckPointers(node->mChildren, node->mNumChildren, &ImageChecker::CheckNode);
+    }
+
+    void CheckMetadata(const aiMetadata *meta) {
+        if (nullptr == meta) {
+            return;
+        }
+        CheckObject(meta);
+        if (!mMetadata.insert(meta).second) {
+            Fail();
+        }
+        CheckArray(meta->mKeys, meta->mNumProperties);
+        CheckArray(meta->mValues, meta->mNumProperties);
+        for (unsigned int i = 0; nullptr != meta->mValues && i < meta->mNumProperties; ++i) {
+            const aiMetadataEntry &entry = meta->mValues[i];
+            switch (entry.mType) {
+            case AI_BOOL:
+                CheckArray(static_cast<const bool *>(entry.mData), 1);
+                break;
+            case AI_INT32:
+                CheckArray(static_cast<const int32_t *>(entry.mData), 1);
+                break;
+            case AI_UINT64:
+                CheckArray(static_cast<const uint64_t *>(entry.mData), 1);
+                break;
+            case AI_FLOAT:
+                CheckArray(static_cast<const float *>(entry.mData), 1);
+                break;
+            case AI_DOUBLE:
+                CheckArray(static_cast<const double *>(entry.mData), 1);
+                break;
+            case AI_AISTRING:
+                CheckArray(static_cast<const aiString *>(entry.mData), 1);
+                break;
+            case AI_AIVECTOR3D:
+                CheckArray(static_cast<const aiVector3D *>(entry.mData), 1);
+                break;
+            case AI_AIMETADATA:
+                CheckMetadata(static_cast<const aiMetadata *>(entry.mData));
+                break;
+            default:
+                if (nullptr != entry.mData) {
+                    Fail();
+                }
+                break;
+            }
+        }
+    }
+
+    template <typename T>
+    void CheckVertexData(const T *mesh) {
+        const unsigned int num = mesh->mNumVertices;
+        CheckArray(mesh->mVertices, num);
+        CheckArray(mesh->mNormals, num);
+        CheckArray(mesh->mTangents, num);
+        CheckArray(mesh->mBitangents, num);
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i) {
+            CheckArray(mesh->mColors[i], num);
+        }
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+            CheckArray(mesh->mTextureCoords[i], num);
+        }
+    }
+
+    void CheckMesh(const aiMesh *mesh) {
+        CheckObject(mesh);
+        CheckVertexData(mesh);
+        CheckArray(mesh->mFaces, nullptr != mesh->mFaces ? mesh->mNumFaces : 0);
+        for (unsigned int i = 0; nullptr != mesh->mFaces && i < mesh->mNumFaces; ++i) {
+            CheckArray(mesh->mFaces[i].mIndices, mesh->mFaces[i].mNumIndices);
+        }
+        CheckArray(mesh->mFaceIndices, mesh->mNumFaceIndices);
+        CheckArray(mesh->mMeshlets, mesh->mNumMeshlets);
+        CheckArray(mesh->mMeshletVertices, mesh->mNumMeshletVertices);
+        CheckArray(mesh->mMeshletTriangles, uint64_t(mesh->mNumMeshletTriangles) * 3);
+        CheckPointers(mesh->mBones, mesh->mNumBones, &ImageChecker::CheckBone);
+        CheckPointers(mesh->mAnimMeshes, mesh->mNumAnimMeshes, &ImageChecker::CheckAnimMesh);
+    }
+
+    void CheckBone(const aiBone *bone) {
+        CheckObject(bone);
+        CheckArray(bone->mArmature, 1);
+        CheckArray(bone->mNode, 1);
+        CheckArray(bone->mWeights, bone->mNumWeights);
+    }
+
+    void CheckAnimMesh(const aiAnimMesh *mesh) {
+        CheckObject(mesh);
+        CheckVertexData(mesh);
+    }
+
+    void CheckMaterial(const aiMaterial *mat) {
+        CheckObject(mat);
+        if (mat->mNumProperties > mat->mNumAllocated) {
+            Fail();
+        }
+        CheckPointers(mat->mProperties, mat->mNumProperties, &ImageChecker::CheckProperty);
+    }
+
+    void CheckProperty(const aiMaterialProperty *prop) {
+        CheckObject(prop);
+        CheckArray(prop->mData, prop->mDataLength);
+    }
+
+    void CheckAnimation(const aiAnimation *anim) {
+        CheckObject(anim);
+        CheckPointers(anim->mChannels, anim->mNumChannels, &ImageChecker::CheckNodeAnim);
+        CheckPointers(anim->mMeshChannels, anim->mNumMeshChannels, &ImageChecker::CheckMeshAnim);
+        CheckPointers(anim->mMorphMeshChannels, anim->mNumMorphMeshChannels, &ImageChecker::CheckMorphMeshAnim);
+    }
+
+    void CheckNodeAnim(const aiNodeAnim *anim) {
+        CheckObject(anim);
+        CheckArray(anim->mPositionKeys, anim->mNumPositionKeys);
+        CheckArray(anim->mRotationKeys, anim->mNumRotationKeys);
+        CheckArray(anim->mScalingKeys, anim->mNumScalingKeys);
+    }
+
+    void CheckMeshAnim(const aiMeshAnim *anim) {
+        CheckObject(anim);
+        CheckArray(anim->mKeys, anim->mNumKeys);
+    }
+
+    void CheckMorphMeshAnim(const aiMeshMorphAnim *anim) {
+        CheckObject(anim);
+        CheckArray(anim->mKeys, anim->mNumKeys);
+        for (unsigned int i = 0; nullptr != anim->mKeys && i < anim->mNumKeys; ++i) {
+            CheckArray(anim->mKeys[i].mValues, anim->mKeys[i].mNumValuesAndWeights);
+            CheckArray(anim->mKeys[i].mWeights, anim->mKeys[i].mNumValuesAndWeights);
+        }
+    }
+
+    void CheckTexture(const aiTexture *tex) {
+        CheckObject(tex);
+        if (0 == tex->mHeight) {
+            // compressed texture, mWidth is the size in bytes
+            CheckArray(reinterpret_cast<const char *>(tex->pcData), tex->mWidth);
+        } else {
+            CheckArray(tex->pcData, uint64_t(tex->mWidth) * tex->mHeight);
+        }
+    }
+
+    const char *mBegin;
+    const char *mEnd;
+    std::set<const aiNode *> mNodes;
+    std::set<const aiMetadata *> mMetadata;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Check the header and turn all stored offsets into pointers, returns the scene
+const aiScene *Relocate(char *data, size_t size) {
+    SceneImage::Header header;
+    if (size < sizeof(header)) {
+        throw DeadlyImportError("Scene image is too small");
+    }
+    ::memcpy(&header, data, sizeof(header));
+    if (0 != ::memcmp(header.mMagic, SceneImage::Magic, sizeof(header.mMagic))) {
+        throw DeadlyImportError("Not a scene image");
+    }
+    if (header.mVersion != SceneImage::Version) {
+        throw DeadlyImportError("Unsupported scene image version ", header.mVersion);
+    }
+    if (header.mLayout != SceneImage::ComputeLayoutSignature()) {
+        throw DeadlyImportError("Scene image was written by a build with a different struct layout");
+    }
+    if (header.mSize != size ||
+            header.mScene < sizeof(header) || header.mScene > size - sizeof(aiScene) ||
+            header.mRelocations < sizeof(header) || header.mRelocations > size ||
+            header.mNumRelocations > (size - header.mRelocations) / sizeof(uint64_t)) {
+        throw DeadlyImportError("Scene image is truncated or corrupt");
+    }
+
+    const char *table = data + header.mRelocations;
+    for (uint64_t i = 0; i < header.mNumRelocations; ++i) {
+        uint64_t field;
+        ::memcpy(&field, table + i * sizeof(uint64_t), sizeof(field));
+        // pointer fields are aligned and stored before the table
+        if (field < sizeof(header) || field > header.mRelocations - sizeof(void *) || 0 != field % alignof(void *)) {
+            throw DeadlyImportError("Invalid relocation in scene image");
+        }
+
+        uintptr_t target;
+        ::memcpy(&target, data + field, sizeof(target));
+        if (target < sizeof(header) || target >= size) {
+            throw DeadlyImportError("Invalid pointer in scene image");
+        }
+        target += reinterpret_cast<uintptr_t>(data);
+        ::memcpy(data + field, &target, sizeof(target));
+    }
+
+    // all structs and arrays are stored before the table
+    const aiScene *scene = reinterpret_cast<const aiScene *>(data + header.mScene);
+    ImageChecker(data + sizeof(header), data + header.mRelocations).CheckScene(scene);
+    return scene;
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+SceneImageImporter::SceneImageImporter() :
+        mMapFile(false) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+SceneImageImporter::~SceneImageImporter() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+bool SceneImageImporter::CanRead(const std::string &pFile, IOSystem *pIOHandler, bool /*checkSig*/) const {
+    std::unique_ptr<IOStream> in(pIOHandler->Open(pFile));
+    if (nullptr == in) {
+        return false;
+    }
+
+    // A header of this format version whose offsets fit the size it records.
+    // Truncated images and images with a different layout are still claimed,
+    // so they fail with a clear message instead of being handed to another
+    // importer.
+    SceneImage::Header header;
+    return in->Read(&header, sizeof(header), 1) == 1 &&
+           0 == ::memcmp(header.mMagic, SceneImage::Magic, sizeof(header.mMagic)) &&
+           header.mVersion == SceneImage::Version &&
+           header.mScene >= sizeof(header) && header.mScene < header.mSize &&
+           header.mRelocations >= sizeof(header) && header.mRelocations <= header.mSize &&
+           header.mNumRelocations <= (header.mSize - header.mRelocations) / sizeof(uint64_t);
+}
+
+// ------------------------------------------------------------------------------------------------
+const aiImporterDesc *SceneImageImporter::GetInfo() const {
+    return &desc;
+}
+
+// ------------------------------------------------------------------------------------------------
+void SceneImageImporter::SetupProperties(const Importer *pImp) {
+    // InternReadFile() only sees a filter wrapping the IOSystem, so check here
+    // whether the file may be mapped directly
+    mMapFile = nullptr != dynamic_cast<DefaultIOSystem *>(pImp->GetIOHandler());
+}
+
+// ------------------------------------------------------------------------------------------------
+void SceneImageImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSystem *pIOHandler) {
+    std::shared_ptr<void> image;
+    char *data = nullptr;
+    size_t size = 0;
+
+    // A private writable mapping: relocating copies only the pages holding
+    // pointers, vertex and index data are shared with the page cache.
+    if (mMapFile) {
+        MemoryMappedIOStream *mapped = MemoryMappedIOStream::Map(pFile.c_str(), true);
+        if (nullptr != mapped) {
+            image.reset(mapped);
+            data = static_cast<char *>(const_cast<void *>(mapped->GetMappedData()));
+            size = mapped->FileSize();
+        }
+    }
+
+    if (nullptr == data) {
+        std::unique_ptr<IOStream> file(pIOHandler->Open(pFile, "rb"));
+        if (nullptr == file) {
+            throw DeadlyImportError("Failed to open scene image ", pFile);
+        }
+        size = file->FileSize();
+
+        // 8-byte aligned, the image is laid out for that
+        uint64_t *buffer = new uint64_t[(size + sizeof(uint64_t) - 1) / sizeof(uint64_t)];
+        image.reset(buffer, std::default_delete<uint64_t[]>());
+        data = reinterpret_cast<char *>(buffer);
+        if (file->Read(data, 1, size) != size) {
+            throw DeadlyImportError("Failed to read scene image ", pFile);
+        }
+    }
+
+    const aiScene *scene = Relocate(data, size);
+    pScene->mFlags = scene->mFlags;
+    pScene->mRootNode = scene->mRootNode;
+    pScene->mNumMeshes = scene->mNumMeshes;
+    pScene->mMeshes = scene->mMeshes;
+    pScene->mNumMaterials = scene->mNumMaterials;
+    pScene->mMaterials = scene->mMaterials;
+    pScene->mNumAnimations = scene->mNumAnimations;
+    pScene->mAnimations = scene->mAnimations;
+    pScene->mNumTextures = scene->mNumTextures;
+    pScene->mTextures = scene->mTextures;
+    pScene->mNumLights = scene->mNumLights;
+    pScene->mLights = scene->mLights;
+    pScene->mNumCameras = scene->mNumCameras;
+    pScene->mCameras = scene->mCameras;
+    pScene->mMetaData = scene->mMetaData;
+    pScene->mName = scene->mName;
+
+    // from now on the scene owns the image
+    ScenePriv(pScene)->mImage = image;
+}
+
+#endif // ASSIMP_BUILD_NO_SCENEIMAGE_IMPORTER
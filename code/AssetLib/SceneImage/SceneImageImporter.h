@@ -0,0 +1,90 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  SceneImageImporter.h
+ *  @brief Importer for relocatable scene images (.assimg)
+ */
+#ifndef AI_SCENEIMAGEIMPORTER_H_INC
+#define AI_SCENEIMAGEIMPORTER_H_INC
+
+#ifndef ASSIMP_BUILD_NO_SCENEIMAGE_IMPORTER
+
+#include <assimp/BaseImporter.h>
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** Importer for scene images written by the assimg exporter.
+ *
+ *  The image is mapped (or read into a single block) and relocated in place,
+ *  the scene then points straight into it. Such a scene is read-only until
+ *  a post-processing step needs to change it, the Importer replaces it by a
+ *  regular deep copy first. See SceneImage.h for the format.
+ */
+class SceneImageImporter : public BaseImporter {
+public:
+    SceneImageImporter();
+    ~SceneImageImporter();
+
+    // -------------------------------------------------------------------
+    bool CanRead(const std::string &pFile, IOSystem *pIOHandler, bool checkSig) const;
+
+protected:
+    // -------------------------------------------------------------------
+    const aiImporterDesc *GetInfo() const;
+
+    // -------------------------------------------------------------------
+    void SetupProperties(const Importer *pImp);
+
+    // -------------------------------------------------------------------
+    void InternReadFile(const std::string &pFile, aiScene *pScene, IOSystem *pIOHandler);
+
+private:
+    /** Map files directly, only if they are read through the default IOSystem */
+    bool mMapFile;
+};
+
+} // namespace Assimp
+
+#endif // ASSIMP_BUILD_NO_SCENEIMAGE_IMPORTER
+
+#endif // AI_SCENEIMAGEIMPORTER_H_INC
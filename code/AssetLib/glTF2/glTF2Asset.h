@@ -541,7 +541,9 @@ public:
 
     void Read(Value &obj, Asset &r);
 
-    bool LoadFromStream(IOStream &stream, size_t length = 0, size_t baseOffset = 0);
+    /// Load the data from the stream. If the stream holds its contents in memory
+    /// already, the buffer refers to them and keeps the stream alive instead of copying.
+    bool LoadFromStream(const shared_ptr<IOStream> &stream, size_t length = 0, size_t baseOffset = 0);
 
     /// \fn void EncodedRegion_Mark(const size_t pOffset, const size_t pEncodedData_Length, uint8_t* pDecodedData, const size_t pDecodedData_Length, const std::string& pID)
     /// Mark region of "bufferView" as encoded. When data is request from such region then "bufferView" use decoded data.
@@ -406,10 +406,9 @@ inline void Buffer::Read(Value &obj, Asset &r) {
                    r.mCurrentAssetDir : r.mCurrentAssetDir + '/'
             ) : "";
 
-            IOStream *file = r.OpenFile(dir + uri, "rb");
+            shared_ptr<IOStream> file(r.OpenFile(dir + uri, "rb"));
             if (file) {
-                bool ok = LoadFromStream(*file, byteLength);
-                delete file;
+                bool ok = LoadFromStream(file, byteLength);
 
                 if (!ok)
                     throw DeadlyImportError("GLTF: error while reading referenced file \"", uri, "\"");
@@ -420,16 +419,27 @@ inline void Buffer::Read(Value &obj, Asset &r) {
     }
 }
 
-inline bool Buffer::LoadFromStream(IOStream &stream, size_t length, size_t baseOffset) {
-    byteLength = length ? length : stream.FileSize();
+inline bool Buffer::LoadFromStream(const shared_ptr<IOStream> &stream, size_t length, size_t baseOffset) {
+    byteLength = length ? length : stream->FileSize();
+
+    // The data is only read while importing, so share the stream contents
+    // if possible. The aliasing pointer keeps the stream open.
+    const uint8_t *mapped = static_cast<const uint8_t *>(stream->GetMappedData());
+    if (mapped) {
+        if (baseOffset > stream->FileSize() || byteLength > stream->FileSize() - baseOffset) {
+            return false;
+        }
+        mData = shared_ptr<uint8_t>(stream, const_cast<uint8_t *>(mapped) + baseOffset);
+        return true;
+    }
 
     if (baseOffset) {
-        stream.Seek(baseOffset, aiOrigin_SET);
+        stream->Seek(baseOffset, aiOrigin_SET);
     }
 
     mData.reset(new uint8_t[byteLength], std::default_delete<uint8_t[]>());
 
-    if (stream.Read(mData.get(), byteLength, 1) != 1) {
+    if (stream->Read(mData.get(), byteLength, 1) != 1) {
         return false;
     }
     return true;
@@ -749,6 +759,14 @@ inline void CopyData(size_t count,
     }
 }
 
+// ExtractData() has already checked that ElemSize fits into T
+template <size_t ElemSize, class T>
+inline void CopyStrided(T *out, const uint8_t *src, size_t count, size_t stride) {
+    const size_t size = ElemSize < sizeof(T) ? ElemSize : sizeof(T);
+    for (size_t i = 0; i < count; ++i, src += stride) {
+        memcpy(out + i, src, size);
+    }
+}
 } // namespace
 
 template <class T>
@@ -777,10 +795,29 @@ void Accessor::ExtractData(T *&outData) {
     outData = new T[count];
     if (stride == elemSize && targetElemSize == elemSize) {
         memcpy(outData, data, totalSize);
-    } else {
+        return;
+    }
+
+    // Interleaved or widened data: dispatch the common element sizes to a
+    // constant-size copy, which the compiler turns into plain vector moves.
+    switch (elemSize) {
+    case 4:
+        CopyStrided<4>(outData, data, count, stride);
+        break;
+    case 8:
+        CopyStrided<8>(outData, data, count, stride);
+        break;
+    case 12:
+        CopyStrided<12>(outData, data, count, stride);
+        break;
+    case 16:
+        CopyStrided<16>(outData, data, count, stride);
+        break;
+    default:
         for (size_t i = 0; i < count; ++i) {
             memcpy(outData + i, data + i * stride, elemSize);
         }
+        break;
     }
 }
 
@@ -1683,7 +1720,7 @@ inline void Asset::Load(const std::string &pFile, bool isBinary) {
 
     // Fill the buffer instance for the current file embedded contents
     if (mBodyLength > 0) {
-        if (!mBodyBuffer->LoadFromStream(*stream, mBodyLength, mBodyOffset)) {
+        if (!mBodyBuffer->LoadFromStream(stream, mBodyLength, mBodyOffset)) {
             throw DeadlyImportError("GLTF: Unable to read gltf file");
         }
     }
@@ -45,6 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PostProcessing/MakeVerboseFormat.h"
 #include "AssetLib/glTF2/glTF2Asset.h"
 #include "AssetLib/glTF2/glTF2AssetWriter.h"
+#include "Common/ThreadPool.h"
 
 #include <assimp/CreateAnimMesh.h>
 #include <assimp/StringComparison.h>
@@ -383,341 +384,348 @@ static inline bool CheckValidFacesIndices(aiFace *faces, unsigned nFaces, unsign
 }
 #endif // ASSIMP_BUILD_DEBUG
 
-void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
-    ASSIMP_LOG_DEBUG_F("Importing ", r.meshes.Size(), " meshes");
-    std::vector<std::unique_ptr<aiMesh>> meshes;
+// Fills aim from one primitive. Only touches aim, so primitives can be imported concurrently.
+static void ImportPrimitive(Mesh &mesh, Mesh::Primitive &prim, aiMesh *aim) {
+    switch (prim.mode) {
+        case PrimitiveMode_POINTS:
+            aim->mPrimitiveTypes |= aiPrimitiveType_POINT;
+            break;
+
+        case PrimitiveMode_LINES:
+        case PrimitiveMode_LINE_LOOP:
+        case PrimitiveMode_LINE_STRIP:
+            aim->mPrimitiveTypes |= aiPrimitiveType_LINE;
+            break;
+
+        case PrimitiveMode_TRIANGLES:
+        case PrimitiveMode_TRIANGLE_STRIP:
+        case PrimitiveMode_TRIANGLE_FAN:
+            aim->mPrimitiveTypes |= aiPrimitiveType_TRIANGLE;
+            break;
+    }
 
-    unsigned int k = 0;
-    meshOffsets.clear();
+    Mesh::Primitive::Attributes &attr = prim.attributes;
 
-    for (unsigned int m = 0; m < r.meshes.Size(); ++m) {
-        Mesh &mesh = r.meshes[m];
+    if (attr.position.size() > 0 && attr.position[0]) {
+        aim->mNumVertices = static_cast<unsigned int>(attr.position[0]->count);
+        attr.position[0]->ExtractData(aim->mVertices);
+    }
 
-        meshOffsets.push_back(k);
-        k += unsigned(mesh.primitives.size());
+    if (attr.normal.size() > 0 && attr.normal[0]) {
+        attr.normal[0]->ExtractData(aim->mNormals);
 
-        for (unsigned int p = 0; p < mesh.primitives.size(); ++p) {
-            Mesh::Primitive &prim = mesh.primitives[p];
+        // only extract tangents if normals are present
+        if (attr.tangent.size() > 0 && attr.tangent[0]) {
+            // generate bitangents from normals and tangents according to spec
+            Tangent *tangents = nullptr;
 
-            aiMesh *aim = new aiMesh();
-            meshes.push_back(std::unique_ptr<aiMesh>(aim));
+            attr.tangent[0]->ExtractData(tangents);
 
-            aim->mName = mesh.name.empty() ? mesh.id : mesh.name;
+            aim->mTangents = new aiVector3D[aim->mNumVertices];
+            aim->mBitangents = new aiVector3D[aim->mNumVertices];
 
-            if (mesh.primitives.size() > 1) {
-                ai_uint32 &len = aim->mName.length;
-                aim->mName.data[len] = '-';
-                len += 1 + ASSIMP_itoa10(aim->mName.data + len + 1, unsigned(MAXLEN - len - 1), p);
+            for (unsigned int i = 0; i < aim->mNumVertices; ++i) {
+                aim->mTangents[i] = tangents[i].xyz;
+                aim->mBitangents[i] = (aim->mNormals[i] ^ tangents[i].xyz) * tangents[i].w;
             }
 
-            switch (prim.mode) {
-                case PrimitiveMode_POINTS:
-                    aim->mPrimitiveTypes |= aiPrimitiveType_POINT;
-                    break;
-
-                case PrimitiveMode_LINES:
-                case PrimitiveMode_LINE_LOOP:
-                case PrimitiveMode_LINE_STRIP:
-                    aim->mPrimitiveTypes |= aiPrimitiveType_LINE;
-                    break;
-
-                case PrimitiveMode_TRIANGLES:
-                case PrimitiveMode_TRIANGLE_STRIP:
-                case PrimitiveMode_TRIANGLE_FAN:
-                    aim->mPrimitiveTypes |= aiPrimitiveType_TRIANGLE;
-                    break;
-            }
+            delete[] tangents;
+        }
+    }
+
+    for (size_t c = 0; c < attr.color.size() && c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+        if (attr.color[c]->count != aim->mNumVertices) {
+            DefaultLogger::get()->warn("Color stream size in mesh \"" + mesh.name +
+                                       "\" does not match the vertex count");
+            continue;
+        }
+        attr.color[c]->ExtractData(aim->mColors[c]);
+    }
+    for (size_t tc = 0; tc < attr.texcoord.size() && tc < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++tc) {
+        if (!attr.texcoord[tc]) {
+            DefaultLogger::get()->warn("Texture coordinate accessor not found or non-contiguous texture coordinate sets.");
+            continue;
+        }
 
-            Mesh::Primitive::Attributes &attr = prim.attributes;
+        if (attr.texcoord[tc]->count != aim->mNumVertices) {
+            DefaultLogger::get()->warn("Texcoord stream size in mesh \"" + mesh.name +
+                                       "\" does not match the vertex count");
+            continue;
+        }
 
-            if (attr.position.size() > 0 && attr.position[0]) {
-                aim->mNumVertices = static_cast<unsigned int>(attr.position[0]->count);
-                attr.position[0]->ExtractData(aim->mVertices);
+        attr.texcoord[tc]->ExtractData(aim->mTextureCoords[tc]);
+        aim->mNumUVComponents[tc] = attr.texcoord[tc]->GetNumComponents();
+
+        aiVector3D *values = aim->mTextureCoords[tc];
+        for (unsigned int i = 0; i < aim->mNumVertices; ++i) {
+            values[i].y = 1 - values[i].y; // Flip Y coords
+        }
+    }
+
+    std::vector<Mesh::Primitive::Target> &targets = prim.targets;
+    if (targets.size() > 0) {
+        aim->mNumAnimMeshes = (unsigned int)targets.size();
+        aim->mAnimMeshes = new aiAnimMesh *[aim->mNumAnimMeshes];
+        std::fill(aim->mAnimMeshes, aim->mAnimMeshes + aim->mNumAnimMeshes, nullptr);
+        for (size_t i = 0; i < targets.size(); i++) {
+            bool needPositions = targets[i].position.size() > 0;
+            bool needNormals = targets[i].normal.size() > 0;
+            bool needTangents = targets[i].tangent.size() > 0;
+            // GLTF morph does not support colors and texCoords
+            aim->mAnimMeshes[i] = aiCreateAnimMesh(aim,
+                    needPositions, needNormals, needTangents, false, false);
+            aiAnimMesh &aiAnimMesh = *(aim->mAnimMeshes[i]);
+            Mesh::Primitive::Target &target = targets[i];
+
+            if (needPositions) {
+                aiVector3D *positionDiff = nullptr;
+                target.position[0]->ExtractData(positionDiff);
+                for (unsigned int vertexId = 0; vertexId < aim->mNumVertices; vertexId++) {
+                    aiAnimMesh.mVertices[vertexId] += positionDiff[vertexId];
+                }
+                delete[] positionDiff;
             }
+            if (needNormals) {
+                aiVector3D *normalDiff = nullptr;
+                target.normal[0]->ExtractData(normalDiff);
+                for (unsigned int vertexId = 0; vertexId < aim->mNumVertices; vertexId++) {
+                    aiAnimMesh.mNormals[vertexId] += normalDiff[vertexId];
+                }
+                delete[] normalDiff;
+            }
+            if (needTangents) {
+                Tangent *tangent = nullptr;
+                attr.tangent[0]->ExtractData(tangent);
 
-            if (attr.normal.size() > 0 && attr.normal[0]) {
-                attr.normal[0]->ExtractData(aim->mNormals);
+                aiVector3D *tangentDiff = nullptr;
+                target.tangent[0]->ExtractData(tangentDiff);
 
-                // only extract tangents if normals are present
-                if (attr.tangent.size() > 0 && attr.tangent[0]) {
-                    // generate bitangents from normals and tangents according to spec
-                    Tangent *tangents = nullptr;
+                for (unsigned int vertexId = 0; vertexId < aim->mNumVertices; ++vertexId) {
+                    tangent[vertexId].xyz += tangentDiff[vertexId];
+                    aiAnimMesh.mTangents[vertexId] = tangent[vertexId].xyz;
+                    aiAnimMesh.mBitangents[vertexId] = (aiAnimMesh.mNormals[vertexId] ^ tangent[vertexId].xyz) * tangent[vertexId].w;
+                }
+                delete[] tangent;
+                delete[] tangentDiff;
+            }
+            if (mesh.weights.size() > i) {
+                aiAnimMesh.mWeight = mesh.weights[i];
+            }
+            if (mesh.targetNames.size() > i) {
+                aiAnimMesh.mName = mesh.targetNames[i];
+            }
+        }
+    }
 
-                    attr.tangent[0]->ExtractData(tangents);
+    aiFace *faces = nullptr;
+    aiFace *facePtr = nullptr;
+    size_t nFaces = 0;
 
-                    aim->mTangents = new aiVector3D[aim->mNumVertices];
-                    aim->mBitangents = new aiVector3D[aim->mNumVertices];
+    if (prim.indices) {
+        size_t count = prim.indices->count;
 
-                    for (unsigned int i = 0; i < aim->mNumVertices; ++i) {
-                        aim->mTangents[i] = tangents[i].xyz;
-                        aim->mBitangents[i] = (aim->mNormals[i] ^ tangents[i].xyz) * tangents[i].w;
-                    }
+        Accessor::Indexer data = prim.indices->GetIndexer();
+        if (!data.IsValid()) {
+            throw DeadlyImportError("GLTF: Invalid accessor without data in mesh ", getContextForErrorMessages(mesh.id, mesh.name));
+        }
 
-                    delete[] tangents;
+        switch (prim.mode) {
+            case PrimitiveMode_POINTS: {
+                nFaces = count;
+                facePtr = faces = new aiFace[nFaces];
+                for (unsigned int i = 0; i < count; ++i) {
+                    SetFaceAndAdvance1(facePtr, aim->mNumVertices, data.GetUInt(i));
                 }
+                break;
             }
 
-            for (size_t c = 0; c < attr.color.size() && c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
-                if (attr.color[c]->count != aim->mNumVertices) {
-                    DefaultLogger::get()->warn("Color stream size in mesh \"" + mesh.name +
-                                               "\" does not match the vertex count");
-                    continue;
+            case PrimitiveMode_LINES: {
+                nFaces = count / 2;
+                if (nFaces * 2 != count) {
+                    ASSIMP_LOG_WARN("The number of vertices was not compatible with the LINES mode. Some vertices were dropped.");
+                    count = nFaces * 2;
                 }
-                attr.color[c]->ExtractData(aim->mColors[c]);
-            }
-            for (size_t tc = 0; tc < attr.texcoord.size() && tc < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++tc) {
-                if (!attr.texcoord[tc]) {
-                    DefaultLogger::get()->warn("Texture coordinate accessor not found or non-contiguous texture coordinate sets.");
-                    continue;
+                facePtr = faces = new aiFace[nFaces];
+                for (unsigned int i = 0; i < count; i += 2) {
+                    SetFaceAndAdvance2(facePtr, aim->mNumVertices, data.GetUInt(i), data.GetUInt(i + 1));
                 }
+                break;
+            }
 
-                if (attr.texcoord[tc]->count != aim->mNumVertices) {
-                    DefaultLogger::get()->warn("Texcoord stream size in mesh \"" + mesh.name +
-                                               "\" does not match the vertex count");
-                    continue;
+            case PrimitiveMode_LINE_LOOP:
+            case PrimitiveMode_LINE_STRIP: {
+                nFaces = count - ((prim.mode == PrimitiveMode_LINE_STRIP) ? 1 : 0);
+                facePtr = faces = new aiFace[nFaces];
+                SetFaceAndAdvance2(facePtr, aim->mNumVertices, data.GetUInt(0), data.GetUInt(1));
+                for (unsigned int i = 2; i < count; ++i) {
+                    SetFaceAndAdvance2(facePtr, aim->mNumVertices, data.GetUInt(i - 1), data.GetUInt(i));
                 }
-
-                attr.texcoord[tc]->ExtractData(aim->mTextureCoords[tc]);
-                aim->mNumUVComponents[tc] = attr.texcoord[tc]->GetNumComponents();
-
-                aiVector3D *values = aim->mTextureCoords[tc];
-                for (unsigned int i = 0; i < aim->mNumVertices; ++i) {
-                    values[i].y = 1 - values[i].y; // Flip Y coords
+                if (prim.mode == PrimitiveMode_LINE_LOOP) { // close the loop
+                    SetFaceAndAdvance2(facePtr, aim->mNumVertices, data.GetUInt(static_cast<int>(count) - 1), faces[0].mIndices[0]);
                 }
+                break;
             }
 
-            std::vector<Mesh::Primitive::Target> &targets = prim.targets;
-            if (targets.size() > 0) {
-                aim->mNumAnimMeshes = (unsigned int)targets.size();
-                aim->mAnimMeshes = new aiAnimMesh *[aim->mNumAnimMeshes];
-                std::fill(aim->mAnimMeshes, aim->mAnimMeshes + aim->mNumAnimMeshes, nullptr);
-                for (size_t i = 0; i < targets.size(); i++) {
-                    bool needPositions = targets[i].position.size() > 0;
-                    bool needNormals = targets[i].normal.size() > 0;
-                    bool needTangents = targets[i].tangent.size() > 0;
-                    // GLTF morph does not support colors and texCoords
-                    aim->mAnimMeshes[i] = aiCreateAnimMesh(aim,
-                            needPositions, needNormals, needTangents, false, false);
-                    aiAnimMesh &aiAnimMesh = *(aim->mAnimMeshes[i]);
-                    Mesh::Primitive::Target &target = targets[i];
-
-                    if (needPositions) {
-                        aiVector3D *positionDiff = nullptr;
-                        target.position[0]->ExtractData(positionDiff);
-                        for (unsigned int vertexId = 0; vertexId < aim->mNumVertices; vertexId++) {
-                            aiAnimMesh.mVertices[vertexId] += positionDiff[vertexId];
-                        }
-                        delete[] positionDiff;
-                    }
-                    if (needNormals) {
-                        aiVector3D *normalDiff = nullptr;
-                        target.normal[0]->ExtractData(normalDiff);
-                        for (unsigned int vertexId = 0; vertexId < aim->mNumVertices; vertexId++) {
-                            aiAnimMesh.mNormals[vertexId] += normalDiff[vertexId];
-                        }
-                        delete[] normalDiff;
+            case PrimitiveMode_TRIANGLES: {
+                nFaces = count / 3;
+                if (nFaces * 3 != count) {
+                    ASSIMP_LOG_WARN("The number of vertices was not compatible with the TRIANGLES mode. Some vertices were dropped.");
+                    count = nFaces * 3;
+                }
+                facePtr = faces = new aiFace[nFaces];
+                for (unsigned int i = 0; i < count; i += 3) {
+                    SetFaceAndAdvance3(facePtr, aim->mNumVertices, data.GetUInt(i), data.GetUInt(i + 1), data.GetUInt(i + 2));
+                }
+                break;
+            }
+            case PrimitiveMode_TRIANGLE_STRIP: {
+                nFaces = count - 2;
+                facePtr = faces = new aiFace[nFaces];
+                for (unsigned int i = 0; i < nFaces; ++i) {
+                    //The ordering is to ensure that the triangles are all drawn with the same orientation
+                    if ((i + 1) % 2 == 0) {
+                        //For even n, vertices n + 1, n, and n + 2 define triangle n
+                        SetFaceAndAdvance3(facePtr, aim->mNumVertices, data.GetUInt(i + 1), data.GetUInt(i), data.GetUInt(i + 2));
+                    } else {
+                        //For odd n, vertices n, n+1, and n+2 define triangle n
+                        SetFaceAndAdvance3(facePtr, aim->mNumVertices, data.GetUInt(i), data.GetUInt(i + 1), data.GetUInt(i + 2));
                     }
-                    if (needTangents) {
-                        Tangent *tangent = nullptr;
-                        attr.tangent[0]->ExtractData(tangent);
+                }
+                break;
+            }
+            case PrimitiveMode_TRIANGLE_FAN:
+                nFaces = count - 2;
+                facePtr = faces = new aiFace[nFaces];
+                SetFaceAndAdvance3(facePtr, aim->mNumVertices, data.GetUInt(0), data.GetUInt(1), data.GetUInt(2));
+                for (unsigned int i = 1; i < nFaces; ++i) {
+                    SetFaceAndAdvance3(facePtr, aim->mNumVertices, data.GetUInt(0), data.GetUInt(i + 1), data.GetUInt(i + 2));
+                }
+                break;
+        }
+    } else { // no indices provided so directly generate from counts
 
-                        aiVector3D *tangentDiff = nullptr;
-                        target.tangent[0]->ExtractData(tangentDiff);
+        // use the already determined count as it includes checks
+        unsigned int count = aim->mNumVertices;
 
-                        for (unsigned int vertexId = 0; vertexId < aim->mNumVertices; ++vertexId) {
-                            tangent[vertexId].xyz += tangentDiff[vertexId];
-                            aiAnimMesh.mTangents[vertexId] = tangent[vertexId].xyz;
-                            aiAnimMesh.mBitangents[vertexId] = (aiAnimMesh.mNormals[vertexId] ^ tangent[vertexId].xyz) * tangent[vertexId].w;
-                        }
-                        delete[] tangent;
-                        delete[] tangentDiff;
-                    }
-                    if (mesh.weights.size() > i) {
-                        aiAnimMesh.mWeight = mesh.weights[i];
-                    }
-                    if (mesh.targetNames.size() > i) {
-                        aiAnimMesh.mName = mesh.targetNames[i];
-                    }
+        switch (prim.mode) {
+            case PrimitiveMode_POINTS: {
+                nFaces = count;
+                facePtr = faces = new aiFace[nFaces];
+                for (unsigned int i = 0; i < count; ++i) {
+                    SetFaceAndAdvance1(facePtr, aim->mNumVertices, i);
                 }
+                break;
             }
 
-            aiFace *faces = nullptr;
-            aiFace *facePtr = nullptr;
-            size_t nFaces = 0;
-
-            if (prim.indices) {
-                size_t count = prim.indices->count;
+            case PrimitiveMode_LINES: {
+                nFaces = count / 2;
+                if (nFaces * 2 != count) {
+                    ASSIMP_LOG_WARN("The number of vertices was not compatible with the LINES mode. Some vertices were dropped.");
+                    count = (unsigned int)nFaces * 2;
+                }
+                facePtr = faces = new aiFace[nFaces];
+                for (unsigned int i = 0; i < count; i += 2) {
+                    SetFaceAndAdvance2(facePtr, aim->mNumVertices, i, i + 1);
+                }
+                break;
+            }
 
-                Accessor::Indexer data = prim.indices->GetIndexer();
-                if (!data.IsValid()) {
-                    throw DeadlyImportError("GLTF: Invalid accessor without data in mesh ", getContextForErrorMessages(mesh.id, mesh.name));
+            case PrimitiveMode_LINE_LOOP:
+            case PrimitiveMode_LINE_STRIP: {
+                nFaces = count - ((prim.mode == PrimitiveMode_LINE_STRIP) ? 1 : 0);
+                facePtr = faces = new aiFace[nFaces];
+                SetFaceAndAdvance2(facePtr, aim->mNumVertices, 0, 1);
+                for (unsigned int i = 2; i < count; ++i) {
+                    SetFaceAndAdvance2(facePtr, aim->mNumVertices, i - 1, i);
                 }
+                if (prim.mode == PrimitiveMode_LINE_LOOP) { // close the loop
+                    SetFaceAndAdvance2(facePtr, aim->mNumVertices, count - 1, 0);
+                }
+                break;
+            }
 
-                switch (prim.mode) {
-                    case PrimitiveMode_POINTS: {
-                        nFaces = count;
-                        facePtr = faces = new aiFace[nFaces];
-                        for (unsigned int i = 0; i < count; ++i) {
-                            SetFaceAndAdvance1(facePtr, aim->mNumVertices, data.GetUInt(i));
-                        }
-                        break;
+            case PrimitiveMode_TRIANGLES: {
+                nFaces = count / 3;
+                if (nFaces * 3 != count) {
+                    ASSIMP_LOG_WARN("The number of vertices was not compatible with the TRIANGLES mode. Some vertices were dropped.");
+                    count = (unsigned int)nFaces * 3;
+                }
+                facePtr = faces = new aiFace[nFaces];
+                for (unsigned int i = 0; i < count; i += 3) {
+                    SetFaceAndAdvance3(facePtr, aim->mNumVertices, i, i + 1, i + 2);
+                }
+                break;
+            }
+            case PrimitiveMode_TRIANGLE_STRIP: {
+                nFaces = count - 2;
+                facePtr = faces = new aiFace[nFaces];
+                for (unsigned int i = 0; i < nFaces; ++i) {
+                    //The ordering is to ensure that the triangles are all drawn with the same orientation
+                    if ((i + 1) % 2 == 0) {
+                        //For even n, vertices n + 1, n, and n + 2 define triangle n
+                        SetFaceAndAdvance3(facePtr, aim->mNumVertices, i + 1, i, i + 2);
+                    } else {
+                        //For odd n, vertices n, n+1, and n+2 define triangle n
+                        SetFaceAndAdvance3(facePtr, aim->mNumVertices, i, i + 1, i + 2);
                     }
+                }
+                break;
+            }
+            case PrimitiveMode_TRIANGLE_FAN:
+                nFaces = count - 2;
+                facePtr = faces = new aiFace[nFaces];
+                SetFaceAndAdvance3(facePtr, aim->mNumVertices, 0, 1, 2);
+                for (unsigned int i = 1; i < nFaces; ++i) {
+                    SetFaceAndAdvance3(facePtr, aim->mNumVertices, 0, i + 1, i + 2);
+                }
+                break;
+        }
+    }
 
-                    case PrimitiveMode_LINES: {
-                        nFaces = count / 2;
-                        if (nFaces * 2 != count) {
-                            ASSIMP_LOG_WARN("The number of vertices was not compatible with the LINES mode. Some vertices were dropped.");
-                            count = nFaces * 2;
-                        }
-                        facePtr = faces = new aiFace[nFaces];
-                        for (unsigned int i = 0; i < count; i += 2) {
-                            SetFaceAndAdvance2(facePtr, aim->mNumVertices, data.GetUInt(i), data.GetUInt(i + 1));
-                        }
-                        break;
-                    }
+    if (faces) {
+        aim->mFaces = faces;
+        const unsigned int actualNumFaces = static_cast<unsigned int>(facePtr - faces);
+        if (actualNumFaces < nFaces) {
+            ASSIMP_LOG_WARN("Some faces had out-of-range indices. Those faces were dropped.");
+        }
+        if (actualNumFaces == 0)
+        {
+            throw DeadlyImportError("Mesh \"", aim->mName.C_Str(), "\" has no faces");
+        }
+        aim->mNumFaces = actualNumFaces;
+        ai_assert(CheckValidFacesIndices(faces, actualNumFaces, aim->mNumVertices));
+    }
+}
 
-                    case PrimitiveMode_LINE_LOOP:
-                    case PrimitiveMode_LINE_STRIP: {
-                        nFaces = count - ((prim.mode == PrimitiveMode_LINE_STRIP) ? 1 : 0);
-                        facePtr = faces = new aiFace[nFaces];
-                        SetFaceAndAdvance2(facePtr, aim->mNumVertices, data.GetUInt(0), data.GetUInt(1));
-                        for (unsigned int i = 2; i < count; ++i) {
-                            SetFaceAndAdvance2(facePtr, aim->mNumVertices, data.GetUInt(i - 1), data.GetUInt(i));
-                        }
-                        if (prim.mode == PrimitiveMode_LINE_LOOP) { // close the loop
-                            SetFaceAndAdvance2(facePtr, aim->mNumVertices, data.GetUInt(static_cast<int>(count) - 1), faces[0].mIndices[0]);
-                        }
-                        break;
-                    }
+void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
+    ASSIMP_LOG_DEBUG_F("Importing ", r.meshes.Size(), " meshes");
+    std::vector<std::unique_ptr<aiMesh>> meshes;
 
-                    case PrimitiveMode_TRIANGLES: {
-                        nFaces = count / 3;
-                        if (nFaces * 3 != count) {
-                            ASSIMP_LOG_WARN("The number of vertices was not compatible with the TRIANGLES mode. Some vertices were dropped.");
-                            count = nFaces * 3;
-                        }
-                        facePtr = faces = new aiFace[nFaces];
-                        for (unsigned int i = 0; i < count; i += 3) {
-                            SetFaceAndAdvance3(facePtr, aim->mNumVertices, data.GetUInt(i), data.GetUInt(i + 1), data.GetUInt(i + 2));
-                        }
-                        break;
-                    }
-                    case PrimitiveMode_TRIANGLE_STRIP: {
-                        nFaces = count - 2;
-                        facePtr = faces = new aiFace[nFaces];
-                        for (unsigned int i = 0; i < nFaces; ++i) {
-                            //The ordering is to ensure that the triangles are all drawn with the same orientation
-                            if ((i + 1) % 2 == 0) {
-                                //For even n, vertices n + 1, n, and n + 2 define triangle n
-                                SetFaceAndAdvance3(facePtr, aim->mNumVertices, data.GetUInt(i + 1), data.GetUInt(i), data.GetUInt(i + 2));
-                            } else {
-                                //For odd n, vertices n, n+1, and n+2 define triangle n
-                                SetFaceAndAdvance3(facePtr, aim->mNumVertices, data.GetUInt(i), data.GetUInt(i + 1), data.GetUInt(i + 2));
-                            }
-                        }
-                        break;
-                    }
-                    case PrimitiveMode_TRIANGLE_FAN:
-                        nFaces = count - 2;
-                        facePtr = faces = new aiFace[nFaces];
-                        SetFaceAndAdvance3(facePtr, aim->mNumVertices, data.GetUInt(0), data.GetUInt(1), data.GetUInt(2));
-                        for (unsigned int i = 1; i < nFaces; ++i) {
-                            SetFaceAndAdvance3(facePtr, aim->mNumVertices, data.GetUInt(0), data.GetUInt(i + 1), data.GetUInt(i + 2));
-                        }
-                        break;
-                }
-            } else { // no indices provided so directly generate from counts
+    // (mesh, primitive) pair for every aiMesh, in output order
+    std::vector<std::pair<unsigned int, unsigned int>> primitives;
 
-                // use the already determined count as it includes checks
-                unsigned int count = aim->mNumVertices;
+    unsigned int k = 0;
+    meshOffsets.clear();
 
-                switch (prim.mode) {
-                    case PrimitiveMode_POINTS: {
-                        nFaces = count;
-                        facePtr = faces = new aiFace[nFaces];
-                        for (unsigned int i = 0; i < count; ++i) {
-                            SetFaceAndAdvance1(facePtr, aim->mNumVertices, i);
-                        }
-                        break;
-                    }
+    for (unsigned int m = 0; m < r.meshes.Size(); ++m) {
+        Mesh &mesh = r.meshes[m];
 
-                    case PrimitiveMode_LINES: {
-                        nFaces = count / 2;
-                        if (nFaces * 2 != count) {
-                            ASSIMP_LOG_WARN("The number of vertices was not compatible with the LINES mode. Some vertices were dropped.");
-                            count = (unsigned int)nFaces * 2;
-                        }
-                        facePtr = faces = new aiFace[nFaces];
-                        for (unsigned int i = 0; i < count; i += 2) {
-                            SetFaceAndAdvance2(facePtr, aim->mNumVertices, i, i + 1);
-                        }
-                        break;
-                    }
+        meshOffsets.push_back(k);
+        k += unsigned(mesh.primitives.size());
 
-                    case PrimitiveMode_LINE_LOOP:
-                    case PrimitiveMode_LINE_STRIP: {
-                        nFaces = count - ((prim.mode == PrimitiveMode_LINE_STRIP) ? 1 : 0);
-                        facePtr = faces = new aiFace[nFaces];
-                        SetFaceAndAdvance2(facePtr, aim->mNumVertices, 0, 1);
-                        for (unsigned int i = 2; i < count; ++i) {
-                            SetFaceAndAdvance2(facePtr, aim->mNumVertices, i - 1, i);
-                        }
-                        if (prim.mode == PrimitiveMode_LINE_LOOP) { // close the loop
-                            SetFaceAndAdvance2(facePtr, aim->mNumVertices, count - 1, 0);
-                        }
-                        break;
-                    }
+        for (unsigned int p = 0; p < mesh.primitives.size(); ++p) {
+            Mesh::Primitive &prim = mesh.primitives[p];
 
-                    case PrimitiveMode_TRIANGLES: {
-                        nFaces = count / 3;
-                        if (nFaces * 3 != count) {
-                            ASSIMP_LOG_WARN("The number of vertices was not compatible with the TRIANGLES mode. Some vertices were dropped.");
-                            count = (unsigned int)nFaces * 3;
-                        }
-                        facePtr = faces = new aiFace[nFaces];
-                        for (unsigned int i = 0; i < count; i += 3) {
-                            SetFaceAndAdvance3(facePtr, aim->mNumVertices, i, i + 1, i + 2);
-                        }
-                        break;
-                    }
-                    case PrimitiveMode_TRIANGLE_STRIP: {
-                        nFaces = count - 2;
-                        facePtr = faces = new aiFace[nFaces];
-                        for (unsigned int i = 0; i < nFaces; ++i) {
-                            //The ordering is to ensure that the triangles are all drawn with the same orientation
-                            if ((i + 1) % 2 == 0) {
-                                //For even n, vertices n + 1, n, and n + 2 define triangle n
-                                SetFaceAndAdvance3(facePtr, aim->mNumVertices, i + 1, i, i + 2);
-                            } else {
-                                //For odd n, vertices n, n+1, and n+2 define triangle n
-                                SetFaceAndAdvance3(facePtr, aim->mNumVertices, i, i + 1, i + 2);
-                            }
-                        }
-                        break;
-                    }
-                    case PrimitiveMode_TRIANGLE_FAN:
-                        nFaces = count - 2;
-                        facePtr = faces = new aiFace[nFaces];
-                        SetFaceAndAdvance3(facePtr, aim->mNumVertices, 0, 1, 2);
-                        for (unsigned int i = 1; i < nFaces; ++i) {
-                            SetFaceAndAdvance3(facePtr, aim->mNumVertices, 0, i + 1, i + 2);
-                        }
-                        break;
-                }
-            }
+            aiMesh *aim = new aiMesh();
+            meshes.push_back(std::unique_ptr<aiMesh>(aim));
+            primitives.emplace_back(m, p);
 
-            if (faces) {
-                aim->mFaces = faces;
-                const unsigned int actualNumFaces = static_cast<unsigned int>(facePtr - faces);
-                if (actualNumFaces < nFaces) {
-                    ASSIMP_LOG_WARN("Some faces had out-of-range indices. Those faces were dropped.");
-                }
-                if (actualNumFaces == 0)
-                {
-                    throw DeadlyImportError("Mesh \"", aim->mName.C_Str(), "\" has no faces");
-                }
-                aim->mNumFaces = actualNumFaces;
-                ai_assert(CheckValidFacesIndices(faces, actualNumFaces, aim->mNumVertices));
+            aim->mName = mesh.name.empty() ? mesh.id : mesh.name;
+
+            if (mesh.primitives.size() > 1) {
+                ai_uint32 &len = aim->mName.length;
+                aim->mName.data[len] = '-';
+                len += 1 + ASSIMP_itoa10(aim->mName.data + len + 1, unsigned(MAXLEN - len - 1), p);
             }
 
             if (prim.material) {
@@ -730,6 +738,13 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
 
     meshOffsets.push_back(k);
 
+    // All accessors are resolved while the asset is read, so the primitives
+    // only read shared data and can be extracted independently.
+    ParallelFor(m_threadPool, static_cast<unsigned int>(primitives.size()), [&](unsigned int i) {
+        Mesh &mesh = r.meshes[primitives[i].first];
+        ImportPrimitive(mesh, mesh.primitives[primitives[i].second], meshes[i].get());
+    });
+
     CopyVector(meshes, mScene->mMeshes, mScene->mNumMeshes);
 }
 
@@ -46,6 +46,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "FileSystemFilter.h"
 #include "Importer.h"
 #include <assimp/BaseImporter.h>
+#include <assimp/BatchImporter.hpp>
 #include <assimp/ByteSwapper.h>
 #include <assimp/ParsingUtils.h>
 #include <assimp/importerdesc.h>
@@ -54,17 +55,22 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/Importer.hpp>
 
 #include <cctype>
+#include <future>
 #include <ios>
 #include <list>
 #include <memory>
 #include <sstream>
+#include <vector>
 
 using namespace Assimp;
 
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 BaseImporter::BaseImporter() AI_NO_EXCEPT
-        : m_progress() {
+        : m_progress(),
+          m_profiler(),
+          m_threadPool(),
+          m_poolFaceIndices(false) {
     /**
     * Assimp Importer
     * unit conversions available
@@ -498,24 +504,16 @@ struct LoadRequest {
 // ------------------------------------------------------------------------------------------------
 // BatchLoader::pimpl data structure
 struct Assimp::BatchData {
-    BatchData(IOSystem *pIO, bool validate) :
-            pIOSystem(pIO), pImporter(nullptr), next_id(0xffff), validate(validate) {
+    BatchData(IOSystem *pIO, bool validate, ThreadPool *pool) :
+            pIOSystem(pIO), pThreadPool(pool), next_id(0xffff), validate(validate) {
         ai_assert(nullptr != pIO);
-
-        pImporter = new Importer();
-        pImporter->SetIOHandler(pIO);
-    }
-
-    ~BatchData() {
-        pImporter->SetIOHandler(nullptr); /* get pointer back into our possession */
-        delete pImporter;
     }
 
     // IO system to be used for all imports
     IOSystem *pIOSystem;
 
-    // Importer used to load all meshes
-    Importer *pImporter;
+    // Thread pool to load the files on, may be nullptr
+    ThreadPool *pThreadPool;
 
     // List of all imports
     std::list<LoadRequest> requests;
@@ -533,10 +531,10 @@ struct Assimp::BatchData {
 typedef std::list<LoadRequest>::iterator LoadReqIt;
 
 // ------------------------------------------------------------------------------------------------
-BatchLoader::BatchLoader(IOSystem *pIO, bool validate) {
+BatchLoader::BatchLoader(IOSystem *pIO, bool validate, ThreadPool *pool) {
     ai_assert(nullptr != pIO);
 
-    m_data = new BatchData(pIO, validate);
+    m_data = new BatchData(pIO, validate, pool);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -601,8 +599,13 @@ aiScene *BatchLoader::GetImport(unsigned int which) {
 
 // ------------------------------------------------------------------------------------------------
 void BatchLoader::LoadAll() {
-    // no threaded implementation for the moment
+    BatchImporter importer(m_data->pThreadPool, m_data->pIOSystem);
+    std::vector<std::pair<LoadRequest *, std::future<aiScene *>>> results;
     for (LoadReqIt it = m_data->requests.begin(); it != m_data->requests.end(); ++it) {
+        if ((*it).loaded) {
+            continue;
+        }
+
         // force validation in debug builds
         unsigned int pp = (*it).flags;
         if (m_data->validate) {
@@ -610,20 +613,24 @@ void BatchLoader::LoadAll() {
         }
 
         // setup config properties if necessary
-        ImporterPimpl *pimpl = m_data->pImporter->Pimpl();
-        pimpl->mFloatProperties = (*it).map.floats;
-        pimpl->mIntProperties = (*it).map.ints;
-        pimpl->mStringProperties = (*it).map.strings;
-        pimpl->mMatrixProperties = (*it).map.matrices;
-
-        if (!DefaultLogger::isNullLogger()) {
-            ASSIMP_LOG_INFO("%%% BEGIN EXTERNAL FILE %%%");
-            ASSIMP_LOG_INFO_F("File: ", (*it).file);
-        }
-        m_data->pImporter->ReadFile((*it).file, pp);
-        (*it).scene = m_data->pImporter->GetOrphanedScene();
-        (*it).loaded = true;
+        ImportRequest request((*it).file, pp);
+        request.mFloatProperties = (*it).map.floats;
+        request.mIntProperties = (*it).map.ints;
+        request.mStringProperties = (*it).map.strings;
+        request.mMatrixProperties = (*it).map.matrices;
+
+        ASSIMP_LOG_INFO_F("Loading external file ", (*it).file);
+        results.emplace_back(&*it, importer.AddRequest(request));
+    }
 
-        ASSIMP_LOG_INFO("%%% END EXTERNAL FILE %%%");
+    importer.ImportAll();
+
+    for (auto &result : results) {
+        try {
+            result.first->scene = result.second.get();
+        } catch (const std::exception &e) {
+            ASSIMP_LOG_WARN_F("Unable to load external file ", result.first->file, ": ", e.what());
+        }
+        result.first->loaded = true;
     }
 }
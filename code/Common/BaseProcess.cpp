@@ -43,9 +43,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "BaseProcess.h"
 #include "Importer.h"
+#include "ThreadPool.h"
 #include <assimp/BaseImporter.h>
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
+#include <assimp/Profiler.h>
 
 using namespace Assimp;
 
@@ -53,7 +55,9 @@ using namespace Assimp;
 // Constructor to be privately used by Importer
 BaseProcess::BaseProcess() AI_NO_EXCEPT
         : shared(),
-          progress() {
+          progress(),
+          threadPool(),
+          meshProfiler() {
     // empty
 }
 
@@ -71,6 +75,9 @@ void BaseProcess::ExecuteOnScene(Importer *pImp) {
     progress = pImp->GetProgressHandler();
     ai_assert(nullptr != progress);
 
+    threadPool = pImp->Pimpl()->mThreadPool;
+    meshProfiler = pImp->GetPropertyBool(AI_CONFIG_GLOB_MEASURE_TIME_PER_MESH, false) ? pImp->Pimpl()->mProfiler : nullptr;
+
     SetupProperties(pImp);
 
     // catch exceptions thrown inside the PostProcess-Step
@@ -89,11 +96,31 @@ void BaseProcess::ExecuteOnScene(Importer *pImp) {
     }
 }
 
+// ------------------------------------------------------------------------------------------------
+void BaseProcess::ForEachMesh(unsigned int numMeshes, const std::function<void(unsigned int)> &fn) {
+    if (nullptr == meshProfiler) {
+        ParallelFor(threadPool, numMeshes, fn);
+        return;
+    }
+
+    using Profiling::Profiler;
+    ParallelFor(threadPool, numMeshes, [this, &fn](unsigned int i) {
+        const Profiler::Clock::time_point start = Profiler::Clock::now();
+        fn(i);
+        meshProfiler->AddRegion(Formatter::format("mesh ") << i, start, Profiler::Clock::now());
+    });
+}
+
 // ------------------------------------------------------------------------------------------------
 void BaseProcess::SetupProperties(const Importer * /*pImp*/) {
     // the default implementation does nothing
 }
 
+// ------------------------------------------------------------------------------------------------
+bool BaseProcess::IsEnabled(unsigned int pFlags, const Importer * /*pImp*/) const {
+    return IsActive(pFlags);
+}
+
 // ------------------------------------------------------------------------------------------------
 bool BaseProcess::RequireVerboseFormat() const {
     return true;
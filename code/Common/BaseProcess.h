@@ -45,6 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/GenericProperty.h>
 
+#include <functional>
 #include <map>
 
 struct aiScene;
@@ -52,6 +53,10 @@ struct aiScene;
 namespace Assimp {
 
 class Importer;
+class ThreadPool;
+namespace Profiling {
+class Profiler;
+}
 
 // ---------------------------------------------------------------------------
 /** Helper class to allow post-processing steps to interact with each other.
@@ -194,6 +199,16 @@ public:
     */
     virtual bool IsActive(unsigned int pFlags) const = 0;
 
+    // -------------------------------------------------------------------
+    /** Returns whether the step is to be executed by the given importer.
+     * The default implementation forwards to IsActive(). Steps which have
+     * no #aiPostProcessSteps flag of their own (all bits are in use) are
+     * enabled by a property instead and override this.
+     * @param pFlags The processing flags the importer was called with.
+     * @param pImp Importer instance which runs the step.
+     */
+    virtual bool IsEnabled(unsigned int pFlags, const Importer *pImp) const;
+
     // -------------------------------------------------------------------
     /** Check whether this step expects its input vertex data to be
      *  in verbose format. */
@@ -239,11 +254,26 @@ public:
     }
 
 protected:
+    // -------------------------------------------------------------------
+    /** Calls fn(i) for each of the numMeshes meshes of the scene.
+     * The meshes are spread across the thread pool if there is one, thus
+     * fn must not touch any other mesh than the i-th one. Each call is
+     * timed on its own if #AI_CONFIG_GLOB_MEASURE_TIME_PER_MESH is set.
+     */
+    void ForEachMesh(unsigned int numMeshes, const std::function<void(unsigned int)> &fn);
+
     /** See the doc of #SharedPostProcessInfo for more details */
     SharedPostProcessInfo *shared;
 
     /** Currently active progress handler */
     ProgressHandler *progress;
+
+    /** Worker threads for per-mesh work, nullptr if the step has to run
+     *  serially. See #AI_CONFIG_GLOB_NUM_THREADS. */
+    ThreadPool *threadPool;
+
+    /** Profiler to record per-mesh timings into, nullptr if disabled */
+    Profiling::Profiler *meshProfiler;
 };
 
 } // end of namespace Assimp
@@ -0,0 +1,220 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+/** @file BatchImporter.cpp
+ *  @brief Implementation of the concurrent multi-file import
+ */
+
+#include "Common/Importer.h"
+#include "Common/ThreadPool.h"
+
+#include <assimp/BatchImporter.hpp>
+#include <assimp/Exceptional.h>
+#include <assimp/GenericProperty.h>
+#include <assimp/Importer.hpp>
+#include <assimp/config.h>
+
+#include <mutex>
+#include <vector>
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+ImportRequest::ImportRequest(const std::string &file, unsigned int flags) :
+        mFile(file),
+        mFlags(flags),
+        mIntProperties(),
+        mFloatProperties(),
+        mStringProperties(),
+        mMatrixProperties() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ImportRequest::SetPropertyInteger(const char *szName, int iValue) {
+    return SetGenericProperty<int>(mIntProperties, szName, iValue);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ImportRequest::SetPropertyFloat(const char *szName, ai_real fValue) {
+    return SetGenericProperty<ai_real>(mFloatProperties, szName, fValue);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ImportRequest::SetPropertyString(const char *szName, const std::string &sValue) {
+    return SetGenericProperty<std::string>(mStringProperties, szName, sValue);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ImportRequest::SetPropertyMatrix(const char *szName, const aiMatrix4x4 &sValue) {
+    return SetGenericProperty<aiMatrix4x4>(mMatrixProperties, szName, sValue);
+}
+
+// ------------------------------------------------------------------------------------------------
+// BatchImporter::pimpl data structure
+struct BatchImporterData {
+    struct Job {
+        ImportRequest request;
+        std::promise<aiScene *> result;
+    };
+
+    BatchImporterData(ThreadPool *pool, bool ownsPool, IOSystem *io) :
+            mPool(pool), mOwnsPool(ownsPool), mIOHandler(io) {
+        // empty
+    }
+
+    ~BatchImporterData() {
+        for (Importer *importer : mIdle) {
+            importer->Pimpl()->mThreadPool = nullptr;
+            if (nullptr != mIOHandler) {
+                importer->SetIOHandler(nullptr);
+            }
+            delete importer;
+        }
+        if (mOwnsPool) {
+            delete mPool;
+        }
+    }
+
+    // Get an importer which is not in use. A thread may hold several of them, as a worker which
+    // waits for a nested import can run another request in the meantime.
+    Importer *Acquire() {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (!mIdle.empty()) {
+                Importer *importer = mIdle.back();
+                mIdle.pop_back();
+                return importer;
+            }
+        }
+
+        Importer *importer = new Importer();
+        if (nullptr != mIOHandler) {
+            importer->SetIOHandler(mIOHandler);
+        }
+        return importer;
+    }
+
+    void Release(Importer *importer) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mIdle.push_back(importer);
+    }
+
+    void Import(Job &job) {
+        Importer *importer = Acquire();
+
+        ImporterPimpl *pimpl = importer->Pimpl();
+        pimpl->mIntProperties = job.request.mIntProperties;
+        pimpl->mFloatProperties = job.request.mFloatProperties;
+        pimpl->mStringProperties = job.request.mStringProperties;
+        pimpl->mMatrixProperties = job.request.mMatrixProperties;
+
+        // share the batch pool instead of letting each importer start its own
+        pimpl->mThreadPool = mPool;
+        SetGenericProperty<int>(pimpl->mIntProperties, AI_CONFIG_GLOB_NUM_THREADS,
+                nullptr != mPool ? static_cast<int>(mPool->GetNumThreads()) : 1);
+
+        try {
+            if (nullptr == importer->ReadFile(job.request.mFile, job.request.mFlags)) {
+                throw DeadlyImportError(importer->GetErrorString());
+            }
+            job.result.set_value(importer->GetOrphanedScene());
+        } catch (...) {
+            importer->FreeScene();
+            job.result.set_exception(std::current_exception());
+        }
+        Release(importer);
+    }
+
+    ThreadPool *mPool;
+    bool mOwnsPool;
+    IOSystem *mIOHandler;
+
+    std::vector<Job> mJobs;
+
+    std::mutex mMutex;
+    std::vector<Importer *> mIdle;
+};
+
+// ------------------------------------------------------------------------------------------------
+BatchImporter::BatchImporter(unsigned int numThreads, IOSystem *pIOHandler) {
+    if (0 == numThreads) {
+        numThreads = ThreadPool::GetHardwareConcurrency();
+    }
+    ThreadPool *pool = numThreads > 1 ? new ThreadPool(numThreads) : nullptr;
+    mData = new BatchImporterData(pool, true, pIOHandler);
+}
+
+// ------------------------------------------------------------------------------------------------
+BatchImporter::BatchImporter(ThreadPool *pool, IOSystem *pIOHandler) {
+    mData = new BatchImporterData(pool, false, pIOHandler);
+}
+
+// ------------------------------------------------------------------------------------------------
+BatchImporter::~BatchImporter() {
+    // requests which were never imported leave their futures with a broken promise
+    delete mData;
+}
+
+// ------------------------------------------------------------------------------------------------
+std::future<aiScene *> BatchImporter::AddRequest(const ImportRequest &request) {
+    mData->mJobs.emplace_back();
+    BatchImporterData::Job &job = mData->mJobs.back();
+    job.request = request;
+    return job.result.get_future();
+}
+
+// ------------------------------------------------------------------------------------------------
+void BatchImporter::ImportAll() {
+    std::vector<BatchImporterData::Job> jobs;
+    jobs.swap(mData->mJobs);
+
+    ParallelFor(mData->mPool, static_cast<unsigned int>(jobs.size()), [&](unsigned int i) {
+        mData->Import(jobs[i]);
+    });
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t BatchImporter::GetNumPendingRequests() const {
+    return mData->mJobs.size();
+}
+
+} // namespace Assimp
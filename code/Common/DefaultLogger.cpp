@@ -62,6 +62,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <mutex>
 #include <thread>
 std::mutex loggerMutex;
+
+// Post-processing steps may log from several worker threads at once,
+// see AI_CONFIG_GLOB_NUM_THREADS.
+static std::mutex streamMutex;
 #endif
 
 namespace Assimp {
@@ -388,6 +392,9 @@ DefaultLogger::~DefaultLogger() {
 //  Writes message to stream
 void DefaultLogger::WriteToStreams(const char *message, ErrorSeverity ErrorSev) {
     ai_assert(nullptr != message);
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    std::lock_guard<std::mutex> lock(streamMutex);
+#endif
 
     // Check whether this is a repeated message
     if (!::strncmp(message, lastMsg, lastLen - 1)) {
@@ -118,6 +118,9 @@ void ExportSceneGLB2(const char*, IOSystem*, const aiScene*, const ExportPropert
 #ifndef ASSIMP_BUILD_NO_ASSBIN_EXPORTER
 void ExportSceneAssbin(const char*, IOSystem*, const aiScene*, const ExportProperties*);
 #endif
+#ifndef ASSIMP_BUILD_NO_SCENEIMAGE_EXPORTER
+void ExportSceneImage(const char*, IOSystem*, const aiScene*, const ExportProperties*);
+#endif
 #ifndef ASSIMP_BUILD_NO_ASSXML_EXPORTER
 void ExportSceneAssxml(const char*, IOSystem*, const aiScene*, const ExportProperties*);
 #endif
@@ -199,6 +202,10 @@ static void setupExporterArray(std::vector<Exporter::ExportFormatEntry> &exporte
 	exporters.push_back(Exporter::ExportFormatEntry("assbin", "Assimp Binary File", "assbin", &ExportSceneAssbin, 0));
 #endif
 
+#ifndef ASSIMP_BUILD_NO_SCENEIMAGE_EXPORTER
+	exporters.push_back(Exporter::ExportFormatEntry("assimg", "Assimp Scene Image", "assimg", &ExportSceneImage, 0));
+#endif
+
 #ifndef ASSIMP_BUILD_NO_ASSXML_EXPORTER
 	exporters.push_back(Exporter::ExportFormatEntry("assxml", "Assimp XML Document", "assxml", &ExportSceneAssxml, 0));
 #endif
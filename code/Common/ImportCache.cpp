@@ -0,0 +1,478 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+/** @file ImportCache.cpp
+ *  @brief Implementation of the import cache
+ *
+ *  A cache entry consists of two files named after a 64 bit key:
+ *  - <key>.deps names the scene image and lists every other file the import
+ *    opened, each with a digest of its size and contents;
+ *  - <key>-<digest>.assimg is the scene image (see SceneImage.h), where the
+ *    digest combines the ones of all listed files.
+ *  The image is written before the list, both to a temporary file first which
+ *  is renamed then, so several processes may share one cache directory and a
+ *  list never names an image made from other files.
+ */
+
+#include "Common/ImportCache.h"
+#include "Common/Importer.h"
+#include "AssetLib/SceneImage/SceneImageExporter.h"
+#include "AssetLib/SceneImage/SceneImageImporter.h"
+
+#include <assimp/DefaultIOSystem.h>
+#include <assimp/DefaultLogger.hpp>
+#include <assimp/Hash.h>
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
+#include <assimp/StringUtils.h>
+#include <assimp/config.h>
+#include <assimp/scene.h>
+#include <assimp/version.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace Assimp {
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// FNV-1a over 64 bit words, with a shift to carry the upper bits down again
+class KeyHash {
+public:
+    KeyHash() :
+            mHash(14695981039346656037ull) {
+        // empty
+    }
+
+    void Add(const void *data, size_t size) {
+        const uint8_t *bytes = static_cast<const uint8_t *>(data);
+        for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t), bytes += sizeof(uint64_t)) {
+            uint64_t word;
+            ::memcpy(&word, bytes, sizeof(word));
+            Mix(word);
+        }
+        uint64_t tail = size;
+        ::memcpy(&tail, bytes, size);
+        Mix(tail ^ (static_cast<uint64_t>(size) << 56));
+    }
+
+    template <class T>
+    void AddValue(const T &value) {
+        Add(&value, sizeof(T));
+    }
+
+    void AddString(const std::string &str) {
+        AddValue(static_cast<uint64_t>(str.size()));
+        Add(str.data(), str.size());
+    }
+
+    uint64_t Get() const {
+        return mHash;
+    }
+
+private:
+    void Mix(uint64_t word) {
+        mHash = (mHash ^ word) * 1099511628211ull;
+        mHash ^= mHash >> 32;
+    }
+
+    uint64_t mHash;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Properties which are set by the import itself or don't change its result
+bool IsIgnoredProperty(uint32_t key) {
+    static const uint32_t ignored[] = {
+        SuperFastHash("importerIndex"),
+        SuperFastHash("sourceFilePath"),
+        SuperFastHash(AI_CONFIG_APP_SCALE_KEY),
+        SuperFastHash(AI_CONFIG_GLOB_NUM_THREADS),
+        SuperFastHash(AI_CONFIG_GLOB_MEASURE_TIME),
+        SuperFastHash(AI_CONFIG_GLOB_MEASURE_TIME_PER_MESH),
+        SuperFastHash(AI_CONFIG_GLOB_IMPORT_CACHE_DIR),
+        SuperFastHash(AI_CONFIG_GLOB_SCENE_IMAGE_IN_PLACE)
+    };
+    return std::find(std::begin(ignored), std::end(ignored), key) != std::end(ignored);
+}
+
+// ------------------------------------------------------------------------------------------------
+template <class TMap, class TAdd>
+void AddProperties(KeyHash &hash, const TMap &properties, TAdd add) {
+    // std::map iterates in key order, so equal settings give equal keys
+    uint64_t count = 0;
+    for (const auto &property : properties) {
+        if (!IsIgnoredProperty(property.first)) {
+            hash.AddValue(property.first);
+            add(property.second);
+            ++count;
+        }
+    }
+    hash.AddValue(count);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool AddFileContents(KeyHash &hash, IOSystem *io, const std::string &file) {
+    IOStream *stream = io->Open(file, "rb");
+    if (nullptr == stream) {
+        return false;
+    }
+
+    const size_t size = stream->FileSize();
+    hash.AddValue(static_cast<uint64_t>(size));
+
+    bool ok = true;
+    if (const void *mapped = stream->GetMappedData()) {
+        hash.Add(mapped, size);
+    } else {
+        std::vector<char> buffer(std::min<size_t>(size, 1 << 20));
+        for (size_t remaining = size; remaining > 0;) {
+            const size_t read = stream->Read(buffer.data(), 1, std::min(remaining, buffer.size()));
+            if (0 == read) {
+                ok = false;
+                break;
+            }
+            hash.Add(buffer.data(), read);
+            remaining -= read;
+        }
+    }
+    io->Close(stream);
+    return ok;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Digest of a file the import depended on, files which cannot be read get a fixed value
+uint64_t GetFileDigest(IOSystem *io, const std::string &file) {
+    KeyHash hash;
+    return AddFileContents(hash, io, file) ? hash.Get() : ~0ull;
+}
+
+// ------------------------------------------------------------------------------------------------
+std::string GetImageName(const std::string &cacheKey, uint64_t digest) {
+    char name[32];
+    ai_snprintf(name, sizeof(name), "-%016llx.assimg", static_cast<unsigned long long>(digest));
+
+    const std::string::size_type sep = cacheKey.find_last_of("/\\");
+    return (std::string::npos != sep ? cacheKey.substr(sep + 1) : cacheKey) + name;
+}
+
+// ------------------------------------------------------------------------------------------------
+std::string GetTempFile(const std::string &file) {
+    // unique per thread and call, so concurrent writers never share a temporary file
+    const size_t unique = std::hash<std::thread::id>()(std::this_thread::get_id()) ^
+                          static_cast<size_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    return file + "." + to_string(unique) + ".tmp";
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ReadText(DefaultIOSystem &io, const std::string &file, std::string &text) {
+    std::unique_ptr<IOStream> stream(io.Open(file.c_str(), "rb"));
+    if (!stream) {
+        return false;
+    }
+    text.resize(stream->FileSize());
+    return text.empty() || stream->Read(&text[0], text.size(), 1) == 1;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool WriteText(DefaultIOSystem &io, const std::string &file, const std::string &text) {
+    std::unique_ptr<IOStream> stream(io.Open(file.c_str(), "wb"));
+    return stream && (text.empty() || stream->Write(text.data(), text.size(), 1) == 1);
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+std::string GetImportCacheKey(const ImporterPimpl *pimpl, const std::string &cacheDir,
+        const std::string &file, unsigned int flags) {
+    ai_assert(nullptr != pimpl);
+
+    KeyHash hash;
+    if (!AddFileContents(hash, pimpl->mIOHandler, file)) {
+        return std::string();
+    }
+
+    // the extension selects the importer, and with it the interpretation of the contents
+    const std::string::size_type dot = file.find_last_of('.');
+    std::string extension = std::string::npos != dot ? file.substr(dot + 1) : std::string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    hash.AddString(extension);
+    hash.AddValue(flags);
+
+    AddProperties(hash, pimpl->mIntProperties, [&](int value) { hash.AddValue(value); });
+    AddProperties(hash, pimpl->mFloatProperties, [&](ai_real value) { hash.AddValue(value); });
+    AddProperties(hash, pimpl->mStringProperties, [&](const std::string &value) { hash.AddString(value); });
+    AddProperties(hash, pimpl->mMatrixProperties, [&](const aiMatrix4x4 &value) { hash.AddValue(value); });
+
+    // a different library may import differently
+    hash.AddValue(aiGetVersionMajor());
+    hash.AddValue(aiGetVersionMinor());
+    hash.AddValue(aiGetVersionPatch());
+    hash.AddValue(aiGetVersionRevision());
+    hash.AddValue(aiGetCompileFlags());
+
+    char name[32];
+    ai_snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(hash.Get()));
+
+    std::string path = cacheDir;
+    if ('/' != path.back() && '\\' != path.back()) {
+        path += '/';
+    }
+    return path + name;
+}
+
+// ------------------------------------------------------------------------------------------------
+aiScene *ReadImportCache(Importer *pImp, IOSystem *io, const std::string &cacheKey) {
+#ifndef ASSIMP_BUILD_NO_SCENEIMAGE_IMPORTER
+    ai_assert(nullptr != io);
+
+    DefaultIOSystem cacheIO;
+    std::string deps;
+    if (!ReadText(cacheIO, cacheKey + ".deps", deps)) {
+        return nullptr;
+    }
+
+    // first line: the image, then one "<digest> <path>" line per file
+    std::string::size_type end = deps.find('\n');
+    if (std::string::npos == end) {
+        ASSIMP_LOG_WARN("Ignoring unusable import cache entry " + cacheKey);
+        return nullptr;
+    }
+    const std::string image = deps.substr(0, end);
+
+    KeyHash digests;
+    for (std::string::size_type begin = end + 1; begin < deps.size(); begin = end + 1) {
+        end = deps.find('\n', begin);
+        if (std::string::npos == end || end - begin < 18 || ' ' != deps[begin + 16]) {
+            ASSIMP_LOG_WARN("Ignoring unusable import cache entry " + cacheKey);
+            return nullptr;
+        }
+        const uint64_t stored = std::strtoull(deps.substr(begin, 16).c_str(), nullptr, 16);
+        const std::string file = deps.substr(begin + 17, end - begin - 17);
+        const uint64_t digest = GetFileDigest(io, file);
+        if (digest != stored) {
+            ASSIMP_LOG_DEBUG_F("Import cache entry ", cacheKey, " is outdated, ", file, " has changed");
+            return nullptr;
+        }
+        digests.AddString(file);
+        digests.AddValue(digest);
+    }
+
+    // the list names the image it was written for
+    const std::string::size_type sep = cacheKey.find_last_of("/\\");
+    const std::string cacheFile = cacheKey.substr(0, std::string::npos != sep ? sep + 1 : 0) + image;
+    if (image != GetImageName(cacheKey, digests.Get()) || !cacheIO.Exists(cacheFile.c_str())) {
+        ASSIMP_LOG_WARN("Ignoring unusable import cache entry " + cacheKey);
+        return nullptr;
+    }
+
+    SceneImageImporter importer;
+    aiScene *scene = importer.ReadFile(pImp, cacheFile, &cacheIO);
+    if (nullptr == scene) {
+        ASSIMP_LOG_WARN("Ignoring unusable import cache entry " + cacheFile);
+    }
+    return scene;
+#else
+    (void)pImp;
+    (void)io;
+    (void)cacheKey;
+    return nullptr;
+#endif // ASSIMP_BUILD_NO_SCENEIMAGE_IMPORTER
+}
+
+// ------------------------------------------------------------------------------------------------
+void WriteImportCache(IOSystem *io, const std::string &cacheKey,
+        const std::vector<std::string> &dependencies, const aiScene *scene) {
+#if !defined ASSIMP_BUILD_NO_EXPORT && !defined ASSIMP_BUILD_NO_SCENEIMAGE_EXPORTER
+    ai_assert(nullptr != io);
+    ai_assert(nullptr != scene);
+
+    // digest the files as they are now, a change during the import only costs a miss later
+    KeyHash digests;
+    std::string list;
+    for (const std::string &file : dependencies) {
+        if (std::string::npos != file.find_first_of("\r\n")) {
+            ASSIMP_LOG_WARN("Not caching import, unable to record dependency " + file);
+            return;
+        }
+        const uint64_t digest = GetFileDigest(io, file);
+        digests.AddString(file);
+        digests.AddValue(digest);
+
+        char line[32];
+        ai_snprintf(line, sizeof(line), "%016llx ", static_cast<unsigned long long>(digest));
+        list += line + file + '\n';
+    }
+
+    const std::string image = GetImageName(cacheKey, digests.Get());
+    const std::string::size_type sep = cacheKey.find_last_of("/\\");
+    const std::string cacheFile = cacheKey.substr(0, std::string::npos != sep ? sep + 1 : 0) + image;
+
+    DefaultIOSystem cacheIO;
+    std::string tempFile = GetTempFile(cacheFile);
+    try {
+        ExportSceneImage(tempFile.c_str(), &cacheIO, scene, nullptr);
+    } catch (const std::exception &e) {
+        ASSIMP_LOG_WARN(std::string("Unable to write import cache entry: ") + e.what());
+        std::remove(tempFile.c_str());
+        return;
+    }
+
+    // if another process stored the same image meanwhile, keep that one
+    if (0 != std::rename(tempFile.c_str(), cacheFile.c_str())) {
+        std::remove(tempFile.c_str());
+    }
+
+    // the image exists now, so the list may name it
+    const std::string depsFile = cacheKey + ".deps";
+    tempFile = GetTempFile(depsFile);
+    if (!WriteText(cacheIO, tempFile, image + '\n' + list)) {
+        ASSIMP_LOG_WARN("Unable to write import cache entry " + depsFile);
+        std::remove(tempFile.c_str());
+        return;
+    }
+    if (0 != std::rename(tempFile.c_str(), depsFile.c_str())) {
+        // Windows does not replace existing files
+        std::remove(depsFile.c_str());
+        if (0 != std::rename(tempFile.c_str(), depsFile.c_str())) {
+            std::remove(tempFile.c_str());
+        }
+    }
+#else
+    (void)io;
+    (void)cacheKey;
+    (void)dependencies;
+    (void)scene;
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+ImportCacheRecorder::ImportCacheRecorder(IOSystem *io, const std::string &file) :
+        mWrapped(io), mFile(file) {
+    ai_assert(nullptr != mWrapped);
+}
+
+// ------------------------------------------------------------------------------------------------
+ImportCacheRecorder::~ImportCacheRecorder() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ImportCacheRecorder::Exists(const char *pFile) const {
+    return mWrapped->Exists(pFile);
+}
+
+// ------------------------------------------------------------------------------------------------
+char ImportCacheRecorder::getOsSeparator() const {
+    return mWrapped->getOsSeparator();
+}
+
+// ------------------------------------------------------------------------------------------------
+IOStream *ImportCacheRecorder::Open(const char *pFile, const char *pMode) {
+    ai_assert(nullptr != pFile);
+    ai_assert(nullptr != pMode);
+
+    // failed opens count too, the file may appear later and change the result
+    if (mFile != pFile && nullptr == ::strchr(pMode, 'w')) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mFiles.insert(pFile);
+    }
+    return mWrapped->Open(pFile, pMode);
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImportCacheRecorder::Close(IOStream *pFile) {
+    mWrapped->Close(pFile);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ImportCacheRecorder::ComparePaths(const char *one, const char *second) const {
+    return mWrapped->ComparePaths(one, second);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ImportCacheRecorder::PushDirectory(const std::string &path) {
+    return mWrapped->PushDirectory(path);
+}
+
+// ------------------------------------------------------------------------------------------------
+const std::string &ImportCacheRecorder::CurrentDirectory() const {
+    return mWrapped->CurrentDirectory();
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t ImportCacheRecorder::StackSize() const {
+    return mWrapped->StackSize();
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ImportCacheRecorder::PopDirectory() {
+    return mWrapped->PopDirectory();
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ImportCacheRecorder::CreateDirectory(const std::string &path) {
+    return mWrapped->CreateDirectory(path);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ImportCacheRecorder::ChangeDirectory(const std::string &path) {
+    return mWrapped->ChangeDirectory(path);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ImportCacheRecorder::DeleteFile(const std::string &file) {
+    return mWrapped->DeleteFile(file);
+}
+
+// ------------------------------------------------------------------------------------------------
+std::vector<std::string> ImportCacheRecorder::GetFiles() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return std::vector<std::string>(mFiles.begin(), mFiles.end());
+}
+
+} // namespace Assimp
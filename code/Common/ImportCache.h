@@ -0,0 +1,125 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file ImportCache.h
+ *  @brief On-disk cache of imported and post-processed scenes, see AI_CONFIG_GLOB_IMPORT_CACHE_DIR
+ */
+#pragma once
+#ifndef AI_IMPORTCACHE_H_INC
+#define AI_IMPORTCACHE_H_INC
+
+#include <assimp/defs.h>
+#include <assimp/IOSystem.hpp>
+
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+struct aiScene;
+
+namespace Assimp {
+
+class Importer;
+class ImporterPimpl;
+
+// ---------------------------------------------------------------------------
+/** Compute the key of an import.
+ *
+ *  The key covers the contents of the file, its extension, the post-processing
+ *  flags, all properties which may change the result and the library version.
+ *  Files opened by the import itself (materials, buffers, textures) are listed
+ *  in the cache entry and checked when it is read, see ImportCacheRecorder.
+ *  @return The path of the cache entry without extension, empty if the file
+ *    cannot be read */
+std::string ASSIMP_API GetImportCacheKey(const ImporterPimpl *pimpl, const std::string &cacheDir,
+                                         const std::string &file, unsigned int flags);
+
+// ---------------------------------------------------------------------------
+/** Load a cached scene.
+ *  @param io IOSystem to read the files the import depended on
+ *  @return nullptr if there is no entry or one of these files has changed */
+aiScene ASSIMP_API *ReadImportCache(Importer *pImp, IOSystem *io, const std::string &cacheKey);
+
+// ---------------------------------------------------------------------------
+/** Store a scene in the cache together with the files the import opened.
+ *  Failures are logged and otherwise ignored. */
+void ASSIMP_API WriteImportCache(IOSystem *io, const std::string &cacheKey,
+                                 const std::vector<std::string> &dependencies, const aiScene *scene);
+
+// ---------------------------------------------------------------------------
+/** IOSystem which forwards to another one and records the path of every file
+ *  opened through it, including the ones which could not be opened. An import
+ *  runs through it while the cache is enabled. */
+class ASSIMP_API ImportCacheRecorder : public IOSystem {
+public:
+    /** @param io The wrapped IOSystem
+     *  @param file The imported file, which is covered by the key already */
+    ImportCacheRecorder(IOSystem *io, const std::string &file);
+    ~ImportCacheRecorder();
+
+    bool Exists(const char *pFile) const;
+    char getOsSeparator() const;
+    IOStream *Open(const char *pFile, const char *pMode = "rb");
+    void Close(IOStream *pFile);
+    bool ComparePaths(const char *one, const char *second) const;
+    bool PushDirectory(const std::string &path);
+    const std::string &CurrentDirectory() const;
+    size_t StackSize() const;
+    bool PopDirectory();
+    bool CreateDirectory(const std::string &path);
+    bool ChangeDirectory(const std::string &path);
+    bool DeleteFile(const std::string &file);
+
+    /** The recorded paths, sorted */
+    std::vector<std::string> GetFiles() const;
+
+private:
+    IOSystem *mWrapped;
+    std::string mFile;
+    mutable std::mutex mMutex;
+    std::set<std::string> mFiles;
+};
+
+} // namespace Assimp
+
+#endif // AI_IMPORTCACHE_H_INC
@@ -63,24 +63,32 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // Internal headers
 // ------------------------------------------------------------------------------------------------
 #include "Common/Importer.h"
+#include "Common/ImportCache.h"
 #include "Common/BaseProcess.h"
 #include "Common/DefaultProgressHandler.h"
 #include "PostProcessing/ProcessHelper.h"
 #include "Common/ScenePreprocessor.h"
 #include "Common/ScenePrivate.h"
+#include "Common/ThreadPool.h"
 
 #include <assimp/BaseImporter.h>
 #include <assimp/GenericProperty.h>
 #include <assimp/MemoryIOWrapper.h>
+#include <assimp/SceneCombiner.h>
 #include <assimp/Profiler.h>
 #include <assimp/TinyFormatter.h>
 #include <assimp/Exceptional.h>
-#include <assimp/Profiler.h>
 #include <assimp/commonMetaData.h>
 
 #include <set>
 #include <memory>
 #include <cctype>
+#include <typeinfo>
+
+#ifdef __GNUC__
+#   include <cxxabi.h>
+#   include <cstdlib>
+#endif
 
 #include <assimp/DefaultIOStream.h>
 #include <assimp/DefaultIOSystem.h>
@@ -104,6 +112,164 @@ namespace Assimp {
 using namespace Assimp;
 using namespace Assimp::Intern;
 
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Close a region with the number of bytes held by the current scene. Walking
+// the scene is expensive, so it is only done while a profiler records.
+void EndRegion(ScopedRegion &region, const Importer *pImp) {
+    if (region.IsOpen()) {
+        aiMemoryInfo info;
+        pImp->GetMemoryRequirements(info);
+        region.End(info.total);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Create the worker threads as configured, 1 means no threading at all
+ThreadPool *SetupThreadPool(Importer *pImp) {
+    ImporterPimpl *pimpl = pImp->Pimpl();
+    int numThreads = pImp->GetPropertyInteger(AI_CONFIG_GLOB_NUM_THREADS, 1);
+    if (numThreads <= 0) {
+        numThreads = static_cast<int>(ThreadPool::GetHardwareConcurrency());
+    }
+#ifdef ASSIMP_BUILD_SINGLETHREADED
+    numThreads = 1;
+#endif
+    if (nullptr != pimpl->mThreadPool && pimpl->mThreadPool->GetNumThreads() != static_cast<unsigned int>(numThreads)) {
+        delete pimpl->mThreadPool;
+        pimpl->mThreadPool = nullptr;
+    }
+    if (nullptr == pimpl->mThreadPool && numThreads > 1) {
+        ASSIMP_LOG_DEBUG_F("Using ", numThreads, " worker threads");
+        pimpl->mThreadPool = new ThreadPool(static_cast<unsigned int>(numThreads));
+    }
+    return pimpl->mThreadPool;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Get the profiler of a running ReadFile() call, or start a new profile if the
+// post-processing is invoked on its own
+Profiler *ContinueProfile(Importer *pImp) {
+    ImporterPimpl *pimpl = pImp->Pimpl();
+    if (nullptr != pimpl->mProfiler && pimpl->mProfiler->HasOpenRegions()) {
+        return pimpl->mProfiler;
+    }
+    delete pimpl->mProfiler;
+    pimpl->mProfiler = pImp->GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME, 0) ? new Profiler() : nullptr;
+    return pimpl->mProfiler;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Get a readable name of a post-processing step, i.e. its class name
+std::string GetStepName(const BaseProcess *process) {
+    std::string name = typeid(*process).name();
+#ifdef __GNUC__
+    int status = 0;
+    char *demangled = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+    if (nullptr != demangled) {
+        if (0 == status) {
+            name = demangled;
+        }
+        ::free(demangled);
+    }
+#endif
+    // strip "class " (MSVC) and the namespace
+    const std::string::size_type pos = name.find_last_of(": ");
+    if (pos != std::string::npos) {
+        name = name.substr(pos + 1);
+    }
+    return name;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Route the file accesses of an import through another IOSystem, until restored or destroyed
+class IOHandlerRedirect {
+public:
+    IOHandlerRedirect(ImporterPimpl *pimpl, IOSystem *io) :
+            mPimpl(pimpl), mHandler(pimpl->mIOHandler) {
+        if (nullptr != io) {
+            mPimpl->mIOHandler = io;
+        }
+    }
+
+    ~IOHandlerRedirect() {
+        Restore();
+    }
+
+    void Restore() {
+        mPimpl->mIOHandler = mHandler;
+    }
+
+private:
+    ImporterPimpl *mPimpl;
+    IOSystem *mHandler;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Check whether any post-processing step would run for the given flags
+bool HasEnabledSteps(const Importer *pImp, unsigned int pFlags) {
+    for (const BaseProcess *process : pImp->Pimpl()->mPostProcessingSteps) {
+        if (process->IsEnabled(pFlags, pImp)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Check whether the scene points into a scene image instead of owning its sub-objects
+bool IsSceneImage(const aiScene *scene) {
+    const ScenePrivateData *priv = ScenePriv(scene);
+    return nullptr != priv && priv->mImage;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Post-processing steps reallocate arrays freely, which a scene image does not
+// allow. Replace the contents of such a scene by a deep copy; the aiScene
+// itself stays the same so pointers handed out before remain valid.
+void MaterializeSceneImage(aiScene *scene) {
+    if (!IsSceneImage(scene)) {
+        return;
+    }
+    ASSIMP_LOG_DEBUG("Copying scene image before post-processing");
+
+    aiScene *copy = nullptr;
+    SceneCombiner::CopyScene(&copy, scene);
+
+    // bones are copied flat, point them to the copied nodes
+    for (unsigned int i = 0; i < copy->mNumMeshes; ++i) {
+        const aiMesh *mesh = scene->mMeshes[i];
+        for (unsigned int j = 0; j < copy->mMeshes[i]->mNumBones; ++j) {
+            const aiBone *bone = mesh->mBones[j];
+            aiBone *copied = copy->mMeshes[i]->mBones[j];
+            copied->mArmature = nullptr != bone->mArmature ? copy->mRootNode->FindNode(bone->mArmature->mName) : nullptr;
+            copied->mNode = nullptr != bone->mNode ? copy->mRootNode->FindNode(bone->mNode->mName) : nullptr;
+        }
+    }
+
+    std::swap(scene->mRootNode, copy->mRootNode);
+    std::swap(scene->mNumMeshes, copy->mNumMeshes);
+    std::swap(scene->mMeshes, copy->mMeshes);
+    std::swap(scene->mNumMaterials, copy->mNumMaterials);
+    std::swap(scene->mMaterials, copy->mMaterials);
+    std::swap(scene->mNumAnimations, copy->mNumAnimations);
+    std::swap(scene->mAnimations, copy->mAnimations);
+    std::swap(scene->mNumTextures, copy->mNumTextures);
+    std::swap(scene->mTextures, copy->mTextures);
+    std::swap(scene->mNumLights, copy->mNumLights);
+    std::swap(scene->mLights, copy->mLights);
+    std::swap(scene->mNumCameras, copy->mNumCameras);
+    std::swap(scene->mCameras, copy->mCameras);
+    std::swap(scene->mMetaData, copy->mMetaData);
+
+    // the copy now refers to the image, deleting it releases the image
+    std::swap(ScenePriv(scene)->mImage, ScenePriv(copy)->mImage);
+    delete copy;
+}
+
+} // namespace
+
 // ------------------------------------------------------------------------------------------------
 // Intern::AllocateFromAssimpHeap serves as abstract base class. It overrides
 // new and delete (and their array counterparts) of public API classes (e.g. Logger) to
@@ -192,6 +358,12 @@ Importer::~Importer() {
     // Delete shared post-processing data
     delete pimpl->mPPShared;
 
+    // Delete the profiling data of the last import
+    delete pimpl->mProfiler;
+
+    // Stop the post-processing worker threads
+    delete pimpl->mThreadPool;
+
     // and finally the pimpl itself
     delete pimpl;
 }
@@ -611,10 +783,54 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
             return nullptr;
         }
 
-        std::unique_ptr<Profiler> profiler(GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME, 0) ? new Profiler() : nullptr);
-        if (profiler) {
-            profiler->BeginRegion("total");
+        // Start a new profile, it's kept until the next import, see GetProfiler()
+        delete pimpl->mProfiler;
+        pimpl->mProfiler = GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME, 0) ? new Profiler() : nullptr;
+        Profiler *profiler = pimpl->mProfiler;
+        ScopedRegion totalRegion(profiler, "total");
+
+        // Look for a stored result of the same import
+        std::string cacheKey;
+        const std::string cacheDir = GetPropertyString(AI_CONFIG_GLOB_IMPORT_CACHE_DIR, "");
+        if (!cacheDir.empty()) {
+            ScopedRegion cacheRegion(profiler, "cache");
+            cacheKey = GetImportCacheKey(pimpl, cacheDir, pFile, pFlags);
+            if (!cacheKey.empty()) {
+                pimpl->mScene = ReadImportCache(this, pimpl->mIOHandler, cacheKey);
+            }
+#ifndef ASSIMP_BUILD_NO_VALIDATEDS_PROCESS
+            // a corrupt or outdated entry is never handed out, the file is imported instead
+            if (pimpl->mScene) {
+                ValidateDSProcess ds;
+                ds.ExecuteOnScene(this);
+                if (!pimpl->mScene) {
+                    ASSIMP_LOG_WARN("Ignoring invalid import cache entry " + cacheKey);
+                    pimpl->mErrorString = "";
+                }
+            }
+#endif // no validation
+            EndRegion(cacheRegion, this);
+
+            if (pimpl->mScene) {
+                ASSIMP_LOG_INFO("Loaded import result from cache " + cacheKey);
+                ++pimpl->mCacheHits;
+                ScenePriv(pimpl->mScene)->mPPStepsApplied = pFlags;
+                if (!GetPropertyBool(AI_CONFIG_GLOB_SCENE_IMAGE_IN_PLACE, false)) {
+                    MaterializeSceneImage(pimpl->mScene);
+                }
+                SetPropertyString("sourceFilePath", pFile);
+                EndRegion(totalRegion, this);
+                return pimpl->mScene;
+            }
+            ++pimpl->mCacheMisses;
+        }
+
+        // the files opened by the import and post-processing become part of the cache entry
+        std::unique_ptr<ImportCacheRecorder> cacheRecorder;
+        if (!cacheKey.empty()) {
+            cacheRecorder.reset(new ImportCacheRecorder(pimpl->mIOHandler, pFile));
         }
+        IOHandlerRedirect redirect(pimpl, cacheRecorder.get());
 
         // Find an worker class which can handle the file
         BaseImporter* imp = nullptr;
@@ -667,22 +883,34 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
         ASSIMP_LOG_INFO("Found a matching importer for this file format: " + ext + "." );
         pimpl->mProgressHandler->UpdateFileRead( 0, fileSize );
 
-        if (profiler) {
-            profiler->BeginRegion("import");
-        }
-
+        ScopedRegion importRegion(profiler, "import");
+        const bool poolFaceIndices = GetPropertyBool(AI_CONFIG_GLOB_FACE_INDEX_POOL, false);
+        imp->m_profiler = profiler;
+        imp->m_threadPool = SetupThreadPool(this);
+        imp->m_poolFaceIndices = poolFaceIndices;
         pimpl->mScene = imp->ReadFile( this, pFile, pimpl->mIOHandler);
+        imp->m_profiler = nullptr;
+        imp->m_threadPool = nullptr;
+        imp->m_poolFaceIndices = false;
         pimpl->mProgressHandler->UpdateFileRead( fileSize, fileSize );
-
-        if (profiler) {
-            profiler->EndRegion("import");
-        }
+        EndRegion(importRegion, this);
 
         SetPropertyString("sourceFilePath", pFile);
 
         // If successful, apply all active post processing steps to the imported data
         if( pimpl->mScene)  {
-            if (!pimpl->mScene->mMetaData || !pimpl->mScene->mMetaData->HasKey(AI_METADATA_SOURCE_FORMAT)) {
+            // scene images are stored preprocessed and cannot grow in place
+            const bool isImage = IsSceneImage(pimpl->mScene);
+
+            // meshes of importers which allocate their faces one by one are packed here
+            if (poolFaceIndices && !isImage) {
+                for (unsigned int i = 0; i < pimpl->mScene->mNumMeshes; ++i) {
+                    if (nullptr != pimpl->mScene->mMeshes[i]) {
+                        pimpl->mScene->mMeshes[i]->PackFaceIndices();
+                    }
+                }
+            }
+            if (!isImage && (!pimpl->mScene->mMetaData || !pimpl->mScene->mMetaData->HasKey(AI_METADATA_SOURCE_FORMAT))) {
                 if (!pimpl->mScene->mMetaData) {
                     pimpl->mScene->mMetaData = new aiMetadata;
                 }
@@ -701,19 +929,26 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
 #endif // no validation
 
             // Preprocess the scene and prepare it for post-processing
-            if (profiler) {
-                profiler->BeginRegion("preprocess");
+            {
+                ScopedRegion preprocessRegion(profiler, "preprocess");
+                if (!isImage) {
+                    ScenePreprocessor pre(pimpl->mScene);
+                    pre.ProcessScene();
+                }
             }
 
-            ScenePreprocessor pre(pimpl->mScene);
-            pre.ProcessScene();
+            // Ensure that the validation process won't be called twice
+            ApplyPostProcessing(pFlags & (~aiProcess_ValidateDataStructure));
 
-            if (profiler) {
-                profiler->EndRegion("preprocess");
+            if (pimpl->mScene && cacheRecorder) {
+                redirect.Restore();
+                WriteImportCache(pimpl->mIOHandler, cacheKey, cacheRecorder->GetFiles(), pimpl->mScene);
             }
 
-            // Ensure that the validation process won't be called twice
-            ApplyPostProcessing(pFlags & (~aiProcess_ValidateDataStructure));
+            // callers may edit the scene they get, which an image does not allow
+            if (pimpl->mScene && !GetPropertyBool(AI_CONFIG_GLOB_SCENE_IMAGE_IN_PLACE, false)) {
+                MaterializeSceneImage(pimpl->mScene);
+            }
         }
         // if failed, extract the error string
         else if( !pimpl->mScene) {
@@ -723,10 +958,7 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
 
         // clear any data allocated by post-process steps
         pimpl->mPPShared->Clean();
-
-        if (profiler) {
-            profiler->EndRegion("total");
-        }
+        EndRegion(totalRegion, this);
     }
 #ifdef ASSIMP_CATCH_GLOBAL_EXCEPTIONS
     catch (std::exception &e) {
@@ -760,8 +992,9 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags) {
         return nullptr;
     }
 
-    // If no flags are given, return the current scene with no further action
-    if (!pFlags) {
+    // If no step is enabled, return the current scene with no further action. Some
+    // steps are enabled by a property instead of a flag, see BaseProcess::IsEnabled()
+    if (!pFlags && !HasEnabledSteps(this, pFlags)) {
         return pimpl->mScene;
     }
 
@@ -794,20 +1027,21 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags) {
     }
 #endif // ! DEBUG
 
-    std::unique_ptr<Profiler> profiler(GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME, 0) ? new Profiler() : nullptr);
+    // Setup the worker threads for the per-mesh steps
+    SetupThreadPool(this);
+
+    // Continue the profile of ReadFile() if we're called from there
+    Profiler *profiler = ContinueProfile(this);
+    ScopedRegion postprocessRegion(profiler, "postprocess");
+
     for( unsigned int a = 0; a < pimpl->mPostProcessingSteps.size(); a++)   {
         BaseProcess* process = pimpl->mPostProcessingSteps[a];
         pimpl->mProgressHandler->UpdatePostProcess(static_cast<int>(a), static_cast<int>(pimpl->mPostProcessingSteps.size()) );
-        if( process->IsActive( pFlags)) {
-            if (profiler) {
-                profiler->BeginRegion("postprocess");
-            }
-
+        if( process->IsEnabled( pFlags, this)) {
+            ScopedRegion stepRegion(profiler, profiler ? GetStepName(process) : std::string());
+            MaterializeSceneImage(pimpl->mScene);
             process->ExecuteOnScene ( this );
-
-            if (profiler) {
-                profiler->EndRegion("postprocess");
-            }
+            EndRegion(stepRegion, this);
         }
         if( !pimpl->mScene) {
             break;
@@ -834,6 +1068,8 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags) {
     pimpl->mProgressHandler->UpdatePostProcess( static_cast<int>(pimpl->mPostProcessingSteps.size()), 
         static_cast<int>(pimpl->mPostProcessingSteps.size()) );
 
+    EndRegion(postprocessRegion, this);
+
     // update private scene flags
     if( pimpl->mScene ) {
       ScenePriv(pimpl->mScene)->mPPStepsApplied |= pFlags;
@@ -892,17 +1128,10 @@ const aiScene* Importer::ApplyCustomizedPostProcessing( BaseProcess *rootProcess
     }
 #endif // ! DEBUG
 
-    std::unique_ptr<Profiler> profiler(GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME, 0) ? new Profiler() : nullptr);
-
-    if ( profiler ) {
-        profiler->BeginRegion( "postprocess" );
-    }
-
+    ScopedRegion postprocessRegion(ContinueProfile(this), "postprocess");
+    MaterializeSceneImage(pimpl->mScene);
     rootProcess->ExecuteOnScene( this );
-
-    if ( profiler ) {
-        profiler->EndRegion( "postprocess" );
-    }
+    EndRegion(postprocessRegion, this);
 
     // If the extra verbose mode is active, execute the ValidateDataStructureStep again - after each step
     if ( pimpl->bExtraVerbose || requestValidation  ) {
@@ -1120,6 +1349,29 @@ void AddNodeWeight(unsigned int& iScene,const aiNode* pcNode) {
     }
 }
 
+// ------------------------------------------------------------------------------------------------
+// Get the profiling data of the last import
+const Profiler* Importer::GetProfiler() const {
+    ai_assert(nullptr != pimpl);
+
+    return pimpl->mProfiler;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Get the statistics of the import cache
+unsigned int Importer::GetImportCacheHits() const {
+    ai_assert(nullptr != pimpl);
+
+    return pimpl->mCacheHits;
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int Importer::GetImportCacheMisses() const {
+    ai_assert(nullptr != pimpl);
+
+    return pimpl->mCacheMisses;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Get the memory requirements of the scene
 void Importer::GetMemoryRequirements(aiMemoryInfo& in) const {
@@ -44,6 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef INCLUDED_AI_IMPORTER_H
 #define INCLUDED_AI_IMPORTER_H
 
+#include <exception>
 #include <map>
 #include <vector>
 #include <string>
@@ -57,6 +58,10 @@ namespace Assimp    {
     class BaseImporter;
     class BaseProcess;
     class SharedPostProcessInfo;
+    class ThreadPool;
+    namespace Profiling {
+        class Profiler;
+    }
 
 
 //! @cond never
@@ -122,6 +127,17 @@ public:
     /** Used by post-process steps to share data */
     SharedPostProcessInfo* mPPShared;
 
+    /** Worker threads for the per-mesh post-process steps, nullptr if
+     *  AI_CONFIG_GLOB_NUM_THREADS asks for serial processing */
+    ThreadPool* mThreadPool;
+
+    /** Timings of the last import, nullptr if AI_CONFIG_GLOB_MEASURE_TIME is off */
+    Profiling::Profiler* mProfiler;
+
+    /** Statistics of the import cache, see AI_CONFIG_GLOB_IMPORT_CACHE_DIR */
+    unsigned int mCacheHits;
+    unsigned int mCacheMisses;
+
     /// The default class constructor.
     ImporterPimpl() AI_NO_EXCEPT;
 };
@@ -142,7 +158,11 @@ ImporterPimpl::ImporterPimpl() AI_NO_EXCEPT :
         mStringProperties(),
         mMatrixProperties(),
         bExtraVerbose( false ),
-        mPPShared( nullptr ) {
+        mPPShared( nullptr ),
+        mThreadPool( nullptr ),
+        mProfiler( nullptr ),
+        mCacheHits( 0 ),
+        mCacheMisses( 0 ) {
     // empty
 }
 //! @endcond
@@ -153,8 +173,8 @@ struct BatchData;
 /** FOR IMPORTER PLUGINS ONLY: A helper class to the pleasure of importers
  *  that need to load many external meshes recursively.
  *
- *  The class uses several threads to load these meshes (or at least it
- *  could, this has not yet been implemented at the moment).
+ *  The files are loaded by a BatchImporter, concurrently if a thread pool
+ *  is passed.
  *
  *  @note The class may not be used by more than one thread*/
 class ASSIMP_API BatchLoader {
@@ -183,8 +203,12 @@ public:
     // -------------------------------------------------------------------
     /** Construct a batch loader from a given IO system to be used
      *  to access external files 
+     *  @param pool Thread pool to load the files concurrently on. pIO is
+     *    then called from several threads at once and must be thread-safe,
+     *    which the IOSystem passed to an importer plugin is not required to
+     *    be. nullptr loads the files one after another.
      */
-    explicit BatchLoader(IOSystem* pIO, bool validate = false );
+    explicit BatchLoader(IOSystem* pIO, bool validate = false, ThreadPool* pool = nullptr );
 
     // -------------------------------------------------------------------
     /** The class destructor.
@@ -179,6 +179,9 @@ corresponding preprocessor flag to selectively disable formats.
 #ifndef ASSIMP_BUILD_NO_ASSBIN_IMPORTER
 #include "AssetLib/Assbin/AssbinLoader.h"
 #endif
+#ifndef ASSIMP_BUILD_NO_SCENEIMAGE_IMPORTER
+#include "AssetLib/SceneImage/SceneImageImporter.h"
+#endif
 #if !defined(ASSIMP_BUILD_NO_GLTF_IMPORTER) && !defined(ASSIMP_BUILD_NO_GLTF1_IMPORTER)
 #include "AssetLib/glTF/glTFImporter.h"
 #endif
@@ -341,6 +344,9 @@ void GetImporterInstanceList(std::vector<BaseImporter *> &out) {
 #if (!defined ASSIMP_BUILD_NO_ASSBIN_IMPORTER)
     out.push_back(new AssbinImporter());
 #endif
+#if (!defined ASSIMP_BUILD_NO_SCENEIMAGE_IMPORTER)
+    out.push_back(new SceneImageImporter());
+#endif
 #if (!defined ASSIMP_BUILD_NO_GLTF_IMPORTER && !defined ASSIMP_BUILD_NO_GLTF1_IMPORTER)
     out.push_back(new glTFImporter());
 #endif
@@ -0,0 +1,249 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file InflateIOStream.cpp
+ *  @brief Implementation of the zlib inflating stream
+ */
+#include "InflateIOStream.h"
+
+#include <assimp/Exceptional.h>
+#include <assimp/ai_assert.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+#ifdef ASSIMP_BUILD_NO_OWN_ZLIB
+#include <zlib.h>
+#else
+#include <contrib/zlib/zlib.h>
+#endif
+
+using namespace Assimp;
+
+namespace {
+
+// Size of the compressed chunks read from unmapped streams and of the inflated data buffer
+const size_t ChunkSize = 64 * 1024;
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+InflateIOStream::InflateIOStream(IOStream *source, size_t uncompressedSize) :
+        mSource(source),
+        mZStream(new z_stream()),
+        mMappedInput(nullptr),
+        mMappedInputSize(0),
+        mOutput(ChunkSize),
+        mOutputPos(0),
+        mOutputEnd(0),
+        mPos(0),
+        mSize(uncompressedSize),
+        mEnd(false) {
+    ai_assert(nullptr != source);
+
+    const unsigned char *mapped = static_cast<const unsigned char *>(source->GetMappedData());
+    if (nullptr != mapped) {
+        mMappedInput = mapped + source->Tell();
+        mMappedInputSize = source->FileSize() - source->Tell();
+    } else {
+        mInput.resize(ChunkSize);
+    }
+
+    mZStream->zalloc = Z_NULL;
+    mZStream->zfree = Z_NULL;
+    mZStream->opaque = Z_NULL;
+    mZStream->next_in = Z_NULL;
+    mZStream->avail_in = 0;
+    if (Z_OK != inflateInit(mZStream.get())) {
+        throw DeadlyImportError("Zlib decompression failed.");
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+InflateIOStream::~InflateIOStream() {
+    inflateEnd(mZStream.get());
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t InflateIOStream::Read(void *pvBuffer, size_t pSize, size_t pCount) {
+    ai_assert(nullptr != pvBuffer);
+    if (0 == pSize || 0 == pCount) {
+        return 0;
+    }
+
+    unsigned char *out = static_cast<unsigned char *>(pvBuffer);
+    const size_t total = pSize * pCount;
+    size_t done = 0;
+    while (done < total) {
+        // hand out what has been inflated already
+        if (mOutputPos < mOutputEnd) {
+            const size_t n = std::min(total - done, mOutputEnd - mOutputPos);
+            ::memcpy(out + done, &mOutput[mOutputPos], n);
+            mOutputPos += n;
+            done += n;
+            continue;
+        }
+        if (mEnd) {
+            break;
+        }
+
+        // large reads bypass the buffer
+        if (total - done >= mOutput.size()) {
+            done += Inflate(out + done, total - done);
+        } else {
+            mOutputPos = 0;
+            mOutputEnd = Inflate(mOutput.data(), mOutput.size());
+        }
+    }
+
+    mPos += done;
+    return done / pSize;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t InflateIOStream::Write(const void * /*pvBuffer*/, size_t /*pSize*/, size_t /*pCount*/) {
+    return 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+aiReturn InflateIOStream::Seek(size_t pOffset, aiOrigin pOrigin) {
+    size_t target;
+    switch (pOrigin) {
+    case aiOrigin_SET:
+        target = pOffset;
+        break;
+    case aiOrigin_CUR:
+        target = mPos + pOffset;
+        break;
+    case aiOrigin_END:
+        if (pOffset > mSize) {
+            return AI_FAILURE;
+        }
+        target = mSize - pOffset;
+        break;
+    default:
+        return AI_FAILURE;
+    }
+    if (target < mPos) {
+        return AI_FAILURE;
+    }
+
+    // there is no way around inflating everything up to the target
+    unsigned char skipped[4096];
+    while (mPos < target) {
+        const size_t n = std::min(target - mPos, sizeof(skipped));
+        if (Read(skipped, 1, n) != n) {
+            return AI_FAILURE;
+        }
+    }
+    return AI_SUCCESS;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t InflateIOStream::Tell() const {
+    return mPos;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t InflateIOStream::FileSize() const {
+    return mSize;
+}
+
+// ------------------------------------------------------------------------------------------------
+void InflateIOStream::Flush() {
+    // nothing to do
+}
+
+// ------------------------------------------------------------------------------------------------
+// Inflates up to size bytes into out, returns the number of bytes written. Less than size bytes
+// are written only at the end of the compressed data.
+size_t InflateIOStream::Inflate(unsigned char *out, size_t size) {
+    z_stream &stream = *mZStream;
+    size_t done = 0;
+    while (done < size && !mEnd) {
+        if (0 == stream.avail_in && !NextInput()) {
+            // truncated data, let the reader run into its EOF handling
+            mEnd = true;
+            break;
+        }
+
+        const uInt chunk = static_cast<uInt>(std::min<size_t>(size - done, UINT_MAX));
+        stream.next_out = out + done;
+        stream.avail_out = chunk;
+        const int res = inflate(&stream, Z_NO_FLUSH);
+        done += chunk - stream.avail_out;
+
+        if (Z_STREAM_END == res) {
+            mEnd = true;
+        } else if (Z_OK != res && Z_BUF_ERROR != res) {
+            throw DeadlyImportError("Zlib decompression failed.");
+        }
+    }
+    return done;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Provides the next piece of compressed data to zlib, returns false at the end of the source.
+bool InflateIOStream::NextInput() {
+    z_stream &stream = *mZStream;
+    if (nullptr != mMappedInput) {
+        const size_t n = std::min<size_t>(mMappedInputSize, UINT_MAX);
+        if (0 == n) {
+            return false;
+        }
+        // zlib does not write through next_in
+        stream.next_in = const_cast<Bytef *>(mMappedInput);
+        stream.avail_in = static_cast<uInt>(n);
+        mMappedInput += n;
+        mMappedInputSize -= n;
+        return true;
+    }
+
+    const size_t n = mSource->Read(mInput.data(), 1, mInput.size());
+    if (0 == n) {
+        return false;
+    }
+    stream.next_in = mInput.data();
+    stream.avail_in = static_cast<uInt>(n);
+    return true;
+}
@@ -0,0 +1,129 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file InflateIOStream.h
+ *  @brief Read-only stream which inflates zlib-compressed data on the fly.
+ */
+#ifndef AI_INFLATEIOSTREAM_H_INC
+#define AI_INFLATEIOSTREAM_H_INC
+
+#include <assimp/IOStream.hpp>
+
+#include <memory>
+#include <vector>
+
+struct z_stream_s;
+
+namespace Assimp {
+
+// --------------------------------------------------------------------------------------------
+/** @brief Reads a zlib-compressed block from another stream and inflates it chunk by chunk.
+ *
+ *  Neither the compressed nor the uncompressed data is ever held in memory as a whole. The
+ *  compressed data is read from the current position of the source stream up to its end,
+ *  mapped source streams are inflated in place. Small reads are served from an internal
+ *  buffer, large reads are inflated straight into the caller's buffer. Seeking is limited
+ *  to moving forward. Corrupt data raises a DeadlyImportError. */
+// --------------------------------------------------------------------------------------------
+class ASSIMP_API InflateIOStream : public IOStream {
+public:
+    // ----------------------------------------------------------------------------
+    /** @brief Construction
+     *  @param source Stream positioned at the start of the compressed data, must
+     *    outlive this stream.
+     *  @param uncompressedSize Size of the data once inflated, as stored by the writer. */
+    InflateIOStream(IOStream *source, size_t uncompressedSize);
+
+    /** Destructor, the source stream is not closed. */
+    ~InflateIOStream();
+
+    // -------------------------------------------------------------------
+    /// Read from stream
+    size_t Read(void *pvBuffer, size_t pSize, size_t pCount);
+
+    // -------------------------------------------------------------------
+    /// Write to stream, always fails
+    size_t Write(const void *pvBuffer, size_t pSize, size_t pCount);
+
+    // -------------------------------------------------------------------
+    /// Seek specific position, only forward seeks are supported
+    aiReturn Seek(size_t pOffset, aiOrigin pOrigin);
+
+    // -------------------------------------------------------------------
+    /// Get current position in the uncompressed data
+    size_t Tell() const;
+
+    // -------------------------------------------------------------------
+    /// Get size of the uncompressed data
+    size_t FileSize() const;
+
+    // -------------------------------------------------------------------
+    /// Flush file contents, nothing to do
+    void Flush();
+
+private:
+    size_t Inflate(unsigned char *out, size_t size);
+    bool NextInput();
+
+    InflateIOStream(const InflateIOStream &) = delete;
+    InflateIOStream &operator=(const InflateIOStream &) = delete;
+
+private:
+    IOStream *mSource;
+    std::unique_ptr<z_stream_s> mZStream;
+
+    const unsigned char *mMappedInput; ///< Rest of a mapped source stream, nullptr if not mapped
+    size_t mMappedInputSize;
+    std::vector<unsigned char> mInput; ///< Compressed data read from an unmapped source stream
+
+    std::vector<unsigned char> mOutput; ///< Inflated data not handed out yet
+    size_t mOutputPos;
+    size_t mOutputEnd;
+
+    size_t mPos;
+    size_t mSize;
+    bool mEnd;
+};
+
+} // namespace Assimp
+
+#endif // AI_INFLATEIOSTREAM_H_INC
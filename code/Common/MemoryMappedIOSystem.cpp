@@ -0,0 +1,214 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+/** @file MemoryMappedIOSystem.cpp
+ *  @brief Implementation of the memory-mapped IOSystem and IOStream
+ */
+
+#include <assimp/MemoryMappedIOSystem.h>
+#include <assimp/ai_assert.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdint.h>
+#include <string>
+
+#ifdef _WIN32
+#    ifndef NOMINMAX
+#        define NOMINMAX // keep std::min usable
+#    endif
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+using namespace Assimp;
+
+// ------------------------------------------------------------------------------------------------
+MemoryMappedIOStream::MemoryMappedIOStream(const uint8_t *data, size_t size) AI_NO_EXCEPT
+        : mData(data),
+          mSize(size),
+          mPos(0) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+MemoryMappedIOStream::~MemoryMappedIOStream() {
+#ifdef _WIN32
+    ::UnmapViewOfFile(mData);
+#else
+    ::munmap(const_cast<uint8_t *>(mData), mSize);
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+MemoryMappedIOStream *MemoryMappedIOStream::Map(const char *file, bool copyOnWrite) {
+    ai_assert(file != nullptr);
+#ifdef _WIN32
+    const int len = ::MultiByteToWideChar(CP_UTF8, 0, file, -1, nullptr, 0);
+    std::wstring wide(static_cast<size_t>(len), L'\0');
+    ::MultiByteToWideChar(CP_UTF8, 0, file, -1, &wide[0], len);
+
+    HANDLE handle = ::CreateFileW(wide.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return nullptr;
+    }
+    LARGE_INTEGER size;
+    if (!::GetFileSizeEx(handle, &size) || size.QuadPart <= 0 ||
+            static_cast<unsigned long long>(size.QuadPart) > SIZE_MAX) {
+        ::CloseHandle(handle);
+        return nullptr;
+    }
+    HANDLE mapping = ::CreateFileMappingW(handle, nullptr,
+            copyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, nullptr);
+    ::CloseHandle(handle);
+    if (mapping == nullptr) {
+        return nullptr;
+    }
+    // the view keeps the mapping object alive
+    void *data = ::MapViewOfFile(mapping, copyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+    ::CloseHandle(mapping);
+    if (data == nullptr) {
+        return nullptr;
+    }
+    return new MemoryMappedIOStream(static_cast<const uint8_t *>(data), static_cast<size_t>(size.QuadPart));
+#else
+    const int fd = ::open(file, O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size <= 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    const size_t size = static_cast<size_t>(info.st_size);
+    void *data = ::mmap(nullptr, size, copyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping stays valid after closing the descriptor
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        return nullptr;
+    }
+#ifdef MADV_SEQUENTIAL
+    ::madvise(data, size, MADV_SEQUENTIAL);
+#endif
+    return new MemoryMappedIOStream(static_cast<const uint8_t *>(data), size);
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t MemoryMappedIOStream::Read(void *pvBuffer, size_t pSize, size_t pCount) {
+    ai_assert(nullptr != pvBuffer);
+    if (0 == pSize) {
+        return 0;
+    }
+
+    const size_t cnt = std::min(pCount, (mSize - mPos) / pSize);
+    const size_t ofs = pSize * cnt;
+    ::memcpy(pvBuffer, mData + mPos, ofs);
+    mPos += ofs;
+
+    return cnt;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t MemoryMappedIOStream::Write(const void * /*pvBuffer*/, size_t /*pSize*/, size_t /*pCount*/) {
+    return 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+aiReturn MemoryMappedIOStream::Seek(size_t pOffset, aiOrigin pOrigin) {
+    size_t pos;
+    if (aiOrigin_SET == pOrigin) {
+        pos = pOffset;
+    } else if (aiOrigin_END == pOrigin) {
+        if (pOffset > mSize) {
+            return AI_FAILURE;
+        }
+        pos = mSize - pOffset;
+    } else {
+        pos = mPos + pOffset;
+    }
+    if (pos > mSize) {
+        return AI_FAILURE;
+    }
+    mPos = pos;
+    return AI_SUCCESS;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t MemoryMappedIOStream::Tell() const {
+    return mPos;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t MemoryMappedIOStream::FileSize() const {
+    return mSize;
+}
+
+// ------------------------------------------------------------------------------------------------
+void MemoryMappedIOStream::Flush() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+const void *MemoryMappedIOStream::GetMappedData() const {
+    return mData;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Map files opened for reading, let the base class handle everything else.
+IOStream *MemoryMappedIOSystem::Open(const char *strFile, const char *strMode) {
+    ai_assert(strFile != nullptr);
+    ai_assert(strMode != nullptr);
+
+    if (nullptr == ::strpbrk(strMode, "wa+")) {
+        IOStream *stream = MemoryMappedIOStream::Map(strFile);
+        if (nullptr != stream) {
+            return stream;
+        }
+    }
+    return DefaultIOSystem::Open(strFile, strMode);
+}
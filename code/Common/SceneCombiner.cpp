@@ -864,17 +864,40 @@ void SceneCombiner::MergeMeshes(aiMesh **_out, unsigned int /*flags*/,
         out->mFaces = new aiFace[out->mNumFaces];
         aiFace *pf2 = out->mFaces;
 
+        // if one of the meshes has an index pool, the output gets one for
+        // all indices, else the index arrays of the faces are moved
+        unsigned int *pool = nullptr;
+        for (std::vector<aiMesh *>::const_iterator it = begin; it != end && !pool; ++it) {
+            if ((*it)->mFaceIndices) {
+                for (std::vector<aiMesh *>::const_iterator it2 = begin; it2 != end; ++it2) {
+                    for (unsigned int m = 0; m < (*it2)->mNumFaces; ++m) {
+                        out->mNumFaceIndices += (*it2)->mFaces[m].mNumIndices;
+                    }
+                }
+                pool = out->mFaceIndices = new unsigned int[out->mNumFaceIndices];
+            }
+        }
+
         unsigned int ofs = 0;
         for (std::vector<aiMesh *>::const_iterator it = begin; it != end; ++it) {
             for (unsigned int m = 0; m < (*it)->mNumFaces; ++m, ++pf2) {
                 aiFace &face = (*it)->mFaces[m];
                 pf2->mNumIndices = face.mNumIndices;
-                pf2->mIndices = face.mIndices;
+                if (pool) {
+                    pf2->mIndices = pool;
+                    ::memcpy(pool, face.mIndices, face.mNumIndices * sizeof(unsigned int));
+                    pool += face.mNumIndices;
+                    if (!(*it)->IsPooledFace(face)) {
+                        delete[] face.mIndices;
+                    }
+                } else {
+                    pf2->mIndices = face.mIndices;
+                }
 
                 if (ofs) {
                     // add the offset to the vertex
                     for (unsigned int q = 0; q < face.mNumIndices; ++q) {
-                        face.mIndices[q] += ofs;
+                        pf2->mIndices[q] += ofs;
                     }
                 }
                 face.mIndices = nullptr;
@@ -1078,13 +1101,23 @@ void SceneCombiner::Copy(aiMesh **_dest, const aiMesh *src) {
 
     // make a deep copy of all faces
     GetArrayCopy(dest->mFaces, dest->mNumFaces);
+    // copy the index pool in one go and rebase the pooled faces onto the copy
+    GetArrayCopy(dest->mFaceIndices, dest->mNumFaceIndices);
     for (unsigned int i = 0; i < dest->mNumFaces; ++i) {
         aiFace &f = dest->mFaces[i];
-        GetArrayCopy(f.mIndices, f.mNumIndices);
+        if (src->IsPooledFace(f)) {
+            f.mIndices = dest->mFaceIndices + (f.mIndices - src->mFaceIndices);
+        } else {
+            GetArrayCopy(f.mIndices, f.mNumIndices);
+        }
     }
 
     // make a deep copy of all blend shapes
     CopyPtrArray(dest->mAnimMeshes, dest->mAnimMeshes, dest->mNumAnimMeshes);
+
+    GetArrayCopy(dest->mMeshlets, dest->mNumMeshlets);
+    GetArrayCopy(dest->mMeshletVertices, dest->mNumMeshletVertices);
+    GetArrayCopy(dest->mMeshletTriangles, dest->mNumMeshletTriangles * 3);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -49,6 +49,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/ai_assert.h>
 #include <assimp/scene.h>
 
+#include <memory>
+
 namespace Assimp {
 
 // Forward declarations
@@ -71,13 +73,19 @@ struct ScenePrivateData {
     // and mOrigImporter are no longer safe to rely on and only
     // serve informative purposes.
     bool mIsCopy;
+
+    // Storage of a scene loaded from a scene image. If set, all sub-objects
+    // of the scene live inside this block instead of being allocated one by
+    // one, so they must not be deleted or reallocated individually.
+    std::shared_ptr<void> mImage;
 };
 
 inline
 ScenePrivateData::ScenePrivateData() AI_NO_EXCEPT
 : mOrigImporter( nullptr )
 , mPPStepsApplied( 0 )
-, mIsCopy( false ) {
+, mIsCopy( false )
+, mImage() {
     // empty
 }
 
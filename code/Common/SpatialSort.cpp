@@ -44,6 +44,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/SpatialSort.h>
 #include <assimp/ai_assert.h>
 
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
 using namespace Assimp;
 
 // CHAR_BIT seems to be defined under MVSC, but not under GCC. Pray that the correct value is 8.
@@ -58,14 +65,16 @@ const aiVector3D PlaneInit(0.8523f, 0.34321f, 0.5736f);
 // define the reference plane. We choose some arbitrary vector away from all basic axises
 // in the hope that no model spreads all its vertices along this plane.
 SpatialSort::SpatialSort(const aiVector3D *pPositions, unsigned int pNumPositions, unsigned int pElementOffset) :
-        mPlaneNormal(PlaneInit) {
+        mPlaneNormal(PlaneInit),
+        mThreadPool(nullptr) {
     mPlaneNormal.Normalize();
     Fill(pPositions, pNumPositions, pElementOffset);
 }
 
 // ------------------------------------------------------------------------------------------------
 SpatialSort::SpatialSort() :
-        mPlaneNormal(PlaneInit) {
+        mPlaneNormal(PlaneInit),
+        mThreadPool(nullptr) {
     mPlaneNormal.Normalize();
 }
 
@@ -75,17 +84,145 @@ SpatialSort::~SpatialSort() {
     // empty
 }
 
+namespace {
+
+// Below this number of positions Finalize() uses a comparison sort
+const size_t RadixSortMinSize = 256;
+
+// Minimum number of positions per task when sorting or querying on the thread pool
+const size_t SortMinBlockSize = 16384;
+const size_t QueryMinBlockSize = 4096;
+
+const unsigned int RadixBits = 8;
+const unsigned int RadixSize = 1u << RadixBits;
+
+// Unsigned integer of the same size as ai_real
+typedef std::conditional<sizeof(ai_real) == 8, uint64_t, uint32_t>::type SortKey;
+static_assert(sizeof(SortKey) == sizeof(ai_real), "sizeof(SortKey) == sizeof(ai_real)");
+
+// --------------------------------------------------------------------------------------------
+// Maps a floating-point value to an unsigned integer of the same order. Positive values get
+// their sign bit set, negative values are inverted so larger magnitudes sort first.
+SortKey ToSortKey(ai_real pValue) {
+    SortKey bits;
+    ::memcpy(&bits, &pValue, sizeof(bits));
+    const SortKey signBit = SortKey(1) << (CHAR_BIT * sizeof(SortKey) - 1);
+    return (bits & signBit) ? ~bits : (bits | signBit);
+}
+
+// --------------------------------------------------------------------------------------------
+// Number of contiguous blocks to split count items into so each task gets enough work
+unsigned int GetNumBlocks(ThreadPool *pool, size_t count, size_t minBlockSize) {
+    if (nullptr == pool) {
+        return 1;
+    }
+    const size_t maxBlocks = std::max<size_t>(1, count / minBlockSize);
+    return static_cast<unsigned int>(std::min<size_t>(pool->GetNumThreads(), maxBlocks));
+}
+
+// --------------------------------------------------------------------------------------------
+// Stable LSD radix sort of the keys, the values are moved along with their keys. Each pass
+// counts the digits of all blocks in parallel, then scatters the blocks in parallel. Passes
+// in which all keys share the same digit are skipped.
+void RadixSort(std::vector<SortKey> &keys, std::vector<unsigned int> &values, ThreadPool *pool) {
+    const size_t count = keys.size();
+    const unsigned int numBlocks = GetNumBlocks(pool, count, SortMinBlockSize);
+    const size_t blockSize = (count + numBlocks - 1) / numBlocks;
+
+    std::vector<SortKey> keysOut(count);
+    std::vector<unsigned int> valuesOut(count);
+    std::vector<size_t> offsets(numBlocks * RadixSize);
+
+    for (unsigned int shift = 0; shift < CHAR_BIT * sizeof(SortKey); shift += RadixBits) {
+        std::fill(offsets.begin(), offsets.end(), 0);
+        ParallelFor(pool, numBlocks, [&](unsigned int block) {
+            size_t *histogram = &offsets[block * RadixSize];
+            const size_t end = std::min(count, (block + 1) * blockSize);
+            for (size_t i = block * blockSize; i < end; ++i) {
+                ++histogram[(keys[i] >> shift) & (RadixSize - 1)];
+            }
+        });
+
+        // turn the counts into output offsets, ordered by digit first and block second
+        // so equal digits keep their relative order
+        bool skipPass = false;
+        size_t sum = 0;
+        for (unsigned int digit = 0; digit < RadixSize; ++digit) {
+            const size_t digitBegin = sum;
+            for (unsigned int block = 0; block < numBlocks; ++block) {
+                const size_t blockCount = offsets[block * RadixSize + digit];
+                offsets[block * RadixSize + digit] = sum;
+                sum += blockCount;
+            }
+            skipPass = skipPass || sum - digitBegin == count;
+        }
+        if (skipPass) {
+            continue;
+        }
+
+        ParallelFor(pool, numBlocks, [&](unsigned int block) {
+            size_t *offset = &offsets[block * RadixSize];
+            const size_t end = std::min(count, (block + 1) * blockSize);
+            for (size_t i = block * blockSize; i < end; ++i) {
+                const size_t target = offset[(keys[i] >> shift) & (RadixSize - 1)]++;
+                keysOut[target] = keys[i];
+                valuesOut[target] = values[i];
+            }
+        });
+        keys.swap(keysOut);
+        values.swap(valuesOut);
+    }
+}
+
+// --------------------------------------------------------------------------------------------
+// Reorders data so that data[i] becomes data[order[i]]
+template <typename T>
+void ApplyOrder(std::vector<T> &data, const std::vector<unsigned int> &order) {
+    std::vector<T> sorted(data.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        sorted[i] = data[order[i]];
+    }
+    data.swap(sorted);
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+void SpatialSort::SetThreadPool(ThreadPool *pPool) {
+    mThreadPool = pPool;
+}
+
 // ------------------------------------------------------------------------------------------------
 void SpatialSort::Fill(const aiVector3D *pPositions, unsigned int pNumPositions,
         unsigned int pElementOffset,
         bool pFinalize /*= true */) {
+    mDistances.clear();
     mPositions.clear();
+    mIndices.clear();
     Append(pPositions, pNumPositions, pElementOffset, pFinalize);
 }
 
 // ------------------------------------------------------------------------------------------------
 void SpatialSort::Finalize() {
-    std::sort(mPositions.begin(), mPositions.end());
+    const size_t count = mDistances.size();
+    std::vector<unsigned int> order(count);
+    std::vector<SortKey> keys(count);
+    for (size_t i = 0; i < count; ++i) {
+        order[i] = static_cast<unsigned int>(i);
+        keys[i] = ToSortKey(mDistances[i]);
+    }
+
+    if (count < RadixSortMinSize) {
+        std::stable_sort(order.begin(), order.end(), [&keys](unsigned int a, unsigned int b) {
+            return keys[a] < keys[b];
+        });
+    } else {
+        RadixSort(keys, order, mThreadPool);
+    }
+
+    ApplyOrder(mDistances, order);
+    ApplyOrder(mPositions, order);
+    ApplyOrder(mIndices, order);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -94,14 +231,18 @@ void SpatialSort::Append(const aiVector3D *pPositions, unsigned int pNumPosition
         bool pFinalize /*= true */) {
     // store references to all given positions along with their distance to the reference plane
     const size_t initial = mPositions.size();
-    mPositions.reserve(initial + (pFinalize ? pNumPositions : pNumPositions * 2));
+    const size_t reserve = initial + (pFinalize ? pNumPositions : pNumPositions * 2);
+    mDistances.reserve(reserve);
+    mPositions.reserve(reserve);
+    mIndices.reserve(reserve);
     for (unsigned int a = 0; a < pNumPositions; a++) {
         const char *tempPointer = reinterpret_cast<const char *>(pPositions);
         const aiVector3D *vec = reinterpret_cast<const aiVector3D *>(tempPointer + a * pElementOffset);
 
         // store position by index and distance
-        ai_real distance = *vec * mPlaneNormal;
-        mPositions.push_back(Entry(static_cast<unsigned int>(a + initial), *vec, distance));
+        mDistances.push_back(*vec * mPlaneNormal);
+        mPositions.push_back(*vec);
+        mIndices.push_back(static_cast<unsigned int>(a + initial));
     }
 
     if (pFinalize) {
@@ -121,18 +262,18 @@ void SpatialSort::FindPositions(const aiVector3D &pPosition,
     poResults.clear();
 
     // quick check for positions outside the range
-    if (mPositions.size() == 0)
+    if (mDistances.size() == 0)
         return;
-    if (maxDist < mPositions.front().mDistance)
+    if (maxDist < mDistances.front())
         return;
-    if (minDist > mPositions.back().mDistance)
+    if (minDist > mDistances.back())
         return;
 
     // do a binary search for the minimal distance to start the iteration there
-    unsigned int index = (unsigned int)mPositions.size() / 2;
-    unsigned int binaryStepSize = (unsigned int)mPositions.size() / 4;
+    unsigned int index = (unsigned int)mDistances.size() / 2;
+    unsigned int binaryStepSize = (unsigned int)mDistances.size() / 4;
     while (binaryStepSize > 1) {
-        if (mPositions[index].mDistance < minDist)
+        if (mDistances[index] < minDist)
             index += binaryStepSize;
         else
             index -= binaryStepSize;
@@ -142,26 +283,94 @@ void SpatialSort::FindPositions(const aiVector3D &pPosition,
 
     // depending on the direction of the last step we need to single step a bit back or forth
     // to find the actual beginning element of the range
-    while (index > 0 && mPositions[index].mDistance > minDist)
+    while (index > 0 && mDistances[index] > minDist)
         index--;
-    while (index < (mPositions.size() - 1) && mPositions[index].mDistance < minDist)
+    while (index < (mDistances.size() - 1) && mDistances[index] < minDist)
         index++;
 
     // Mow start iterating from there until the first position lays outside of the distance range.
     // Add all positions inside the distance range within the given radius to the result aray
-    std::vector<Entry>::const_iterator it = mPositions.begin() + index;
     const ai_real pSquared = pRadius * pRadius;
-    while (it->mDistance < maxDist) {
-        if ((it->mPosition - pPosition).SquareLength() < pSquared)
-            poResults.push_back(it->mIndex);
-        ++it;
-        if (it == mPositions.end())
-            break;
+    for (; index < mDistances.size() && mDistances[index] < maxDist; ++index) {
+        if ((mPositions[index] - pPosition).SquareLength() < pSquared)
+            poResults.push_back(mIndices[index]);
     }
 
     // that's it
 }
 
+// ------------------------------------------------------------------------------------------------
+// Resolves the neighbours of all positions. The queries run in sorted order, so the start of the
+// search range only ever moves forward and no binary search is needed except once per block.
+void SpatialSort::FindAllNeighbors(ai_real pRadius, std::vector<unsigned int> &poOffsets,
+        std::vector<unsigned int> &poNeighbors) const {
+    const size_t count = mDistances.size();
+    poOffsets.assign(count + 1, 0);
+    poNeighbors.clear();
+
+    // NaN distances end up at both ends of the sorted array. FindPositions() never finds
+    // anything for them, so just leave them out.
+    size_t validBegin = 0, validEnd = count;
+    while (validBegin < validEnd && mDistances[validBegin] != mDistances[validBegin])
+        ++validBegin;
+    while (validEnd > validBegin && mDistances[validEnd - 1] != mDistances[validEnd - 1])
+        --validEnd;
+    if (validBegin == validEnd)
+        return;
+
+    // search all blocks of positions independently, remembering the number of neighbours
+    // per sorted position
+    const size_t numValid = validEnd - validBegin;
+    const unsigned int numBlocks = GetNumBlocks(mThreadPool, numValid, QueryMinBlockSize);
+    const size_t blockSize = (numValid + numBlocks - 1) / numBlocks;
+    std::vector<std::vector<unsigned int>> blockNeighbors(numBlocks);
+    std::vector<unsigned int> numNeighbors(count, 0);
+    const ai_real pSquared = pRadius * pRadius;
+
+    ParallelFor(mThreadPool, numBlocks, [&](unsigned int block) {
+        const size_t begin = validBegin + block * blockSize;
+        const size_t end = std::min(validEnd, begin + blockSize);
+        std::vector<unsigned int> &found = blockNeighbors[block];
+        found.reserve((end - begin) * 4);
+
+        size_t first = std::lower_bound(mDistances.begin() + validBegin, mDistances.begin() + validEnd,
+                               mDistances[begin] - pRadius) -
+                       mDistances.begin();
+        for (size_t i = begin; i < end; ++i) {
+            const ai_real minDist = mDistances[i] - pRadius, maxDist = mDistances[i] + pRadius;
+            while (mDistances[first] < minDist)
+                ++first;
+
+            const aiVector3D &position = mPositions[i];
+            const size_t before = found.size();
+            for (size_t j = first; j < validEnd && mDistances[j] < maxDist; ++j) {
+                if ((mPositions[j] - position).SquareLength() < pSquared)
+                    found.push_back(mIndices[j]);
+            }
+            numNeighbors[i] = static_cast<unsigned int>(found.size() - before);
+        }
+    });
+
+    // compute the offsets in vertex order and scatter the results there
+    for (size_t i = 0; i < count; ++i) {
+        poOffsets[mIndices[i] + 1] = numNeighbors[i];
+    }
+    for (size_t i = 0; i < count; ++i) {
+        poOffsets[i + 1] += poOffsets[i];
+    }
+    poNeighbors.resize(poOffsets[count]);
+
+    ParallelFor(mThreadPool, numBlocks, [&](unsigned int block) {
+        const size_t begin = validBegin + block * blockSize;
+        const size_t end = std::min(validEnd, begin + blockSize);
+        const unsigned int *src = blockNeighbors[block].data();
+        for (size_t i = begin; i < end; ++i) {
+            std::copy(src, src + numNeighbors[i], poNeighbors.begin() + poOffsets[mIndices[i]]);
+            src += numNeighbors[i];
+        }
+    });
+}
+
 namespace {
 
 // Binary, signed-integer representation of a single-precision floating-point value.
@@ -262,11 +471,13 @@ void SpatialSort::FindIdenticalPositions(const aiVector3D &pPosition, std::vecto
     poResults.resize(0);
 
     // do a binary search for the minimal distance to start the iteration there
-    unsigned int index = (unsigned int)mPositions.size() / 2;
-    unsigned int binaryStepSize = (unsigned int)mPositions.size() / 4;
+    if (mDistances.empty())
+        return;
+    unsigned int index = (unsigned int)mDistances.size() / 2;
+    unsigned int binaryStepSize = (unsigned int)mDistances.size() / 4;
     while (binaryStepSize > 1) {
         // Ugly, but conditional jumps are faster with integers than with floats
-        if (minDistBinary > ToBinary(mPositions[index].mDistance))
+        if (minDistBinary > ToBinary(mDistances[index]))
             index += binaryStepSize;
         else
             index -= binaryStepSize;
@@ -276,20 +487,16 @@ void SpatialSort::FindIdenticalPositions(const aiVector3D &pPosition, std::vecto
 
     // depending on the direction of the last step we need to single step a bit back or forth
     // to find the actual beginning element of the range
-    while (index > 0 && minDistBinary < ToBinary(mPositions[index].mDistance))
+    while (index > 0 && minDistBinary < ToBinary(mDistances[index]))
         index--;
-    while (index < (mPositions.size() - 1) && minDistBinary > ToBinary(mPositions[index].mDistance))
+    while (index < (mDistances.size() - 1) && minDistBinary > ToBinary(mDistances[index]))
         index++;
 
     // Now start iterating from there until the first position lays outside of the distance range.
     // Add all positions inside the distance range within the tolerance to the result array
-    std::vector<Entry>::const_iterator it = mPositions.begin() + index;
-    while (ToBinary(it->mDistance) < maxDistBinary) {
-        if (distance3DToleranceInULPs >= ToBinary((it->mPosition - pPosition).SquareLength()))
-            poResults.push_back(it->mIndex);
-        ++it;
-        if (it == mPositions.end())
-            break;
+    for (; index < mDistances.size() && ToBinary(mDistances[index]) < maxDistBinary; ++index) {
+        if (distance3DToleranceInULPs >= ToBinary((mPositions[index] - pPosition).SquareLength()))
+            poResults.push_back(mIndices[index]);
     }
 
     // that's it
@@ -298,25 +505,24 @@ void SpatialSort::FindIdenticalPositions(const aiVector3D &pPosition, std::vecto
 // ------------------------------------------------------------------------------------------------
 unsigned int SpatialSort::GenerateMappingTable(std::vector<unsigned int> &fill, ai_real pRadius) const {
     fill.resize(mPositions.size(), UINT_MAX);
-    ai_real dist, maxDist;
+    ai_real maxDist;
 
     unsigned int t = 0;
     const ai_real pSquared = pRadius * pRadius;
     for (size_t i = 0; i < mPositions.size();) {
-        dist = mPositions[i].mPosition * mPlaneNormal;
-        maxDist = dist + pRadius;
+        maxDist = mDistances[i] + pRadius;
 
-        fill[mPositions[i].mIndex] = t;
-        const aiVector3D &oldpos = mPositions[i].mPosition;
-        for (++i; i < fill.size() && mPositions[i].mDistance < maxDist && (mPositions[i].mPosition - oldpos).SquareLength() < pSquared; ++i) {
-            fill[mPositions[i].mIndex] = t;
+        fill[mIndices[i]] = t;
+        const aiVector3D &oldpos = mPositions[i];
+        for (++i; i < fill.size() && mDistances[i] < maxDist && (mPositions[i] - oldpos).SquareLength() < pSquared; ++i) {
+            fill[mIndices[i]] = t;
         }
         ++t;
     }
 
 #ifdef ASSIMP_BUILD_DEBUG
 
-    // debug invariant: mPositions[i].mIndex values must range from 0 to mPositions.size()-1
+    // debug invariant: mIndices[i] values must range from 0 to mPositions.size()-1
     for (size_t i = 0; i < fill.size(); ++i) {
         ai_assert(fill[i] < mPositions.size());
     }
@@ -0,0 +1,239 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** @file Implementation of the ThreadPool helper class
+ */
+
+#include "ThreadPool.h"
+#include <assimp/ai_assert.h>
+
+#include <exception>
+
+using namespace Assimp;
+
+// ------------------------------------------------------------------------------------------------
+// A single ParallelFor() invocation, lives on the stack of the calling thread
+struct ThreadPool::Batch {
+    const std::function<void(unsigned int)> *fn;
+    unsigned int remaining;
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable done;
+};
+
+// ------------------------------------------------------------------------------------------------
+struct ThreadPool::Task {
+    Batch *batch;
+    unsigned int index;
+};
+
+// ------------------------------------------------------------------------------------------------
+struct ThreadPool::WorkQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+};
+
+// ------------------------------------------------------------------------------------------------
+ThreadPool::ThreadPool(unsigned int numThreads) :
+        mQueues(),
+        mThreads(),
+        mMutex(),
+        mWakeUp(),
+        mPending(0),
+        mStop(false) {
+    if (0 == numThreads) {
+        numThreads = GetHardwareConcurrency();
+    }
+#ifdef ASSIMP_BUILD_SINGLETHREADED
+    // without threading support all work is done by the calling thread
+    numThreads = 1;
+#endif
+
+    // queue 0 belongs to the thread calling ParallelFor(), all others to a worker
+    mQueues.reserve(numThreads);
+    for (unsigned int i = 0; i < numThreads; ++i) {
+        mQueues.emplace_back(new WorkQueue());
+    }
+    mThreads.reserve(numThreads - 1);
+    for (unsigned int i = 1; i < numThreads; ++i) {
+        mThreads.emplace_back(&ThreadPool::WorkerMain, this, i);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mWakeUp.notify_all();
+    for (std::thread &thread : mThreads) {
+        thread.join();
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int ThreadPool::GetNumThreads() const {
+    return static_cast<unsigned int>(mQueues.size());
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int ThreadPool::GetHardwareConcurrency() {
+    const unsigned int num = std::thread::hardware_concurrency();
+    return num ? num : 1;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ThreadPool::ParallelFor(unsigned int count, const std::function<void(unsigned int)> &fn) {
+    if (0 == count) {
+        return;
+    }
+
+    Batch batch;
+    batch.fn = &fn;
+    batch.remaining = count;
+
+    // hand out contiguous blocks so neighbouring items tend to run on the same thread
+    // bump the counter first so it never drops below the number of queued tasks
+    mPending += count;
+    const unsigned int numQueues = static_cast<unsigned int>(mQueues.size());
+    for (unsigned int q = 0; q < numQueues; ++q) {
+        const unsigned int begin = static_cast<unsigned int>(static_cast<unsigned long long>(count) * q / numQueues);
+        const unsigned int end = static_cast<unsigned int>(static_cast<unsigned long long>(count) * (q + 1) / numQueues);
+        if (begin == end) {
+            continue;
+        }
+        std::lock_guard<std::mutex> lock(mQueues[q]->mutex);
+        for (unsigned int i = begin; i < end; ++i) {
+            mQueues[q]->tasks.push_back(Task{ &batch, i });
+        }
+    }
+    {
+        // make sure no worker misses the wake-up between its check and its wait
+        std::lock_guard<std::mutex> lock(mMutex);
+    }
+    mWakeUp.notify_all();
+
+    // help out until the queues run dry, then wait for the items still in flight
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(batch.mutex);
+            if (0 == batch.remaining) {
+                break;
+            }
+        }
+        if (!RunPendingTask(0)) {
+            std::unique_lock<std::mutex> lock(batch.mutex);
+            batch.done.wait(lock, [&batch] { return 0 == batch.remaining; });
+            break;
+        }
+    }
+
+    if (batch.error) {
+        std::rethrow_exception(batch.error);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ThreadPool::RunPendingTask(unsigned int home) {
+    Task task = { nullptr, 0 };
+
+    // own queue first, oldest item first ...
+    const unsigned int numQueues = static_cast<unsigned int>(mQueues.size());
+    {
+        WorkQueue &queue = *mQueues[home];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = queue.tasks.front();
+            queue.tasks.pop_front();
+        }
+    }
+
+    // ... then steal the newest item of somebody else
+    for (unsigned int i = 1; nullptr == task.batch && i < numQueues; ++i) {
+        WorkQueue &queue = *mQueues[(home + i) % numQueues];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = queue.tasks.back();
+            queue.tasks.pop_back();
+        }
+    }
+    if (nullptr == task.batch) {
+        return false;
+    }
+    --mPending;
+
+    Batch &batch = *task.batch;
+    std::exception_ptr error;
+    try {
+        (*batch.fn)(task.index);
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    // the batch may be destroyed as soon as its owner observes remaining == 0,
+    // so the mutex must be held until we're done touching it.
+    std::lock_guard<std::mutex> lock(batch.mutex);
+    if (error && !batch.error) {
+        batch.error = error;
+    }
+    if (0 == --batch.remaining) {
+        batch.done.notify_all();
+    }
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ThreadPool::WorkerMain(unsigned int index) {
+    ai_assert(index < mQueues.size());
+
+    for (;;) {
+        if (RunPendingTask(index)) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(mMutex);
+        mWakeUp.wait(lock, [this] { return mStop || mPending > 0; });
+        if (mStop) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,134 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file Defines a small work-stealing thread pool used to spread
+ *  independent work items (e.g. meshes) across all cores. */
+#ifndef AI_THREADPOOL_H_INC
+#define AI_THREADPOOL_H_INC
+
+#include <assimp/defs.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Assimp {
+
+// --------------------------------------------------------------------------------------------
+/** @brief A fixed-size pool of worker threads.
+ *
+ *  Each worker owns a task queue. Work is distributed across the queues in contiguous
+ *  blocks, a worker drains its own queue from the front and steals from the back of the
+ *  other queues once it runs dry. The thread calling ParallelFor() takes part in the
+ *  work as well, so nested calls from inside a task cannot deadlock the pool. */
+// --------------------------------------------------------------------------------------------
+class ASSIMP_API ThreadPool {
+public:
+    // ----------------------------------------------------------------------------
+    /** @brief Construction
+     *  @param numThreads Total number of threads working on a ParallelFor() call,
+     *    including the calling thread. Pass 0 to use all hardware threads. */
+    explicit ThreadPool(unsigned int numThreads);
+
+    // ----------------------------------------------------------------------------
+    /** @brief Destructor, joins all worker threads */
+    ~ThreadPool();
+
+    // ----------------------------------------------------------------------------
+    /** @brief Get the total number of threads, including the calling thread */
+    unsigned int GetNumThreads() const;
+
+    // ----------------------------------------------------------------------------
+    /** @brief Calls fn(i) for every i in [0, count) and returns once all calls
+     *    have finished.
+     *
+     *  The order in which the items are processed is unspecified. If one or more
+     *  calls throw, the first exception caught is rethrown to the caller after all
+     *  items have been processed. */
+    void ParallelFor(unsigned int count, const std::function<void(unsigned int)> &fn);
+
+    // ----------------------------------------------------------------------------
+    /** @brief Get the number of hardware threads, at least 1 */
+    static unsigned int GetHardwareConcurrency();
+
+private:
+    struct Batch;
+    struct Task;
+    struct WorkQueue;
+
+    bool RunPendingTask(unsigned int home);
+    void WorkerMain(unsigned int index);
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+private:
+    std::vector<std::unique_ptr<WorkQueue>> mQueues;
+    std::vector<std::thread> mThreads;
+    std::mutex mMutex;
+    std::condition_variable mWakeUp;
+    std::atomic<unsigned int> mPending;
+    bool mStop;
+};
+
+// --------------------------------------------------------------------------------------------
+/** @brief Calls fn(i) for every i in [0, count), either on the given pool or serially
+ *    on the calling thread if no pool is passed. */
+// --------------------------------------------------------------------------------------------
+inline void ParallelFor(ThreadPool *pool, unsigned int count, const std::function<void(unsigned int)> &fn) {
+    if (nullptr == pool || count < 2) {
+        for (unsigned int i = 0; i < count; ++i) {
+            fn(i);
+        }
+        return;
+    }
+    pool->ParallelFor(count, fn);
+}
+
+} // namespace Assimp
+
+#endif // AI_THREADPOOL_H_INC
@@ -142,6 +142,15 @@ ASSIMP_API aiScene::aiScene() :
 
 // ------------------------------------------------------------------------------------------------
 ASSIMP_API aiScene::~aiScene() {
+    Assimp::ScenePrivateData *priv = static_cast<Assimp::ScenePrivateData *>(mPrivate);
+    if (nullptr != priv && priv->mImage) {
+        // all sub-objects live in the scene image, releasing the private
+        // data releases the image as well. Such scenes are immutable, see
+        // AI_CONFIG_GLOB_SCENE_IMAGE_IN_PLACE
+        delete priv;
+        return;
+    }
+
     // delete all sub-objects recursively
     delete mRootNode;
 
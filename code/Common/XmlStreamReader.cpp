@@ -0,0 +1,476 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+/** @file XmlStreamReader.cpp
+ *  @brief Implementation of the streaming XML pull parser
+ */
+
+#include <assimp/XmlStreamReader.h>
+#include <assimp/Exceptional.h>
+#include <assimp/IOStream.hpp>
+#include <assimp/ai_assert.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+using namespace Assimp;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+inline bool IsXmlSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+// ------------------------------------------------------------------------------------------------
+void AppendUtf8(std::string &out, unsigned long code) {
+    if (code < 0x80) {
+        out.push_back(static_cast<char>(code));
+    } else if (code < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (code >> 6)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    } else if (code < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (code >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | ((code >> 18) & 0x07)));
+        out.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Resolves the predefined and the numeric character entities, unknown ones are kept as they are
+void DecodeEntities(const char *begin, const char *end, std::string &out) {
+    out.clear();
+    out.reserve(end - begin);
+    while (begin < end) {
+        if ('&' != *begin) {
+            out.push_back(*begin++);
+            continue;
+        }
+
+        const char *semicolon = std::find(begin, end, ';');
+        if (semicolon == end) {
+            out.append(begin, end);
+            break;
+        }
+
+        const std::string entity(begin + 1, semicolon);
+        if (entity == "lt") {
+            out.push_back('<');
+        } else if (entity == "gt") {
+            out.push_back('>');
+        } else if (entity == "amp") {
+            out.push_back('&');
+        } else if (entity == "quot") {
+            out.push_back('"');
+        } else if (entity == "apos") {
+            out.push_back('\'');
+        } else if (entity.size() > 1 && '#' == entity[0]) {
+            const bool hex = ('x' == entity[1] || 'X' == entity[1]);
+            AppendUtf8(out, std::strtoul(entity.c_str() + (hex ? 2 : 1), nullptr, hex ? 16 : 10));
+        } else {
+            out.append(begin, semicolon + 1);
+        }
+        begin = semicolon + 1;
+    }
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+XmlStreamReader::XmlStreamReader(IOStream *stream, size_t chunkSize) :
+        mStream(stream),
+        mChunkSize(std::max<size_t>(chunkSize, 16)),
+        mBuffer(mChunkSize),
+        mPos(0),
+        mSize(0),
+        mEof(false),
+        mPendingEnd(false),
+        mNumAttributes(0),
+        mText(nullptr),
+        mTextLength(0) {
+    ai_assert(nullptr != stream);
+
+    // skip the UTF-8 byte order mark
+    if (require(3) && 0 == ::memcmp(&mBuffer[mPos], "\xEF\xBB\xBF", 3)) {
+        mPos += 3;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+XmlStreamReader::~XmlStreamReader() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+// Moves the unread data to the front of the buffer and appends the next chunk of the stream
+bool XmlStreamReader::fill() {
+    if (mEof) {
+        return false;
+    }
+
+    if (mPos > 0) {
+        ::memmove(&mBuffer[0], &mBuffer[mPos], mSize - mPos);
+        mSize -= mPos;
+        mPos = 0;
+    }
+    if (mBuffer.size() < mSize + mChunkSize) {
+        mBuffer.resize(mSize + mChunkSize);
+    }
+
+    const size_t read = mStream->Read(&mBuffer[mSize], 1, mChunkSize);
+    if (0 == read) {
+        mEof = true;
+        return false;
+    }
+    mSize += read;
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Makes sure count bytes are buffered, returns false if the stream ends before
+bool XmlStreamReader::require(size_t count) {
+    while (mSize - mPos < count) {
+        if (!fill()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns the offset of pattern relative to the current position, searching from offset on
+size_t XmlStreamReader::find(size_t offset, const char *pattern) {
+    const size_t length = ::strlen(pattern);
+    for (;;) {
+        const char *begin = &mBuffer[mPos];
+        const char *end = &mBuffer[0] + mSize;
+        const char *hit = std::search(begin + std::min(offset, mSize - mPos), end, pattern, pattern + length);
+        if (hit != end) {
+            return hit - begin;
+        }
+
+        // continue behind the data searched so far, the pattern may start in its last bytes
+        const size_t searched = mSize - mPos;
+        if (searched >= length) {
+            offset = std::max(offset, searched - length + 1);
+        }
+        if (!fill()) {
+            throw DeadlyImportError("XML: unexpected end of file, expected \"", pattern, "\"");
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+XmlStreamReader::Event XmlStreamReader::next() {
+    mNumAttributes = 0;
+    mText = nullptr;
+    mTextLength = 0;
+
+    if (mPendingEnd) {
+        // second half of an empty element tag, mName still holds its name
+        mPendingEnd = false;
+        mOpenElements.pop_back();
+        return Event_EndElement;
+    }
+
+    for (;;) {
+        if (mPos == mSize && !fill()) {
+            if (!mOpenElements.empty()) {
+                throw DeadlyImportError("XML: unexpected end of file in element <", mOpenElements.back(), ">");
+            }
+            return Event_EndOfDocument;
+        }
+
+        if ('<' != mBuffer[mPos]) {
+            if (readText()) {
+                return Event_Text;
+            }
+            continue;
+        }
+
+        require(9);
+        const char *cur = &mBuffer[mPos];
+        const size_t available = mSize - mPos;
+        if (available >= 2 && '?' == cur[1]) {
+            // processing instruction or XML declaration
+            mPos += find(2, "?>") + 2;
+        } else if (available >= 4 && 0 == ::strncmp(cur, "<!--", 4)) {
+            mPos += find(4, "-->") + 3;
+        } else if (available >= 9 && 0 == ::strncmp(cur, "<![CDATA[", 9)) {
+            const size_t end = find(9, "]]>");
+            mText = &mBuffer[mPos + 9];
+            mTextLength = end - 9;
+            mPos += end + 3;
+            if (mTextLength) {
+                return Event_Text;
+            }
+        } else if (available >= 2 && '!' == cur[1]) {
+            skipDoctype();
+        } else if (available >= 2 && '/' == cur[1]) {
+            readEndElement();
+            return Event_EndElement;
+        } else {
+            readStartElement();
+            return Event_StartElement;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Reads character data up to the next markup. Returns false if it is whitespace only.
+bool XmlStreamReader::readText() {
+    for (;;) {
+        const char *begin = &mBuffer[mPos];
+        const size_t available = mSize - mPos;
+        const char *lt = static_cast<const char *>(::memchr(begin, '<', available));
+
+        size_t length = available;
+        if (nullptr != lt) {
+            length = lt - begin;
+        } else if (!mEof) {
+            // top up a nearly drained buffer before cutting the text into pieces
+            if (available < mChunkSize) {
+                fill();
+                continue;
+            }
+
+            // cut behind the last whitespace, so no token is split between two pieces
+            while (length > 0 && !IsXmlSpace(begin[length - 1])) {
+                --length;
+            }
+            if (0 == length) {
+                fill();
+                continue;
+            }
+        }
+        mPos += length;
+
+        const char *end = begin + length;
+        if (std::find_if(begin, end, [](char c) { return !IsXmlSpace(c); }) == end) {
+            return false;
+        }
+
+        if (nullptr != ::memchr(begin, '&', length)) {
+            DecodeEntities(begin, end, mDecodedText);
+            mText = mDecodedText.data();
+            mTextLength = mDecodedText.size();
+        } else {
+            mText = begin;
+            mTextLength = length;
+        }
+        return true;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void XmlStreamReader::readStartElement() {
+    // find the end of the tag, a '>' in an attribute value does not count
+    size_t end = 1;
+    char quote = 0;
+    for (;; ++end) {
+        if (end >= mSize - mPos && !require(end + 1)) {
+            throw DeadlyImportError("XML: unexpected end of file in a start tag");
+        }
+        const char c = mBuffer[mPos + end];
+        if (quote) {
+            if (c == quote) {
+                quote = 0;
+            }
+        } else if ('"' == c || '\'' == c) {
+            quote = c;
+        } else if ('>' == c) {
+            break;
+        }
+    }
+
+    const char *tag = &mBuffer[mPos];
+    const bool isEmpty = ('/' == tag[end - 1]);
+    const size_t tagEnd = isEmpty ? end - 1 : end;
+
+    size_t i = 1;
+    while (i < tagEnd && !IsXmlSpace(tag[i])) {
+        ++i;
+    }
+    if (1 == i) {
+        throw DeadlyImportError("XML: start tag without element name");
+    }
+    mName.assign(tag + 1, i - 1);
+
+    for (;;) {
+        while (i < tagEnd && IsXmlSpace(tag[i])) {
+            ++i;
+        }
+        if (i >= tagEnd) {
+            break;
+        }
+
+        const size_t nameBegin = i;
+        while (i < tagEnd && '=' != tag[i] && !IsXmlSpace(tag[i])) {
+            ++i;
+        }
+        const size_t nameEnd = i;
+        while (i < tagEnd && IsXmlSpace(tag[i])) {
+            ++i;
+        }
+        if (i >= tagEnd || '=' != tag[i]) {
+            throw DeadlyImportError("XML: attribute without value in element <", mName, ">");
+        }
+        ++i;
+        while (i < tagEnd && IsXmlSpace(tag[i])) {
+            ++i;
+        }
+        if (i >= tagEnd || ('"' != tag[i] && '\'' != tag[i])) {
+            throw DeadlyImportError("XML: attribute value without quotes in element <", mName, ">");
+        }
+        const char valueQuote = tag[i++];
+        const size_t valueBegin = i;
+        while (i < tagEnd && valueQuote != tag[i]) {
+            ++i;
+        }
+        if (i >= tagEnd) {
+            throw DeadlyImportError("XML: unterminated attribute value in element <", mName, ">");
+        }
+
+        // the attribute slots are reused, so their strings keep their capacity
+        if (mNumAttributes == mAttributes.size()) {
+            mAttributes.emplace_back();
+        }
+        std::pair<std::string, std::string> &attribute = mAttributes[mNumAttributes++];
+        attribute.first.assign(tag + nameBegin, nameEnd - nameBegin);
+        DecodeEntities(tag + valueBegin, tag + i, attribute.second);
+        ++i;
+    }
+
+    mPos += end + 1;
+    mOpenElements.push_back(mName);
+    mPendingEnd = isEmpty;
+}
+
+// ------------------------------------------------------------------------------------------------
+void XmlStreamReader::readEndElement() {
+    const size_t end = find(2, ">");
+    const char *tag = &mBuffer[mPos];
+
+    size_t nameEnd = end;
+    while (nameEnd > 2 && IsXmlSpace(tag[nameEnd - 1])) {
+        --nameEnd;
+    }
+    mName.assign(tag + 2, nameEnd - 2);
+    mPos += end + 1;
+
+    if (mOpenElements.empty() || mOpenElements.back() != mName) {
+        throw DeadlyImportError("XML: unexpected end tag </", mName, ">");
+    }
+    mOpenElements.pop_back();
+}
+
+// ------------------------------------------------------------------------------------------------
+// Skips a document type declaration, including its internal subset
+void XmlStreamReader::skipDoctype() {
+    int brackets = 0;
+    for (size_t i = 2;; ++i) {
+        if (i >= mSize - mPos && !require(i + 1)) {
+            throw DeadlyImportError("XML: unexpected end of file in a document type declaration");
+        }
+        const char c = mBuffer[mPos + i];
+        if ('[' == c) {
+            ++brackets;
+        } else if (']' == c) {
+            --brackets;
+        } else if ('>' == c && brackets <= 0) {
+            mPos += i + 1;
+            return;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+const std::string &XmlStreamReader::getName() const {
+    return mName;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t XmlStreamReader::getDepth() const {
+    return mOpenElements.size();
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t XmlStreamReader::getNumAttributes() const {
+    return mNumAttributes;
+}
+
+// ------------------------------------------------------------------------------------------------
+const std::string &XmlStreamReader::getAttributeName(size_t index) const {
+    ai_assert(index < mNumAttributes);
+    return mAttributes[index].first;
+}
+
+// ------------------------------------------------------------------------------------------------
+const std::string &XmlStreamReader::getAttributeValue(size_t index) const {
+    ai_assert(index < mNumAttributes);
+    return mAttributes[index].second;
+}
+
+// ------------------------------------------------------------------------------------------------
+const char *XmlStreamReader::getAttribute(const char *name) const {
+    for (size_t i = 0; i < mNumAttributes; ++i) {
+        if (mAttributes[i].first == name) {
+            return mAttributes[i].second.c_str();
+        }
+    }
+    return nullptr;
+}
+
+// ------------------------------------------------------------------------------------------------
+const char *XmlStreamReader::getText() const {
+    return mText;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t XmlStreamReader::getTextLength() const {
+    return mTextLength;
+}
@@ -52,8 +52,189 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/types.h>
 #include <assimp/DefaultLogger.hpp>
 
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 using namespace Assimp;
 
+namespace {
+
+// Materials with fewer properties are searched linearly, which beats hashing the key
+const unsigned int MinIndexedProperties = 16;
+
+// ------------------------------------------------------------------------------------------------
+// FNV-1a hash of a property key, combined with its semantic and index
+uint32_t HashPropertyKey(const char *key, unsigned int type, unsigned int index) {
+    uint32_t hash = 2166136261u;
+    for (; *key; ++key) {
+        hash = (hash ^ static_cast<unsigned char>(*key)) * 16777619u;
+    }
+    hash = (hash ^ type) * 16777619u;
+    hash = (hash ^ index) * 16777619u;
+    return hash;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool IsProperty(const aiMaterialProperty *prop, const char *key, unsigned int type, unsigned int index) {
+    return prop /* just for safety ... */
+            && prop->mSemantic == type && prop->mIndex == index && 0 == strcmp(prop->mKey.data, key);
+}
+
+} // namespace
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+// Open-addressing hash table mapping (key, semantic, index) to the position of a property in
+// aiMaterial::mProperties. It keeps a copy of the property pointers it was built for. If they
+// no longer match the material, e.g. because a property was replaced through mProperties[i],
+// lookups search linearly until the next change made through aiMaterial brings the index up
+// to date.
+class MaterialPropertyIndex {
+public:
+    // Position of the first property with exactly this key, semantic and index in the property
+    // array of a material, or UINT_MAX if there is none.
+    static unsigned int Find(const aiMaterial *mat, const char *key, unsigned int type, unsigned int index) {
+        if (mat->mNumProperties >= MinIndexedProperties) {
+            Shard &shard = GetShard(mat->mProperties);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            const auto it = shard.indices.find(mat->mProperties);
+            if (it != shard.indices.end() && it->second->IsValidFor(mat)) {
+                return it->second->Find(key, type, index);
+            }
+        }
+        for (unsigned int i = 0; i < mat->mNumProperties; ++i) {
+            if (IsProperty(mat->mProperties[i], key, type, index)) {
+                return i;
+            }
+        }
+        return UINT_MAX;
+    }
+
+    // Bring the index of a material up to date after properties were added or replaced. Small
+    // materials go without one.
+    static void Update(const aiMaterial *mat) {
+        if (mat->mNumProperties < MinIndexedProperties) {
+            return;
+        }
+        Shard &shard = GetShard(mat->mProperties);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        std::unique_ptr<MaterialPropertyIndex> &propertyIndex = shard.indices[mat->mProperties];
+        if (!propertyIndex) {
+            propertyIndex.reset(new MaterialPropertyIndex());
+        }
+        propertyIndex->Sync(mat);
+    }
+
+    // Drop the index of a material before its property array is freed or properties are
+    // removed. Only materials which were large enough at their last change can have one.
+    static void Release(const aiMaterial *mat) {
+        if (mat->mNumProperties < MinIndexedProperties) {
+            return;
+        }
+        Shard &shard = GetShard(mat->mProperties);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.indices.erase(mat->mProperties);
+    }
+
+private:
+    // The indices live outside of aiMaterial so that the layout C sees stays the same. They are
+    // keyed by the property array they were built for, which aiMaterial drops from here before
+    // it frees the array. An index left behind by code that freed the array itself is only used
+    // while it holds exactly the property pointers of the material asking, so another array at
+    // the same address never picks up its positions. Each shard has its own lock.
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<aiMaterialProperty *const *, std::unique_ptr<MaterialPropertyIndex>> indices;
+    };
+
+    static const size_t NumShards = 64;
+
+    static Shard &GetShard(aiMaterialProperty *const *properties) {
+        // never destroyed, materials may still be released during static destruction
+        static Shard *shards = new Shard[NumShards];
+        return shards[(reinterpret_cast<uintptr_t>(properties) / sizeof(void *)) % NumShards];
+    }
+
+    struct Slot {
+        uint32_t hash = 0;
+        unsigned int position = 0; ///< Position in the property array + 1, 0 for empty slots
+    };
+
+    // Keep the table at most half full
+    static size_t GetTableSize(unsigned int numProperties) {
+        size_t size = 32;
+        while (size < 2 * static_cast<size_t>(numProperties)) {
+            size *= 2;
+        }
+        return size;
+    }
+
+    // Whether the first count properties of the material are the ones the index was built for
+    bool Matches(const aiMaterial *mat, size_t count) const {
+        return count <= mProperties.size() &&
+               0 == ::memcmp(mProperties.data(), mat->mProperties, count * sizeof(aiMaterialProperty *));
+    }
+
+    bool IsValidFor(const aiMaterial *mat) const {
+        return mProperties.size() == mat->mNumProperties && Matches(mat, mat->mNumProperties);
+    }
+
+    void Sync(const aiMaterial *mat) {
+        const unsigned int num = mat->mNumProperties;
+        if (mProperties.size() + 1 == num && mSlots.size() >= GetTableSize(num) && Matches(mat, num - 1)) {
+            // one property was appended
+            const aiMaterialProperty *prop = mat->mProperties[num - 1];
+            mProperties.push_back(mat->mProperties[num - 1]);
+            if (UINT_MAX == Find(prop->mKey.data, prop->mSemantic, prop->mIndex)) {
+                Insert(HashPropertyKey(prop->mKey.data, prop->mSemantic, prop->mIndex), num - 1);
+            }
+        } else if (!IsValidFor(mat)) {
+            Build(mat);
+        }
+    }
+
+    void Build(const aiMaterial *mat) {
+        mProperties.assign(mat->mProperties, mat->mProperties + mat->mNumProperties);
+        mSlots.assign(GetTableSize(mat->mNumProperties), Slot());
+        for (unsigned int i = 0; i < mat->mNumProperties; ++i) {
+            const aiMaterialProperty *prop = mProperties[i];
+            // the linear search returns the first match, so skip duplicates
+            if (prop && UINT_MAX == Find(prop->mKey.data, prop->mSemantic, prop->mIndex)) {
+                Insert(HashPropertyKey(prop->mKey.data, prop->mSemantic, prop->mIndex), i);
+            }
+        }
+    }
+
+    unsigned int Find(const char *key, unsigned int type, unsigned int index) const {
+        const uint32_t hash = HashPropertyKey(key, type, index);
+        const size_t mask = mSlots.size() - 1;
+        for (size_t i = hash & mask; mSlots[i].position; i = (i + 1) & mask) {
+            if (mSlots[i].hash == hash && IsProperty(mProperties[mSlots[i].position - 1], key, type, index)) {
+                return mSlots[i].position - 1;
+            }
+        }
+        return UINT_MAX;
+    }
+
+    void Insert(uint32_t hash, unsigned int position) {
+        const size_t mask = mSlots.size() - 1;
+        size_t i = hash & mask;
+        while (mSlots[i].position) {
+            i = (i + 1) & mask;
+        }
+        mSlots[i].hash = hash;
+        mSlots[i].position = position + 1;
+    }
+
+    std::vector<aiMaterialProperty *> mProperties;
+    std::vector<Slot> mSlots;
+};
+
+} // namespace Assimp
+
 // ------------------------------------------------------------------------------------------------
 // Get a specific property from a material
 aiReturn aiGetMaterialProperty(const aiMaterial *pMat,
@@ -65,19 +246,28 @@ aiReturn aiGetMaterialProperty(const aiMaterial *pMat,
     ai_assert(pKey != nullptr);
     ai_assert(pPropOut != nullptr);
 
-    /*  Just search for a property with exactly this name ..
-     *  could be improved by hashing, but it's possibly
-     *  no worth the effort (we're bound to C structures,
-     *  thus std::map or derivates are not applicable. */
-    for (unsigned int i = 0; i < pMat->mNumProperties; ++i) {
-        aiMaterialProperty *prop = pMat->mProperties[i];
+    /*  UINT_MAX is a wild-card, but this is undocumented :-)
+     *  Such queries just search the whole list. */
+    if (UINT_MAX == type || UINT_MAX == index) {
+        for (unsigned int i = 0; i < pMat->mNumProperties; ++i) {
+            aiMaterialProperty *prop = pMat->mProperties[i];
 
-        if (prop /* just for safety ... */
-                && 0 == strcmp(prop->mKey.data, pKey) && (UINT_MAX == type || prop->mSemantic == type) /* UINT_MAX is a wild-card, but this is undocumented :-) */
-                && (UINT_MAX == index || prop->mIndex == index)) {
-            *pPropOut = pMat->mProperties[i];
-            return AI_SUCCESS;
+            if (prop /* just for safety ... */
+                    && 0 == strcmp(prop->mKey.data, pKey) && (UINT_MAX == type || prop->mSemantic == type) && (UINT_MAX == index || prop->mIndex == index)) {
+                *pPropOut = pMat->mProperties[i];
+                return AI_SUCCESS;
+            }
         }
+        *pPropOut = nullptr;
+        return AI_FAILURE;
+    }
+
+    /*  Search for a property with exactly this name. Larger materials
+     *  are looked up through a hash index. */
+    const unsigned int i = MaterialPropertyIndex::Find(pMat, pKey, type, index);
+    if (UINT_MAX != i) {
+        *pPropOut = pMat->mProperties[i];
+        return AI_SUCCESS;
     }
     *pPropOut = nullptr;
     return AI_FAILURE;
@@ -411,6 +601,7 @@ aiString aiMaterial::GetName() const {
 
 // ------------------------------------------------------------------------------------------------
 void aiMaterial::Clear() {
+    MaterialPropertyIndex::Release(this);
     for (unsigned int i = 0; i < mNumProperties; ++i) {
         // delete this entry
         delete mProperties[i];
@@ -425,24 +616,22 @@ void aiMaterial::Clear() {
 aiReturn aiMaterial::RemoveProperty(const char *pKey, unsigned int type, unsigned int index) {
     ai_assert(nullptr != pKey);
 
-    for (unsigned int i = 0; i < mNumProperties; ++i) {
-        aiMaterialProperty *prop = mProperties[i];
+    const unsigned int i = MaterialPropertyIndex::Find(this, pKey, type, index);
+    if (UINT_MAX == i) {
+        return AI_FAILURE;
+    }
 
-        if (prop && !strcmp(prop->mKey.data, pKey) &&
-                prop->mSemantic == type && prop->mIndex == index) {
-            // Delete this entry
-            delete mProperties[i];
+    // Delete this entry
+    MaterialPropertyIndex::Release(this);
+    delete mProperties[i];
 
-            // collapse the array behind --.
-            --mNumProperties;
-            for (unsigned int a = i; a < mNumProperties; ++a) {
-                mProperties[a] = mProperties[a + 1];
-            }
-            return AI_SUCCESS;
-        }
+    // collapse the array behind --.
+    --mNumProperties;
+    for (unsigned int a = i; a < mNumProperties; ++a) {
+        mProperties[a] = mProperties[a + 1];
     }
-
-    return AI_FAILURE;
+    MaterialPropertyIndex::Update(this);
+    return AI_SUCCESS;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -461,17 +650,7 @@ aiReturn aiMaterial::AddBinaryProperty(const void *pInput,
     }
 
     // first search the list whether there is already an entry with this key
-    unsigned int iOutIndex(UINT_MAX);
-    for (unsigned int i = 0; i < mNumProperties; ++i) {
-        aiMaterialProperty *prop(mProperties[i]);
-
-        if (prop /* just for safety */ && !strcmp(prop->mKey.data, pKey) &&
-                prop->mSemantic == type && prop->mIndex == index) {
-
-            delete mProperties[i];
-            iOutIndex = i;
-        }
-    }
+    const unsigned int iOutIndex = MaterialPropertyIndex::Find(this, pKey, type, index);
 
     // Allocate a new material property
     aiMaterialProperty *pcNew = new aiMaterialProperty();
@@ -490,7 +669,9 @@ aiReturn aiMaterial::AddBinaryProperty(const void *pInput,
     strcpy(pcNew->mKey.data, pKey);
 
     if (UINT_MAX != iOutIndex) {
+        delete mProperties[iOutIndex];
         mProperties[iOutIndex] = pcNew;
+        MaterialPropertyIndex::Update(this);
         return AI_SUCCESS;
     }
 
@@ -510,12 +691,16 @@ aiReturn aiMaterial::AddBinaryProperty(const void *pInput,
         // just copy all items over; then replace the old array
         memcpy(ppTemp, mProperties, iOld * sizeof(void *));
 
+        MaterialPropertyIndex::Release(this);
         delete[] mProperties;
         mProperties = ppTemp;
     }
     // push back ...
     mProperties[mNumProperties++] = pcNew;
 
+    // ... and keep the index up to date
+    MaterialPropertyIndex::Update(this);
+
     return AI_SUCCESS;
 }
 
@@ -561,6 +746,7 @@ void aiMaterial::CopyPropertyList(aiMaterial *pcDest,
     ai_assert(nullptr != pcDest);
     ai_assert(nullptr != pcSrc);
 
+    MaterialPropertyIndex::Release(pcDest);
     unsigned int iOldNum = pcDest->mNumProperties;
     pcDest->mNumAllocated += pcSrc->mNumAllocated;
     pcDest->mNumProperties += pcSrc->mNumProperties;
@@ -606,4 +792,5 @@ void aiMaterial::CopyPropertyList(aiMaterial *pcDest,
         prop->mData = new char[propSrc->mDataLength];
         memcpy(prop->mData, propSrc->mData, prop->mDataLength);
     }
+    MaterialPropertyIndex::Update(pcDest);
 }
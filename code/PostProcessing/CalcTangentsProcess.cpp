@@ -92,9 +92,16 @@ void CalcTangentsProcess::Execute(aiScene *pScene) {
 
     ASSIMP_LOG_DEBUG("CalcTangentsProcess begin");
 
+    // the meshes don't depend on each other, don't use std::vector<bool> here
+    // as its elements can't be written from several threads
+    std::vector<unsigned char> generated(pScene->mNumMeshes, 0);
+    ForEachMesh(pScene->mNumMeshes, [&](unsigned int a) {
+        generated[a] = ProcessMesh(pScene->mMeshes[a], a);
+    });
+
     bool bHas = false;
     for (unsigned int a = 0; a < pScene->mNumMeshes; a++) {
-        if (ProcessMesh(pScene->mMeshes[a], a)) bHas = true;
+        if (generated[a]) bHas = true;
     }
 
     if (bHas) {
@@ -336,6 +336,9 @@ void FlipWindingOrderProcess::Execute(aiScene *pScene) {
 // ------------------------------------------------------------------------------------------------
 // Converts a single mesh
 void FlipWindingOrderProcess::ProcessMesh(aiMesh *pMesh) {
+    // the meshlets keep the old order
+    pMesh->ReleaseMeshlets();
+
     // invert the order of all faces in this mesh
     for (unsigned int a = 0; a < pMesh->mNumFaces; a++) {
         aiFace &face = pMesh->mFaces[a];
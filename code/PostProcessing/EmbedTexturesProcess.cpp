@@ -44,12 +44,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/ParsingUtils.h>
 #include "ProcessHelper.h"
 
-#include <fstream>
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
 
 using namespace Assimp;
 
 EmbedTexturesProcess::EmbedTexturesProcess()
-: BaseProcess() {
+: BaseProcess()
+, mIOHandler(nullptr) {
 }
 
 EmbedTexturesProcess::~EmbedTexturesProcess() {
@@ -62,6 +64,7 @@ bool EmbedTexturesProcess::IsActive(unsigned int pFlags) const {
 void EmbedTexturesProcess::SetupProperties(const Importer* pImp) {
     mRootPath = pImp->GetPropertyString("sourceFilePath");
     mRootPath = mRootPath.substr(0, mRootPath.find_last_of("\\/") + 1u);
+    mIOHandler = pImp->GetIOHandler();
 }
 
 void EmbedTexturesProcess::Execute(aiScene* pScene) {
@@ -97,31 +100,33 @@ void EmbedTexturesProcess::Execute(aiScene* pScene) {
 }
 
 bool EmbedTexturesProcess::addTexture(aiScene* pScene, std::string path) const {
-    std::streampos imageSize = 0;
-    std::string    imagePath = path;
-
-    // Test path directly
-    std::ifstream file(imagePath, std::ios::binary | std::ios::ate);
-    if ((imageSize = file.tellg()) == std::streampos(-1)) {
-        ASSIMP_LOG_WARN_F("EmbedTexturesProcess: Cannot find image: ", imagePath, ". Will try to find it in root folder.");
+    // read through the importer's IOSystem, so custom file systems see the textures too
+    IOSystem *io = mIOHandler;
+    IOStream *file = io->Open(path);
+    if (nullptr == file) {
+        ASSIMP_LOG_WARN_F("EmbedTexturesProcess: Cannot find image: ", path, ". Will try to find it in root folder.");
 
         // Test path in root path
-        imagePath = mRootPath + path;
-        file.open(imagePath, std::ios::binary | std::ios::ate);
-        if ((imageSize = file.tellg()) == std::streampos(-1)) {
+        file = io->Open(mRootPath + path);
+        if (nullptr == file) {
             // Test path basename in root path
-            imagePath = mRootPath + path.substr(path.find_last_of("\\/") + 1u);
-            file.open(imagePath, std::ios::binary | std::ios::ate);
-            if ((imageSize = file.tellg()) == std::streampos(-1)) {
+            file = io->Open(mRootPath + path.substr(path.find_last_of("\\/") + 1u));
+            if (nullptr == file) {
                 ASSIMP_LOG_ERROR_F("EmbedTexturesProcess: Unable to embed texture: ", path, ".");
                 return false;
             }
         }
     }
 
-    aiTexel* imageContent = new aiTexel[ 1ul + static_cast<unsigned long>( imageSize ) / sizeof(aiTexel)];
-    file.seekg(0, std::ios::beg);
-    file.read(reinterpret_cast<char*>(imageContent), imageSize);
+    const size_t imageSize = file->FileSize();
+    aiTexel* imageContent = new aiTexel[ 1ul + imageSize / sizeof(aiTexel)];
+    const bool ok = 0 == imageSize || file->Read(imageContent, imageSize, 1) == 1;
+    io->Close(file);
+    if (!ok) {
+        delete [] imageContent;
+        ASSIMP_LOG_ERROR_F("EmbedTexturesProcess: Unable to read texture: ", path, ".");
+        return false;
+    }
 
     // Enlarging the textures table
     unsigned int textureId = pScene->mNumTextures++;
@@ -50,6 +50,8 @@ struct aiNode;
 
 namespace Assimp {
 
+class IOSystem;
+
 /**
  *  Force embedding of textures (using the path = "*1" convention).
  *  If a texture's file does not exist at the specified path
@@ -80,6 +82,7 @@ private:
 
 private:
     std::string mRootPath;
+    IOSystem* mIOHandler;
 };
 
 } // namespace Assimp
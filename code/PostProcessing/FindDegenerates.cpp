@@ -254,6 +254,11 @@ evil_jump_outside:
         continue;
     }
 
+    // the meshlets refer to the faces as they were
+    if (deg) {
+        mesh->ReleaseMeshlets();
+    }
+
     // If AI_CONFIG_PP_FD_REMOVE is true, remove degenerated faces from the import
     if (mConfigRemoveDegenerates && deg) {
         unsigned int n = 0;
@@ -274,8 +279,11 @@ evil_jump_outside:
                 }
             }
             else {
-                // Otherwise delete it if we don't need this face
-                delete[] face_src.mIndices;
+                // Otherwise delete it if we don't need this face,
+                // indices from the mesh's index pool stay in the pool
+                if (!mesh->IsPooledFace(face_src)) {
+                    delete[] face_src.mIndices;
+                }
                 face_src.mIndices = nullptr;
                 face_src.mNumIndices = 0;
             }
@@ -47,7 +47,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 
 #include "FindInstancesProcess.h"
+#include <assimp/commonMetaData.h>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <map>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 #include <stdio.h>
 
 using namespace Assimp;
@@ -104,6 +111,13 @@ bool CompareBones(const aiMesh* orig, const aiMesh* inst)
     return true;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Meshes kept so far which share a hash, by the x coordinate of their first vertex
+struct MeshBucket {
+    std::multimap<float, unsigned int> sorted;
+    std::vector<unsigned int> unsorted;
+};
+
 // ------------------------------------------------------------------------------------------------
 // Update mesh indices in the node graph
 void UpdateMeshIndices(aiNode* node, unsigned int* lookup)
@@ -127,130 +141,165 @@ void FindInstancesProcess::Execute( aiScene* pScene)
         // in the pipeline, so we could, depending on the file format,
         // have several thousand small meshes. That's too much for a brute
         // everyone-against-everyone check involving up to 10 comparisons
-        // each.
-        std::unique_ptr<uint64_t[]> hashes (new uint64_t[pScene->mNumMeshes]);
-        std::unique_ptr<unsigned int[]> remapping (new unsigned int[pScene->mNumMeshes]);
+        // each. Meshes with equal hashes share a bucket, which is sorted
+        // by the x coordinate of the first vertex: two meshes can only
+        // be equal if these differ by less than the epsilon.
+        const unsigned int numMeshes = pScene->mNumMeshes;
+        std::vector<uint64_t> hashes(numMeshes);
+        std::vector<float> epsilons(numMeshes);
+        std::vector<float> keys(numMeshes);
+        std::unique_ptr<unsigned int[]> remapping (new unsigned int[numMeshes]);
+
+        ForEachMesh(numMeshes, [&](unsigned int i) {
+            aiMesh* mesh = pScene->mMeshes[i];
+            hashes[i] = GetMeshHash(mesh);
+
+            // Find an appropriate epsilon
+            // to compare position differences against
+            epsilons[i] = ComputePositionEpsilon(mesh);
+            keys[i] = mesh->HasPositions() && mesh->mNumVertices ? static_cast<float>(mesh->mVertices[0].x) : 0.f;
+        });
+
+        std::unordered_map<uint64_t, MeshBucket> buckets;
+        std::vector<unsigned int> candidates;
 
         unsigned int numMeshesOut = 0;
-        for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+        for (unsigned int i = 0; i < numMeshes; ++i) {
 
             aiMesh* inst = pScene->mMeshes[i];
-            hashes[i] = GetMeshHash(inst);
+            MeshBucket& bucket = buckets[hashes[i]];
+            const float key = keys[i];
+            float epsilon = epsilons[i];
+
+            // Collect the meshes of the bucket which may be equal. Non-finite
+            // coordinates compare equal to anything, so these are always checked.
+            candidates.assign(bucket.unsorted.begin(), bucket.unsorted.end());
+            if (std::isfinite(key)) {
+                // widened a bit, the range must not lose matches to rounding
+                const float range = epsilon * 1.001f + std::fabs(key) * 1e-6f;
+                const auto last = bucket.sorted.upper_bound(key + range);
+                for (auto it = bucket.sorted.lower_bound(key - range); it != last; ++it) {
+                    candidates.push_back(it->second);
+                }
+            } else {
+                for (const auto& entry : bucket.sorted) {
+                    candidates.push_back(entry.second);
+                }
+            }
 
-            // Find an appropriate epsilon 
-            // to compare position differences against
-            float epsilon = ComputePositionEpsilon(inst);
+            // the closest preceding mesh wins, as with a linear scan
+            std::sort(candidates.begin(), candidates.end(), std::greater<unsigned int>());
             epsilon *= epsilon;
 
-            for (int a = i-1; a >= 0; --a) {
-                if (hashes[i] == hashes[a])
-                {
-                    aiMesh* orig = pScene->mMeshes[a];
-                    if (!orig)
+            for (const unsigned int a : candidates) {
+                aiMesh* orig = pScene->mMeshes[a];
+
+                // check for hash collision .. we needn't check
+                // the vertex format, it *must* match due to the
+                // (brilliant) construction of the hash
+                if (orig->mNumBones       != inst->mNumBones      ||
+                    orig->mNumFaces       != inst->mNumFaces      ||
+                    orig->mNumVertices    != inst->mNumVertices   ||
+                    orig->mMaterialIndex  != inst->mMaterialIndex ||
+                    orig->mPrimitiveTypes != inst->mPrimitiveTypes)
+                    continue;
+
+                // up to now the meshes are equal. Now compare vertex positions, normals,
+                // tangents and bitangents using this epsilon.
+                if (orig->HasPositions()) {
+                    if(!CompareArrays(orig->mVertices,inst->mVertices,orig->mNumVertices,epsilon))
                         continue;
-
-                    // check for hash collision .. we needn't check
-                    // the vertex format, it *must* match due to the
-                    // (brilliant) construction of the hash
-                    if (orig->mNumBones       != inst->mNumBones      ||
-                        orig->mNumFaces       != inst->mNumFaces      ||
-                        orig->mNumVertices    != inst->mNumVertices   ||
-                        orig->mMaterialIndex  != inst->mMaterialIndex ||
-                        orig->mPrimitiveTypes != inst->mPrimitiveTypes)
+                }
+                if (orig->HasNormals()) {
+                    if(!CompareArrays(orig->mNormals,inst->mNormals,orig->mNumVertices,epsilon))
+                        continue;
+                }
+                if (orig->HasTangentsAndBitangents()) {
+                    if (!CompareArrays(orig->mTangents,inst->mTangents,orig->mNumVertices,epsilon) ||
+                        !CompareArrays(orig->mBitangents,inst->mBitangents,orig->mNumVertices,epsilon))
                         continue;
+                }
 
-                    // up to now the meshes are equal. Now compare vertex positions, normals,
-                    // tangents and bitangents using this epsilon.
-                    if (orig->HasPositions()) {
-                        if(!CompareArrays(orig->mVertices,inst->mVertices,orig->mNumVertices,epsilon))
+                // use a constant epsilon for colors and UV coordinates
+                static const float uvEpsilon = 10e-4f;
+                {
+                    unsigned int j, end = orig->GetNumUVChannels();
+                    for(j = 0; j < end; ++j) {
+                        if (!orig->mTextureCoords[j]) {
                             continue;
+                        }
+                        if(!CompareArrays(orig->mTextureCoords[j],inst->mTextureCoords[j],orig->mNumVertices,uvEpsilon)) {
+                            break;
+                        }
                     }
-                    if (orig->HasNormals()) {
-                        if(!CompareArrays(orig->mNormals,inst->mNormals,orig->mNumVertices,epsilon))
-                            continue;
+                    if (j != end) {
+                        continue;
                     }
-                    if (orig->HasTangentsAndBitangents()) {
-                        if (!CompareArrays(orig->mTangents,inst->mTangents,orig->mNumVertices,epsilon) ||
-                            !CompareArrays(orig->mBitangents,inst->mBitangents,orig->mNumVertices,epsilon))
+                }
+                {
+                    unsigned int j, end = orig->GetNumColorChannels();
+                    for(j = 0; j < end; ++j) {
+                        if (!orig->mColors[j]) {
                             continue;
-                    }
-
-                    // use a constant epsilon for colors and UV coordinates
-                    static const float uvEpsilon = 10e-4f;
-                    {
-                        unsigned int j, end = orig->GetNumUVChannels();
-                        for(j = 0; j < end; ++j) {
-                            if (!orig->mTextureCoords[j]) {
-                                continue;
-                            }
-                            if(!CompareArrays(orig->mTextureCoords[j],inst->mTextureCoords[j],orig->mNumVertices,uvEpsilon)) {
-                                break;
-                            }
                         }
-                        if (j != end) {
-                            continue;
+                        if(!CompareArrays(orig->mColors[j],inst->mColors[j],orig->mNumVertices,uvEpsilon)) {
+                            break;
                         }
                     }
-                    {
-                        unsigned int j, end = orig->GetNumColorChannels();
-                        for(j = 0; j < end; ++j) {
-                            if (!orig->mColors[j]) {
-                                continue;
-                            }
-                            if(!CompareArrays(orig->mColors[j],inst->mColors[j],orig->mNumVertices,uvEpsilon)) {
-                                break;
-                            }
-                        }
-                        if (j != end) {
-                            continue;
-                        }
+                    if (j != end) {
+                        continue;
                     }
+                }
 
-                    // These two checks are actually quite expensive and almost *never* required.
-                    // Almost. That's why they're still here. But there's no reason to do them
-                    // in speed-targeted imports.
-                    if (!configSpeedFlag) {
-
-                        // It seems to be strange, but we really need to check whether the
-                        // bones are identical too. Although it's extremely unprobable
-                        // that they're not if control reaches here, we need to deal
-                        // with unprobable cases, too. It could still be that there are
-                        // equal shapes which are deformed differently.
-                        if (!CompareBones(orig,inst))
-                            continue;
+                // These two checks are actually quite expensive and almost *never* required.
+                // Almost. That's why they're still here. But there's no reason to do them
+                // in speed-targeted imports.
+                if (!configSpeedFlag) {
+
+                    // It seems to be strange, but we really need to check whether the
+                    // bones are identical too. Although it's extremely unprobable
+                    // that they're not if control reaches here, we need to deal
+                    // with unprobable cases, too. It could still be that there are
+                    // equal shapes which are deformed differently.
+                    if (!CompareBones(orig,inst))
+                        continue;
 
-                        // For completeness ... compare even the index buffers for equality
-                        // face order & winding order doesn't care. Input data is in verbose format.
-                        std::unique_ptr<unsigned int[]> ftbl_orig(new unsigned int[orig->mNumVertices]);
-                        std::unique_ptr<unsigned int[]> ftbl_inst(new unsigned int[orig->mNumVertices]);
+                    // For completeness ... compare even the index buffers for equality
+                    // face order & winding order doesn't care. Input data is in verbose format.
+                    std::unique_ptr<unsigned int[]> ftbl_orig(new unsigned int[orig->mNumVertices]);
+                    std::unique_ptr<unsigned int[]> ftbl_inst(new unsigned int[orig->mNumVertices]);
 
-                        for (unsigned int tt = 0; tt < orig->mNumFaces;++tt) {
-                            aiFace& f = orig->mFaces[tt];
-                            for (unsigned int nn = 0; nn < f.mNumIndices;++nn)
-                                ftbl_orig[f.mIndices[nn]] = tt;
+                    for (unsigned int tt = 0; tt < orig->mNumFaces;++tt) {
+                        aiFace& f = orig->mFaces[tt];
+                        for (unsigned int nn = 0; nn < f.mNumIndices;++nn)
+                            ftbl_orig[f.mIndices[nn]] = tt;
 
-                            aiFace& f2 = inst->mFaces[tt];
-                            for (unsigned int nn = 0; nn < f2.mNumIndices;++nn)
-                                ftbl_inst[f2.mIndices[nn]] = tt;
-                        }
-                        if (0 != ::memcmp(ftbl_inst.get(),ftbl_orig.get(),orig->mNumVertices*sizeof(unsigned int)))
-                            continue;
+                        aiFace& f2 = inst->mFaces[tt];
+                        for (unsigned int nn = 0; nn < f2.mNumIndices;++nn)
+                            ftbl_inst[f2.mIndices[nn]] = tt;
                     }
+                    if (0 != ::memcmp(ftbl_inst.get(),ftbl_orig.get(),orig->mNumVertices*sizeof(unsigned int)))
+                        continue;
+                }
 
-                    // We're still here. Or in other words: 'inst' is an instance of 'orig'.
-                    // Place a marker in our list that we can easily update mesh indices.
-                    remapping[i] = remapping[a];
+                // We're still here. Or in other words: 'inst' is an instance of 'orig'.
+                // Place a marker in our list that we can easily update mesh indices.
+                remapping[i] = remapping[a];
 
-                    // Delete the instanced mesh, we don't need it anymore
-                    delete inst;
-                    pScene->mMeshes[i] = nullptr;
-                    break;
-                }
+                // Delete the instanced mesh, we don't need it anymore
+                delete inst;
+                pScene->mMeshes[i] = nullptr;
+                break;
             }
 
             // If we didn't find a match for the current mesh: keep it
             if (pScene->mMeshes[i]) {
                 remapping[i] = numMeshesOut++;
+                if (std::isfinite(key)) {
+                    bucket.sorted.insert(std::make_pair(key, i));
+                } else {
+                    bucket.unsorted.push_back(i);
+                }
             }
         }
         ai_assert(0 != numMeshesOut);
@@ -265,9 +314,17 @@ void FindInstancesProcess::Execute( aiScene* pScene)
             // And update the node graph with our nice lookup table
             UpdateMeshIndices(pScene->mRootNode,remapping.get());
 
-            // write to log
+            // write to log and keep the count with the scene
+            const unsigned int numInstances = pScene->mNumMeshes - numMeshesOut;
             if (!DefaultLogger::isNullLogger()) {
-                ASSIMP_LOG_INFO_F( "FindInstancesProcess finished. Found ", (pScene->mNumMeshes - numMeshesOut), " instances" );
+                ASSIMP_LOG_INFO_F( "FindInstancesProcess finished. Found ", numInstances, " instances" );
+            }
+            if (!pScene->mMetaData) {
+                pScene->mMetaData = new aiMetadata;
+            }
+            const uint64_t collapsed = numInstances;
+            if (!pScene->mMetaData->Set(AI_METADATA_COLLAPSED_INSTANCES, collapsed)) {
+                pScene->mMetaData->Add(AI_METADATA_COLLAPSED_INSTANCES, collapsed);
             }
             pScene->mNumMeshes = numMeshesOut;
         } else {
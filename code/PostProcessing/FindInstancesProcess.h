@@ -49,6 +49,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Common/BaseProcess.h"
 #include "PostProcessing/ProcessHelper.h"
 
+#include <algorithm>
+
 class FindInstancesProcessTest;
 namespace Assimp    {
 
@@ -74,6 +76,9 @@ uint64_t GetMeshHash(aiMesh* in) {
         (in->mPrimitiveTypes<<28)) & 0xffffffff );
 }
 
+/** Number of elements CompareArrays() checks before it tests for a difference */
+static const unsigned int CompareBlockSize = 16;
+
 // -------------------------------------------------------------------------------
 /** @brief Perform a component-wise comparison of two arrays
  *
@@ -86,8 +91,14 @@ uint64_t GetMeshHash(aiMesh* in) {
 inline
 bool CompareArrays(const aiVector3D* first, const aiVector3D* second,
         unsigned int size, float e) {
-    for (const aiVector3D* end = first+size; first != end; ++first,++second) {
-        if ( (*first - *second).SquareLength() >= e)
+    // blocks without an early exit inside, so the compiler can vectorize them
+    for (unsigned int i = 0; i < size; i += CompareBlockSize) {
+        const unsigned int end = std::min(size, i + CompareBlockSize);
+        bool differ = false;
+        for (unsigned int j = i; j < end; ++j) {
+            differ |= (first[j] - second[j]).SquareLength() >= e;
+        }
+        if (differ)
             return false;
     }
     return true;
@@ -97,8 +108,13 @@ bool CompareArrays(const aiVector3D* first, const aiVector3D* second,
 inline bool CompareArrays(const aiColor4D* first, const aiColor4D* second,
     unsigned int size, float e)
 {
-    for (const aiColor4D* end = first+size; first != end; ++first,++second) {
-        if ( GetColorDifference(*first,*second) >= e)
+    for (unsigned int i = 0; i < size; i += CompareBlockSize) {
+        const unsigned int end = std::min(size, i + CompareBlockSize);
+        bool differ = false;
+        for (unsigned int j = i; j < end; ++j) {
+            differ |= GetColorDifference(first[j], second[j]) >= e;
+        }
+        if (differ)
             return false;
     }
     return true;
@@ -107,7 +123,7 @@ inline bool CompareArrays(const aiColor4D* first, const aiColor4D* second,
 // ---------------------------------------------------------------------------
 /** @brief A post-processing steps to search for instanced meshes
 */
-class FindInstancesProcess : public BaseProcess
+class ASSIMP_API FindInstancesProcess : public BaseProcess
 {
 public:
 
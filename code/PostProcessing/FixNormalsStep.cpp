@@ -171,7 +171,8 @@ bool FixInfacingNormalsProcess::ProcessMesh( aiMesh* pcMesh, unsigned int index)
         for (unsigned int i = 0; i < pcMesh->mNumVertices;++i)
             pcMesh->mNormals[i] *= -1.0f;
 
-        // ... and flip faces
+        // ... and flip faces, the meshlets keep the old order
+        pcMesh->ReleaseMeshlets();
         for (unsigned int i = 0; i < pcMesh->mNumFaces;++i)
         {
             aiFace& face = pcMesh->mFaces[i];
@@ -0,0 +1,374 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file Implementation of the post-processing step to partition meshes into meshlets.
+ * <br>
+ * The bounding spheres are Ritter's approximation, the normal cones follow
+ * the definition used by meshoptimizer.
+ */
+
+#ifndef ASSIMP_BUILD_NO_GENMESHLETS_PROCESS
+
+#include "PostProcessing/GenMeshletsProcess.h"
+#include "Common/VertexTriangleAdjacency.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <assimp/DefaultLogger.hpp>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <vector>
+
+namespace Assimp {
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Ritter's bounding sphere of the given vertices
+void ComputeBoundingSphere(const aiMesh *mesh, const unsigned int *vertices, unsigned int numVertices,
+        aiVector3D &center, ai_real &radius) {
+    const aiVector3D *pos = mesh->mVertices;
+
+    // start with the two points far apart from each other
+    unsigned int a = 0, b = 0;
+    ai_real maxDist = 0;
+    for (unsigned int i = 0; i < numVertices; ++i) {
+        const ai_real dist = (pos[vertices[i]] - pos[vertices[0]]).SquareLength();
+        if (dist > maxDist) {
+            maxDist = dist;
+            a = i;
+        }
+    }
+    maxDist = 0;
+    for (unsigned int i = 0; i < numVertices; ++i) {
+        const ai_real dist = (pos[vertices[i]] - pos[vertices[a]]).SquareLength();
+        if (dist > maxDist) {
+            maxDist = dist;
+            b = i;
+        }
+    }
+    center = (pos[vertices[a]] + pos[vertices[b]]) * static_cast<ai_real>(0.5);
+    radius = std::sqrt(maxDist) * static_cast<ai_real>(0.5);
+
+    // grow it to include the remaining points
+    for (unsigned int i = 0; i < numVertices; ++i) {
+        const aiVector3D &p = pos[vertices[i]];
+        const ai_real dist = (p - center).Length();
+        if (dist > radius) {
+            const ai_real grow = (dist - radius) * static_cast<ai_real>(0.5);
+            center += (p - center) * (grow / dist);
+            radius += grow;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Normal cone of the faces of a meshlet, the bounding sphere must be set already
+void ComputeNormalCone(const aiMesh *mesh, aiMeshlet &meshlet) {
+    meshlet.mConeApex = meshlet.mCenter;
+    meshlet.mConeAxis = aiVector3D();
+    meshlet.mConeCutoff = 1;
+
+    const aiVector3D *pos = mesh->mVertices;
+    std::vector<aiVector3D> normals(meshlet.mNumFaces);
+    aiVector3D axis;
+    for (unsigned int i = 0; i < meshlet.mNumFaces; ++i) {
+        const unsigned int *idx = mesh->mFaces[meshlet.mFaceOffset + i].mIndices;
+        aiVector3D n = (pos[idx[1]] - pos[idx[0]]) ^ (pos[idx[2]] - pos[idx[0]]);
+        const ai_real length = n.Length();
+
+        // degenerated faces don't restrict the cone
+        if (length > 0) {
+            n /= length;
+            axis += n;
+        }
+        normals[i] = n;
+    }
+    const ai_real axisLength = axis.Length();
+    if (axisLength <= 0) {
+        return;
+    }
+    axis /= axisLength;
+
+    ai_real minDot = 1;
+    for (const aiVector3D &n : normals) {
+        if (n.SquareLength() > 0) {
+            minDot = std::min(minDot, n * axis);
+        }
+    }
+    meshlet.mConeAxis = axis;
+
+    // the cone would be wider than ~84 degrees, culling it won't be worth it
+    if (minDot <= static_cast<ai_real>(0.1)) {
+        return;
+    }
+
+    // move the apex back along the axis until it is behind all faces
+    ai_real maxT = 0;
+    for (unsigned int i = 0; i < meshlet.mNumFaces; ++i) {
+        const aiVector3D &n = normals[i];
+        if (n.SquareLength() > 0) {
+            const aiVector3D &p = pos[mesh->mFaces[meshlet.mFaceOffset + i].mIndices[0]];
+            maxT = std::max(maxT, ((meshlet.mCenter - p) * n) / (axis * n));
+        }
+    }
+    meshlet.mConeApex = meshlet.mCenter - axis * maxT;
+    meshlet.mConeCutoff = std::sqrt(1 - minDot * minDot);
+}
+
+} // Namespace
+
+// ------------------------------------------------------------------------------------------------
+GenMeshletsProcess::GenMeshletsProcess() :
+        BaseProcess(),
+        mConfigMaxVertices(PP_GM_MAX_VERTICES),
+        mConfigMaxTriangles(PP_GM_MAX_TRIANGLES) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+GenMeshletsProcess::~GenMeshletsProcess() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GenMeshletsProcess::IsActive(unsigned int /*pFlags*/) const {
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GenMeshletsProcess::IsEnabled(unsigned int /*pFlags*/, const Importer *pImp) const {
+    return pImp->GetPropertyBool(AI_CONFIG_PP_GENERATE_MESHLETS, false);
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenMeshletsProcess::SetupProperties(const Importer *pImp) {
+    const int maxVertices = pImp->GetPropertyInteger(AI_CONFIG_PP_GM_MAX_VERTICES, PP_GM_MAX_VERTICES);
+    const int maxTriangles = pImp->GetPropertyInteger(AI_CONFIG_PP_GM_MAX_TRIANGLES, PP_GM_MAX_TRIANGLES);
+
+    mConfigMaxVertices = static_cast<unsigned int>(std::min(std::max(maxVertices, 3), 256));
+    mConfigMaxTriangles = static_cast<unsigned int>(std::min(std::max(maxTriangles, 1), 512));
+    if (static_cast<int>(mConfigMaxVertices) != maxVertices) {
+        ASSIMP_LOG_WARN_F("AI_CONFIG_PP_GM_MAX_VERTICES is out of range, using ", mConfigMaxVertices);
+    }
+    if (static_cast<int>(mConfigMaxTriangles) != maxTriangles) {
+        ASSIMP_LOG_WARN_F("AI_CONFIG_PP_GM_MAX_TRIANGLES is out of range, using ", mConfigMaxTriangles);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenMeshletsProcess::Execute(aiScene *pScene) {
+    ASSIMP_LOG_DEBUG("GenMeshletsProcess begin");
+
+    std::vector<unsigned int> numMeshlets(pScene->mNumMeshes);
+    ForEachMesh(pScene->mNumMeshes, [&](unsigned int a) {
+        numMeshlets[a] = ProcessMesh(pScene->mMeshes[a]);
+    });
+
+    if (!DefaultLogger::isNullLogger()) {
+        unsigned int total = 0, numm = 0;
+        for (unsigned int n : numMeshlets) {
+            total += n;
+            numm += n ? 1 : 0;
+        }
+        ASSIMP_LOG_INFO_F("GenMeshletsProcess finished. Generated ", total, " meshlets for ", numm, " meshes");
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int GenMeshletsProcess::ProcessMesh(aiMesh *pMesh) const {
+    ai_assert(nullptr != pMesh);
+
+    // existing meshlets refer to the old face order
+    pMesh->ReleaseMeshlets();
+
+    const unsigned int numFaces = pMesh->mNumFaces;
+    if (!numFaces || !pMesh->mNumVertices || !pMesh->mVertices) {
+        return 0;
+    }
+    for (unsigned int i = 0; i < numFaces; ++i) {
+        if (3 != pMesh->mFaces[i].mNumIndices) {
+            ASSIMP_LOG_WARN("GenMeshletsProcess: skipping a mesh which is not made of triangles only");
+            return 0;
+        }
+    }
+
+    VertexTriangleAdjacency adj(pMesh->mFaces, numFaces, pMesh->mNumVertices, true);
+    unsigned int *const liveTriangles = adj.mLiveTriangles;
+
+    const unsigned int unused = UINT_MAX;
+    std::vector<unsigned int> localIndex(pMesh->mNumVertices, unused);
+    std::vector<bool> emitted(numFaces, false);
+
+    std::vector<unsigned int> order;
+    std::vector<unsigned int> vertices;
+    std::vector<unsigned char> triangles;
+    std::vector<aiMeshlet> meshlets;
+    order.reserve(numFaces);
+    triangles.reserve(numFaces * 3);
+
+    aiMeshlet current;
+    aiVector3D centroidSum;
+
+    // number of vertices of face f which are not yet part of the current meshlet
+    auto countNewVertices = [&](unsigned int f) {
+        const unsigned int *idx = pMesh->mFaces[f].mIndices;
+        return (localIndex[idx[0]] == unused ? 1u : 0u) +
+               (localIndex[idx[1]] == unused && idx[1] != idx[0] ? 1u : 0u) +
+               (localIndex[idx[2]] == unused && idx[2] != idx[0] && idx[2] != idx[1] ? 1u : 0u);
+    };
+    auto centroid = [&](unsigned int f) {
+        const unsigned int *idx = pMesh->mFaces[f].mIndices;
+        const aiVector3D *pos = pMesh->mVertices;
+        return (pos[idx[0]] + pos[idx[1]] + pos[idx[2]]) / static_cast<ai_real>(3);
+    };
+    auto flush = [&]() {
+        for (unsigned int i = 0; i < current.mNumVertices; ++i) {
+            localIndex[vertices[current.mVertexOffset + i]] = unused;
+        }
+        meshlets.push_back(current);
+
+        current = aiMeshlet();
+        current.mFaceOffset = static_cast<unsigned int>(order.size());
+        current.mVertexOffset = static_cast<unsigned int>(vertices.size());
+        centroidSum = aiVector3D();
+    };
+
+    unsigned int seed = 0;
+    while (order.size() < numFaces) {
+        // find the adjacent face which adds the fewest vertices, ties are
+        // broken by the distance to the center of the meshlet
+        unsigned int best = unused, bestNew = 4;
+        ai_real bestDist = 0;
+        bool haveAdjacent = false;
+        const aiVector3D center = current.mNumFaces ? centroidSum / static_cast<ai_real>(current.mNumFaces) : aiVector3D();
+        for (unsigned int i = 0; i < current.mNumVertices; ++i) {
+            const unsigned int v = vertices[current.mVertexOffset + i];
+            if (!liveTriangles[v]) {
+                continue;
+            }
+            const unsigned int *adjacent = adj.GetAdjacentTriangles(v);
+            const unsigned int numAdjacent = adj.mOffsetTable[v + 1] - adj.mOffsetTable[v];
+            for (unsigned int t = 0; t < numAdjacent; ++t) {
+                const unsigned int f = adjacent[t];
+                if (emitted[f]) {
+                    continue;
+                }
+                haveAdjacent = true;
+                const unsigned int numNew = countNewVertices(f);
+                if (current.mNumVertices + numNew > mConfigMaxVertices || numNew > bestNew) {
+                    continue;
+                }
+                const ai_real dist = (centroid(f) - center).SquareLength();
+                if (numNew < bestNew || dist < bestDist || (dist == bestDist && f < best)) {
+                    best = f;
+                    bestNew = numNew;
+                    bestDist = dist;
+                }
+            }
+        }
+
+        // otherwise continue with the next face in order, in a new meshlet
+        // unless the current one has no neighbours left at all
+        if (unused == best) {
+            while (emitted[seed]) {
+                ++seed;
+            }
+            best = seed;
+            if (current.mNumFaces && (haveAdjacent || current.mNumVertices + countNewVertices(best) > mConfigMaxVertices)) {
+                flush();
+            }
+        }
+
+        const unsigned int *idx = pMesh->mFaces[best].mIndices;
+        for (unsigned int a = 0; a < 3; ++a) {
+            const unsigned int v = idx[a];
+            if (localIndex[v] == unused) {
+                localIndex[v] = current.mNumVertices++;
+                vertices.push_back(v);
+            }
+            triangles.push_back(static_cast<unsigned char>(localIndex[v]));
+            --liveTriangles[v];
+        }
+        emitted[best] = true;
+        order.push_back(best);
+        centroidSum += centroid(best);
+        if (++current.mNumFaces == mConfigMaxTriangles) {
+            flush();
+        }
+    }
+    if (current.mNumFaces) {
+        flush();
+    }
+
+    // sort the faces by meshlet, all of them are triangles
+    std::vector<unsigned int> indices(numFaces * 3);
+    for (unsigned int i = 0; i < numFaces; ++i) {
+        const unsigned int *idx = pMesh->mFaces[order[i]].mIndices;
+        std::copy(idx, idx + 3, &indices[i * 3]);
+    }
+    for (unsigned int i = 0; i < numFaces; ++i) {
+        std::copy(&indices[i * 3], &indices[i * 3] + 3, pMesh->mFaces[i].mIndices);
+    }
+
+    for (aiMeshlet &meshlet : meshlets) {
+        ComputeBoundingSphere(pMesh, &vertices[meshlet.mVertexOffset], meshlet.mNumVertices, meshlet.mCenter, meshlet.mRadius);
+        ComputeNormalCone(pMesh, meshlet);
+    }
+
+    pMesh->mNumMeshlets = static_cast<unsigned int>(meshlets.size());
+    pMesh->mMeshlets = new aiMeshlet[meshlets.size()];
+    std::copy(meshlets.begin(), meshlets.end(), pMesh->mMeshlets);
+    pMesh->mNumMeshletVertices = static_cast<unsigned int>(vertices.size());
+    pMesh->mMeshletVertices = new unsigned int[vertices.size()];
+    std::copy(vertices.begin(), vertices.end(), pMesh->mMeshletVertices);
+    pMesh->mNumMeshletTriangles = static_cast<unsigned int>(triangles.size() / 3);
+    pMesh->mMeshletTriangles = new unsigned char[triangles.size()];
+    std::copy(triangles.begin(), triangles.end(), pMesh->mMeshletTriangles);
+
+    return pMesh->mNumMeshlets;
+}
+
+} // Namespace Assimp
+
+#endif // ASSIMP_BUILD_NO_GENMESHLETS_PROCESS
@@ -0,0 +1,106 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file Defines a post-processing step to partition meshes into meshlets.
+ */
+
+#pragma once
+
+#ifndef AI_GENMESHLETSPROCESS_H_INC
+#define AI_GENMESHLETSPROCESS_H_INC
+
+#ifndef ASSIMP_BUILD_NO_GENMESHLETS_PROCESS
+
+#include "Common/BaseProcess.h"
+
+struct aiMesh;
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** Post-processing step to partition the triangles of all meshes into
+ *  meshlets, clusters with a bounded number of vertices and triangles, see
+ *  aiMeshlet.
+ *
+ *  Meshlets are grown greedily along the triangle adjacency, preferring the
+ *  triangle which adds the fewest new vertices. The faces of each mesh are
+ *  sorted by meshlet afterwards.
+ *
+ *  There is no aiPostProcessSteps flag left for the step, it is enabled
+ *  with #AI_CONFIG_PP_GENERATE_MESHLETS.
+ *
+ *  @note This step expects triangulated input data.
+ */
+class ASSIMP_API GenMeshletsProcess : public BaseProcess {
+public:
+    /// The class constructor.
+    GenMeshletsProcess();
+    /// The class destructor.
+    ~GenMeshletsProcess();
+    /// Always false, the step has no flag.
+    bool IsActive(unsigned int pFlags) const override;
+    /// Will return true, if #AI_CONFIG_PP_GENERATE_MESHLETS is set.
+    bool IsEnabled(unsigned int pFlags, const Importer *pImp) const override;
+    /// Reads the meshlet limits.
+    void SetupProperties(const Importer *pImp) override;
+    /// The execution callback.
+    void Execute(aiScene *pScene) override;
+
+    // -------------------------------------------------------------------
+    /** Generates the meshlets of a single mesh, replacing existing ones.
+     *  @param pMesh The mesh to process.
+     *  @return Number of meshlets, 0 if the mesh isn't made of triangles */
+    unsigned int ProcessMesh(aiMesh *pMesh) const;
+
+private:
+    //! Configuration parameter: maximum number of vertices per meshlet
+    unsigned int mConfigMaxVertices;
+
+    //! Configuration parameter: maximum number of triangles per meshlet
+    unsigned int mConfigMaxTriangles;
+};
+
+} // Namespace Assimp
+
+#endif // #ifndef ASSIMP_BUILD_NO_GENMESHLETS_PROCESS
+
+#endif // AI_GENMESHLETSPROCESS_H_INC
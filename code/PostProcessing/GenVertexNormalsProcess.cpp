@@ -90,9 +90,16 @@ void GenVertexNormalsProcess::Execute(aiScene *pScene) {
         throw DeadlyImportError("Post-processing order mismatch: expecting pseudo-indexed (\"verbose\") vertices here");
     }
 
+    // the meshes don't depend on each other, don't use std::vector<bool> here
+    // as its elements can't be written from several threads
+    std::vector<unsigned char> generated(pScene->mNumMeshes, 0);
+    ForEachMesh(pScene->mNumMeshes, [&](unsigned int a) {
+        generated[a] = GenMeshVertexNormals(pScene->mMeshes[a], a);
+    });
+
     bool bHas = false;
     for (unsigned int a = 0; a < pScene->mNumMeshes; ++a) {
-        if (GenMeshVertexNormals(pScene->mMeshes[a], a))
+        if (generated[a])
             bHas = true;
     }
 
@@ -164,6 +171,7 @@ bool GenVertexNormalsProcess::GenMeshVertexNormals(aiMesh *pMesh, unsigned int m
         }
     }
     if (!vertexFinder) {
+        _vertexFinder.SetThreadPool(threadPool);
         _vertexFinder.Fill(pMesh->mVertices, pMesh->mNumVertices, sizeof(aiVector3D));
         vertexFinder = &_vertexFinder;
         posEpsilon = ComputePositionEpsilon(pMesh);
@@ -203,20 +211,22 @@ bool GenVertexNormalsProcess::GenMeshVertexNormals(aiMesh *pMesh, unsigned int m
     // the effect, this one is the most straightforward one.
     else {
         const ai_real fLimit = std::cos(configMaxAngle);
-        for (unsigned int i = 0; i < pMesh->mNumVertices; ++i) {
-            // Get all vertices that share this one ...
-            vertexFinder->FindPositions(pMesh->mVertices[i], posEpsilon, verticesFound);
 
+        // Every vertex needs its own neighbours here, so get them all at once. The
+        // neighbours of vertex i are neighbors[offsets[i]] ... neighbors[offsets[i+1]-1].
+        std::vector<unsigned int> offsets, neighbors;
+        vertexFinder->FindAllNeighbors(posEpsilon, offsets, neighbors);
+        for (unsigned int i = 0; i < pMesh->mNumVertices; ++i) {
             aiVector3D vr = pMesh->mNormals[i];
 
             aiVector3D pcNor;
-            for (unsigned int a = 0; a < verticesFound.size(); ++a) {
-                aiVector3D v = pMesh->mNormals[verticesFound[a]];
+            for (unsigned int a = offsets[i]; a < offsets[i + 1]; ++a) {
+                aiVector3D v = pMesh->mNormals[neighbors[a]];
 
                 // Check whether the angle between the two normals is not too large.
                 // Skip the angle check on our own normal to avoid false negatives
                 // (v*v is not guaranteed to be 1.0 for all unit vectors v)
-                if (is_not_qnan(v.x) && (verticesFound[a] == i || (v * vr >= fLimit)))
+                if (is_not_qnan(v.x) && (neighbors[a] == i || (v * vr >= fLimit)))
                     pcNor += v;
             }
             pcNew[i] = pcNor.NormalizeSafe();
@@ -43,9 +43,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 /** @file Implementation of the post processing step to improve the cache locality of a mesh.
  * <br>
- * The algorithm is roughly basing on this paper:
+ * The default algorithm is roughly basing on this paper:
  * http://www.cs.princeton.edu/gfx/pubs/Sander_2007_%3ETR/tipsy.pdf
- *   .. although overdraw reduction isn't implemented yet ...
+ * The overdraw reduction follows the same paper, clusters are split at a
+ * given ACMR threshold as done in meshoptimizer. The alternative vertex
+ * cache optimizer is Tom Forsyth's "Linear-Speed Vertex Cache Optimisation".
  */
 
 // internal headers
@@ -53,18 +55,186 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Common/VertexTriangleAdjacency.h"
 
 #include <assimp/StringUtils.h>
+#include <assimp/commonMetaData.h>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
+#include <algorithm>
+#include <climits>
+#include <cmath>
 #include <stdio.h>
 #include <stack>
 
 using namespace Assimp;
 
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Emulates a FIFO cache with time stamps: a vertex is in the cache if fewer than
+// cacheSize other vertices were added after it. Returns whether v was missed.
+inline bool UpdateCache(unsigned int v, unsigned int cacheSize, std::vector<unsigned int>& stamps, unsigned int& time) {
+    if (time - stamps[v] > cacheSize) {
+        stamps[v] = time++;
+        return true;
+    }
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Cache misses of the triangles [begin,end) of an index buffer
+unsigned int CountCacheMisses(const unsigned int* indices, size_t begin, size_t end, unsigned int cacheSize,
+        std::vector<unsigned int>& stamps, unsigned int& time) {
+    unsigned int misses = 0;
+    for (size_t i = begin * 3; i < end * 3; ++i) {
+        misses += UpdateCache(indices[i], cacheSize, stamps, time);
+    }
+    return misses;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Score of a vertex for Forsyth's optimizer
+float ForsythVertexScore(int cachePosition, unsigned int numLiveTriangles, unsigned int cacheSize) {
+    if (0 == numLiveTriangles) {
+        // no triangles left to draw
+        return -1.f;
+    }
+
+    float score = 0.f;
+    if (cachePosition >= 0) {
+        if (cachePosition < 3) {
+            // the vertices of the last triangle get a fixed score, whichever
+            // of them is used next, they all have to be in the cache anyway
+            score = 0.75f;
+        } else {
+            // the score falls off with the position in the cache
+            const float scaler = 1.f / (cacheSize - 3);
+            score = std::pow(1.f - (cachePosition - 3) * scaler, 1.5f);
+        }
+    }
+
+    // bonus for vertices with few triangles left, so they are finished
+    // quickly instead of leaving lone triangles behind
+    score += 2.f * std::pow(static_cast<float>(numLiveTriangles), -0.5f);
+    return score;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Reorder an array of per-vertex data so that old vertex i ends up at remap[i]
+template <typename T>
+void RemapVertexArray(T*& data, const std::vector<unsigned int>& remap) {
+    if (nullptr == data) {
+        return;
+    }
+    T* out = new T[remap.size()];
+    for (size_t i = 0; i < remap.size(); ++i) {
+        out[remap[i]] = data[i];
+    }
+    delete[] data;
+    data = out;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Renumber the vertices of a mesh in the order its faces use them first
+void OptimizeVertexFetch(aiMesh* pMesh) {
+    const unsigned int unused = UINT_MAX;
+    std::vector<unsigned int> remap(pMesh->mNumVertices, unused);
+    unsigned int next = 0;
+    for (unsigned int f = 0; f < pMesh->mNumFaces; ++f) {
+        const aiFace& face = pMesh->mFaces[f];
+        for (unsigned int i = 0; i < face.mNumIndices; ++i) {
+            if (unused == remap[face.mIndices[i]]) {
+                remap[face.mIndices[i]] = next++;
+            }
+        }
+    }
+
+    // vertices without faces are kept at the end
+    for (unsigned int v = 0; v < pMesh->mNumVertices; ++v) {
+        if (unused == remap[v]) {
+            remap[v] = next++;
+        }
+    }
+
+    for (unsigned int f = 0; f < pMesh->mNumFaces; ++f) {
+        aiFace& face = pMesh->mFaces[f];
+        for (unsigned int i = 0; i < face.mNumIndices; ++i) {
+            face.mIndices[i] = remap[face.mIndices[i]];
+        }
+    }
+
+    RemapVertexArray(pMesh->mVertices, remap);
+    RemapVertexArray(pMesh->mNormals, remap);
+    RemapVertexArray(pMesh->mTangents, remap);
+    RemapVertexArray(pMesh->mBitangents, remap);
+    for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+        RemapVertexArray(pMesh->mColors[c], remap);
+    }
+    for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++c) {
+        RemapVertexArray(pMesh->mTextureCoords[c], remap);
+    }
+
+    for (unsigned int b = 0; b < pMesh->mNumBones; ++b) {
+        aiBone* bone = pMesh->mBones[b];
+        for (unsigned int w = 0; w < bone->mNumWeights; ++w) {
+            bone->mWeights[w].mVertexId = remap[bone->mWeights[w].mVertexId];
+        }
+    }
+
+    for (unsigned int a = 0; a < pMesh->mNumAnimMeshes; ++a) {
+        aiAnimMesh* anim = pMesh->mAnimMeshes[a];
+        RemapVertexArray(anim->mVertices, remap);
+        RemapVertexArray(anim->mNormals, remap);
+        RemapVertexArray(anim->mTangents, remap);
+        RemapVertexArray(anim->mBitangents, remap);
+        for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+            RemapVertexArray(anim->mColors[c], remap);
+        }
+        for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++c) {
+            RemapVertexArray(anim->mTextureCoords[c], remap);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Add a metadata entry or replace its value
+template <typename T>
+void SetMetaData(aiScene* pScene, const char* key, const T& value) {
+    if (!pScene->mMetaData) {
+        pScene->mMetaData = new aiMetadata;
+    }
+    if (!pScene->mMetaData->Set(key, value)) {
+        pScene->mMetaData->Add(key, value);
+    }
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+VertexCacheStatistics Assimp::ComputeVertexCacheStatistics(const aiMesh* pMesh, unsigned int cacheSize) {
+    ai_assert(nullptr != pMesh);
+
+    VertexCacheStatistics stats;
+    stats.mNumFaces = pMesh->mNumFaces;
+    stats.mNumVertices = pMesh->mNumVertices;
+
+    std::vector<unsigned int> stamps(pMesh->mNumVertices, 0);
+    unsigned int time = cacheSize + 1;
+    for (unsigned int f = 0; f < pMesh->mNumFaces; ++f) {
+        const aiFace& face = pMesh->mFaces[f];
+        for (unsigned int i = 0; i < face.mNumIndices; ++i) {
+            stats.mNumMisses += UpdateCache(face.mIndices[i], cacheSize, stamps, time);
+        }
+    }
+    return stats;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 ImproveCacheLocalityProcess::ImproveCacheLocalityProcess()
-: mConfigCacheDepth(PP_ICL_PTCACHE_SIZE) {
+: mConfigCacheDepth(PP_ICL_PTCACHE_SIZE)
+, mConfigAlgorithm(aiVertexCacheAlgorithm_Tipsify)
+, mConfigOverdrawThreshold(0.f)
+, mConfigVertexFetch(false) {
     // empty
 }
 
@@ -85,6 +255,14 @@ bool ImproveCacheLocalityProcess::IsActive( unsigned int pFlags) const {
 void ImproveCacheLocalityProcess::SetupProperties(const Importer* pImp) {
     // AI_CONFIG_PP_ICL_PTCACHE_SIZE controls the target cache size for the optimizer
     mConfigCacheDepth = pImp->GetPropertyInteger(AI_CONFIG_PP_ICL_PTCACHE_SIZE,PP_ICL_PTCACHE_SIZE);
+    mConfigAlgorithm = pImp->GetPropertyInteger(AI_CONFIG_PP_ICL_ALGORITHM,aiVertexCacheAlgorithm_Tipsify);
+    mConfigOverdrawThreshold = pImp->GetPropertyFloat(AI_CONFIG_PP_ICL_OVERDRAW_THRESHOLD,0.f);
+    mConfigVertexFetch = pImp->GetPropertyBool(AI_CONFIG_PP_ICL_VERTEX_FETCH,false);
+
+    if (aiVertexCacheAlgorithm_Tipsify != mConfigAlgorithm && aiVertexCacheAlgorithm_Forsyth != mConfigAlgorithm) {
+        ASSIMP_LOG_WARN("AI_CONFIG_PP_ICL_ALGORITHM is unknown, using Tipsify");
+        mConfigAlgorithm = aiVertexCacheAlgorithm_Tipsify;
+    }
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -97,19 +275,36 @@ void ImproveCacheLocalityProcess::Execute( aiScene* pScene) {
 
     ASSIMP_LOG_DEBUG("ImproveCacheLocalityProcess begin");
 
-    float out = 0.f;
-    unsigned int numf = 0, numm = 0;
+    // the meshes don't depend on each other, the statistics are gathered
+    // afterwards to keep the summation order stable
+    std::vector<VertexCacheStatistics> before(pScene->mNumMeshes), after(pScene->mNumMeshes);
+    ForEachMesh(pScene->mNumMeshes, [&](unsigned int a) {
+        after[a] = ProcessMesh( pScene->mMeshes[a],a,before[a]);
+    });
+
+    VertexCacheStatistics in, out;
+    unsigned int numm = 0;
     for( unsigned int a = 0; a < pScene->mNumMeshes; ++a ){
-        const float res = ProcessMesh( pScene->mMeshes[a],a);
-        if (res) {
-            numf += pScene->mMeshes[a]->mNumFaces;
-            out  += res;
+        if (after[a].mNumFaces) {
+            in.mNumFaces += before[a].mNumFaces;
+            in.mNumVertices += before[a].mNumVertices;
+            in.mNumMisses += before[a].mNumMisses;
+            out.mNumFaces += after[a].mNumFaces;
+            out.mNumVertices += after[a].mNumVertices;
+            out.mNumMisses += after[a].mNumMisses;
             ++numm;
         }
     }
+    if (out.mNumFaces > 0) {
+        SetMetaData(pScene, AI_METADATA_ACMR_IN, static_cast<float>(in.GetACMR()));
+        SetMetaData(pScene, AI_METADATA_ACMR_OUT, static_cast<float>(out.GetACMR()));
+        SetMetaData(pScene, AI_METADATA_ATVR_IN, static_cast<float>(in.GetATVR()));
+        SetMetaData(pScene, AI_METADATA_ATVR_OUT, static_cast<float>(out.GetATVR()));
+    }
     if (!DefaultLogger::isNullLogger()) {
-        if (numf > 0) {
-            ASSIMP_LOG_INFO_F("Cache relevant are ", numm, " meshes (", numf, " faces). Average output ACMR is ", out / numf);
+        if (out.mNumFaces > 0) {
+            ASSIMP_LOG_INFO_F("Cache relevant are ", numm, " meshes (", out.mNumFaces, " faces). Average output ACMR is ", out.GetACMR(),
+                    ", ATVR is ", out.GetATVR());
         }
         ASSIMP_LOG_DEBUG("ImproveCacheLocalityProcess finished. ");
     }
@@ -117,84 +312,84 @@ void ImproveCacheLocalityProcess::Execute( aiScene* pScene) {
 
 // ------------------------------------------------------------------------------------------------
 // Improves the cache coherency of a specific mesh
-ai_real ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshNum) {
-    // TODO: rewrite this to use std::vector or boost::shared_array
+VertexCacheStatistics ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshNum, VertexCacheStatistics& in) {
     ai_assert(nullptr != pMesh);
 
     // Check whether the input data is valid
     // - there must be vertices and faces
     // - all faces must be triangulated or we can't operate on them
     if (!pMesh->HasFaces() || !pMesh->HasPositions())
-        return static_cast<ai_real>(0.f);
+        return VertexCacheStatistics();
 
     if (pMesh->mPrimitiveTypes != aiPrimitiveType_TRIANGLE) {
         ASSIMP_LOG_ERROR("This algorithm works on triangle meshes only");
-        return static_cast<ai_real>(0.f);
+        return VertexCacheStatistics();
     }
 
     if(pMesh->mNumVertices <= mConfigCacheDepth) {
-        return static_cast<ai_real>(0.f);
+        return VertexCacheStatistics();
     }
 
-    ai_real fACMR = 3.f;
-    const aiFace* const pcEnd = pMesh->mFaces+pMesh->mNumFaces;
+    in = ComputeVertexCacheStatistics(pMesh, mConfigCacheDepth);
+    if (3 * in.mNumFaces == in.mNumMisses)   {
+        char szBuff[128]; // should be sufficiently large in every case
 
-    // Input ACMR is for logging purposes only
-    if (!DefaultLogger::isNullLogger())     {
+        // the JoinIdenticalVertices process has not been executed on this
+        // mesh, otherwise this value would normally be at least minimally
+        // smaller than 3.0 ...
+        ai_snprintf(szBuff,128,"Mesh %u: Not suitable for vcache optimization",meshNum);
+        ASSIMP_LOG_WARN(szBuff);
+        return VertexCacheStatistics();
+    }
 
-        unsigned int* piFIFOStack = new unsigned int[mConfigCacheDepth];
-        memset(piFIFOStack,0xff,mConfigCacheDepth*sizeof(unsigned int));
-        unsigned int* piCur = piFIFOStack;
-        const unsigned int* const piCurEnd = piFIFOStack + mConfigCacheDepth;
+    std::vector<unsigned int> indices;
+    if (aiVertexCacheAlgorithm_Forsyth == mConfigAlgorithm) {
+        OptimizeForsyth(pMesh, indices);
+    } else {
+        OptimizeTipsify(pMesh, indices);
+    }
+    if (mConfigOverdrawThreshold > 0.f) {
+        OptimizeOverdraw(pMesh, indices);
+    }
 
-        // count the number of cache misses
-        unsigned int iCacheMisses = 0;
-        for (const aiFace* pcFace = pMesh->mFaces;pcFace != pcEnd;++pcFace) {
-            for (unsigned int qq = 0; qq < 3;++qq) {
-                bool bInCache = false;
-                for (unsigned int* pp = piFIFOStack;pp < piCurEnd;++pp) {
-                    if (*pp == pcFace->mIndices[qq])    {
-                        // the vertex is in cache
-                        bInCache = true;
-                        break;
-                    }
-                }
-                if (!bInCache)  {
-                    ++iCacheMisses;
-                    if (piCurEnd == piCur) {
-                        piCur = piFIFOStack;
-                    }
-                    *piCur++ = pcFace->mIndices[qq];
-                }
-            }
-        }
-        delete[] piFIFOStack;
-        fACMR = (ai_real) iCacheMisses / pMesh->mNumFaces;
-        if (3.0 == fACMR)   {
-            char szBuff[128]; // should be sufficiently large in every case
-
-            // the JoinIdenticalVertices process has not been executed on this
-            // mesh, otherwise this value would normally be at least minimally
-            // smaller than 3.0 ...
-            ai_snprintf(szBuff,128,"Mesh %u: Not suitable for vcache optimization",meshNum);
-            ASSIMP_LOG_WARN(szBuff);
-            return static_cast<ai_real>(0.f);
+    // sort the output index buffer back to the input array, the meshlets keep the old order
+    pMesh->ReleaseMeshlets();
+    const unsigned int* piCSIter = indices.data();
+    for (unsigned int f = 0; f < pMesh->mNumFaces; ++f) {
+        aiFace& face = pMesh->mFaces[f];
+        for (unsigned int i = 0; i < 3; ++i) {
+            face.mIndices[i] = *piCSIter++;
         }
     }
 
+    if (mConfigVertexFetch) {
+        OptimizeVertexFetch(pMesh);
+    }
+
+    const VertexCacheStatistics out = ComputeVertexCacheStatistics(pMesh, mConfigCacheDepth);
+
+    // very intense verbose logging ... prepare for much text if there are many meshes
+    if (!DefaultLogger::isNullLogger() && DefaultLogger::get()->getLogSeverity() == Logger::VERBOSE) {
+        const ai_real fACMR = in.GetACMR(), fACMR2 = out.GetACMR();
+        ASSIMP_LOG_VERBOSE_DEBUG_F("Mesh ", meshNum, " | ACMR in: ", fACMR, " out: ", fACMR2, " | ~", ((fACMR - fACMR2) / fACMR) * 100.f, "%");
+    }
+    return out;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Tipsify vertex cache optimization
+void ImproveCacheLocalityProcess::OptimizeTipsify( const aiMesh* pMesh, std::vector<unsigned int>& out) const {
     // first we need to build a vertex-triangle adjacency list
     VertexTriangleAdjacency adj(pMesh->mFaces,pMesh->mNumFaces, pMesh->mNumVertices,true);
 
     // build a list to store per-vertex caching time stamps
-    unsigned int* const piCachingStamps = new unsigned int[pMesh->mNumVertices];
-    memset(piCachingStamps,0x0,pMesh->mNumVertices*sizeof(unsigned int));
+    std::vector<unsigned int> piCachingStamps(pMesh->mNumVertices, 0);
 
     // allocate an empty output index buffer. We store the output indices in one large array.
     // Since the number of triangles won't change the input faces can be reused. This is how
     // we save thousands of redundant mini allocations for aiFace::mIndices
-    const unsigned int iIdxCnt = pMesh->mNumFaces*3;
-    unsigned int* const piIBOutput = new unsigned int[iIdxCnt];
-    unsigned int* piCSIter = piIBOutput;
+    out.clear();
+    out.reserve(pMesh->mNumFaces*3);
 
     // allocate the flag array to hold the information
     // whether a face has already been emitted or not
@@ -208,16 +403,9 @@ ai_real ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int me
     const std::vector<unsigned int> piNumTriPtrNoModify(piNumTriPtr, piNumTriPtr + pMesh->mNumVertices);
 
     // get the largest number of referenced triangles and allocate the "candidate buffer"
-    unsigned int iMaxRefTris = 0; {
-        const unsigned int* piCur = adj.mLiveTriangles;
-        const unsigned int* const piCurEnd = adj.mLiveTriangles+pMesh->mNumVertices;
-        for (;piCur != piCurEnd;++piCur) {
-            iMaxRefTris = std::max(iMaxRefTris,*piCur);
-        }
-    }
+    const unsigned int iMaxRefTris = *std::max_element(piNumTriPtr, piNumTriPtr + pMesh->mNumVertices);
     ai_assert(iMaxRefTris > 0);
-    unsigned int* piCandidates = new unsigned int[iMaxRefTris*3];
-    unsigned int iCacheMisses = 0;
+    std::vector<unsigned int> piCandidates(iMaxRefTris*3);
 
     // ...................................................................................
     /** PSEUDOCODE for the algorithm
@@ -251,12 +439,12 @@ ai_real ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int me
 
     int ivdx = 0;
     int ics = 1;
-    int iStampCnt = mConfigCacheDepth+1;
+    unsigned int iStampCnt = mConfigCacheDepth+1;
     while (ivdx >= 0)   {
 
         unsigned int icnt = piNumTriPtrNoModify[ivdx];
         unsigned int* piList = adj.GetAdjacentTriangles(ivdx);
-        unsigned int* piCurCandidate = piCandidates;
+        unsigned int* piCurCandidate = piCandidates.data();
 
         // get all triangles in the neighborhood
         for (unsigned int tri = 0; tri < icnt;++tri)    {
@@ -284,12 +472,11 @@ ai_real ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int me
                     }
 
                     // append the vertex to the output index buffer
-                    *piCSIter++ = dp;
+                    out.push_back(dp);
 
                     // if the vertex is not yet in cache, set its cache count
                     if (iStampCnt-piCachingStamps[dp] > mConfigCacheDepth) {
                         piCachingStamps[dp] = iStampCnt++;
-                        ++iCacheMisses;
                     }
                 }
                 // flag triangle as emitted
@@ -303,7 +490,7 @@ ai_real ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int me
         // get next fanning vertex
         ivdx = -1;
         int max_priority = -1;
-        for (unsigned int* piCur = piCandidates;piCur != piCurCandidate;++piCur)    {
+        for (unsigned int* piCur = piCandidates.data();piCur != piCurCandidate;++piCur)    {
             const unsigned int dp = *piCur;
 
             // must have live triangles
@@ -339,8 +526,7 @@ ai_real ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int me
             if (-1 == ivdx) {
                 // well, there isn't such a vertex. Simply get the next vertex in input order and
                 // hope it is not too bad ...
-                while (ics < (int)pMesh->mNumVertices)  {
-                    ++ics;
+                while (++ics < (int)pMesh->mNumVertices)  {
                     if (piNumTriPtr[ics] > 0)   {
                         ivdx = ics;
                         break;
@@ -349,31 +535,213 @@ ai_real ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int me
             }
         }
     }
-    ai_real fACMR2 = 0.0f;
-    if (!DefaultLogger::isNullLogger()) {
-        fACMR2 = (float)iCacheMisses / pMesh->mNumFaces;
 
-        // very intense verbose logging ... prepare for much text if there are many meshes
-        if ( DefaultLogger::get()->getLogSeverity() == Logger::VERBOSE) {
-            ASSIMP_LOG_VERBOSE_DEBUG_F("Mesh %u | ACMR in: ", meshNum, " out: ", fACMR, " | ~", fACMR2, ((fACMR - fACMR2) / fACMR) * 100.f);
+    // faces which were never reached, i.e. degenerated ones, keep their input order
+    for (unsigned int f = 0; f < pMesh->mNumFaces; ++f) {
+        if (!abEmitted[f]) {
+            out.insert(out.end(), pMesh->mFaces[f].mIndices, pMesh->mFaces[f].mIndices + 3);
         }
+    }
+}
 
-        fACMR2 *= pMesh->mNumFaces;
+// ------------------------------------------------------------------------------------------------
+// Forsyth's linear-speed vertex cache optimization
+void ImproveCacheLocalityProcess::OptimizeForsyth( const aiMesh* pMesh, std::vector<unsigned int>& out) const {
+    const unsigned int numFaces = pMesh->mNumFaces;
+    const unsigned int numVertices = pMesh->mNumVertices;
+
+    // the score function needs a cache larger than a triangle
+    const unsigned int cacheSize = std::max(mConfigCacheDepth, 4u);
+
+    // the first mLiveTriangles[v] entries of the adjacency list of v are the
+    // triangles not yet emitted
+    VertexTriangleAdjacency adj(pMesh->mFaces, numFaces, numVertices, true);
+    unsigned int* const live = adj.mLiveTriangles;
+
+    std::vector<int> cachePosition(numVertices, -1);
+    std::vector<float> vertexScore(numVertices);
+    for (unsigned int v = 0; v < numVertices; ++v) {
+        vertexScore[v] = ForsythVertexScore(-1, live[v], cacheSize);
     }
-    // sort the output index buffer back to the input array
-    piCSIter = piIBOutput;
-    for (aiFace* pcFace = pMesh->mFaces; pcFace != pcEnd;++pcFace)  {
-        unsigned nind = pcFace->mNumIndices;
-        unsigned * ind = pcFace->mIndices;
-        if (nind > 0) ind[0] = *piCSIter++;
-        if (nind > 1) ind[1] = *piCSIter++;
-        if (nind > 2) ind[2] = *piCSIter++;
+
+    std::vector<float> faceScore(numFaces);
+    std::vector<bool> emitted(numFaces, false);
+    int best = -1;
+    float bestScore = -1.f;
+    for (unsigned int f = 0; f < numFaces; ++f) {
+        const unsigned int* idx = pMesh->mFaces[f].mIndices;
+        faceScore[f] = vertexScore[idx[0]] + vertexScore[idx[1]] + vertexScore[idx[2]];
+        if (faceScore[f] > bestScore) {
+            bestScore = faceScore[f];
+            best = f;
+        }
     }
 
-    // delete temporary storage
-    delete[] piCachingStamps;
-    delete[] piIBOutput;
-    delete[] piCandidates;
+    // LRU cache, grows by up to three vertices per triangle before it is cut
+    std::vector<unsigned int> cache, newCache;
+    cache.reserve(cacheSize + 3);
+    newCache.reserve(cacheSize + 3);
+
+    out.clear();
+    out.reserve(numFaces * 3);
+    unsigned int cursor = 0;
+    for (unsigned int n = 0; n < numFaces; ++n) {
+        // no candidate in the cache, continue with the next face in input order
+        if (best < 0) {
+            while (emitted[cursor]) {
+                ++cursor;
+            }
+            best = cursor;
+        }
 
-    return fACMR2;
+        const unsigned int* idx = pMesh->mFaces[best].mIndices;
+        emitted[best] = true;
+        newCache.clear();
+        for (unsigned int i = 0; i < 3; ++i) {
+            const unsigned int v = idx[i];
+            out.push_back(v);
+            newCache.push_back(v);
+
+            // move the face behind the live faces of the vertex
+            unsigned int* list = adj.GetAdjacentTriangles(v);
+            for (unsigned int t = 0; t < live[v]; ++t) {
+                if (list[t] == static_cast<unsigned int>(best)) {
+                    std::swap(list[t], list[live[v] - 1]);
+                    break;
+                }
+            }
+            --live[v];
+        }
+        for (const unsigned int v : cache) {
+            if (v != idx[0] && v != idx[1] && v != idx[2]) {
+                newCache.push_back(v);
+            }
+        }
+
+        // update the scores of the cached and the evicted vertices ...
+        for (size_t i = 0; i < newCache.size(); ++i) {
+            const unsigned int v = newCache[i];
+            cachePosition[v] = i < cacheSize ? static_cast<int>(i) : -1;
+            vertexScore[v] = ForsythVertexScore(cachePosition[v], live[v], cacheSize);
+        }
+
+        // ... and of their faces, the best of these is drawn next
+        best = -1;
+        bestScore = -1.f;
+        for (const unsigned int v : newCache) {
+            const unsigned int* list = adj.GetAdjacentTriangles(v);
+            for (unsigned int t = 0; t < live[v]; ++t) {
+                const unsigned int f = list[t];
+                const unsigned int* fidx = pMesh->mFaces[f].mIndices;
+                faceScore[f] = vertexScore[fidx[0]] + vertexScore[fidx[1]] + vertexScore[fidx[2]];
+                if (faceScore[f] > bestScore) {
+                    bestScore = faceScore[f];
+                    best = f;
+                }
+            }
+        }
+
+        if (newCache.size() > cacheSize) {
+            newCache.resize(cacheSize);
+        }
+        cache.swap(newCache);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Overdraw optimization of Tipsify: cut the vertex cache order into clusters and draw
+// the clusters facing away from the center of the mesh first
+void ImproveCacheLocalityProcess::OptimizeOverdraw( const aiMesh* pMesh, std::vector<unsigned int>& indices) const {
+    const size_t numFaces = indices.size() / 3;
+    const unsigned int cacheSize = mConfigCacheDepth;
+    std::vector<unsigned int> stamps(pMesh->mNumVertices, 0);
+    unsigned int time = 0;
+
+    // hard boundaries: a face missing all three vertices starts a new patch of the mesh
+    std::vector<size_t> hard;
+    time += cacheSize + 1;
+    for (size_t f = 0; f < numFaces; ++f) {
+        if (0 == f || 3 == CountCacheMisses(indices.data(), f, f + 1, cacheSize, stamps, time)) {
+            hard.push_back(f);
+        }
+    }
+
+    // soft boundaries: cut a patch wherever the ACMR of the current cluster,
+    // starting with an empty cache, is below the threshold
+    std::vector<size_t> clusters;
+    for (size_t c = 0; c < hard.size(); ++c) {
+        const size_t start = hard[c];
+        const size_t end = c + 1 < hard.size() ? hard[c + 1] : numFaces;
+
+        time += cacheSize + 1;
+        const unsigned int misses = CountCacheMisses(indices.data(), start, end, cacheSize, stamps, time);
+        const float threshold = mConfigOverdrawThreshold * misses / (end - start);
+
+        clusters.push_back(start);
+        time += cacheSize + 1;
+        unsigned int runningMisses = 0, runningFaces = 0;
+        for (size_t f = start; f < end; ++f) {
+            runningMisses += CountCacheMisses(indices.data(), f, f + 1, cacheSize, stamps, time);
+            ++runningFaces;
+            if (static_cast<float>(runningMisses) / runningFaces <= threshold) {
+                clusters.push_back(f + 1);
+                time += cacheSize + 1;
+                runningMisses = runningFaces = 0;
+            }
+        }
+
+        // the rest of the patch is usually too small to be good on its own,
+        // merge it with the cluster before
+        if (clusters.back() != start) {
+            clusters.pop_back();
+        }
+    }
+
+    // mesh centroid, weighted by use
+    aiVector3D center;
+    for (const unsigned int i : indices) {
+        center += pMesh->mVertices[i];
+    }
+    center /= static_cast<ai_real>(indices.size());
+
+    // sort key: how much the cluster faces away from the center
+    std::vector<std::pair<float, size_t>> keys(clusters.size());
+    for (size_t c = 0; c < clusters.size(); ++c) {
+        const size_t start = clusters[c];
+        const size_t end = c + 1 < clusters.size() ? clusters[c + 1] : numFaces;
+
+        aiVector3D centroid, normal;
+        ai_real area = 0;
+        for (size_t f = start; f < end; ++f) {
+            const aiVector3D& p0 = pMesh->mVertices[indices[f * 3 + 0]];
+            const aiVector3D& p1 = pMesh->mVertices[indices[f * 3 + 1]];
+            const aiVector3D& p2 = pMesh->mVertices[indices[f * 3 + 2]];
+            const aiVector3D n = (p1 - p0) ^ (p2 - p0);
+            const ai_real a = n.Length();
+            centroid += (p0 + p1 + p2) * (a / 3);
+            normal += n;
+            area += a;
+        }
+        if (area > 0) {
+            centroid /= area;
+        }
+        const ai_real length = normal.Length();
+        if (length > 0) {
+            normal /= length;
+        }
+        keys[c] = std::make_pair(static_cast<float>((centroid - center) * normal), c);
+    }
+    std::stable_sort(keys.begin(), keys.end(), [](const std::pair<float, size_t>& a, const std::pair<float, size_t>& b) {
+        return a.first > b.first;
+    });
+
+    std::vector<unsigned int> sorted;
+    sorted.reserve(indices.size());
+    for (const auto& key : keys) {
+        const size_t c = key.second;
+        const size_t start = clusters[c];
+        const size_t end = c + 1 < clusters.size() ? clusters[c + 1] : numFaces;
+        sorted.insert(sorted.end(), indices.begin() + start * 3, indices.begin() + end * 3);
+    }
+    indices.swap(sorted);
 }
@@ -49,19 +49,59 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/types.h>
 
+#include <vector>
+
 struct aiMesh;
 
 namespace Assimp
 {
 
+// ---------------------------------------------------------------------------
+/** @brief Vertex cache efficiency of a mesh, see ComputeVertexCacheStatistics() */
+struct VertexCacheStatistics {
+    //! Number of faces and vertices of the mesh
+    unsigned int mNumFaces;
+    unsigned int mNumVertices;
+
+    //! Vertices transformed by a FIFO cache drawing the faces in order
+    unsigned int mNumMisses;
+
+    VertexCacheStatistics() :
+            mNumFaces(0), mNumVertices(0), mNumMisses(0) {
+        // empty
+    }
+
+    //! Average cache miss ratio, misses per face. 3 is the worst for triangles.
+    ai_real GetACMR() const {
+        return mNumFaces ? static_cast<ai_real>(mNumMisses) / mNumFaces : static_cast<ai_real>(0.f);
+    }
+
+    //! Average transformed vertex ratio, misses per vertex. 1 is the best.
+    ai_real GetATVR() const {
+        return mNumVertices ? static_cast<ai_real>(mNumMisses) / mNumVertices : static_cast<ai_real>(0.f);
+    }
+};
+
+// ---------------------------------------------------------------------------
+/** @brief Simulate a FIFO post-transform vertex cache for the faces of a mesh
+ *  @param pMesh Mesh to measure, faces may be arbitrary polygons
+ *  @param cacheSize Number of vertices the cache holds
+ */
+ASSIMP_API VertexCacheStatistics ComputeVertexCacheStatistics(const aiMesh *pMesh, unsigned int cacheSize);
+
 // ---------------------------------------------------------------------------
 /** The ImproveCacheLocalityProcess reorders all faces for improved vertex
  *  cache locality. It tries to arrange all faces to fans and to render
  *  faces which share vertices directly one after the other.
  *
+ *  The algorithm is chosen by #AI_CONFIG_PP_ICL_ALGORITHM. Optionally the
+ *  faces are clustered and sorted against overdraw afterwards, and the
+ *  vertices are renumbered in the order of their first use. The average
+ *  ACMR and ATVR before and after are stored in the scene metadata.
+ *
  *  @note This step expects triagulated input data.
  */
-class ImproveCacheLocalityProcess : public BaseProcess
+class ASSIMP_API ImproveCacheLocalityProcess : public BaseProcess
 {
 public:
 
@@ -87,13 +127,38 @@ protected:
     /** Executes the postprocessing step on the given mesh
      * @param pMesh The mesh to process.
      * @param meshNum Index of the mesh to process
+     * @param in Receives the statistics of the mesh before the step
+     * @return The statistics after the step, all zero if the mesh was
+     *   left untouched
      */
-    ai_real ProcessMesh( aiMesh* pMesh, unsigned int meshNum);
+    VertexCacheStatistics ProcessMesh( aiMesh* pMesh, unsigned int meshNum, VertexCacheStatistics& in);
+
+    // -------------------------------------------------------------------
+    /** Tipsify, writes the new index buffer of a triangle mesh to out */
+    void OptimizeTipsify( const aiMesh* pMesh, std::vector<unsigned int>& out) const;
+
+    // -------------------------------------------------------------------
+    /** Forsyth's optimizer, writes the new index buffer of a triangle mesh to out */
+    void OptimizeForsyth( const aiMesh* pMesh, std::vector<unsigned int>& out) const;
+
+    // -------------------------------------------------------------------
+    /** Reorders clusters of the index buffer of a triangle mesh against overdraw */
+    void OptimizeOverdraw( const aiMesh* pMesh, std::vector<unsigned int>& indices) const;
 
 private:
     //! Configuration parameter: specifies the size of the cache to
     //! optimize the vertex data for.
     unsigned int mConfigCacheDepth;
+
+    //! Configuration parameter: the aiVertexCacheAlgorithm to use
+    unsigned int mConfigAlgorithm;
+
+    //! Configuration parameter: ACMR threshold of the overdraw
+    //! optimization, 0 if disabled
+    float mConfigOverdrawThreshold;
+
+    //! Configuration parameter: renumber vertices in the order of use
+    bool mConfigVertexFetch;
 };
 
 } // end of namespace Assimp
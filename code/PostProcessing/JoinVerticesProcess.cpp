@@ -52,13 +52,18 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ProcessHelper.h"
 #include <assimp/Vertex.h>
 #include <assimp/TinyFormatter.h>
+#include <cmath>
+#include <cstring>
 #include <stdio.h>
+#include <type_traits>
 #include <unordered_set>
 
 using namespace Assimp;
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 JoinVerticesProcess::JoinVerticesProcess()
+: mMethod(AI_JIV_METHOD_SPATIAL_SORT)
+, mQuantizationStep(1e-5f)
 {
     // nothing to do here
 }
@@ -76,6 +81,18 @@ bool JoinVerticesProcess::IsActive( unsigned int pFlags) const
 {
     return (pFlags & aiProcess_JoinIdenticalVertices) != 0;
 }
+
+// ------------------------------------------------------------------------------------------------
+// Setup import configuration
+void JoinVerticesProcess::SetupProperties(const Importer* pImp)
+{
+    mMethod = pImp->GetPropertyInteger(AI_CONFIG_PP_JIV_METHOD, AI_JIV_METHOD_SPATIAL_SORT);
+    mQuantizationStep = pImp->GetPropertyFloat(AI_CONFIG_PP_JIV_QUANTIZATION_STEP, 1e-5f);
+    if (mQuantizationStep <= 0.f) {
+        ASSIMP_LOG_ERROR("JoinVerticesProcess: quantization step must be positive, using the default");
+        mQuantizationStep = 1e-5f;
+    }
+}
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void JoinVerticesProcess::Execute( aiScene* pScene)
@@ -90,10 +107,15 @@ void JoinVerticesProcess::Execute( aiScene* pScene)
         }
     }
 
-    // execute the step
+    // execute the step, the meshes don't depend on each other
+    std::vector<int> numVertices(pScene->mNumMeshes, 0);
+    ForEachMesh(pScene->mNumMeshes, [&](unsigned int a) {
+        numVertices[a] = ProcessMesh( pScene->mMeshes[a],a);
+    });
+
     int iNumVertices = 0;
     for( unsigned int a = 0; a < pScene->mNumMeshes; a++)
-        iNumVertices += ProcessMesh( pScene->mMeshes[a],a);
+        iNumVertices += numVertices[a];
 
     // if logging is active, print detailed statistics
     if (!DefaultLogger::isNullLogger()) {
@@ -226,6 +248,179 @@ void updateXMeshVertices(XMesh *pMesh, std::vector<Vertex> &uniqueVertices) {
         }
     }
 }
+
+// ------------------------------------------------------------------------------------------------
+// Replace a vertex array by the elements at the given indices
+template<class T>
+void gatherVertexArray(T *&data, const std::vector<unsigned int> &sourceIndices) {
+    T *unique = new T[sourceIndices.size()];
+    for (size_t a = 0; a < sourceIndices.size(); a++) {
+        unique[a] = data[sourceIndices[a]];
+    }
+    delete [] data;
+    data = unique;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Same as above, but take the unique vertices straight from the old vertex arrays
+template<class XMesh>
+void updateXMeshVertices(XMesh *pMesh, const std::vector<unsigned int> &sourceIndices) {
+    pMesh->mNumVertices = (unsigned int)sourceIndices.size();
+
+    if (pMesh->mVertices) {
+        gatherVertexArray(pMesh->mVertices, sourceIndices);
+    }
+    if (pMesh->mNormals) {
+        gatherVertexArray(pMesh->mNormals, sourceIndices);
+    }
+    if (pMesh->mTangents) {
+        gatherVertexArray(pMesh->mTangents, sourceIndices);
+    }
+    if (pMesh->mBitangents) {
+        gatherVertexArray(pMesh->mBitangents, sourceIndices);
+    }
+    for (unsigned int a = 0; pMesh->HasVertexColors(a); a++) {
+        gatherVertexArray(pMesh->mColors[a], sourceIndices);
+    }
+    for (unsigned int a = 0; pMesh->HasTextureCoords(a); a++) {
+        gatherVertexArray(pMesh->mTextureCoords[a], sourceIndices);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Hashes and compares the vertices of a mesh and its animation meshes by all their attributes.
+// Each attribute value is mapped to an integer key first: either its bit pattern, with -0 and +0
+// mapped to the same key, or its index on a grid of the quantization step.
+class VertexHasher {
+public:
+    VertexHasher(const aiMesh *pMesh, float quantizationStep)
+    : mInvStep(quantizationStep > 0.f ? 1.0 / quantizationStep : 0.0) {
+        AddMesh(pMesh);
+        for (unsigned int a = 0; a < pMesh->mNumAnimMeshes; a++) {
+            AddMesh(pMesh->mAnimMeshes[a]);
+        }
+    }
+
+    uint64_t Hash(unsigned int index) const {
+        uint64_t hash = 0xcbf29ce484222325ull;
+        for (const Stream &stream : mStreams) {
+            const ai_real *values = stream.data + static_cast<size_t>(index) * stream.size;
+            for (unsigned int c = 0; c < stream.size; c++) {
+                hash = (hash ^ Key(values[c])) * 0x100000001b3ull;
+                hash ^= hash >> 29;
+            }
+        }
+        return hash;
+    }
+
+    bool Equal(unsigned int lhs, unsigned int rhs) const {
+        for (const Stream &stream : mStreams) {
+            const ai_real *a = stream.data + static_cast<size_t>(lhs) * stream.size;
+            const ai_real *b = stream.data + static_cast<size_t>(rhs) * stream.size;
+            for (unsigned int c = 0; c < stream.size; c++) {
+                if (Key(a[c]) != Key(b[c])) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+private:
+    struct Stream {
+        const ai_real *data;
+        unsigned int size;
+    };
+
+    typedef std::conditional<sizeof(ai_real) == sizeof(uint64_t), uint64_t, uint32_t>::type Bits;
+
+    template<class XMesh>
+    void AddMesh(const XMesh *pMesh) {
+        AddStream(pMesh->mVertices, 3);
+        AddStream(pMesh->mNormals, 3);
+        AddStream(pMesh->mTangents, 3);
+        AddStream(pMesh->mBitangents, 3);
+        for (unsigned int a = 0; pMesh->HasTextureCoords(a); a++) {
+            AddStream(pMesh->mTextureCoords[a], 3);
+        }
+        for (unsigned int a = 0; pMesh->HasVertexColors(a); a++) {
+            AddStream(pMesh->mColors[a], 4);
+        }
+    }
+
+    template<class T>
+    void AddStream(const T *data, unsigned int size) {
+        static_assert(sizeof(T) == sizeof(ai_real) * (sizeof(T) / sizeof(ai_real)), "unexpected attribute layout");
+        if (data) {
+            const Stream stream = { reinterpret_cast<const ai_real *>(data), size };
+            mStreams.push_back(stream);
+        }
+    }
+
+    uint64_t Key(ai_real value) const {
+        if (mInvStep != 0.0) {
+            const double cell = std::floor(value * mInvStep + 0.5);
+            if (std::fabs(cell) < 9.0e18) {
+                return static_cast<uint64_t>(static_cast<int64_t>(cell));
+            }
+        }
+        value += ai_real(0.0);
+        Bits bits;
+        ::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+private:
+    const double mInvStep;
+    std::vector<Stream> mStreams;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Translate the face indices and bone weights to the unique vertices
+void updateFacesAndBones(aiMesh *pMesh, const std::vector<unsigned int> &replaceIndex) {
+    // the meshlets refer to the old vertices
+    pMesh->ReleaseMeshlets();
+
+    // adjust the indices in all faces
+    for( unsigned int a = 0; a < pMesh->mNumFaces; a++)
+    {
+        aiFace& face = pMesh->mFaces[a];
+        for( unsigned int b = 0; b < face.mNumIndices; b++) {
+            face.mIndices[b] = replaceIndex[face.mIndices[b]] & ~0x80000000;
+        }
+    }
+
+    // adjust bone vertex weights.
+    for( int a = 0; a < (int)pMesh->mNumBones; a++) {
+        aiBone* bone = pMesh->mBones[a];
+        std::vector<aiVertexWeight> newWeights;
+        newWeights.reserve( bone->mNumWeights);
+
+        if (nullptr != bone->mWeights) {
+            for ( unsigned int b = 0; b < bone->mNumWeights; b++ ) {
+                const aiVertexWeight& ow = bone->mWeights[ b ];
+                // if the vertex is a unique one, translate it
+                if ( !( replaceIndex[ ow.mVertexId ] & 0x80000000 ) ) {
+                    aiVertexWeight nw;
+                    nw.mVertexId = replaceIndex[ ow.mVertexId ];
+                    nw.mWeight = ow.mWeight;
+                    newWeights.push_back( nw );
+                }
+            }
+        } else {
+            ASSIMP_LOG_ERROR( "X-Export: aiBone shall contain weights, but pointer to them is nullptr." );
+        }
+
+        if (newWeights.size() > 0) {
+            // kill the old and replace them with the translated weights
+            delete [] bone->mWeights;
+            bone->mNumWeights = (unsigned int)newWeights.size();
+
+            bone->mWeights = new aiVertexWeight[bone->mNumWeights];
+            memcpy( bone->mWeights, &newWeights[0], bone->mNumWeights * sizeof( aiVertexWeight));
+        }
+    }
+}
 } // namespace
 
 // ------------------------------------------------------------------------------------------------
@@ -240,6 +435,10 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
         return 0;
     }
 
+    if (mMethod == AI_JIV_METHOD_HASH_EXACT || mMethod == AI_JIV_METHOD_HASH_QUANTIZED) {
+        return ProcessMeshHashed(pMesh, meshIndex);
+    }
+
     // We should care only about used vertices, not all of them
     // (this can happen due to original file vertices buffer being used by
     // multiple meshes)
@@ -393,45 +592,87 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
         }
     }
 
-    // adjust the indices in all faces
-    for( unsigned int a = 0; a < pMesh->mNumFaces; a++)
-    {
-        aiFace& face = pMesh->mFaces[a];
+    updateFacesAndBones(pMesh, replaceIndex);
+    return pMesh->mNumVertices;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Unites identical vertices in the given mesh using a hash table of all vertex attributes
+int JoinVerticesProcess::ProcessMeshHashed( aiMesh* pMesh, unsigned int meshIndex)
+{
+    // We should care only about used vertices, see above
+    std::vector<bool> used(pMesh->mNumVertices, false);
+    unsigned int numUsed = 0;
+    for( unsigned int a = 0; a < pMesh->mNumFaces; a++) {
+        const aiFace& face = pMesh->mFaces[a];
         for( unsigned int b = 0; b < face.mNumIndices; b++) {
-            face.mIndices[b] = replaceIndex[face.mIndices[b]] & ~0x80000000;
+            if (!used[face.mIndices[b]]) {
+                used[face.mIndices[b]] = true;
+                ++numUsed;
+            }
         }
     }
 
-    // adjust bone vertex weights.
-    for( int a = 0; a < (int)pMesh->mNumBones; a++) {
-        aiBone* bone = pMesh->mBones[a];
-        std::vector<aiVertexWeight> newWeights;
-        newWeights.reserve( bone->mNumWeights);
+    const VertexHasher hasher(pMesh, mMethod == AI_JIV_METHOD_HASH_QUANTIZED ? mQuantizationStep : 0.f);
 
-        if (nullptr != bone->mWeights) {
-            for ( unsigned int b = 0; b < bone->mNumWeights; b++ ) {
-                const aiVertexWeight& ow = bone->mWeights[ b ];
-                // if the vertex is a unique one, translate it
-                if ( !( replaceIndex[ ow.mVertexId ] & 0x80000000 ) ) {
-                    aiVertexWeight nw;
-                    nw.mVertexId = replaceIndex[ ow.mVertexId ];
-                    nw.mWeight = ow.mWeight;
-                    newWeights.push_back( nw );
-                }
+    // open addressing with linear probing, the table is at most half full
+    size_t capacity = 16;
+    while (capacity < 2 * static_cast<size_t>(numUsed)) {
+        capacity *= 2;
+    }
+    const size_t mask = capacity - 1;
+    std::vector<unsigned int> slots(capacity, 0xffffffff);
+    std::vector<uint32_t> slotHashes(capacity);
+
+    // For each unique vertex the index of its first occurrence, for each vertex the index
+    // of the unique vertex it was replaced by. Same encoding as in ProcessMesh().
+    std::vector<unsigned int> uniqueSources;
+    uniqueSources.reserve(numUsed);
+    std::vector<unsigned int> replaceIndex( pMesh->mNumVertices, 0xffffffff);
+
+    for( unsigned int a = 0; a < pMesh->mNumVertices; a++) {
+        if (!used[a]) {
+            continue;
+        }
+
+        const uint64_t hash = hasher.Hash(a);
+        const uint32_t shortHash = static_cast<uint32_t>(hash >> 32);
+        for (size_t slot = static_cast<size_t>(hash) & mask;; slot = (slot + 1) & mask) {
+            const unsigned int uidx = slots[slot];
+            if (uidx == 0xffffffff) {
+                // no unique vertex matches it up to now -> so add it
+                slots[slot] = replaceIndex[a] = static_cast<unsigned int>(uniqueSources.size());
+                slotHashes[slot] = shortHash;
+                uniqueSources.push_back(a);
+                break;
+            }
+            if (slotHashes[slot] == shortHash && hasher.Equal(uniqueSources[uidx], a)) {
+                replaceIndex[a] = uidx | 0x80000000;
+                break;
             }
-        } else {
-            ASSIMP_LOG_ERROR( "X-Export: aiBone shall contain weights, but pointer to them is nullptr." );
         }
+    }
 
-        if (newWeights.size() > 0) {
-            // kill the old and replace them with the translated weights
-            delete [] bone->mWeights;
-            bone->mNumWeights = (unsigned int)newWeights.size();
+    if (!DefaultLogger::isNullLogger() && DefaultLogger::get()->getLogSeverity() == Logger::VERBOSE)    {
+        ASSIMP_LOG_VERBOSE_DEBUG_F(
+            "Mesh ",meshIndex,
+            " (",
+            (pMesh->mName.length ? pMesh->mName.data : "unnamed"),
+            ") | Verts in: ",pMesh->mNumVertices,
+            " out: ",
+            uniqueSources.size(),
+            " | ~",
+            ((pMesh->mNumVertices - uniqueSources.size()) / (float)pMesh->mNumVertices) * 100.f,
+            "%"
+        );
+    }
 
-            bone->mWeights = new aiVertexWeight[bone->mNumWeights];
-            memcpy( bone->mWeights, &newWeights[0], bone->mNumWeights * sizeof( aiVertexWeight));
-        }
+    updateXMeshVertices(pMesh, uniqueSources);
+    for (unsigned int animMeshIndex = 0; animMeshIndex < pMesh->mNumAnimMeshes; animMeshIndex++) {
+        updateXMeshVertices(pMesh->mAnimMeshes[animMeshIndex], uniqueSources);
     }
+
+    updateFacesAndBones(pMesh, replaceIndex);
     return pMesh->mNumVertices;
 }
 
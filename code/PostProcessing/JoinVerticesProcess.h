@@ -75,6 +75,13 @@ public:
     */
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    /** Called prior to ExecuteOnScene().
+    * The function is a request to the process to update its configuration
+    * basing on the Importer's configuration property list.
+    */
+    void SetupProperties(const Importer* pImp);
+
     // -------------------------------------------------------------------
     /** Executes the post processing step on the given imported data.
     * At the moment a process is not supposed to fail.
@@ -88,6 +95,20 @@ public:
      * @param meshIndex Index of the mesh to process
      */
     int ProcessMesh( aiMesh* pMesh, unsigned int meshIndex);
+
+private:
+    // -------------------------------------------------------------------
+    /** Unites identical vertices by hashing their attributes, see
+     *  #AI_CONFIG_PP_JIV_METHOD.
+     */
+    int ProcessMeshHashed( aiMesh* pMesh, unsigned int meshIndex);
+
+private:
+    /** Configured search method, one of the AI_JIV_METHOD_XXX values */
+    int mMethod;
+
+    /** Configured grid size for AI_JIV_METHOD_HASH_QUANTIZED */
+    float mQuantizationStep;
 };
 
 } // end of namespace Assimp
@@ -82,6 +82,9 @@ void MakeVerboseFormatProcess::Execute(aiScene *pScene) {
 bool MakeVerboseFormatProcess::MakeVerboseFormat(aiMesh *pcMesh) {
     ai_assert(nullptr != pcMesh);
 
+    // every face gets vertices of its own, the meshlets refer to the old ones
+    pcMesh->ReleaseMeshlets();
+
     unsigned int iOldNumVertices = pcMesh->mNumVertices;
     const unsigned int iNumVerts = pcMesh->mNumFaces * 3;
 
@@ -125,17 +125,22 @@ unsigned int PretransformVertices::GetMeshVFormat(aiMesh *pcMesh) const {
 // Count the number of vertices in the whole scene and a given
 // material index
 void PretransformVertices::CountVerticesAndFaces(const aiScene *pcScene, const aiNode *pcNode, unsigned int iMat,
-		unsigned int iVFormat, unsigned int *piFaces, unsigned int *piVertices) const {
+		unsigned int iVFormat, unsigned int *piFaces, unsigned int *piVertices,
+		unsigned int *piIndices, bool *pbIndexPool) const {
 	for (unsigned int i = 0; i < pcNode->mNumMeshes; ++i) {
 		aiMesh *pcMesh = pcScene->mMeshes[pcNode->mMeshes[i]];
 		if (iMat == pcMesh->mMaterialIndex && iVFormat == GetMeshVFormat(pcMesh)) {
 			*piVertices += pcMesh->mNumVertices;
 			*piFaces += pcMesh->mNumFaces;
+			for (unsigned int a = 0; a < pcMesh->mNumFaces; ++a) {
+				*piIndices += pcMesh->mFaces[a].mNumIndices;
+			}
+			*pbIndexPool = *pbIndexPool || nullptr != pcMesh->mFaceIndices;
 		}
 	}
 	for (unsigned int i = 0; i < pcNode->mNumChildren; ++i) {
 		CountVerticesAndFaces(pcScene, pcNode->mChildren[i], iMat,
-				iVFormat, piFaces, piVertices);
+				iVFormat, piFaces, piVertices, piIndices, pbIndexPool);
 	}
 }
 
@@ -234,7 +239,21 @@ void PretransformVertices::CollectData(const aiScene *pcScene, const aiNode *pcN
 				f_dst.mNumIndices = num_idx;
 
 				unsigned int *pi;
-				if (!num_ref) { /* if last time the mesh is referenced -> no reallocation */
+				if (pcMeshOut->mFaceIndices) { /* the output keeps its indices in a pool, mNumFaceIndices is the fill level */
+					pi = f_dst.mIndices = pcMeshOut->mFaceIndices + pcMeshOut->mNumFaceIndices;
+					pcMeshOut->mNumFaceIndices += num_idx;
+
+					// copy and offset all vertex indices
+					for (unsigned int hahn = 0; hahn < num_idx; ++hahn) {
+						pi[hahn] = f_src.mIndices[hahn] + aiCurrent[AI_PTVS_VERTEX];
+					}
+
+					// an index array which is not part of a pool is not reused
+					if (!num_ref && !pcMesh->IsPooledFace(f_src)) {
+						delete[] f_src.mIndices;
+						f_src.mIndices = nullptr;
+					}
+				} else if (!num_ref) { /* if last time the mesh is referenced -> no reallocation */
 					pi = f_dst.mIndices = f_src.mIndices;
 
 					// offset all vertex indices
@@ -496,13 +515,19 @@ void PretransformVertices::Execute(aiScene *pScene) {
 			for (std::list<unsigned int>::const_iterator j = aiVFormats.begin(); j != aiVFormats.end(); ++j) {
 				unsigned int iVertices = 0;
 				unsigned int iFaces = 0;
-				CountVerticesAndFaces(pScene, pScene->mRootNode, i, *j, &iFaces, &iVertices);
+				unsigned int iIndices = 0;
+				bool bIndexPool = false;
+				CountVerticesAndFaces(pScene, pScene->mRootNode, i, *j, &iFaces, &iVertices, &iIndices, &bIndexPool);
 				if (0 != iFaces && 0 != iVertices) {
 					apcOutMeshes.push_back(new aiMesh());
 					aiMesh *pcMesh = apcOutMeshes.back();
 					pcMesh->mNumFaces = iFaces;
 					pcMesh->mNumVertices = iVertices;
 					pcMesh->mFaces = new aiFace[iFaces];
+					if (bIndexPool) {
+						// filled up by CollectData()
+						pcMesh->mFaceIndices = new unsigned int[iIndices];
+					}
 					pcMesh->mVertices = new aiVector3D[iVertices];
 					pcMesh->mMaterialIndex = i;
 					if ((*j) & 0x2) pcMesh->mNormals = new aiVector3D[iVertices];
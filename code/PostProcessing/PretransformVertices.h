@@ -110,12 +110,15 @@ private:
 
 	// -------------------------------------------------------------------
 	// Count the number of vertices in the whole scene and a given
-	// material index
+	// material index. pbIndexPool is set if one of the meshes keeps
+	// its face indices in a pool.
 	void CountVerticesAndFaces(const aiScene *pcScene, const aiNode *pcNode,
 			unsigned int iMat,
 			unsigned int iVFormat,
 			unsigned int *piFaces,
-			unsigned int *piVertices) const;
+			unsigned int *piVertices,
+			unsigned int *piIndices,
+			bool *pbIndexPool) const;
 
 	// -------------------------------------------------------------------
 	// Collect vertex/face data
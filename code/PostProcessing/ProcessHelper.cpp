@@ -286,12 +286,26 @@ aiMesh *MakeSubmesh(const aiMesh *pMesh, const std::vector<unsigned int> &subMes
     // and copy over the data, generating faces with linear indices along the way
     oMesh->mFaces = new aiFace[numSubFaces];
 
+    // keep the index pool of the source mesh
+    if (pMesh->mFaceIndices) {
+        for (unsigned int a = 0; a < numSubFaces; ++a) {
+            oMesh->mNumFaceIndices += pMesh->mFaces[subMeshFaces[a]].mNumIndices;
+        }
+        oMesh->mFaceIndices = new unsigned int[oMesh->mNumFaceIndices];
+    }
+    unsigned int *nextIndex = oMesh->mFaceIndices;
+
     for (unsigned int a = 0; a < numSubFaces; ++a) {
 
         const aiFace &srcFace = pMesh->mFaces[subMeshFaces[a]];
         aiFace &dstFace = oMesh->mFaces[a];
         dstFace.mNumIndices = srcFace.mNumIndices;
-        dstFace.mIndices = new unsigned int[dstFace.mNumIndices];
+        if (nextIndex) {
+            dstFace.mIndices = nextIndex;
+            nextIndex += dstFace.mNumIndices;
+        } else {
+            dstFace.mIndices = new unsigned int[dstFace.mNumIndices];
+        }
 
         // accumulate linearly all the vertices of the source face
         for (size_t b = 0; b < dstFace.mNumIndices; ++b) {
@@ -51,6 +51,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ProcessHelper.h"
 #include "Material/MaterialSystem.h"
 #include <stdio.h>
+#include <unordered_map>
 
 using namespace Assimp;
 
@@ -139,7 +140,8 @@ void RemoveRedundantMatsProcess::Execute( aiScene* pScene)
         // store all hashes in a list and so a quick search whether
         // we do already have a specific hash. This allows us to
         // determine which materials are identical.
-        uint32_t *aiHashes = new uint32_t[ pScene->mNumMaterials ];;
+        std::unordered_map<uint32_t, unsigned int> hashes;
+        hashes.reserve(pScene->mNumMaterials);
         for (unsigned int i = 0; i < pScene->mNumMaterials;++i)
         {
             // No mesh is referencing this material, remove it.
@@ -150,24 +152,19 @@ void RemoveRedundantMatsProcess::Execute( aiScene* pScene)
                 continue;
             }
 
-            // Check all previously mapped materials for a matching hash.
+            // Look for a previously mapped material with the same hash.
             // On a match we can delete this material and just make it ref to the same index.
-            uint32_t me = aiHashes[i] = ComputeMaterialHash(pScene->mMaterials[i]);
-            for (unsigned int a = 0; a < i;++a)
-            {
-                if (abReferenced[a] && me == aiHashes[a]) {
-                    ++redundantRemoved;
-                    me = 0;
-                    aiMappingTable[i] = aiMappingTable[a];
-                    delete pScene->mMaterials[i];
-                    pScene->mMaterials[i] = nullptr;
-                    break;
-                }
+            const uint32_t me = ComputeMaterialHash(pScene->mMaterials[i]);
+            std::pair<std::unordered_map<uint32_t, unsigned int>::iterator, bool> it = hashes.insert(std::make_pair(me, iNewNum));
+            if (!it.second) {
+                ++redundantRemoved;
+                aiMappingTable[i] = it.first->second;
+                delete pScene->mMaterials[i];
+                pScene->mMaterials[i] = nullptr;
+                continue;
             }
             // This is a new material that is referenced, add to the map.
-            if (me) {
-                aiMappingTable[i] = iNewNum++;
-            }
+            aiMappingTable[i] = iNewNum++;
         }
         // If the new material count differs from the original,
         // we need to rebuild the material list and remap mesh material indexes.
@@ -206,7 +203,6 @@ void RemoveRedundantMatsProcess::Execute( aiScene* pScene)
             pScene->mNumMaterials = iNewNum;
         }
         // delete temporary storage
-        delete[] aiHashes;
         delete[] aiMappingTable;
     }
     if (redundantRemoved == 0 && unreferencedRemoved == 0)
@@ -210,6 +210,12 @@ void SortByPTypeProcess::Execute(aiScene *pScene) {
 
             out->mNumVertices = (3 == real ? numPolyVerts : out->mNumFaces * (real + 1));
 
+            // each index of the output refers to a vertex of its own
+            if (mesh->mFaceIndices) {
+                out->mFaceIndices = new unsigned int[out->mNumVertices];
+                out->mNumFaceIndices = out->mNumVertices;
+            }
+
             aiVector3D *vert(nullptr), *nor(nullptr), *tan(nullptr), *bit(nullptr);
             aiVector3D *uv[AI_MAX_NUMBER_OF_TEXTURECOORDS];
             aiColor4D *cols[AI_MAX_NUMBER_OF_COLOR_SETS];
@@ -299,7 +305,7 @@ void SortByPTypeProcess::Execute(aiScene *pScene) {
                 }
 
                 outFaces->mNumIndices = in.mNumIndices;
-                outFaces->mIndices = in.mIndices;
+                outFaces->mIndices = out->mFaceIndices ? out->mFaceIndices + outIdx : in.mIndices;
 
                 for (unsigned int q = 0; q < in.mNumIndices; ++q) {
                     unsigned int idx = in.mIndices[q];
@@ -357,10 +363,13 @@ void SortByPTypeProcess::Execute(aiScene *pScene) {
                     if (pp == mesh->mNumAnimMeshes)
                         amIdx++;
 
-                    in.mIndices[q] = outIdx++;
+                    outFaces->mIndices[q] = outIdx++;
                 }
 
-                in.mIndices = nullptr;
+                // the index array was taken over, unless it was copied to the pool
+                if (!out->mFaceIndices) {
+                    in.mIndices = nullptr;
+                }
                 ++outFaces;
             }
             ai_assert(outFaces == out->mFaces + out->mNumFaces);
@@ -291,6 +291,12 @@ void SplitByBoneCountProcess::SplitMesh( const aiMesh* pMesh, std::vector<aiMesh
 
         // and copy over the data, generating faces with linear indices along the way
         newMesh->mFaces = new aiFace[subMeshFaces.size()];
+        if( pMesh->mFaceIndices )
+        {
+            // one index per new vertex, keep the index pool of the source mesh
+            newMesh->mFaceIndices = new unsigned int[newMesh->mNumVertices];
+            newMesh->mNumFaceIndices = newMesh->mNumVertices;
+        }
         unsigned int nvi = 0; // next vertex index
         std::vector<unsigned int> previousVertexIndices( numSubMeshVertices, std::numeric_limits<unsigned int>::max()); // per new vertex: its index in the source mesh
         for( unsigned int a = 0; a < subMeshFaces.size(); ++a )
@@ -298,7 +304,7 @@ void SplitByBoneCountProcess::SplitMesh( const aiMesh* pMesh, std::vector<aiMesh
             const aiFace& srcFace = pMesh->mFaces[subMeshFaces[a]];
             aiFace& dstFace = newMesh->mFaces[a];
             dstFace.mNumIndices = srcFace.mNumIndices;
-            dstFace.mIndices = new unsigned int[dstFace.mNumIndices];
+            dstFace.mIndices = newMesh->mFaceIndices ? newMesh->mFaceIndices + nvi : new unsigned int[dstFace.mNumIndices];
 
             // accumulate linearly all the vertices of the source face
             for( unsigned int b = 0; b < dstFace.mNumIndices; ++b )
@@ -48,6 +48,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "SplitLargeMeshes.h"
 #include "ProcessHelper.h"
 
+#include <algorithm>
+
 using namespace Assimp;
 
 // ------------------------------------------------------------------------------------------------
@@ -176,6 +178,12 @@ void SplitLargeMeshesProcess_Triangle::SplitMesh(
             }
             pcMesh->mNumVertices = iCnt;
 
+            // keep the index pool of the input mesh
+            if (pMesh->mFaceIndices) {
+                pcMesh->mFaceIndices = new unsigned int[iCnt];
+                pcMesh->mNumFaceIndices = iCnt;
+            }
+
             // allocate storage
             if (pMesh->mVertices != nullptr) {
                 pcMesh->mVertices = new aiVector3D[iCnt];
@@ -261,7 +269,8 @@ void SplitLargeMeshesProcess_Triangle::SplitMesh(
                 // setup face type and number of indices
                 pcMesh->mFaces[p].mNumIndices = iNumIndices;
                 unsigned int* pi = pMesh->mFaces[iTemp].mIndices;
-                unsigned int* piOut = pcMesh->mFaces[p].mIndices = new unsigned int[iNumIndices];
+                unsigned int* piOut = pcMesh->mFaces[p].mIndices = pcMesh->mFaceIndices ?
+                    pcMesh->mFaceIndices + iCurrent : new unsigned int[iNumIndices];
 
                 // need to update the output primitive types
                 switch (iNumIndices) {
@@ -441,8 +450,9 @@ void SplitLargeMeshesProcess_Vertex::SplitMesh(
                 }
             }
 
-            // output vectors
-            std::vector<aiFace> vFaces;
+            // output vectors, the faces are set up once all their indices are known
+            std::vector<unsigned int> vFaceSizes;
+            std::vector<unsigned int> vIndices;
 
             // reserve enough storage for most cases
             if (pMesh->HasPositions()) {
@@ -462,7 +472,8 @@ void SplitLargeMeshesProcess_Vertex::SplitMesh(
                 pcMesh->mNumUVComponents[c] = pMesh->mNumUVComponents[c];
                 pcMesh->mTextureCoords[c] = new aiVector3D[iOutVertexNum];
             }
-            vFaces.reserve(iEstimatedSize);
+            vFaceSizes.reserve(iEstimatedSize);
+            vIndices.reserve(iEstimatedSize * 3);
 
             // (we will also need to copy the array of indices)
             while (iBase < pMesh->mNumFaces) {
@@ -484,15 +495,14 @@ void SplitLargeMeshesProcess_Vertex::SplitMesh(
                     break;
                 }
 
-                vFaces.push_back(aiFace());
-                aiFace& rFace = vFaces.back();
-
                 // setup face type and number of indices
-                rFace.mNumIndices = iNumIndices;
-                rFace.mIndices = new unsigned int[iNumIndices];
+                vFaceSizes.push_back(iNumIndices);
+                const size_t iFirstIndex = vIndices.size();
+                vIndices.resize(iFirstIndex + iNumIndices);
+                unsigned int* piOut = vIndices.data() + iFirstIndex;
 
                 // need to update the output primitive types
-                switch (rFace.mNumIndices) {
+                switch (iNumIndices) {
                 case 1:
                     pcMesh->mPrimitiveTypes |= aiPrimitiveType_POINT;
                     break;
@@ -512,7 +522,7 @@ void SplitLargeMeshesProcess_Vertex::SplitMesh(
 
                     // check whether we do already have this vertex
                     if (0xFFFFFFFF != avWasCopied[iIndex]) {
-                        rFace.mIndices[v] = avWasCopied[iIndex];
+                        piOut[v] = avWasCopied[iIndex];
                         continue;
                     }
 
@@ -543,7 +553,7 @@ void SplitLargeMeshesProcess_Vertex::SplitMesh(
                         }
                     }
                     // check whether we have bone weights assigned to this vertex
-                    rFace.mIndices[v] = pcMesh->mNumVertices;
+                    piOut[v] = pcMesh->mNumVertices;
                     if (avPerVertexWeights) {
                         VertexWeightTable& table = avPerVertexWeights[ pcMesh->mNumVertices ];
                         if( !table.empty() ) {
@@ -597,11 +607,21 @@ void SplitLargeMeshesProcess_Vertex::SplitMesh(
             }
 
             // copy the face list to the mesh
-            pcMesh->mFaces = new aiFace[vFaces.size()];
-            pcMesh->mNumFaces = (unsigned int)vFaces.size();
-
-            for (unsigned int p = 0; p < pcMesh->mNumFaces;++p) {
-                pcMesh->mFaces[p] = vFaces[p];
+            if (pMesh->mFaceIndices) {
+                pcMesh->AllocateFaces((unsigned int)vFaceSizes.size(), vFaceSizes.data());
+                std::copy(vIndices.begin(), vIndices.end(), pcMesh->mFaceIndices);
+            } else {
+                pcMesh->mFaces = new aiFace[vFaceSizes.size()];
+                pcMesh->mNumFaces = (unsigned int)vFaceSizes.size();
+
+                const unsigned int* piIn = vIndices.data();
+                for (unsigned int p = 0; p < pcMesh->mNumFaces;++p) {
+                    aiFace& rFace = pcMesh->mFaces[p];
+                    rFace.mNumIndices = vFaceSizes[p];
+                    rFace.mIndices = new unsigned int[rFace.mNumIndices];
+                    std::copy(piIn, piIn + rFace.mNumIndices, rFace.mIndices);
+                    piIn += rFace.mNumIndices;
+                }
             }
 
             // add the newly created mesh to the list
@@ -63,6 +63,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PostProcessing/ProcessHelper.h"
 #include "Common/PolyTools.h"
 
+#include <algorithm>
 #include <memory>
 #include <cstdint>
 
@@ -142,7 +143,7 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
     }
 
     // Find out how many output faces we'll get
-    uint32_t numOut = 0, max_out = 0;
+    uint32_t numOut = 0, max_out = 0, numOutIndices = 0;
     bool get_normals = true;
     for( unsigned int a = 0; a < pMesh->mNumFaces; a++) {
         aiFace& face = pMesh->mFaces[a];
@@ -151,10 +152,11 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
         }
         if( face.mNumIndices <= 3) {
             numOut++;
-
+            numOutIndices += face.mNumIndices;
         }
         else {
             numOut += face.mNumIndices-2;
+            numOutIndices += (face.mNumIndices-2)*3;
             max_out = std::max(max_out,face.mNumIndices);
         }
     }
@@ -176,6 +178,18 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
     pMesh->mPrimitiveTypes &= ~aiPrimitiveType_POLYGON;
 
     aiFace* out = new aiFace[numOut](), *curOut = out;
+
+    // if the mesh keeps its indices in a pool, so does the output
+    unsigned int* const pool = pMesh->mFaceIndices ? new unsigned int[numOutIndices] : nullptr;
+    unsigned int* curIndex = pool;
+    auto newIndices = [pool, &curIndex](unsigned int num) {
+        if (!pool) {
+            return new unsigned int[num];
+        }
+        unsigned int* const indices = curIndex;
+        curIndex += num;
+        return indices;
+    };
     std::vector<aiVector3D> temp_verts3d(max_out+2); /* temporary storage for vertices */
     std::vector<aiVector2D> temp_verts(max_out+2);
 
@@ -219,9 +233,14 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
         {
             aiFace& nface = *curOut++;
             nface.mNumIndices = face.mNumIndices;
-            nface.mIndices    = face.mIndices;
-
-            face.mIndices = nullptr;
+            if (pool && face.mIndices) {
+                nface.mIndices = newIndices(face.mNumIndices);
+                std::copy(face.mIndices, face.mIndices + face.mNumIndices, nface.mIndices);
+            }
+            else {
+                nface.mIndices = face.mIndices;
+                face.mIndices = nullptr;
+            }
             continue;
         }
         // optimized code for quadrilaterals
@@ -258,7 +277,7 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
 
             aiFace& nface = *curOut++;
             nface.mNumIndices = 3;
-            nface.mIndices = face.mIndices;
+            nface.mIndices = pool ? newIndices(3) : face.mIndices;
 
             nface.mIndices[0] = temp[start_vertex];
             nface.mIndices[1] = temp[(start_vertex + 1) % 4];
@@ -266,14 +285,16 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
 
             aiFace& sface = *curOut++;
             sface.mNumIndices = 3;
-            sface.mIndices = new unsigned int[3];
+            sface.mIndices = newIndices(3);
 
             sface.mIndices[0] = temp[start_vertex];
             sface.mIndices[1] = temp[(start_vertex + 2) % 4];
             sface.mIndices[2] = temp[(start_vertex + 3) % 4];
 
             // prevent double deletion of the indices field
-            face.mIndices = nullptr;
+            if (!pool) {
+                face.mIndices = nullptr;
+            }
             continue;
         }
         else
@@ -441,7 +462,7 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
                 nface.mNumIndices = 3;
 
                 if (!nface.mIndices) {
-                    nface.mIndices = new unsigned int[3];
+                    nface.mIndices = newIndices(3);
                 }
 
                 // setup indices for the new triangle ...
@@ -458,7 +479,7 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
                 aiFace& nface = *curOut++;
                 nface.mNumIndices = 3;
                 if (!nface.mIndices) {
-                    nface.mIndices = new unsigned int[3];
+                    nface.mIndices = newIndices(3);
                 }
 
                 for (tmp = 0; done[tmp]; ++tmp);
@@ -511,8 +532,10 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
             ++f;
         }
 
-        delete[] face.mIndices;
-        face.mIndices = nullptr;
+        if (!pool) {
+            delete[] face.mIndices;
+            face.mIndices = nullptr;
+        }
     }
 
 #ifdef AI_BUILD_TRIANGULATE_DEBUG_POLYS
@@ -520,11 +543,13 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
 #endif
 
     // kill the old faces
-    delete [] pMesh->mFaces;
+    pMesh->ReleaseFaces();
 
     // ... and store the new ones
     pMesh->mFaces    = out;
     pMesh->mNumFaces = (unsigned int)(curOut-out); /* not necessarily equal to numOut */
+    pMesh->mFaceIndices = pool;
+    pMesh->mNumFaceIndices = (unsigned int)(curIndex-pool);
     return true;
 }
 
@@ -329,6 +329,11 @@ void ValidateDSProcess::Validate(const aiMesh *pMesh) {
 
         if (!face.mIndices)
             ReportError("aiMesh::mFaces[%i].mIndices is nullptr", i);
+
+        // indices taken from the index pool of the mesh must not run past its end
+        if (pMesh->IsPooledFace(face) && face.mIndices + face.mNumIndices > pMesh->mFaceIndices + pMesh->mNumFaceIndices) {
+            ReportError("aiMesh::mFaces[%i].mIndices is not part of aiMesh::mFaceIndices", i);
+        }
     }
 
     // positions must always be there ...
@@ -390,6 +395,44 @@ void ValidateDSProcess::Validate(const aiMesh *pMesh) {
         ReportWarning("There are unreferenced vertices");
     }
 
+    // meshlets cover all faces in order and agree with them
+    if (pMesh->mNumMeshlets) {
+        if (!pMesh->mMeshlets || !pMesh->mMeshletVertices || !pMesh->mMeshletTriangles) {
+            ReportError("aiMesh::mNumMeshlets is not 0 but the meshlet arrays are nullptr");
+        }
+        if (pMesh->mNumMeshletTriangles != pMesh->mNumFaces) {
+            ReportError("aiMesh::mNumMeshletTriangles (%i) does not match aiMesh::mNumFaces (%i)",
+                    pMesh->mNumMeshletTriangles, pMesh->mNumFaces);
+        }
+        unsigned int numFaces = 0;
+        for (unsigned int i = 0; i < pMesh->mNumMeshlets; ++i) {
+            const aiMeshlet &meshlet = pMesh->mMeshlets[i];
+            if (meshlet.mFaceOffset != numFaces) {
+                ReportError("aiMesh::mMeshlets[%i] does not start behind the previous meshlet", i);
+            }
+            numFaces += meshlet.mNumFaces;
+            if (numFaces > pMesh->mNumFaces || meshlet.mVertexOffset + meshlet.mNumVertices > pMesh->mNumMeshletVertices) {
+                ReportError("aiMesh::mMeshlets[%i] is out of range", i);
+            }
+            const unsigned int *vertices = pMesh->mMeshletVertices + meshlet.mVertexOffset;
+            for (unsigned int f = meshlet.mFaceOffset; f < numFaces; ++f) {
+                const aiFace &face = pMesh->mFaces[f];
+                if (3 != face.mNumIndices) {
+                    ReportError("aiMesh::mFaces[%i] is part of a meshlet but not a triangle", f);
+                }
+                for (unsigned int a = 0; a < 3; ++a) {
+                    const unsigned char local = pMesh->mMeshletTriangles[f * 3 + a];
+                    if (local >= meshlet.mNumVertices || vertices[local] != face.mIndices[a]) {
+                        ReportError("aiMesh::mMeshletTriangles does not match aiMesh::mFaces[%i]", f);
+                    }
+                }
+            }
+        }
+        if (numFaces != pMesh->mNumFaces) {
+            ReportError("The meshlets do not cover all faces of the mesh");
+        }
+    }
+
     // texture channel 2 may not be set if channel 1 is zero ...
     {
         unsigned int i = 0;
@@ -1278,6 +1278,19 @@ time got consumed by the #aiProcess_Triangulate, #aiProcess_JoinIdenticalVertice
 postprocessing steps. A wise selection of postprocessing steps is therefore essential to getting good performance.
 Of course this depends on the individual requirements of your application, in many of the typical use cases of assimp performance won't
 matter (i.e. in an offline content pipeline).
+
+The same timings are available in structured form through #Assimp::Importer::GetProfiler(). The regions are nested
+(<tt>total</tt> &gt; <tt>import</tt>, <tt>preprocess</tt>, <tt>postprocess</tt> &gt; one region per executed step, named after
+its class), importers may add regions of their own (the FBX loader reports <tt>tokenize</tt>, <tt>parse</tt>, <tt>document</tt> and
+<tt>convert</tt>) and each region carries the scene memory at its end. Set <tt>GLOB_MEASURE_TIME_PER_MESH</tt> to additionally time
+every mesh processed by the per-mesh steps. The result can be written as JSON or in the Chrome trace event format:
+
+@code
+importer.SetPropertyBool(AI_CONFIG_GLOB_MEASURE_TIME, true);
+importer.ReadFile(file, flags);
+std::ofstream trace("import.json");
+importer.GetProfiler()->WriteChromeTrace(trace);
+@endcode
 */
 
 /**
@@ -68,6 +68,10 @@ class Importer;
 class IOSystem;
 class BaseProcess;
 class SharedPostProcessInfo;
+class ThreadPool;
+namespace Profiling {
+class Profiler;
+}
 class IOStream;
 
 // utility to do char4 to uint32 in a portable manner
@@ -429,6 +433,12 @@ protected:
     std::exception_ptr m_Exception;
     /// Currently set progress handler.
     ProgressHandler *m_progress;
+    /// Profiler to record the phases of the import into, may be nullptr.
+    Profiling::Profiler *m_profiler;
+    /// Worker threads the import may use, nullptr if it should run serially.
+    ThreadPool *m_threadPool;
+    /// Whether meshes should be set up with aiMesh::AllocateFaces(), see #AI_CONFIG_GLOB_FACE_INDEX_POOL.
+    bool m_poolFaceIndices;
 };
 
 } // end of namespace Assimp
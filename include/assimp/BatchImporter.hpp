@@ -0,0 +1,165 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  BatchImporter.hpp
+ *  @brief Defines the CPP-API to import many files concurrently
+ */
+#pragma once
+#ifndef AI_BATCHIMPORTER_HPP_INC
+#define AI_BATCHIMPORTER_HPP_INC
+
+#ifdef __GNUC__
+#pragma GCC system_header
+#endif
+
+#include <assimp/defs.h>
+#include <assimp/matrix4x4.h>
+
+#include <future>
+#include <map>
+#include <string>
+
+struct aiScene;
+
+namespace Assimp {
+
+class IOSystem;
+class ThreadPool;
+struct BatchImporterData;
+
+// ----------------------------------------------------------------------------------
+/** A file to be imported by #BatchImporter, along with its post-processing
+ *  flags and configuration properties. The properties have the same meaning
+ *  as the ones set with Importer::SetPropertyInteger() and friends. */
+class ASSIMP_API ImportRequest {
+public:
+    // Data type to store the key hash
+    typedef unsigned int KeyType;
+
+    typedef std::map<KeyType, int> IntPropertyMap;
+    typedef std::map<KeyType, ai_real> FloatPropertyMap;
+    typedef std::map<KeyType, std::string> StringPropertyMap;
+    typedef std::map<KeyType, aiMatrix4x4> MatrixPropertyMap;
+
+    // -------------------------------------------------------------------
+    /** @param file The file to import
+     *  @param flags The post-processing steps to run, see #aiPostProcessSteps */
+    explicit ImportRequest(const std::string &file = std::string(), unsigned int flags = 0);
+
+    // -------------------------------------------------------------------
+    /** Set a configuration property for the import of this file.
+     *  @return true if the property was set before. */
+    bool SetPropertyInteger(const char *szName, int iValue);
+    bool SetPropertyBool(const char *szName, bool value) {
+        return SetPropertyInteger(szName, value);
+    }
+    bool SetPropertyFloat(const char *szName, ai_real fValue);
+    bool SetPropertyString(const char *szName, const std::string &sValue);
+    bool SetPropertyMatrix(const char *szName, const aiMatrix4x4 &sValue);
+
+    std::string mFile;
+    unsigned int mFlags;
+
+    IntPropertyMap mIntProperties;
+    FloatPropertyMap mFloatProperties;
+    StringPropertyMap mStringProperties;
+    MatrixPropertyMap mMatrixProperties;
+};
+
+// ----------------------------------------------------------------------------------
+/** CPP-API: Imports a list of files concurrently on a bounded thread pool.
+ *
+ *  Queue the files with #AddRequest, then call #ImportAll. Importers are kept
+ *  and reused once their file is done, so the importer registry is set up
+ *  about once per thread instead of once per file. The importers and post-processing steps use the
+ *  same pool for their own work, #AI_CONFIG_GLOB_NUM_THREADS of a request is
+ *  replaced by the size of the pool.
+ *
+ *  The returned futures become ready as soon as their file is done, so another
+ *  thread may consume the results while #ImportAll is still running. A failed
+ *  import stores a DeadlyImportError carrying the error string of the Importer.
+ *  The caller owns the returned scenes and deletes them with 'delete'.
+ *
+ *  A BatchImporter instance itself may only be used by one thread at a time.
+ *  The IOSystem, if one is passed, is shared by all imports and called from
+ *  several worker threads at once, so it must be thread-safe. */
+class ASSIMP_API BatchImporter {
+public:
+    // -------------------------------------------------------------------
+    /** @param numThreads Number of threads importing files, including the
+     *    thread calling #ImportAll. 0 uses all hardware threads.
+     *  @param pIOHandler IO handler for all imports, nullptr for the default
+     *    one. It must be safe to call from several threads at once. The
+     *    BatchImporter does not take ownership of it. */
+    explicit BatchImporter(unsigned int numThreads = 0, IOSystem *pIOHandler = nullptr);
+
+    // -------------------------------------------------------------------
+    /** Run on an existing thread pool, for importer plugins which load
+     *  other files. Passing nullptr imports the files one after another.
+     *  pIOHandler must be thread-safe, as for the other constructor. */
+    BatchImporter(ThreadPool *pool, IOSystem *pIOHandler);
+
+    ~BatchImporter();
+
+    // -------------------------------------------------------------------
+    /** Queue a file for import.
+     *  @return The future result, ready once #ImportAll has imported the file */
+    std::future<aiScene *> AddRequest(const ImportRequest &request);
+
+    // -------------------------------------------------------------------
+    /** Import all queued files and return when all of them are done */
+    void ImportAll();
+
+    // -------------------------------------------------------------------
+    /** Get the number of files queued since the last #ImportAll */
+    size_t GetNumPendingRequests() const;
+
+private:
+    BatchImporter(const BatchImporter &) = delete;
+    BatchImporter &operator=(const BatchImporter &) = delete;
+
+    BatchImporterData *mData;
+};
+
+} // namespace Assimp
+
+#endif // AI_BATCHIMPORTER_HPP_INC
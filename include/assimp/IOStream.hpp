@@ -126,6 +126,18 @@ public:
      *  See fflush() for more details.
      */
     virtual void Flush() = 0;
+
+    // -------------------------------------------------------------------
+    /** @brief Get direct access to the whole contents of the stream
+     *
+     *  Streams which already hold the file contents in memory, e.g. a
+     *  memory-mapped file, can return them here so importers may parse
+     *  in place instead of copying them using Read(). The returned view
+     *  covers FileSize() bytes, is not null-terminated and remains valid
+     *  until the stream is closed. The read cursor is not affected.
+     *  @return nullptr if the stream does not support direct access,
+     *    which is the default. */
+    virtual const void *GetMappedData() const;
 }; //! class IOStream
 
 // ----------------------------------------------------------------------------------
@@ -139,6 +151,12 @@ AI_FORCE_INLINE
 IOStream::~IOStream() {
     // empty
 }
+
+// ----------------------------------------------------------------------------------
+AI_FORCE_INLINE
+const void *IOStream::GetMappedData() const {
+    return nullptr;
+}
 // ----------------------------------------------------------------------------------
 
 } //!namespace Assimp
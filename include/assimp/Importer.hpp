@@ -59,6 +59,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // Public ASSIMP data structures
 #include <assimp/types.h>
 
+#include <exception>
+
 namespace Assimp {
 // =======================================================================
 // Public interface to Assimp
@@ -76,6 +78,11 @@ class ProgressHandler;
 class BaseImporter;
 class BaseProcess;
 class SharedPostProcessInfo;
+
+// Include Profiler.h for the declaration
+namespace Profiling {
+class Profiler;
+}
 class BatchLoader;
 
 // =======================================================================
@@ -623,6 +630,30 @@ public:
      *   is (naturally) not included.*/
     void GetMemoryRequirements(aiMemoryInfo &in) const;
 
+    // -------------------------------------------------------------------
+    /** Returns the timings recorded during the last import.
+     *
+     * The profile covers the last call to #ReadFile() including its
+     * post-processing, or the last call to #ApplyPostProcessing() if
+     * that was called on its own. Each importer phase and each executed
+     * post-processing step is a region of its own, annotated with the
+     * scene memory at its end. Use Profiler::WriteJson() or
+     * Profiler::WriteChromeTrace() to export it.
+     * @return nullptr unless #AI_CONFIG_GLOB_MEASURE_TIME is enabled.
+     *   The object is owned by the importer and valid until the next
+     *   import. */
+    const Profiling::Profiler *GetProfiler() const;
+
+    // -------------------------------------------------------------------
+    /** Returns how many calls to #ReadFile() were answered from the
+     *  import cache, see #AI_CONFIG_GLOB_IMPORT_CACHE_DIR. */
+    unsigned int GetImportCacheHits() const;
+
+    // -------------------------------------------------------------------
+    /** Returns how many calls to #ReadFile() found no usable entry in the
+     *  import cache and ran the import. */
+    unsigned int GetImportCacheMisses() const;
+
     // -------------------------------------------------------------------
     /** Enables "extra verbose" mode.
      *
@@ -142,6 +142,12 @@ public:
         ai_assert(false); // won't be needed
     }
 
+    // -------------------------------------------------------------------
+    // The buffer is already in memory, hand it out directly
+    const void *GetMappedData() const {
+        return buffer;
+    }
+
 private:
     const uint8_t* buffer;
     size_t length,pos;
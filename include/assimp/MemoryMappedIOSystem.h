@@ -0,0 +1,133 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file MemoryMappedIOSystem.h
+ *  @brief IOSystem which maps files into memory instead of reading them
+ */
+#pragma once
+#ifndef AI_MEMORYMAPPEDIOSYSTEM_H_INC
+#define AI_MEMORYMAPPEDIOSYSTEM_H_INC
+
+#ifdef __GNUC__
+#   pragma GCC system_header
+#endif
+
+#include <assimp/DefaultIOSystem.h>
+#include <assimp/IOStream.hpp>
+
+namespace Assimp {
+
+// ----------------------------------------------------------------------------------
+//! @class  MemoryMappedIOStream
+//! @brief  Read-only stream on a file mapped into memory.
+//!
+//! GetMappedData() hands out the mapped view, so importers which support it
+//! parse the file in place without holding a second copy of it. The view is
+//! read-only, writing through it is an error.
+class ASSIMP_API MemoryMappedIOStream : public IOStream {
+    friend class MemoryMappedIOSystem;
+
+protected:
+    MemoryMappedIOStream(const uint8_t *data, size_t size) AI_NO_EXCEPT;
+
+public:
+    /** Destructor public to allow simple deletion to unmap the file. */
+    ~MemoryMappedIOStream();
+
+    // -------------------------------------------------------------------
+    /** Map the given file, returns nullptr if it cannot be mapped.
+     *
+     *  If copyOnWrite is set the view is mapped writable and private:
+     *  pages written through it are copied and the file itself is never
+     *  modified. Otherwise the view is read-only. */
+    static MemoryMappedIOStream *Map(const char *file, bool copyOnWrite = false);
+
+    // -------------------------------------------------------------------
+    /// Read from stream
+    size_t Read(void *pvBuffer, size_t pSize, size_t pCount);
+
+    // -------------------------------------------------------------------
+    /// Write to stream, always fails
+    size_t Write(const void *pvBuffer, size_t pSize, size_t pCount);
+
+    // -------------------------------------------------------------------
+    /// Seek specific position
+    aiReturn Seek(size_t pOffset, aiOrigin pOrigin);
+
+    // -------------------------------------------------------------------
+    /// Get current seek position
+    size_t Tell() const;
+
+    // -------------------------------------------------------------------
+    /// Get size of file
+    size_t FileSize() const;
+
+    // -------------------------------------------------------------------
+    /// Flush file contents, nothing to do
+    void Flush();
+
+    // -------------------------------------------------------------------
+    /// Get the mapped view of the whole file
+    const void *GetMappedData() const;
+
+private:
+    const uint8_t *mData;
+    size_t mSize;
+    size_t mPos;
+};
+
+// ---------------------------------------------------------------------------
+/** Implementation of IOSystem which memory-maps files opened for reading.
+ *
+ *  Files opened for writing, empty files and files which cannot be mapped
+ *  (e.g. pipes) are handled by DefaultIOSystem. Pass an instance to
+ *  Importer::SetIOHandler() to use it. */
+class ASSIMP_API MemoryMappedIOSystem : public DefaultIOSystem {
+public:
+    // -------------------------------------------------------------------
+    /** Open a new file with a given path. */
+    IOStream *Open(const char *pFile, const char *pMode = "rb");
+};
+
+} // namespace Assimp
+
+#endif // AI_MEMORYMAPPEDIOSYSTEM_H_INC
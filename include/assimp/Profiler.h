@@ -55,7 +55,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/TinyFormatter.h>
 
+#include <algorithm>
 #include <map>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <thread>
+#include <vector>
 
 namespace Assimp {
 namespace Profiling {
@@ -63,41 +69,266 @@ namespace Profiling {
 using namespace Formatter;
 
 // ------------------------------------------------------------------------------------------------
-/** Simple wrapper around boost::timer to simplify reporting. Timings are automatically
- *  dumped to the log file.
+/** Records a tree of named, timed regions. Timings are automatically dumped to the log
+ *  file and can be exported as JSON or in the Chrome trace event format (to be viewed
+ *  in chrome://tracing or Perfetto).
+ *
+ *  Regions opened by BeginRegion() nest: each new region becomes a child of the innermost
+ *  open one. AddRegion() records an already finished region below the innermost open one
+ *  and may be called from any thread, e.g. to time single meshes processed by a worker.
  */
 class Profiler {
 public:
-    Profiler() {
-        // empty
+    typedef std::chrono::steady_clock Clock;
+
+    /** A single measured region. Times are given in seconds since the profiler was created. */
+    struct Region {
+        std::string name;
+        int parent;             //!< Index of the enclosing region, -1 for top-level regions
+        unsigned int depth;     //!< Nesting level, 0 for top-level regions
+        unsigned int thread;    //!< 0 for the thread which created the profiler, 1.. for others
+        double start;
+        double end;             //!< Negative as long as the region is open
+        size_t memory;          //!< Scene memory in bytes at the end of the region, 0 if unknown
+    };
+
+    Profiler() :
+            mOrigin(Clock::now()) {
+        mThreads.push_back(std::this_thread::get_id());
     }
 
 
     /** Start a named timer */
     void BeginRegion(const std::string& region) {
-        regions[region] = std::chrono::system_clock::now();
+        std::lock_guard<std::mutex> lock(mMutex);
+        Region r;
+        r.name = region;
+        r.parent = mOpen.empty() ? -1 : static_cast<int>(mOpen.back());
+        r.depth = static_cast<unsigned int>(mOpen.size());
+        r.thread = GetThreadIndex();
+        r.start = Seconds(Clock::now());
+        r.end = -1.0;
+        r.memory = 0;
+        mOpen.push_back(mRegions.size());
+        mRegions.push_back(r);
         ASSIMP_LOG_DEBUG((format("START `"),region,"`"));
     }
 
 
-    /** End a specific named timer and write its end time to the log */
-    void EndRegion(const std::string& region) {
-        RegionMap::const_iterator it = regions.find(region);
-        if (it == regions.end()) {
+    /** End a specific named timer and write its end time to the log. Regions opened
+     *  inside of it and not yet closed are closed as well.
+     *  @param sceneMemory Memory held by the scene at this point, if known */
+    void EndRegion(const std::string& region, size_t sceneMemory = 0) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        std::vector<size_t>::reverse_iterator it = std::find_if(mOpen.rbegin(), mOpen.rend(),
+                [this, &region](size_t index) { return mRegions[index].name == region; });
+        if (it == mOpen.rend()) {
             return;
         }
 
-        std::chrono::duration<double> elapsedSeconds = std::chrono::system_clock::now() - regions[region];
-        ASSIMP_LOG_DEBUG((format("END   `"),region,"`, dt= ", elapsedSeconds.count()," s"));
+        const double now = Seconds(Clock::now());
+        const size_t index = *it;
+        while (mOpen.back() != index) {
+            mRegions[mOpen.back()].end = now;
+            mOpen.pop_back();
+        }
+        mOpen.pop_back();
+
+        Region& r = mRegions[index];
+        r.end = now;
+        r.memory = sceneMemory;
+        ASSIMP_LOG_DEBUG((format("END   `"),region,"`, dt= ", r.end - r.start," s"));
+    }
+
+
+    /** Record a finished region below the innermost open region. Thread-safe. */
+    void AddRegion(const std::string& region, const Clock::time_point& start, const Clock::time_point& end) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        Region r;
+        r.name = region;
+        r.parent = mOpen.empty() ? -1 : static_cast<int>(mOpen.back());
+        r.depth = static_cast<unsigned int>(mOpen.size());
+        r.thread = GetThreadIndex();
+        r.start = Seconds(start);
+        r.end = Seconds(end);
+        r.memory = 0;
+        mRegions.push_back(r);
+    }
+
+
+    /** Check whether there is at least one region which hasn't been closed yet */
+    bool HasOpenRegions() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return !mOpen.empty();
+    }
+
+
+    /** Get all regions recorded so far, parents always precede their children */
+    std::vector<Region> GetRegions() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mRegions;
+    }
+
+
+    /** Get the largest scene memory reported to EndRegion(), in bytes */
+    size_t GetPeakMemory() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        size_t peak = 0;
+        for (const Region& r : mRegions) {
+            peak = std::max(peak, r.memory);
+        }
+        return peak;
+    }
+
+
+    /** Write all regions as a tree of nested JSON objects */
+    void WriteJson(std::ostream& out) const {
+        const std::vector<Region> regions = GetRegions();
+        std::vector<std::vector<size_t>> children(regions.size() + 1);
+        for (size_t i = 0; i < regions.size(); ++i) {
+            children[regions[i].parent + 1].push_back(i);
+        }
+        out << "{\"peakMemory\":" << GetPeakMemory() << ",\"regions\":";
+        WriteJsonChildren(out, regions, children, -1);
+        out << "}";
+    }
+
+
+    /** Write all regions in the Chrome trace event format */
+    void WriteChromeTrace(std::ostream& out) const {
+        const std::vector<Region> regions = GetRegions();
+        out << "{\"traceEvents\":[";
+        for (size_t i = 0; i < regions.size(); ++i) {
+            const Region& r = regions[i];
+            out << (i ? "," : "") << "{\"name\":";
+            WriteJsonString(out, r.name);
+            out << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << r.thread
+                << ",\"ts\":" << Microseconds(r.start)
+                << ",\"dur\":" << Microseconds(Duration(r))
+                << ",\"args\":{\"memory\":" << r.memory << "}}";
+        }
+        out << "],\"displayTimeUnit\":\"ms\"}";
+    }
+
+
+    /** Convenience wrappers returning the exported data as a string */
+    std::string ToJson() const {
+        std::ostringstream ss;
+        WriteJson(ss);
+        return ss.str();
+    }
+
+    std::string ToChromeTrace() const {
+        std::ostringstream ss;
+        WriteChromeTrace(ss);
+        return ss.str();
+    }
+
+private:
+    double Seconds(const Clock::time_point& t) const {
+        return std::chrono::duration<double>(t - mOrigin).count();
+    }
+
+    static double Duration(const Region& r) {
+        return r.end < 0.0 ? 0.0 : r.end - r.start;
+    }
+
+    static long long Microseconds(double seconds) {
+        return static_cast<long long>(seconds * 1e6);
+    }
+
+    unsigned int GetThreadIndex() {
+        const std::thread::id id = std::this_thread::get_id();
+        std::vector<std::thread::id>::const_iterator it = std::find(mThreads.begin(), mThreads.end(), id);
+        if (it != mThreads.end()) {
+            return static_cast<unsigned int>(it - mThreads.begin());
+        }
+        mThreads.push_back(id);
+        return static_cast<unsigned int>(mThreads.size() - 1);
+    }
+
+    static void WriteJsonString(std::ostream& out, const std::string& s) {
+        out << '"';
+        for (const char c : s) {
+            if (c == '"' || c == '\\') {
+                out << '\\' << c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                out << ' ';
+            } else {
+                out << c;
+            }
+        }
+        out << '"';
+    }
+
+    // children[parent + 1] lists the regions below parent, in recording order
+    static void WriteJsonChildren(std::ostream& out, const std::vector<Region>& regions,
+            const std::vector<std::vector<size_t>>& children, int parent) {
+        out << "[";
+        bool first = true;
+        for (const size_t i : children[parent + 1]) {
+            const Region& r = regions[i];
+            out << (first ? "" : ",") << "{\"name\":";
+            WriteJsonString(out, r.name);
+            out << ",\"thread\":" << r.thread
+                << ",\"start\":" << r.start
+                << ",\"duration\":" << Duration(r)
+                << ",\"memory\":" << r.memory
+                << ",\"children\":";
+            WriteJsonChildren(out, regions, children, static_cast<int>(i));
+            out << "}";
+            first = false;
+        }
+        out << "]";
+    }
+
+private:
+    Clock::time_point mOrigin;
+    std::vector<Region> mRegions;
+    std::vector<size_t> mOpen;
+    std::vector<std::thread::id> mThreads;
+    mutable std::mutex mMutex;
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Opens a region on construction and closes it on destruction, so the region is closed
+ *  even if an import error is thrown. Does nothing if no profiler is given.
+ */
+class ScopedRegion {
+public:
+    ScopedRegion(Profiler* profiler, const std::string& region) :
+            mProfiler(profiler), mRegion(region) {
+        if (mProfiler) {
+            mProfiler->BeginRegion(mRegion);
+        }
+    }
+
+    ~ScopedRegion() {
+        End();
+    }
+
+    /** Whether the region is recorded and not closed yet */
+    bool IsOpen() const {
+        return nullptr != mProfiler;
+    }
+
+    /** Close the region before the end of the scope, e.g. to record the scene memory */
+    void End(size_t sceneMemory = 0) {
+        if (mProfiler) {
+            mProfiler->EndRegion(mRegion, sceneMemory);
+            mProfiler = nullptr;
+        }
     }
 
 private:
-    typedef std::map<std::string,std::chrono::time_point<std::chrono::system_clock>> RegionMap;
-    RegionMap regions;
+    ScopedRegion(const ScopedRegion&) = delete;
+    ScopedRegion& operator=(const ScopedRegion&) = delete;
+
+    Profiler* mProfiler;
+    std::string mRegion;
 };
 
 }
 }
 
 #endif // AI_INCLUDED_PROFILER_H
-
@@ -54,6 +54,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace Assimp {
 
+class ThreadPool;
+
 // ------------------------------------------------------------------------------------------------
 /** A little helper class to quickly find all vertices in the epsilon environment of a given
  * position. Construct an instance with an array of positions. The class stores the given positions
@@ -110,6 +112,12 @@ public:
      *  can be called to query the spatial sort.*/
     void Finalize();
 
+    // ------------------------------------------------------------------------------------
+    /** Sets the worker threads used by #Finalize() and #FindAllNeighbors() on large
+     *  data sets. Pass nullptr to run serially, which is the default.
+     *  @param pPool The thread pool, must outlive all calls using it. */
+    void SetThreadPool(ThreadPool *pPool);
+
     // ------------------------------------------------------------------------------------
     /** Returns an iterator for all positions close to the given position.
      * @param pPosition The position to look for vertices.
@@ -130,6 +138,20 @@ public:
     void FindIdenticalPositions(const aiVector3D &pPosition,
             std::vector<unsigned int> &poResults) const;
 
+    // ------------------------------------------------------------------------------------
+    /** Resolves the neighbours of all stored positions in one go. The result is the
+     *  same as calling #FindPositions() with every stored position in turn, but the
+     *  positions are visited in sorted order so no binary search is needed and the
+     *  results end up in two flat arrays instead of one vector per call.
+     *
+     * @param pRadius Maximal distance from a position a vertex may have to be counted in.
+     * @param poOffsets Receives numPositions+1 entries. The neighbours of the position
+     *   with index i are poNeighbors[poOffsets[i]] ... poNeighbors[poOffsets[i+1]-1].
+     * @param poNeighbors Receives the indices of the neighbours of all positions,
+     *   each position is a neighbour of itself. */
+    void FindAllNeighbors(ai_real pRadius, std::vector<unsigned int> &poOffsets,
+            std::vector<unsigned int> &poNeighbors) const;
+
     // ------------------------------------------------------------------------------------
     /** Compute a table that maps each vertex ID referring to a spatially close
      *  enough position to the same output ID. Output IDs are assigned in ascending order
@@ -145,29 +167,15 @@ protected:
     /** Normal of the sorting plane, normalized. The center is always at (0, 0, 0) */
     aiVector3D mPlaneNormal;
 
-    /** An entry in a spatially sorted position array. Consists of a vertex index,
-     * its position and its pre-calculated distance from the reference plane */
-    struct Entry {
-        unsigned int mIndex; ///< The vertex referred by this entry
-        aiVector3D mPosition; ///< Position
-        ai_real mDistance; ///< Distance of this vertex to the sorting plane
-
-        Entry() AI_NO_EXCEPT
-                : mIndex(999999999),
-                  mPosition(),
-                  mDistance(99999.) {
-            // empty
-        }
-        Entry(unsigned int pIndex, const aiVector3D &pPosition, ai_real pDistance) :
-                mIndex(pIndex), mPosition(pPosition), mDistance(pDistance) {
-            // empty
-        }
-
-        bool operator<(const Entry &e) const { return mDistance < e.mDistance; }
-    };
-
-    // all positions, sorted by distance to the sorting plane
-    std::vector<Entry> mPositions;
+    /** All positions, sorted by distance to the sorting plane once finalized. The data
+     *  is kept in parallel arrays so the range scans of the queries only touch the
+     *  distances until they hit a candidate. */
+    std::vector<ai_real> mDistances; ///< Distance of each vertex to the sorting plane
+    std::vector<aiVector3D> mPositions; ///< Position of each vertex
+    std::vector<unsigned int> mIndices; ///< The vertex referred by each entry
+
+    /** Optional worker threads, see #SetThreadPool() */
+    ThreadPool *mThreadPool;
 };
 
 } // end of namespace Assimp
@@ -46,6 +46,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "BaseImporter.h"
 #include "IOStream.hpp"
 #include <pugixml.hpp>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace Assimp {
@@ -121,19 +123,18 @@ public:
             return false;
         }
 
+        clear();
         const size_t len = stream->FileSize();
-        mData.resize(len + 1);
-        memset(&mData[0], '\0', len + 1);
-        stream->Read(&mData[0], 1, len);
-        
-        mDoc = new pugi::xml_document();
-        pugi::xml_parse_result parse_result = mDoc->load_string(&mData[0], pugi::parse_full);
-        if (parse_result.status == pugi::status_ok) {
-            return true;
-        } else {
-            ASSIMP_LOG_DEBUG("Error while parse xml.");
-            return false;
-        }
+        mData.resize(len);
+        mData.resize(stream->Read(&mData[0], 1, len));
+        return parseData();
+    }
+
+    /// Parses a document which is already in memory. The parser takes over the buffer.
+    bool parse(std::string &&data) {
+        clear();
+        mData = std::move(data);
+        return parseData();
     }
 
     pugi::xml_document *getDocument() const {
@@ -231,6 +232,15 @@ public:
         return true;
     }
 
+    /// Returns the text of the node without copying it. The pointer stays valid as long as the document.
+    static inline const char *getValueAsCString( XmlNode &node ) {
+        if (node.empty()) {
+            return "";
+        }
+
+        return node.text().get();
+    }
+
     static inline bool getValueAsFloat( XmlNode &node, ai_real &v ) {
         if (node.empty()) {
             return false;
@@ -245,7 +255,19 @@ public:
  private:
     pugi::xml_document *mDoc;
     TNodeType mCurrent;
-    std::vector<char> mData;
+    std::string mData;
+
+    bool parseData() {
+        // parse in place, the document refers into mData instead of keeping a copy of its own
+        mDoc = new pugi::xml_document();
+        pugi::xml_parse_result parse_result = mDoc->load_buffer_inplace(&mData[0], mData.size(), pugi::parse_full);
+        if (parse_result.status == pugi::status_ok) {
+            return true;
+        } else {
+            ASSIMP_LOG_DEBUG("Error while parse xml.");
+            return false;
+        }
+    }
 };
 
 using XmlParser = TXmlParser<pugi::xml_node>;
@@ -0,0 +1,160 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file XmlStreamReader.h
+ *  @brief Pull parser which reads XML from a stream without building a DOM
+ */
+#pragma once
+#ifndef AI_XMLSTREAMREADER_H_INC
+#define AI_XMLSTREAMREADER_H_INC
+
+#ifdef __GNUC__
+#   pragma GCC system_header
+#endif
+
+#include <assimp/defs.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Assimp {
+
+class IOStream;
+
+// ----------------------------------------------------------------------------------
+//! @class  XmlStreamReader
+//! @brief  Streaming (pull) alternative to XmlParser.
+//!
+//! The document is read through a fixed-size window, so memory use does not
+//! depend on the file size. next() returns one event at a time. Element names,
+//! attributes and text are valid until the following call to next().
+//!
+//! Long text content is split into several Event_Text pieces. Pieces end at
+//! whitespace, so a number or other token is never cut in two and each piece
+//! can be handed to a number parser on its own. Text which contains only
+//! whitespace is skipped, as XmlParser does. Comments, processing
+//! instructions and the document type declaration are skipped as well.
+//! Malformed input raises a DeadlyImportError.
+class ASSIMP_API XmlStreamReader {
+public:
+    enum Event {
+        Event_StartElement,
+        Event_EndElement,
+        Event_Text,
+        Event_EndOfDocument
+    };
+
+    // -------------------------------------------------------------------
+    /** @brief Construction
+     *  @param stream The stream to read, must stay valid while the reader is used
+     *  @param chunkSize Number of bytes read from the stream at once */
+    explicit XmlStreamReader(IOStream *stream, size_t chunkSize = 64 * 1024);
+
+    ~XmlStreamReader();
+
+    // -------------------------------------------------------------------
+    /** @brief Advance to the next event
+     *
+     *  An empty element tag yields an Event_StartElement followed by an
+     *  Event_EndElement. */
+    Event next();
+
+    // -------------------------------------------------------------------
+    /** @brief Element name, valid for Event_StartElement and Event_EndElement */
+    const std::string &getName() const;
+
+    // -------------------------------------------------------------------
+    /** @brief Number of elements which are open, including the current one
+     *    for Event_StartElement */
+    size_t getDepth() const;
+
+    // -------------------------------------------------------------------
+    /** @brief Attributes of the current Event_StartElement */
+    size_t getNumAttributes() const;
+    const std::string &getAttributeName(size_t index) const;
+    const std::string &getAttributeValue(size_t index) const;
+
+    // -------------------------------------------------------------------
+    /** @brief Value of the named attribute, nullptr if it is absent */
+    const char *getAttribute(const char *name) const;
+
+    // -------------------------------------------------------------------
+    /** @brief Text of the current Event_Text, with entities resolved.
+     *    The text is not zero-terminated. */
+    const char *getText() const;
+    size_t getTextLength() const;
+
+private:
+    bool fill();
+    bool require(size_t count);
+    size_t find(size_t offset, const char *pattern);
+    bool readText();
+    void readStartElement();
+    void readEndElement();
+    void skipDoctype();
+
+    XmlStreamReader(const XmlStreamReader &) = delete;
+    XmlStreamReader &operator=(const XmlStreamReader &) = delete;
+
+private:
+    IOStream *mStream;
+    size_t mChunkSize;
+    std::vector<char> mBuffer;
+    size_t mPos;
+    size_t mSize;
+    bool mEof;
+    bool mPendingEnd;
+
+    std::string mName;
+    std::vector<std::string> mOpenElements;
+    std::vector<std::pair<std::string, std::string>> mAttributes;
+    size_t mNumAttributes;
+
+    const char *mText;
+    size_t mTextLength;
+    std::string mDecodedText;
+};
+
+} // namespace Assimp
+
+#endif // AI_XMLSTREAMREADER_H_INC
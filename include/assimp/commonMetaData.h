@@ -64,4 +64,19 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 /// Not all formats add this metadata.
 #define AI_METADATA_SOURCE_COPYRIGHT "SourceAsset_Copyright"
 
+/// Scene metadata holding the number of meshes aiProcess_FindInstances replaced
+/// by references to an equal mesh, as uint64_t. Absent if none were found.
+#define AI_METADATA_COLLAPSED_INSTANCES "PostProcess_CollapsedInstances"
+
+/// Scene metadata holding the average cache miss ratio (vertex cache misses per
+/// triangle) of the meshes aiProcess_ImproveCacheLocality reordered, before and
+/// after the step, as float. Absent if no mesh was reordered.
+#define AI_METADATA_ACMR_IN "PostProcess_ACMR_In"
+#define AI_METADATA_ACMR_OUT "PostProcess_ACMR_Out"
+
+/// Scene metadata holding the average transformed vertex ratio (vertex cache
+/// misses per vertex) of the same meshes, before and after the step, as float.
+#define AI_METADATA_ATVR_IN "PostProcess_ATVR_In"
+#define AI_METADATA_ATVR_OUT "PostProcess_ATVR_Out"
+
 #endif
@@ -350,6 +350,27 @@ const char* fast_atoreal_move(const char* c, Real& out, bool check_comma = true)
     return c;
 }
 
+// ------------------------------------------------------------------------------------
+// Parse up to count whitespace-separated real numbers from a zero-terminated string
+// into out, which must hold count values. Returns the number of values read, which is
+// less than count only if the end of the string was reached. c is advanced past the
+// last value read.
+// ------------------------------------------------------------------------------------
+template<typename Real, typename ExceptionType = DeadlyImportError>
+inline
+size_t fast_atoreal_array(const char*& c, Real* out, size_t count, bool check_comma = true) {
+    size_t n = 0;
+    for (;;) {
+        while (*c == ' ' || *c == '\t' || *c == '\r' || *c == '\n' || *c == '\f') {
+            ++c;
+        }
+        if (n == count || *c == '\0') {
+            return n;
+        }
+        c = fast_atoreal_move<Real, ExceptionType>(c, out[n++], check_comma);
+    }
+}
+
 // ------------------------------------------------------------------------------------
 // The same but more human.
 template<typename ExceptionType = DeadlyImportError>
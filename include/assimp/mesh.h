@@ -139,6 +139,8 @@ struct aiFace {
     unsigned int mNumIndices;
 
     //! Pointer to the indices array. Size of the array is given in numIndices.
+    //! It may point into the index pool of the mesh instead, which the face
+    //! does not own, see #aiMesh::mFaceIndices.
     unsigned int *mIndices;
 
 #ifdef __cplusplus
@@ -553,6 +555,58 @@ enum aiMorphingMethod {
 #endif
 }; //! enum aiMorphingMethod
 
+// ---------------------------------------------------------------------------
+/** @brief A cluster of neighbouring triangles of a mesh, small enough to be
+ *  drawn by a single mesh shader workgroup.
+ *
+ * Meshlets are generated if #AI_CONFIG_PP_GENERATE_MESHLETS is set, see
+ * aiMesh::mMeshlets. The faces of a mesh are sorted by meshlet, so each
+ * meshlet covers a contiguous range of aiMesh::mFaces.
+ */
+struct aiMeshlet {
+    /** The faces of the meshlet are mFaces[mFaceOffset] to
+     *  mFaces[mFaceOffset + mNumFaces - 1]. Their vertices, as indices
+     *  into the meshlet's vertex list, are stored in
+     *  aiMesh::mMeshletTriangles from index 3 * mFaceOffset on. */
+    unsigned int mFaceOffset;
+    unsigned int mNumFaces;
+
+    /** The vertices used by the meshlet, as indices into the vertices of
+     *  the mesh, are aiMesh::mMeshletVertices[mVertexOffset] to
+     *  aiMesh::mMeshletVertices[mVertexOffset + mNumVertices - 1]. */
+    unsigned int mVertexOffset;
+    unsigned int mNumVertices;
+
+    /** Bounding sphere of the vertices */
+    C_STRUCT aiVector3D mCenter;
+    ai_real mRadius;
+
+    /** Normal cone for back-face culling of the whole meshlet. The meshlet
+     *  is invisible from the camera position c if
+     *  dot(normalize(mConeApex - c), mConeAxis) >= mConeCutoff.
+     *  mConeCutoff is 1 if the normals spread too much to cull it. */
+    C_STRUCT aiVector3D mConeApex;
+    C_STRUCT aiVector3D mConeAxis;
+    ai_real mConeCutoff;
+
+#ifdef __cplusplus
+
+    aiMeshlet() AI_NO_EXCEPT
+            : mFaceOffset(0),
+              mNumFaces(0),
+              mVertexOffset(0),
+              mNumVertices(0),
+              mCenter(),
+              mRadius(0),
+              mConeApex(),
+              mConeAxis(),
+              mConeCutoff(1) {
+        // empty
+    }
+
+#endif // __cplusplus
+};
+
 // ---------------------------------------------------------------------------
 /** @brief A mesh represents a geometry or model with a single material.
 *
@@ -723,6 +777,42 @@ struct aiMesh {
      */
     C_STRUCT aiAABB mAABB;
 
+    /** Index pool shared by the faces, nullptr if every face owns its indices.
+     *  Faces whose mIndices point into this array (see IsPooledFace()) do not
+     *  own them, the array holds mNumFaceIndices indices and is owned by the mesh.
+     *  This saves one allocation per face. Use AllocateFaces() to set up faces
+     *  this way; GetIndexBuffer() returns the indices of all faces as one array.
+     *  Set the mIndices of a pooled face to nullptr before deleting or assigning
+     *  to it outside of the mesh, as the face would delete them otherwise.
+     */
+    unsigned int *mFaceIndices;
+
+    /** Number of indices in mFaceIndices. */
+    unsigned int mNumFaceIndices;
+
+    /** The number of meshlets in mMeshlets, 0 if there are none. */
+    unsigned int mNumMeshlets;
+
+    /** Meshlets partitioning the faces of the mesh, see aiMeshlet. They
+     *  are generated by the post-processing step enabled with
+     *  #AI_CONFIG_PP_GENERATE_MESHLETS and describe the vertex and face
+     *  order at that time. Steps which run later and change the faces
+     *  remove the meshlets, see ReleaseMeshlets(). */
+    C_STRUCT aiMeshlet *mMeshlets;
+
+    /** Vertex lists of all meshlets, mNumMeshletVertices indices into the
+     *  vertices of the mesh. */
+    unsigned int *mMeshletVertices;
+    unsigned int mNumMeshletVertices;
+
+    /** Three indices into the vertex list of its meshlet per face, so
+     *  mNumMeshletTriangles * 3 entries. */
+    unsigned char *mMeshletTriangles;
+
+    /** Number of triangles in mMeshletTriangles, equal to mNumFaces while
+     *  the meshlets are valid. */
+    unsigned int mNumMeshletTriangles;
+
 #ifdef __cplusplus
 
     //! Default constructor. Initializes all members to 0
@@ -744,7 +834,15 @@ struct aiMesh {
               mNumAnimMeshes(0),
               mAnimMeshes(nullptr),
               mMethod(0),
-              mAABB() {
+              mAABB(),
+              mFaceIndices(nullptr),
+              mNumFaceIndices(0),
+              mNumMeshlets(0),
+              mMeshlets(nullptr),
+              mMeshletVertices(nullptr),
+              mNumMeshletVertices(0),
+              mMeshletTriangles(nullptr),
+              mNumMeshletTriangles(0) {
         for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++a) {
             mNumUVComponents[a] = 0;
             mTextureCoords[a] = nullptr;
@@ -785,7 +883,152 @@ struct aiMesh {
             delete[] mAnimMeshes;
         }
 
+        ReleaseFaces();
+    }
+
+    //! Delete the meshlets, for steps which change the faces or their indices
+    void ReleaseMeshlets() {
+        delete[] mMeshlets;
+        delete[] mMeshletVertices;
+        delete[] mMeshletTriangles;
+        mMeshlets = nullptr;
+        mMeshletVertices = nullptr;
+        mMeshletTriangles = nullptr;
+        mNumMeshlets = 0;
+        mNumMeshletVertices = 0;
+        mNumMeshletTriangles = 0;
+    }
+
+    //! Delete all faces and their indices, along with the meshlets built on them
+    void ReleaseFaces() {
+        ReleaseMeshlets();
+        // the faces must not delete the indices in the pool
+        if (nullptr != mFaceIndices && nullptr != mFaces) {
+            for (unsigned int i = 0; i < mNumFaces; ++i) {
+                if (IsPooledFace(mFaces[i])) {
+                    mFaces[i].mIndices = nullptr;
+                }
+            }
+        }
         delete[] mFaces;
+        delete[] mFaceIndices;
+        mFaces = nullptr;
+        mFaceIndices = nullptr;
+        mNumFaceIndices = 0;
+    }
+
+    //! Check whether the indices of a face of this mesh are part of its index
+    //! pool. The mesh owns those, the face must not delete them.
+    bool IsPooledFace(const aiFace &face) const {
+        return nullptr != mFaceIndices && face.mIndices >= mFaceIndices &&
+               face.mIndices < mFaceIndices + mNumFaceIndices;
+    }
+
+    //! Replace the faces by numFaces faces with numIndices indices each.
+    //! The indices of all faces are taken from one index pool, see mFaceIndices.
+    //! Throws std::bad_array_new_length if the pool would hold more than UINT_MAX indices.
+    void AllocateFaces(unsigned int numFaces, unsigned int numIndices) {
+        if (0 != numIndices && numFaces > UINT_MAX / numIndices) {
+            throw std::bad_array_new_length();
+        }
+
+        ReleaseFaces();
+        mNumFaces = numFaces;
+        if (0 == numFaces) {
+            return;
+        }
+
+        mFaces = new aiFace[numFaces];
+        mNumFaceIndices = numFaces * numIndices;
+        if (0 == mNumFaceIndices) {
+            return;
+        }
+        mFaceIndices = new unsigned int[mNumFaceIndices];
+        for (unsigned int i = 0; i < numFaces; ++i) {
+            mFaces[i].mNumIndices = numIndices;
+            mFaces[i].mIndices = mFaceIndices + i * numIndices;
+        }
+    }
+
+    //! Replace the faces by numFaces faces, face i gets numIndices[i] indices.
+    //! The indices of all faces are taken from one index pool, see mFaceIndices.
+    //! Throws std::bad_array_new_length if the pool would hold more than UINT_MAX indices.
+    void AllocateFaces(unsigned int numFaces, const unsigned int *numIndices) {
+        unsigned int total = 0;
+        for (unsigned int i = 0; i < numFaces; ++i) {
+            if (numIndices[i] > UINT_MAX - total) {
+                throw std::bad_array_new_length();
+            }
+            total += numIndices[i];
+        }
+
+        ReleaseFaces();
+        mNumFaces = numFaces;
+        if (0 == numFaces) {
+            return;
+        }
+
+        mFaces = new aiFace[numFaces];
+        if (0 == total) {
+            return;
+        }
+        mFaceIndices = new unsigned int[total];
+        mNumFaceIndices = total;
+        for (unsigned int i = 0, pos = 0; i < numFaces; ++i) {
+            mFaces[i].mNumIndices = numIndices[i];
+            if (0 != numIndices[i]) {
+                mFaces[i].mIndices = mFaceIndices + pos;
+            }
+            pos += numIndices[i];
+        }
+    }
+
+    //! Move the indices of all faces into one index pool, in face order.
+    //! Does nothing if they are stored like this already. Index arrays
+    //! which are not part of the old pool are deleted.
+    //! Throws std::bad_array_new_length if the pool would hold more than UINT_MAX indices.
+    void PackFaceIndices() {
+        unsigned int total = 0;
+        bool packed = true;
+        for (unsigned int i = 0; i < mNumFaces; ++i) {
+            const aiFace &face = mFaces[i];
+            if (nullptr == face.mIndices) {
+                continue;
+            }
+            packed = packed && IsPooledFace(face) && face.mIndices == mFaceIndices + total;
+            if (face.mNumIndices > UINT_MAX - total) {
+                throw std::bad_array_new_length();
+            }
+            total += face.mNumIndices;
+        }
+        if (packed || 0 == total) {
+            return;
+        }
+
+        unsigned int *pool = new unsigned int[total];
+        for (unsigned int i = 0, pos = 0; i < mNumFaces; ++i) {
+            aiFace &face = mFaces[i];
+            if (nullptr == face.mIndices) {
+                continue;
+            }
+            ::memcpy(pool + pos, face.mIndices, face.mNumIndices * sizeof(unsigned int));
+            if (!IsPooledFace(face)) {
+                delete[] face.mIndices;
+            }
+            face.mIndices = pool + pos;
+            pos += face.mNumIndices;
+        }
+        delete[] mFaceIndices;
+        mFaceIndices = pool;
+        mNumFaceIndices = total;
+    }
+
+    //! Get the indices of all faces as one array, in face order. The faces are
+    //! moved into an index pool first if needed. The size of the array is
+    //! mNumFaceIndices; returns nullptr for a mesh without indices.
+    const unsigned int *GetIndexBuffer() {
+        PackFaceIndices();
+        return mFaceIndices;
     }
 
     //! Check whether the mesh contains positions. Provided no special
@@ -0,0 +1,279 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file BenchHarness.cpp
+ *  @brief Implementation of the assimp_bench harness.
+ */
+#include "BenchHarness.h"
+
+#include <assimp/version.h>
+
+#include <algorithm>
+#include <ctime>
+#include <exception>
+#include <iomanip>
+#include <sstream>
+
+namespace AssimpBench {
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+struct Entry {
+    std::string name;
+    BenchmarkFunc func;
+};
+
+std::vector<Entry> &GetRegistry() {
+    static std::vector<Entry> registry;
+    return registry;
+}
+
+// ------------------------------------------------------------------------------------------------
+std::string EscapeJson(const std::string &s) {
+    std::string out;
+    out.reserve(s.size());
+    for (const char c : s) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) >= 0x20) {
+            out += c;
+        }
+    }
+    return out;
+}
+
+// ------------------------------------------------------------------------------------------------
+double NanosecondsPerIteration(const Result &r) {
+    return r.iterations ? r.seconds * 1e9 / r.iterations : 0.0;
+}
+
+// ------------------------------------------------------------------------------------------------
+double BytesPerSecond(const Result &r) {
+    return r.seconds > 0.0 ? r.bytesPerIteration * r.iterations / r.seconds : 0.0;
+}
+
+// ------------------------------------------------------------------------------------------------
+double ItemsPerSecond(const Result &r) {
+    return r.seconds > 0.0 ? r.itemsPerIteration * r.iterations / r.seconds : 0.0;
+}
+
+// ------------------------------------------------------------------------------------------------
+void WriteConsole(std::ostream &out, const std::vector<Result> &results) {
+    size_t width = 9;
+    for (const Result &r : results) {
+        width = std::max(width, r.name.size());
+    }
+    out << std::left << std::setw(static_cast<int>(width)) << "Benchmark" << std::right
+        << std::setw(14) << "Time (ms)" << std::setw(12) << "Iterations"
+        << std::setw(12) << "MB/s" << std::setw(14) << "Items/s" << "\n"
+        << std::string(width + 52, '-') << "\n";
+    for (const Result &r : results) {
+        out << std::left << std::setw(static_cast<int>(width)) << r.name << std::right;
+        if (!r.error.empty()) {
+            out << "  ERROR: " << r.error << "\n";
+            continue;
+        }
+        out << std::fixed << std::setprecision(3)
+            << std::setw(14) << NanosecondsPerIteration(r) / 1e6
+            << std::setw(12) << r.iterations
+            << std::setprecision(1)
+            << std::setw(12) << BytesPerSecond(r) / (1024.0 * 1024.0)
+            << std::setprecision(0)
+            << std::setw(14) << ItemsPerSecond(r) << "\n";
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void WriteJson(std::ostream &out, const std::vector<Result> &results) {
+    char date[64] = { 0 };
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    out << "{\n  \"context\": {\n"
+        << "    \"date\": \"" << date << "\",\n"
+        << "    \"library\": \"assimp\",\n"
+        << "    \"version\": \"" << aiGetVersionMajor() << "." << aiGetVersionMinor() << "." << aiGetVersionPatch() << "\",\n"
+        << "    \"revision\": \"" << std::hex << aiGetVersionRevision() << std::dec << "\",\n"
+        << "    \"compile_flags\": " << aiGetCompileFlags() << "\n"
+        << "  },\n  \"benchmarks\": [";
+    out << std::setprecision(10);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result &r = results[i];
+        out << (i ? ",\n" : "\n") << "    {\n"
+            << "      \"name\": \"" << EscapeJson(r.name) << "\",\n"
+            << "      \"run_name\": \"" << EscapeJson(r.name) << "\",\n"
+            << "      \"run_type\": \"iteration\",\n"
+            << "      \"iterations\": " << r.iterations << ",\n"
+            << "      \"real_time\": " << NanosecondsPerIteration(r) << ",\n"
+            << "      \"cpu_time\": " << NanosecondsPerIteration(r) << ",\n"
+            << "      \"time_unit\": \"ns\"";
+        if (r.bytesPerIteration > 0.0) {
+            out << ",\n      \"bytes_per_second\": " << BytesPerSecond(r);
+        }
+        if (r.itemsPerIteration > 0.0) {
+            out << ",\n      \"items_per_second\": " << ItemsPerSecond(r);
+        }
+        if (!r.error.empty()) {
+            out << ",\n      \"error_occurred\": true,\n      \"error_message\": \"" << EscapeJson(r.error) << "\"";
+        }
+        out << "\n    }";
+    }
+    out << "\n  ]\n}\n";
+}
+
+// ------------------------------------------------------------------------------------------------
+void WriteCsv(std::ostream &out, const std::vector<Result> &results) {
+    out << "name,iterations,real_time_ns,bytes_per_second,items_per_second,error\n";
+    out << std::setprecision(10);
+    for (const Result &r : results) {
+        out << "\"" << r.name << "\"," << r.iterations << "," << NanosecondsPerIteration(r) << ","
+            << BytesPerSecond(r) << "," << ItemsPerSecond(r) << ",\"" << r.error << "\"\n";
+    }
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+State::State(const Options &options, Result &result) :
+        mOptions(options), mResult(result) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+void State::Run(const std::function<void()> &body) {
+    Run(std::function<void()>(), body);
+}
+
+// ------------------------------------------------------------------------------------------------
+void State::Run(const std::function<void()> &setup, const std::function<void()> &body) {
+    // Give up on slow setups after a while, even if not enough time has been measured
+    const Clock::time_point deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(10.0 * mOptions.minTime + 1.0));
+
+    while (!HasError() && mResult.iterations < mOptions.maxIterations) {
+        if (setup) {
+            setup();
+        }
+        const Clock::time_point start = Clock::now();
+        body();
+        const Clock::time_point end = Clock::now();
+
+        mResult.seconds += std::chrono::duration<double>(end - start).count();
+        ++mResult.iterations;
+        if (mResult.seconds >= mOptions.minTime || end >= deadline) {
+            break;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void State::SetBytesProcessed(double bytes) {
+    mResult.bytesPerIteration = bytes;
+}
+
+// ------------------------------------------------------------------------------------------------
+void State::SetItemsProcessed(double items) {
+    mResult.itemsPerIteration = items;
+}
+
+// ------------------------------------------------------------------------------------------------
+void State::SkipWithError(const std::string &error) {
+    mResult.error = error.empty() ? std::string("unknown error") : error;
+}
+
+// ------------------------------------------------------------------------------------------------
+const Options &State::GetOptions() const {
+    return mOptions;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool State::HasError() const {
+    return !mResult.error.empty();
+}
+
+// ------------------------------------------------------------------------------------------------
+void RegisterBenchmark(const std::string &name, const BenchmarkFunc &func) {
+    Entry entry;
+    entry.name = name;
+    entry.func = func;
+    GetRegistry().push_back(entry);
+}
+
+// ------------------------------------------------------------------------------------------------
+std::vector<Result> RunBenchmarks(const Options &options) {
+    std::vector<Result> results;
+    for (const Entry &entry : GetRegistry()) {
+        if (!options.filter.empty() && entry.name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+
+        Result result;
+        result.name = entry.name;
+        State state(options, result);
+        try {
+            entry.func(state);
+        } catch (const std::exception &e) {
+            state.SkipWithError(e.what());
+        }
+        if (!state.HasError() && 0 == result.iterations) {
+            state.SkipWithError("benchmark did not run");
+        }
+        results.push_back(result);
+    }
+    return results;
+}
+
+// ------------------------------------------------------------------------------------------------
+void WriteResults(std::ostream &out, const Options &options, const std::vector<Result> &results) {
+    if (options.format == "json") {
+        WriteJson(out, results);
+    } else if (options.format == "csv") {
+        WriteCsv(out, results);
+    } else {
+        WriteConsole(out, results);
+    }
+}
+
+} // namespace AssimpBench
@@ -0,0 +1,146 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file BenchHarness.h
+ *  @brief A minimal benchmark harness for assimp_bench.
+ *
+ *  Each benchmark is a function receiving a State. The function does its
+ *  untimed preparation and then hands the code to be measured to State::Run(),
+ *  which repeats it until enough time has been collected.
+ */
+#pragma once
+#ifndef AI_BENCH_HARNESS_H_INC
+#define AI_BENCH_HARNESS_H_INC
+
+#include <chrono>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace AssimpBench {
+
+// ---------------------------------------------------------------------------
+/** Settings for a benchmark run */
+struct Options {
+    std::string filter;         //!< Only run benchmarks whose name contains this string
+    std::string format;         //!< "console", "json" or "csv"
+    std::string output;         //!< File to write the results to, stdout if empty
+    std::string modelsDir;      //!< Directory holding the test models
+    double minTime;             //!< Minimum measured time per benchmark, in seconds
+    unsigned int maxIterations; //!< Upper bound of iterations per benchmark
+    bool quick;                 //!< Skip the larger synthetic inputs
+
+    Options() :
+            filter(), format("console"), output(), modelsDir(), minTime(0.5), maxIterations(100000), quick(false) {
+        // empty
+    }
+};
+
+// ---------------------------------------------------------------------------
+/** The measurement of a single benchmark */
+struct Result {
+    std::string name;
+    unsigned int iterations;
+    double seconds;             //!< Total measured time of all iterations
+    double bytesPerIteration;   //!< 0 if the benchmark has no throughput
+    double itemsPerIteration;   //!< 0 if the benchmark has no item count
+    std::string error;          //!< Non-empty if the benchmark failed
+
+    Result() :
+            name(), iterations(0), seconds(0.0), bytesPerIteration(0.0), itemsPerIteration(0.0), error() {
+        // empty
+    }
+};
+
+// ---------------------------------------------------------------------------
+/** Passed to each benchmark function, repeats and times the measured code */
+class State {
+public:
+    State(const Options &options, Result &result);
+
+    /** Repeat body until enough time has been measured. */
+    void Run(const std::function<void()> &body);
+
+    /** Same as above, but calls the untimed setup before each iteration. */
+    void Run(const std::function<void()> &setup, const std::function<void()> &body);
+
+    /** Set the number of bytes consumed or produced by one iteration. */
+    void SetBytesProcessed(double bytes);
+
+    /** Set the number of items (vertices, faces, ...) handled by one iteration. */
+    void SetItemsProcessed(double items);
+
+    /** Mark the benchmark as failed, e.g. because an import failed. */
+    void SkipWithError(const std::string &error);
+
+    /** Get the settings of the run, e.g. the models directory. */
+    const Options &GetOptions() const;
+
+    /** Check whether the benchmark has been marked as failed. */
+    bool HasError() const;
+
+private:
+    const Options &mOptions;
+    Result &mResult;
+};
+
+typedef std::function<void(State &)> BenchmarkFunc;
+
+// ---------------------------------------------------------------------------
+/** Add a benchmark to the global list, names use '/' to separate groups. */
+void RegisterBenchmark(const std::string &name, const BenchmarkFunc &func);
+
+// ---------------------------------------------------------------------------
+/** Run all registered benchmarks matching the filter.
+ *  @return The results in registration order. */
+std::vector<Result> RunBenchmarks(const Options &options);
+
+// ---------------------------------------------------------------------------
+/** Write the results in the format given by the options.
+ *  The JSON layout follows the one of google-benchmark, so its comparison
+ *  tools can be used to track results from one commit to the next. */
+void WriteResults(std::ostream &out, const Options &options, const std::vector<Result> &results);
+
+} // namespace AssimpBench
+
+#endif // AI_BENCH_HARNESS_H_INC
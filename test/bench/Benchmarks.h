@@ -0,0 +1,87 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file Benchmarks.h
+ *  @brief Benchmark groups and synthetic input generators of assimp_bench.
+ */
+#pragma once
+#ifndef AI_BENCH_BENCHMARKS_H_INC
+#define AI_BENCH_BENCHMARKS_H_INC
+
+#include "BenchHarness.h"
+
+#include <string>
+#include <vector>
+
+namespace AssimpBench {
+
+// ---------------------------------------------------------------------------
+/** Sizes (quads per grid side) used for the synthetic inputs */
+std::vector<unsigned int> GetGridSizes(const Options &options);
+
+// ---------------------------------------------------------------------------
+/** A regular grid of gridSize x gridSize quads split into numObjects objects,
+ *  as Wavefront OBJ text with positions, normals and texture coordinates. */
+std::string MakeGridObj(unsigned int gridSize, unsigned int numObjects);
+
+/** The same grid, triangulated, as ASCII or binary little-endian PLY. */
+std::string MakeGridPly(unsigned int gridSize, bool binary);
+
+/** The same grid, triangulated, as ASCII or binary STL. */
+std::string MakeGridStl(unsigned int gridSize, bool binary);
+
+// ---------------------------------------------------------------------------
+/** Parse throughput of the importers on synthetic inputs and test models */
+void RegisterImportBenchmarks(const Options &options);
+
+/** Cost of each post-processing step */
+void RegisterPostProcessBenchmarks(const Options &options);
+
+/** Throughput of the exporters */
+void RegisterExportBenchmarks(const Options &options);
+
+/** Hot internal helpers, e.g. SpatialSort */
+void RegisterComponentBenchmarks(const Options &options);
+
+} // namespace AssimpBench
+
+#endif // AI_BENCH_BENCHMARKS_H_INC
@@ -0,0 +1,169 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file ComponentBenchmarks.cpp
+ *  @brief Hot internal helpers used by several importers and post-processing steps.
+ */
+#include "Benchmarks.h"
+
+#include <assimp/SpatialSort.h>
+#include <assimp/material.h>
+
+namespace AssimpBench {
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// The vertices of a gridSize x gridSize quad grid, each position shared by up to six triangles
+std::vector<aiVector3D> MakeGridVertices(unsigned int gridSize) {
+    std::vector<aiVector3D> vertices;
+    vertices.reserve(6u * gridSize * gridSize);
+    for (unsigned int y = 0; y < gridSize; ++y) {
+        for (unsigned int x = 0; x < gridSize; ++x) {
+            const aiVector3D a(ai_real(x), ai_real(y), 0), b(ai_real(x + 1), ai_real(y), 0);
+            const aiVector3D c(ai_real(x + 1), ai_real(y + 1), 0), d(ai_real(x), ai_real(y + 1), 0);
+            vertices.push_back(a);
+            vertices.push_back(b);
+            vertices.push_back(c);
+            vertices.push_back(a);
+            vertices.push_back(c);
+            vertices.push_back(d);
+        }
+    }
+    return vertices;
+}
+
+// ------------------------------------------------------------------------------------------------
+void SpatialSortFill(State &state, unsigned int gridSize) {
+    const std::vector<aiVector3D> vertices = MakeGridVertices(gridSize);
+    state.SetItemsProcessed(static_cast<double>(vertices.size()));
+
+    Assimp::SpatialSort sort;
+    state.Run([&]() {
+        sort.Fill(vertices.data(), static_cast<unsigned int>(vertices.size()), sizeof(aiVector3D));
+    });
+}
+
+// ------------------------------------------------------------------------------------------------
+void SpatialSortFindPositions(State &state, unsigned int gridSize) {
+    const std::vector<aiVector3D> vertices = MakeGridVertices(gridSize);
+    state.SetItemsProcessed(static_cast<double>(vertices.size()));
+
+    Assimp::SpatialSort sort(vertices.data(), static_cast<unsigned int>(vertices.size()), sizeof(aiVector3D));
+    std::vector<unsigned int> found;
+    state.Run([&]() {
+        for (const aiVector3D &v : vertices) {
+            sort.FindPositions(v, ai_real(1e-4), found);
+        }
+    });
+}
+
+// ------------------------------------------------------------------------------------------------
+void SpatialSortFindAllNeighbors(State &state, unsigned int gridSize) {
+    const std::vector<aiVector3D> vertices = MakeGridVertices(gridSize);
+    state.SetItemsProcessed(static_cast<double>(vertices.size()));
+
+    Assimp::SpatialSort sort(vertices.data(), static_cast<unsigned int>(vertices.size()), sizeof(aiVector3D));
+    std::vector<unsigned int> offsets, neighbors;
+    state.Run([&]() {
+        sort.FindAllNeighbors(ai_real(1e-4), offsets, neighbors);
+    });
+}
+
+// ------------------------------------------------------------------------------------------------
+// A material with numProperties float properties spread over a few texture slots
+void FillMaterial(aiMaterial &material, unsigned int numProperties) {
+    for (unsigned int i = 0; i < numProperties; ++i) {
+        const std::string key = "$bench.prop" + std::to_string(i / 4);
+        const float value = static_cast<float>(i);
+        material.AddProperty(&value, 1, key.c_str(), i % 4, 0);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void MaterialAddProperties(State &state, unsigned int numProperties) {
+    state.SetItemsProcessed(static_cast<double>(numProperties));
+    state.Run([&]() {
+        aiMaterial material;
+        FillMaterial(material, numProperties);
+    });
+}
+
+// ------------------------------------------------------------------------------------------------
+void MaterialGet(State &state, unsigned int numProperties) {
+    aiMaterial material;
+    FillMaterial(material, numProperties);
+    state.SetItemsProcessed(static_cast<double>(numProperties));
+
+    std::vector<std::string> keys;
+    for (unsigned int i = 0; i < numProperties; ++i) {
+        keys.push_back("$bench.prop" + std::to_string(i / 4));
+    }
+    float value = 0.f;
+    state.Run([&]() {
+        for (unsigned int i = 0; i < numProperties; ++i) {
+            material.Get(keys[i].c_str(), i % 4, 0, value);
+        }
+    });
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+void RegisterComponentBenchmarks(const Options &options) {
+    for (const unsigned int size : GetGridSizes(options)) {
+        RegisterBenchmark("component/SpatialSort/Fill/grid" + std::to_string(size),
+                [size](State &state) { SpatialSortFill(state, size); });
+        RegisterBenchmark("component/SpatialSort/FindPositions/grid" + std::to_string(size),
+                [size](State &state) { SpatialSortFindPositions(state, size); });
+        RegisterBenchmark("component/SpatialSort/FindAllNeighbors/grid" + std::to_string(size),
+                [size](State &state) { SpatialSortFindAllNeighbors(state, size); });
+    }
+    for (const unsigned int numProperties : { 8u, 128u }) {
+        RegisterBenchmark("component/Material/AddProperties/props" + std::to_string(numProperties),
+                [numProperties](State &state) { MaterialAddProperties(state, numProperties); });
+        RegisterBenchmark("component/Material/Get/props" + std::to_string(numProperties),
+                [numProperties](State &state) { MaterialGet(state, numProperties); });
+    }
+}
+
+} // namespace AssimpBench
@@ -0,0 +1,112 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file ExportBenchmarks.cpp
+ *  @brief Throughput of the exporters.
+ */
+#include "Benchmarks.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#ifndef ASSIMP_BUILD_NO_EXPORT
+#include <assimp/Exporter.hpp>
+#endif
+
+namespace AssimpBench {
+
+#ifndef ASSIMP_BUILD_NO_EXPORT
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+void ExportGrid(State &state, const std::string &formatId, unsigned int gridSize) {
+    const std::string data = MakeGridObj(gridSize, 16);
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFileFromMemory(data.data(), data.size(),
+            aiProcess_Triangulate | aiProcess_JoinIdenticalVertices, "obj");
+    if (nullptr == scene) {
+        state.SkipWithError(importer.GetErrorString());
+        return;
+    }
+    state.SetItemsProcessed(2.0 * gridSize * gridSize);
+
+    Assimp::Exporter exporter;
+    state.Run([&]() {
+        const aiExportDataBlob *blob = exporter.ExportToBlob(scene, formatId);
+        if (nullptr == blob) {
+            state.SkipWithError(exporter.GetErrorString());
+            return;
+        }
+        size_t bytes = 0;
+        for (; nullptr != blob; blob = blob->next) {
+            bytes += blob->size;
+        }
+        state.SetBytesProcessed(static_cast<double>(bytes));
+    });
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+void RegisterExportBenchmarks(const Options &options) {
+    Assimp::Exporter exporter;
+    for (size_t i = 0; i < exporter.GetExportFormatCount(); ++i) {
+        const std::string formatId = exporter.GetExportFormatDescription(i)->id;
+        for (const unsigned int size : GetGridSizes(options)) {
+            RegisterBenchmark("export/" + formatId + "/grid" + std::to_string(size),
+                    [formatId, size](State &state) { ExportGrid(state, formatId, size); });
+        }
+    }
+}
+
+#else
+
+// ------------------------------------------------------------------------------------------------
+void RegisterExportBenchmarks(const Options &) {
+    // exporters are not part of this build
+}
+
+#endif // ASSIMP_BUILD_NO_EXPORT
+
+} // namespace AssimpBench
@@ -0,0 +1,187 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file ImportBenchmarks.cpp
+ *  @brief Parse throughput of the importers.
+ */
+#include "Benchmarks.h"
+
+#include <assimp/Exporter.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <fstream>
+#include <memory>
+
+namespace AssimpBench {
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// One representative test model per importer, relative to the models directory
+struct ModelFile {
+    const char *name;
+    const char *path;
+};
+
+const ModelFile ModelFiles[] = {
+    { "3ds", "3DS/fels.3ds" },
+    { "ac", "AC/Wuson.ac" },
+    { "ase", "ASE/MotionCaptureROM.ase" },
+    { "blend", "BLEND/blender_269_regress1.blend" },
+    { "bvh", "BVH/01_03.bvh" },
+    { "cob", "COB/dwarf.cob" },
+    { "collada", "Collada/duck.dae" },
+    { "fbx-ascii", "FBX/embedded_ascii/box.FBX" },
+    { "fbx-binary", "FBX/spider.fbx" },
+    { "gltf2", "glTF2/BoxTextured-glTF/BoxTextured.gltf" },
+    { "gltf2-glb", "glTF2/2CylinderEngine-glTF-Binary/2CylinderEngine.glb" },
+    { "ifc", "IFC/AC14-FZK-Haus.ifc" },
+    { "obj", "OBJ/spider.obj" },
+    { "ogex", "OpenGEX/collada.ogex" },
+    { "ply", "PLY/Wuson.ply" },
+    { "ply-binary", "PLY/cube_binary.ply" },
+    { "smd", "SMD/WusonSMD.smd" },
+    { "stl", "STL/3DSMaxExport.STL" },
+    { "x", "X/anim_test.x" },
+};
+
+// ------------------------------------------------------------------------------------------------
+typedef std::string (*GridGenerator)(unsigned int gridSize);
+
+std::string MakeObj(unsigned int gridSize) {
+    return MakeGridObj(gridSize, 16);
+}
+std::string MakePlyAscii(unsigned int gridSize) {
+    return MakeGridPly(gridSize, false);
+}
+std::string MakePlyBinary(unsigned int gridSize) {
+    return MakeGridPly(gridSize, true);
+}
+std::string MakeStlAscii(unsigned int gridSize) {
+    return MakeGridStl(gridSize, false);
+}
+std::string MakeStlBinary(unsigned int gridSize) {
+    return MakeGridStl(gridSize, true);
+}
+#ifndef ASSIMP_BUILD_NO_EXPORT
+std::string MakeSceneImage(unsigned int gridSize) {
+    const std::string obj = MakeGridObj(gridSize, 16);
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFileFromMemory(obj.data(), obj.size(),
+            aiProcess_Triangulate | aiProcess_JoinIdenticalVertices, "obj");
+    Assimp::Exporter exporter;
+    const aiExportDataBlob *blob = nullptr != scene ? exporter.ExportToBlob(scene, "assimg") : nullptr;
+    return nullptr != blob ? std::string(static_cast<const char *>(blob->data), blob->size) : std::string();
+}
+#endif
+
+struct SyntheticFormat {
+    const char *name;
+    const char *hint;
+    GridGenerator generator;
+};
+
+const SyntheticFormat SyntheticFormats[] = {
+    { "obj", "obj", &MakeObj },
+    { "ply-ascii", "ply", &MakePlyAscii },
+    { "ply-binary", "ply", &MakePlyBinary },
+    { "stl-ascii", "stl", &MakeStlAscii },
+    { "stl-binary", "stl", &MakeStlBinary },
+#ifndef ASSIMP_BUILD_NO_EXPORT
+    { "assimg", "assimg", &MakeSceneImage },
+#endif
+};
+
+// ------------------------------------------------------------------------------------------------
+void ImportSynthetic(State &state, const SyntheticFormat &format, unsigned int gridSize) {
+    const std::string data = format.generator(gridSize);
+    state.SetBytesProcessed(static_cast<double>(data.size()));
+    state.SetItemsProcessed(2.0 * gridSize * gridSize);
+
+    Assimp::Importer importer;
+    state.Run([&]() { importer.FreeScene(); },
+            [&]() {
+                if (!importer.ReadFileFromMemory(data.data(), data.size(), 0, format.hint)) {
+                    state.SkipWithError(importer.GetErrorString());
+                }
+            });
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImportModel(State &state, const std::string &path) {
+    std::ifstream file(path.c_str(), std::ios::binary | std::ios::ate);
+    if (!file) {
+        state.SkipWithError("cannot open " + path);
+        return;
+    }
+    state.SetBytesProcessed(static_cast<double>(file.tellg()));
+
+    Assimp::Importer importer;
+    state.Run([&]() { importer.FreeScene(); },
+            [&]() {
+                if (!importer.ReadFile(path, 0)) {
+                    state.SkipWithError(importer.GetErrorString());
+                }
+            });
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+void RegisterImportBenchmarks(const Options &options) {
+    for (const SyntheticFormat &format : SyntheticFormats) {
+        for (const unsigned int size : GetGridSizes(options)) {
+            RegisterBenchmark(std::string("import/") + format.name + "/grid" + std::to_string(size),
+                    [&format, size](State &state) { ImportSynthetic(state, format, size); });
+        }
+    }
+
+    for (const ModelFile &model : ModelFiles) {
+        const std::string path = options.modelsDir + "/" + model.path;
+        RegisterBenchmark(std::string("import/") + model.name + "/" + model.path,
+                [path](State &state) { ImportModel(state, path); });
+    }
+}
+
+} // namespace AssimpBench
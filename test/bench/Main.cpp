@@ -0,0 +1,147 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  Main.cpp
+ *  @brief main() function of assimp_bench
+ */
+#include "Benchmarks.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#ifndef ASSIMP_BENCH_MODELS_DIR
+#define ASSIMP_BENCH_MODELS_DIR "test/models"
+#endif
+
+static const char *AIBENCH_MSG_HELP =
+        "assimp_bench [options]\n\n"
+        " options:\n"
+        " \t--filter <text>         Only run benchmarks whose name contains <text>\n"
+        " \t--format <fmt>          Output format: console (default), json or csv\n"
+        " \t--out <file>            Write the results to <file> instead of stdout\n"
+        " \t--min-time <seconds>    Minimum measured time per benchmark (default 0.5)\n"
+        " \t--max-iterations <n>    Maximum iterations per benchmark (default 100000)\n"
+        " \t--models <dir>          Directory holding the assimp test models\n"
+        " \t--quick                 Skip the largest synthetic inputs\n"
+        " \t--help                  Show this help\n";
+
+// ------------------------------------------------------------------------------------------------
+// Accepts both "--name=value" and "--name value", advancing i in the latter case
+static bool GetValue(int argc, char *argv[], int &i, const char *name, std::string &value) {
+    const char *arg = argv[i];
+    const size_t len = ::strlen(name);
+    if (0 != ::strncmp(arg, name, len)) {
+        return false;
+    }
+    if ('=' == arg[len]) {
+        value = arg + len + 1;
+        return true;
+    }
+    if ('\0' == arg[len] && i + 1 < argc) {
+        value = argv[++i];
+        return true;
+    }
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+int main(int argc, char *argv[]) {
+    AssimpBench::Options options;
+    options.modelsDir = ASSIMP_BENCH_MODELS_DIR;
+
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        std::string value;
+        if (!::strcmp(arg, "--help") || !::strcmp(arg, "-h")) {
+            std::cout << AIBENCH_MSG_HELP;
+            return 0;
+        } else if (!::strcmp(arg, "--quick")) {
+            options.quick = true;
+        } else if (GetValue(argc, argv, i, "--filter", value)) {
+            options.filter = value;
+        } else if (GetValue(argc, argv, i, "--format", value)) {
+            if (value != "console" && value != "json" && value != "csv") {
+                std::cerr << "assimp_bench: unknown format " << value << "\n";
+                return 1;
+            }
+            options.format = value;
+        } else if (GetValue(argc, argv, i, "--out", value)) {
+            options.output = value;
+        } else if (GetValue(argc, argv, i, "--min-time", value)) {
+            options.minTime = ::atof(value.c_str());
+        } else if (GetValue(argc, argv, i, "--max-iterations", value)) {
+            options.maxIterations = static_cast<unsigned int>(::strtoul(value.c_str(), nullptr, 10));
+        } else if (GetValue(argc, argv, i, "--models", value)) {
+            options.modelsDir = value;
+        } else {
+            std::cerr << "assimp_bench: unknown option " << arg << "\n" << AIBENCH_MSG_HELP;
+            return 1;
+        }
+    }
+
+    AssimpBench::RegisterImportBenchmarks(options);
+    AssimpBench::RegisterPostProcessBenchmarks(options);
+    AssimpBench::RegisterExportBenchmarks(options);
+    AssimpBench::RegisterComponentBenchmarks(options);
+
+    const std::vector<AssimpBench::Result> results = AssimpBench::RunBenchmarks(options);
+
+    if (options.output.empty()) {
+        AssimpBench::WriteResults(std::cout, options, results);
+    } else {
+        std::ofstream out(options.output.c_str());
+        if (!out) {
+            std::cerr << "assimp_bench: cannot write " << options.output << "\n";
+            return 1;
+        }
+        AssimpBench::WriteResults(out, options, results);
+    }
+
+    for (const AssimpBench::Result &result : results) {
+        if (!result.error.empty()) {
+            return 2;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,138 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file PostProcessBenchmarks.cpp
+ *  @brief Cost of each post-processing step.
+ */
+#include "Benchmarks.h"
+
+#include <assimp/config.h>
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+namespace AssimpBench {
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Each step is applied on its own to a freshly imported grid. Steps which need
+// a specific input run their prerequisites as part of the untimed setup. Steps
+// which only work on skinned meshes (PopulateArmatureData) are left out.
+// Alternative configurations of a step set one integer property.
+struct Step {
+    const char *name;
+    unsigned int flags;
+    unsigned int prerequisites;
+    const char *property;
+    int value;
+};
+
+const Step Steps[] = {
+    { "CalcTangentSpace", aiProcess_CalcTangentSpace, 0, nullptr, 0 },
+    { "JoinIdenticalVertices", aiProcess_JoinIdenticalVertices, 0, nullptr, 0 },
+    { "JoinIdenticalVerticesHashExact", aiProcess_JoinIdenticalVertices, 0, AI_CONFIG_PP_JIV_METHOD, AI_JIV_METHOD_HASH_EXACT },
+    { "JoinIdenticalVerticesHashQuantized", aiProcess_JoinIdenticalVertices, 0, AI_CONFIG_PP_JIV_METHOD, AI_JIV_METHOD_HASH_QUANTIZED },
+    { "MakeLeftHanded", aiProcess_MakeLeftHanded, 0, nullptr, 0 },
+    { "Triangulate", aiProcess_Triangulate, 0, nullptr, 0 },
+    { "RemoveComponent", aiProcess_RemoveComponent, 0, nullptr, 0 },
+    { "GenNormals", aiProcess_GenNormals | aiProcess_ForceGenNormals, 0, nullptr, 0 },
+    { "GenSmoothNormals", aiProcess_GenSmoothNormals | aiProcess_ForceGenNormals, 0, nullptr, 0 },
+    { "SplitLargeMeshes", aiProcess_SplitLargeMeshes, 0, nullptr, 0 },
+    { "PreTransformVertices", aiProcess_PreTransformVertices, 0, nullptr, 0 },
+    { "LimitBoneWeights", aiProcess_LimitBoneWeights, 0, nullptr, 0 },
+    { "ValidateDataStructure", aiProcess_ValidateDataStructure, 0, nullptr, 0 },
+    { "ImproveCacheLocality", aiProcess_ImproveCacheLocality, aiProcess_JoinIdenticalVertices, nullptr, 0 },
+    { "RemoveRedundantMaterials", aiProcess_RemoveRedundantMaterials, 0, nullptr, 0 },
+    { "FixInfacingNormals", aiProcess_FixInfacingNormals, 0, nullptr, 0 },
+    { "SortByPType", aiProcess_SortByPType, 0, nullptr, 0 },
+    { "FindDegenerates", aiProcess_FindDegenerates, 0, nullptr, 0 },
+    { "FindInvalidData", aiProcess_FindInvalidData, 0, nullptr, 0 },
+    { "GenUVCoords", aiProcess_GenUVCoords, 0, nullptr, 0 },
+    { "TransformUVCoords", aiProcess_TransformUVCoords, 0, nullptr, 0 },
+    { "FindInstances", aiProcess_FindInstances, 0, nullptr, 0 },
+    { "OptimizeMeshes", aiProcess_OptimizeMeshes, 0, nullptr, 0 },
+    { "OptimizeGraph", aiProcess_OptimizeGraph, 0, nullptr, 0 },
+    { "FlipUVs", aiProcess_FlipUVs, 0, nullptr, 0 },
+    { "FlipWindingOrder", aiProcess_FlipWindingOrder, 0, nullptr, 0 },
+    { "SplitByBoneCount", aiProcess_SplitByBoneCount, 0, nullptr, 0 },
+    { "Debone", aiProcess_Debone, 0, nullptr, 0 },
+    { "GlobalScale", aiProcess_GlobalScale, 0, nullptr, 0 },
+    { "EmbedTextures", aiProcess_EmbedTextures, 0, nullptr, 0 },
+    { "DropNormals", aiProcess_DropNormals, 0, nullptr, 0 },
+    { "GenBoundingBoxes", aiProcess_GenBoundingBoxes, 0, nullptr, 0 },
+};
+
+// ------------------------------------------------------------------------------------------------
+void ApplyStep(State &state, const Step &step, unsigned int gridSize) {
+    const std::string data = MakeGridObj(gridSize, 16);
+    state.SetItemsProcessed(2.0 * gridSize * gridSize);
+
+    Assimp::Importer importer;
+    if (step.property) {
+        importer.SetPropertyInteger(step.property, step.value);
+    }
+    state.Run([&]() {
+                if (!importer.ReadFileFromMemory(data.data(), data.size(), step.prerequisites, "obj")) {
+                    state.SkipWithError(importer.GetErrorString());
+                }
+            },
+            [&]() {
+                if (!state.HasError() && !importer.ApplyPostProcessing(step.flags)) {
+                    state.SkipWithError(importer.GetErrorString());
+                }
+            });
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+void RegisterPostProcessBenchmarks(const Options &options) {
+    for (const Step &step : Steps) {
+        for (const unsigned int size : GetGridSizes(options)) {
+            RegisterBenchmark(std::string("postprocess/") + step.name + "/grid" + std::to_string(size),
+                    [&step, size](State &state) { ApplyStep(state, step, size); });
+        }
+    }
+}
+
+} // namespace AssimpBench
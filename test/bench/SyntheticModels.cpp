@@ -0,0 +1,240 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file SyntheticModels.cpp
+ *  @brief Generators for the synthetic benchmark inputs.
+ */
+#include "Benchmarks.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace AssimpBench {
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// A slightly wavy grid so normals, tangents and spatial queries have some work to do
+void GridPosition(unsigned int gridSize, unsigned int x, unsigned int y, float *out) {
+    const float scale = 1.f / static_cast<float>(gridSize);
+    out[0] = static_cast<float>(x) * scale;
+    out[1] = static_cast<float>(y) * scale;
+    out[2] = 0.05f * std::sin(static_cast<float>(x) * 0.3f) * std::cos(static_cast<float>(y) * 0.2f);
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int GridIndex(unsigned int gridSize, unsigned int x, unsigned int y) {
+    return y * (gridSize + 1) + x;
+}
+
+// ------------------------------------------------------------------------------------------------
+void Append(std::string &out, const char *fmt, double a, double b, double c) {
+    char buffer[128];
+    const int len = ::snprintf(buffer, sizeof(buffer), fmt, a, b, c);
+    out.append(buffer, static_cast<size_t>(len));
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+void AppendBinary(std::string &out, T value) {
+    char buffer[sizeof(T)];
+    ::memcpy(buffer, &value, sizeof(T));
+    out.append(buffer, sizeof(T));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Calls fn(a, b, c) for each triangle of the grid, two per quad
+template <typename Func>
+void ForEachTriangle(unsigned int gridSize, Func fn) {
+    for (unsigned int y = 0; y < gridSize; ++y) {
+        for (unsigned int x = 0; x < gridSize; ++x) {
+            fn(GridIndex(gridSize, x, y), GridIndex(gridSize, x + 1, y), GridIndex(gridSize, x + 1, y + 1));
+            fn(GridIndex(gridSize, x, y), GridIndex(gridSize, x + 1, y + 1), GridIndex(gridSize, x, y + 1));
+        }
+    }
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+std::vector<unsigned int> GetGridSizes(const Options &options) {
+    std::vector<unsigned int> sizes;
+    sizes.push_back(32);
+    sizes.push_back(128);
+    if (!options.quick) {
+        sizes.push_back(512);
+    }
+    return sizes;
+}
+
+// ------------------------------------------------------------------------------------------------
+std::string MakeGridObj(unsigned int gridSize, unsigned int numObjects) {
+    std::string out;
+    out.reserve(static_cast<size_t>(gridSize + 1) * (gridSize + 1) * 100 + static_cast<size_t>(gridSize) * gridSize * 80);
+    out += "# assimp_bench synthetic grid\n";
+
+    float p[3];
+    for (unsigned int y = 0; y <= gridSize; ++y) {
+        for (unsigned int x = 0; x <= gridSize; ++x) {
+            GridPosition(gridSize, x, y, p);
+            Append(out, "v %f %f %f\n", p[0], p[1], p[2]);
+            Append(out, "vt %f %f %f\n", p[0], p[1], 0.0);
+            Append(out, "vn %f %f %f\n", -p[2], -p[2], 1.0);
+        }
+    }
+
+    // OBJ indices are 1-based and global, each object covers a band of rows
+    numObjects = std::max(1u, std::min(numObjects, gridSize));
+    for (unsigned int o = 0; o < numObjects; ++o) {
+        char name[32];
+        ::snprintf(name, sizeof(name), "o grid%u\n", o);
+        out += name;
+
+        const unsigned int rowBegin = gridSize * o / numObjects;
+        const unsigned int rowEnd = gridSize * (o + 1) / numObjects;
+        for (unsigned int y = rowBegin; y < rowEnd; ++y) {
+            for (unsigned int x = 0; x < gridSize; ++x) {
+                const unsigned int a = GridIndex(gridSize, x, y) + 1;
+                const unsigned int b = GridIndex(gridSize, x + 1, y) + 1;
+                const unsigned int c = GridIndex(gridSize, x + 1, y + 1) + 1;
+                const unsigned int d = GridIndex(gridSize, x, y + 1) + 1;
+                char face[160];
+                ::snprintf(face, sizeof(face), "f %u/%u/%u %u/%u/%u %u/%u/%u\nf %u/%u/%u %u/%u/%u %u/%u/%u\n",
+                        a, a, a, b, b, b, c, c, c, a, a, a, c, c, c, d, d, d);
+                out += face;
+            }
+        }
+    }
+    return out;
+}
+
+// ------------------------------------------------------------------------------------------------
+std::string MakeGridPly(unsigned int gridSize, bool binary) {
+    const unsigned int numVertices = (gridSize + 1) * (gridSize + 1);
+    const unsigned int numFaces = gridSize * gridSize * 2;
+
+    char header[512];
+    ::snprintf(header, sizeof(header),
+            "ply\nformat %s 1.0\ncomment assimp_bench synthetic grid\n"
+            "element vertex %u\nproperty float x\nproperty float y\nproperty float z\n"
+            "element face %u\nproperty list uchar int vertex_indices\nend_header\n",
+            binary ? "binary_little_endian" : "ascii", numVertices, numFaces);
+    std::string out = header;
+
+    float p[3];
+    for (unsigned int y = 0; y <= gridSize; ++y) {
+        for (unsigned int x = 0; x <= gridSize; ++x) {
+            GridPosition(gridSize, x, y, p);
+            if (binary) {
+                AppendBinary(out, p[0]);
+                AppendBinary(out, p[1]);
+                AppendBinary(out, p[2]);
+            } else {
+                Append(out, "%f %f %f\n", p[0], p[1], p[2]);
+            }
+        }
+    }
+    ForEachTriangle(gridSize, [&](unsigned int a, unsigned int b, unsigned int c) {
+        if (binary) {
+            AppendBinary(out, static_cast<uint8_t>(3));
+            AppendBinary(out, static_cast<int32_t>(a));
+            AppendBinary(out, static_cast<int32_t>(b));
+            AppendBinary(out, static_cast<int32_t>(c));
+        } else {
+            char face[64];
+            ::snprintf(face, sizeof(face), "3 %u %u %u\n", a, b, c);
+            out += face;
+        }
+    });
+    return out;
+}
+
+// ------------------------------------------------------------------------------------------------
+std::string MakeGridStl(unsigned int gridSize, bool binary) {
+    std::vector<float> positions;
+    positions.reserve(static_cast<size_t>(gridSize + 1) * (gridSize + 1) * 3);
+    float p[3];
+    for (unsigned int y = 0; y <= gridSize; ++y) {
+        for (unsigned int x = 0; x <= gridSize; ++x) {
+            GridPosition(gridSize, x, y, p);
+            positions.insert(positions.end(), p, p + 3);
+        }
+    }
+
+    std::string out;
+    if (binary) {
+        out.assign(80, ' ');
+        out.replace(0, 28, "assimp_bench synthetic grid ");
+        AppendBinary(out, static_cast<uint32_t>(gridSize * gridSize * 2));
+    } else {
+        out = "solid grid\n";
+    }
+    ForEachTriangle(gridSize, [&](unsigned int a, unsigned int b, unsigned int c) {
+        const float *v[3] = { &positions[a * 3], &positions[b * 3], &positions[c * 3] };
+        if (binary) {
+            for (unsigned int i = 0; i < 3; ++i) {
+                AppendBinary(out, 0.f);
+            }
+            for (unsigned int i = 0; i < 3; ++i) {
+                AppendBinary(out, v[i][0]);
+                AppendBinary(out, v[i][1]);
+                AppendBinary(out, v[i][2]);
+            }
+            AppendBinary(out, static_cast<uint16_t>(0));
+        } else {
+            out += " facet normal 0 0 1\n  outer loop\n";
+            for (unsigned int i = 0; i < 3; ++i) {
+                Append(out, "   vertex %f %f %f\n", v[i][0], v[i][1], v[i][2]);
+            }
+            out += "  endloop\n endfacet\n";
+        }
+    });
+    if (!binary) {
+        out += "endsolid grid\n";
+    }
+    return out;
+}
+
+} // namespace AssimpBench
@@ -40,8 +40,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "UnitTestPCH.h"
 
+#include "Common/ThreadPool.h"
+
 #include <assimp/SpatialSort.h>
 
+#include <algorithm>
+
 using namespace Assimp;
 
 class utSpatialSort : public ::testing::Test {
@@ -82,3 +86,63 @@ TEST_F(utSpatialSort, findPositionsTest) {
     sSort.FindPositions(vecs[0], 0.01f, indices);
     EXPECT_EQ(1u, indices.size());
 }
+
+namespace {
+
+// A welded grid with every position used several times, large enough for the radix sort
+std::vector<aiVector3D> MakeSharedPositions() {
+    std::vector<aiVector3D> positions;
+    for (int y = -20; y < 20; ++y) {
+        for (int x = -20; x < 20; ++x) {
+            const aiVector3D p(x * 0.5f, y * 0.25f, (x * y) * 0.125f);
+            for (int n = 0; n < 3; ++n) {
+                positions.push_back(p);
+            }
+        }
+    }
+    std::reverse(positions.begin(), positions.end());
+    return positions;
+}
+
+} // namespace
+
+TEST_F(utSpatialSort, findPositionsMatchesBruteForceTest) {
+    const std::vector<aiVector3D> positions = MakeSharedPositions();
+    SpatialSort sSort(positions.data(), static_cast<unsigned int>(positions.size()), sizeof(aiVector3D));
+
+    std::vector<unsigned int> indices;
+    for (size_t i = 0; i < positions.size(); i += 7) {
+        sSort.FindPositions(positions[i], 0.01f, indices);
+        std::sort(indices.begin(), indices.end());
+
+        std::vector<unsigned int> expected;
+        for (size_t j = 0; j < positions.size(); ++j) {
+            if ((positions[j] - positions[i]).SquareLength() < 0.01f * 0.01f) {
+                expected.push_back(static_cast<unsigned int>(j));
+            }
+        }
+        EXPECT_EQ(expected, indices);
+    }
+}
+
+TEST_F(utSpatialSort, findAllNeighborsTest) {
+    const std::vector<aiVector3D> positions = MakeSharedPositions();
+    ThreadPool pool(4);
+    for (ThreadPool *threads : { static_cast<ThreadPool *>(nullptr), &pool }) {
+        SpatialSort sSort;
+        sSort.SetThreadPool(threads);
+        sSort.Fill(positions.data(), static_cast<unsigned int>(positions.size()), sizeof(aiVector3D));
+
+        std::vector<unsigned int> offsets, neighbors;
+        sSort.FindAllNeighbors(0.01f, offsets, neighbors);
+        ASSERT_EQ(positions.size() + 1, offsets.size());
+        EXPECT_EQ(3 * positions.size(), neighbors.size());
+
+        std::vector<unsigned int> indices;
+        for (size_t i = 0; i < positions.size(); ++i) {
+            sSort.FindPositions(positions[i], 0.01f, indices);
+            const std::vector<unsigned int> found(neighbors.begin() + offsets[i], neighbors.begin() + offsets[i + 1]);
+            EXPECT_EQ(indices, found);
+        }
+    }
+}
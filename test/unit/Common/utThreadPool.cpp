@@ -0,0 +1,107 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "Common/ThreadPool.h"
+
+#include <atomic>
+#include <stdexcept>
+
+using namespace Assimp;
+
+class utThreadPool : public ::testing::Test {
+    // empty
+};
+
+TEST_F(utThreadPool, visitsEachIndexOnceTest) {
+    ThreadPool pool(4);
+    EXPECT_EQ(4u, pool.GetNumThreads());
+
+    std::vector<unsigned int> visited(1000, 0);
+    pool.ParallelFor(1000, [&](unsigned int i) {
+        ++visited[i];
+    });
+    for (size_t i = 0; i < visited.size(); ++i) {
+        EXPECT_EQ(1u, visited[i]);
+    }
+}
+
+TEST_F(utThreadPool, hardwareConcurrencyTest) {
+    ThreadPool pool(0);
+    EXPECT_EQ(ThreadPool::GetHardwareConcurrency(), pool.GetNumThreads());
+    EXPECT_LE(1u, pool.GetNumThreads());
+}
+
+TEST_F(utThreadPool, nestedParallelForTest) {
+    ThreadPool pool(3);
+    std::atomic<unsigned int> sum(0);
+    pool.ParallelFor(10, [&](unsigned int) {
+        pool.ParallelFor(10, [&](unsigned int j) {
+            sum += j;
+        });
+    });
+    EXPECT_EQ(450u, sum.load());
+}
+
+TEST_F(utThreadPool, rethrowsExceptionTest) {
+    ThreadPool pool(2);
+    std::atomic<unsigned int> count(0);
+    EXPECT_THROW(pool.ParallelFor(100, [&](unsigned int i) {
+        ++count;
+        if (i == 42) {
+            throw std::runtime_error("failed");
+        }
+    }), std::runtime_error);
+
+    // all other items must have been processed nevertheless
+    EXPECT_EQ(100u, count.load());
+}
+
+TEST_F(utThreadPool, serialFallbackTest) {
+    std::vector<unsigned int> order;
+    ParallelFor(nullptr, 5, [&](unsigned int i) {
+        order.push_back(i);
+    });
+    ASSERT_EQ(5u, order.size());
+    for (unsigned int i = 0; i < 5; ++i) {
+        EXPECT_EQ(i, order[i]);
+    }
+}
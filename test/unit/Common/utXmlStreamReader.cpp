@@ -0,0 +1,157 @@
+/*-------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+-------------------------------------------------------------------------*/
+#include "UnitTestPCH.h"
+#include <assimp/XmlStreamReader.h>
+#include <assimp/DefaultIOSystem.h>
+#include <assimp/Exceptional.h>
+#include <assimp/MemoryIOWrapper.h>
+
+#include <cstring>
+
+using namespace Assimp;
+
+class utXmlStreamReader : public ::testing::Test {
+protected:
+    // the reader only sees a few bytes at a time, so every construct crosses chunk borders
+    static std::vector<std::string> Collect(const char *xml, size_t chunkSize = 16) {
+        MemoryIOStream stream(reinterpret_cast<const uint8_t *>(xml), ::strlen(xml));
+        XmlStreamReader reader(&stream, chunkSize);
+        std::vector<std::string> events;
+        for (;;) {
+            switch (reader.next()) {
+            case XmlStreamReader::Event_StartElement: {
+                std::string event = "<" + reader.getName();
+                for (size_t i = 0; i < reader.getNumAttributes(); ++i) {
+                    event += " " + reader.getAttributeName(i) + "=" + reader.getAttributeValue(i);
+                }
+                events.push_back(event + ">");
+                break;
+            }
+            case XmlStreamReader::Event_EndElement:
+                events.push_back("</" + reader.getName() + ">");
+                break;
+            case XmlStreamReader::Event_Text:
+                events.push_back(std::string(reader.getText(), reader.getTextLength()));
+                break;
+            case XmlStreamReader::Event_EndOfDocument:
+                return events;
+            }
+        }
+    }
+};
+
+TEST_F(utXmlStreamReader, eventsTest) {
+    const char *xml =
+            "\xEF\xBB\xBF<?xml version=\"1.0\"?>\n"
+            "<!DOCTYPE root [ <!ENTITY e \"x\"> ]>\n"
+            "<!-- a comment with <tags> -->\n"
+            "<root a=\"1 &amp; 2\" b='x>y'>\n"
+            "  <empty id=\"e\"/>\n"
+            "  <text>a &lt;b&gt; &#65;&#x42;</text>\n"
+            "  <raw><![CDATA[<not & parsed>]]></raw>\n"
+            "</root>\n";
+
+    const std::vector<std::string> expected = {
+        "<root a=1 & 2 b=x>y>",
+        "<empty id=e>", "</empty>",
+        "<text>", "a <b> AB", "</text>",
+        "<raw>", "<not & parsed>", "</raw>",
+        "</root>"
+    };
+    EXPECT_EQ(expected, Collect(xml));
+    EXPECT_EQ(expected, Collect(xml, 64 * 1024));
+}
+
+TEST_F(utXmlStreamReader, splitTextAtWhitespaceTest) {
+    std::string xml = "<float_array count=\"1000\">";
+    std::string numbers;
+    for (int i = 0; i < 1000; ++i) {
+        numbers += std::to_string(i * 1001) + " ";
+    }
+    xml += numbers + "</float_array>";
+
+    MemoryIOStream stream(reinterpret_cast<const uint8_t *>(xml.c_str()), xml.size());
+    XmlStreamReader reader(&stream, 64);
+    EXPECT_EQ(XmlStreamReader::Event_StartElement, reader.next());
+    ASSERT_NE(nullptr, reader.getAttribute("count"));
+    EXPECT_STREQ("1000", reader.getAttribute("count"));
+    EXPECT_EQ(nullptr, reader.getAttribute("id"));
+    EXPECT_EQ(1U, reader.getDepth());
+
+    std::string text;
+    size_t pieces = 0;
+    XmlStreamReader::Event event;
+    while (XmlStreamReader::Event_Text == (event = reader.next())) {
+        const std::string piece(reader.getText(), reader.getTextLength());
+        EXPECT_EQ(' ', piece.back());
+        text += piece;
+        ++pieces;
+    }
+    EXPECT_GT(pieces, 1U);
+    EXPECT_EQ(numbers, text);
+    EXPECT_EQ(XmlStreamReader::Event_EndElement, event);
+    EXPECT_EQ(0U, reader.getDepth());
+    EXPECT_EQ(XmlStreamReader::Event_EndOfDocument, reader.next());
+}
+
+TEST_F(utXmlStreamReader, malformedTest) {
+    EXPECT_THROW(Collect("<a><b></a>"), DeadlyImportError);
+    EXPECT_THROW(Collect("<a><b>"), DeadlyImportError);
+    EXPECT_THROW(Collect("<a b=c/>"), DeadlyImportError);
+    EXPECT_THROW(Collect("<a><!-- open"), DeadlyImportError);
+    EXPECT_THROW(Collect("</a>"), DeadlyImportError);
+}
+
+TEST_F(utXmlStreamReader, readFileTest) {
+    DefaultIOSystem ioSystem;
+    std::unique_ptr<IOStream> stream(ioSystem.Open(ASSIMP_TEST_MODELS_DIR "/X3D/ComputerKeyboard.x3d", "rb"));
+    ASSERT_NE(nullptr, stream.get());
+
+    XmlStreamReader reader(stream.get(), 256);
+    size_t numElements = 0;
+    XmlStreamReader::Event event;
+    while (XmlStreamReader::Event_EndOfDocument != (event = reader.next())) {
+        if (XmlStreamReader::Event_StartElement == event) {
+            EXPECT_FALSE(reader.getName().empty());
+            ++numElements;
+        }
+    }
+    EXPECT_NE(0U, numElements);
+    EXPECT_EQ(0U, reader.getDepth());
+}
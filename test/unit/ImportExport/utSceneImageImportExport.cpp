@@ -0,0 +1,238 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "AbstractImportExportBase.h"
+#include "UnitTestPCH.h"
+#include "SceneDiffer.h"
+
+#include <assimp/Exporter.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+using namespace Assimp;
+
+#ifndef ASSIMP_BUILD_NO_EXPORT
+
+class utSceneImageImportExport : public ::testing::Test {
+protected:
+    static void compareNodes(const aiNode *expected, const aiNode *node, const aiNode *parent) {
+        ASSERT_NE(nullptr, node);
+        EXPECT_STREQ(expected->mName.C_Str(), node->mName.C_Str());
+        EXPECT_EQ(parent, node->mParent);
+        EXPECT_EQ(expected->mTransformation, node->mTransformation);
+        ASSERT_EQ(expected->mNumMeshes, node->mNumMeshes);
+        for (unsigned int i = 0; i < expected->mNumMeshes; ++i) {
+            EXPECT_EQ(expected->mMeshes[i], node->mMeshes[i]);
+        }
+        ASSERT_EQ(expected->mNumChildren, node->mNumChildren);
+        for (unsigned int i = 0; i < expected->mNumChildren; ++i) {
+            compareNodes(expected->mChildren[i], node->mChildren[i], node);
+        }
+    }
+
+    static void compareScenes(const aiScene *expected, const aiScene *scene) {
+        ASSERT_NE(nullptr, scene);
+        SceneDiffer differ;
+        EXPECT_TRUE(differ.isEqual(expected, scene));
+        compareNodes(expected->mRootNode, scene->mRootNode, nullptr);
+
+        for (unsigned int i = 0; i < expected->mNumMeshes; ++i) {
+            const aiMesh *mesh = expected->mMeshes[i], *newMesh = scene->mMeshes[i];
+            ASSERT_EQ(mesh->mNumBones, newMesh->mNumBones);
+            for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+                const aiBone *bone = mesh->mBones[b], *newBone = newMesh->mBones[b];
+                EXPECT_STREQ(bone->mName.C_Str(), newBone->mName.C_Str());
+                ASSERT_EQ(bone->mNumWeights, newBone->mNumWeights);
+                EXPECT_EQ(0, memcmp(bone->mWeights, newBone->mWeights, bone->mNumWeights * sizeof(aiVertexWeight)));
+            }
+        }
+
+        ASSERT_EQ(expected->mNumAnimations, scene->mNumAnimations);
+        for (unsigned int i = 0; i < expected->mNumAnimations; ++i) {
+            const aiAnimation *anim = expected->mAnimations[i], *newAnim = scene->mAnimations[i];
+            ASSERT_EQ(anim->mNumChannels, newAnim->mNumChannels);
+            for (unsigned int c = 0; c < anim->mNumChannels; ++c) {
+                const aiNodeAnim *channel = anim->mChannels[c], *newChannel = newAnim->mChannels[c];
+                EXPECT_STREQ(channel->mNodeName.C_Str(), newChannel->mNodeName.C_Str());
+                ASSERT_EQ(channel->mNumRotationKeys, newChannel->mNumRotationKeys);
+                EXPECT_EQ(0, memcmp(channel->mRotationKeys, newChannel->mRotationKeys, channel->mNumRotationKeys * sizeof(aiQuatKey)));
+            }
+        }
+    }
+
+    static void roundTrip(const char *file, const char *image) {
+        Importer importer;
+        const aiScene *scene = importer.ReadFile(file, aiProcess_ValidateDataStructure);
+        ASSERT_NE(nullptr, scene);
+
+        Exporter exporter;
+        ASSERT_EQ(aiReturn_SUCCESS, exporter.Export(scene, "assimg", image));
+
+        // mapped from disk
+        Importer reader;
+        const aiScene *newScene = reader.ReadFile(image, aiProcess_ValidateDataStructure);
+        compareScenes(scene, newScene);
+
+        // read from memory through a non-default IOSystem
+        std::ifstream in(image, std::ios::binary);
+        const std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        Importer memReader;
+        newScene = memReader.ReadFileFromMemory(data.data(), data.size(), aiProcess_ValidateDataStructure, "assimg");
+        compareScenes(scene, newScene);
+
+        // returned without copying the image
+        Importer inPlaceReader;
+        inPlaceReader.SetPropertyBool(AI_CONFIG_GLOB_SCENE_IMAGE_IN_PLACE, true);
+        newScene = inPlaceReader.ReadFile(image, aiProcess_ValidateDataStructure);
+        compareScenes(scene, newScene);
+    }
+};
+
+TEST_F(utSceneImageImportExport, roundTripObjTest) {
+    roundTrip(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", ASSIMP_TEST_MODELS_DIR "/OBJ/spider_out.assimg");
+}
+
+TEST_F(utSceneImageImportExport, roundTripSkinnedTest) {
+    roundTrip(ASSIMP_TEST_MODELS_DIR "/X/BCN_Epileptic.X", ASSIMP_TEST_MODELS_DIR "/X/BCN_Epileptic_out.assimg");
+}
+
+TEST_F(utSceneImageImportExport, postProcessCopiesImageTest) {
+    Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/X/BCN_Epileptic.X", 0);
+    ASSERT_NE(nullptr, scene);
+    Exporter exporter;
+    ASSERT_EQ(aiReturn_SUCCESS, exporter.Export(scene, "assimg", ASSIMP_TEST_MODELS_DIR "/X/BCN_Epileptic_out.assimg"));
+
+    Importer reader;
+    const aiScene *newScene = reader.ReadFile(ASSIMP_TEST_MODELS_DIR "/X/BCN_Epileptic_out.assimg",
+            aiProcess_ValidateDataStructure | aiProcess_Triangulate);
+    ASSERT_NE(nullptr, newScene);
+
+    // applying more steps later keeps the scene object
+    EXPECT_EQ(newScene, reader.ApplyPostProcessing(aiProcess_CalcTangentSpace | aiProcess_JoinIdenticalVertices | aiProcess_ValidateDataStructure));
+    for (unsigned int i = 0; i < newScene->mNumMeshes; ++i) {
+        const aiMesh *mesh = newScene->mMeshes[i];
+        EXPECT_NE(nullptr, mesh->mTangents);
+        for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+            const aiNode *node = mesh->mBones[b]->mNode;
+            if (nullptr != node) {
+                EXPECT_EQ(node, newScene->mRootNode->FindNode(node->mName));
+            }
+        }
+    }
+}
+
+TEST_F(utSceneImageImportExport, editCopiedSceneTest) {
+    Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", 0);
+    ASSERT_NE(nullptr, scene);
+    Exporter exporter;
+    const aiExportDataBlob *blob = exporter.ExportToBlob(scene, "assimg");
+    ASSERT_NE(nullptr, blob);
+
+    // the scene owns its sub-objects, so they may be replaced like in any other scene
+    Importer reader;
+    ASSERT_NE(nullptr, reader.ReadFileFromMemory(blob->data, blob->size, 0, "assimg"));
+    aiScene *newScene = reader.GetOrphanedScene();
+    ASSERT_NE(nullptr, newScene);
+    aiMesh *mesh = newScene->mMeshes[0];
+    delete[] mesh->mVertices;
+    mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+    delete newScene->mMaterials[0];
+    newScene->mMaterials[0] = new aiMaterial();
+    delete newScene;
+}
+
+TEST_F(utSceneImageImportExport, rejectCorruptImageTest) {
+    Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", 0);
+    ASSERT_NE(nullptr, scene);
+    Exporter exporter;
+    const aiExportDataBlob *blob = exporter.ExportToBlob(scene, "assimg");
+    ASSERT_NE(nullptr, blob);
+
+    // truncated
+    std::vector<char> data(static_cast<const char *>(blob->data), static_cast<const char *>(blob->data) + blob->size);
+    Importer reader;
+    EXPECT_EQ(nullptr, reader.ReadFileFromMemory(data.data(), data.size() / 2, 0, "assimg"));
+
+    // different layout signature
+    data[16] ^= 1;
+    EXPECT_EQ(nullptr, reader.ReadFileFromMemory(data.data(), data.size(), 0, "assimg"));
+}
+
+TEST_F(utSceneImageImportExport, rejectOutOfBoundsArrayTest) {
+    Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", 0);
+    ASSERT_NE(nullptr, scene);
+    Exporter exporter;
+    const aiExportDataBlob *blob = exporter.ExportToBlob(scene, "assimg");
+    ASSERT_NE(nullptr, blob);
+    const std::vector<char> image(static_cast<const char *>(blob->data), static_cast<const char *>(blob->data) + blob->size);
+
+    // follow the stored offsets from the header to the first mesh
+    const aiScene sceneLayout;
+    const aiMesh meshLayout;
+    const size_t meshesField = reinterpret_cast<const char *>(&sceneLayout.mMeshes) - reinterpret_cast<const char *>(&sceneLayout);
+    const size_t countField = reinterpret_cast<const char *>(&meshLayout.mNumVertices) - reinterpret_cast<const char *>(&meshLayout);
+    uint64_t sceneOffset = 0;
+    uintptr_t meshes = 0, mesh = 0;
+    ::memcpy(&sceneOffset, &image[32], sizeof(sceneOffset));
+    ::memcpy(&meshes, &image[sceneOffset + meshesField], sizeof(meshes));
+    ::memcpy(&mesh, &image[meshes], sizeof(mesh));
+
+    // the stored vertex count no longer matches the arrays, which would
+    // reach far behind the end of the image
+    std::vector<char> data = image;
+    const unsigned int numVertices = 0x10000000;
+    ::memcpy(&data[mesh + countField], &numVertices, sizeof(numVertices));
+    Importer reader;
+    EXPECT_EQ(nullptr, reader.ReadFileFromMemory(data.data(), data.size(), 0, "assimg"));
+
+    // the unmodified image still loads
+    EXPECT_NE(nullptr, reader.ReadFileFromMemory(image.data(), image.size(), 0, "assimg"));
+}
+
+#endif // ASSIMP_BUILD_NO_EXPORT
@@ -47,6 +47,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/mesh.h>
 #include <assimp/material.h>
 
+#include <algorithm>
+#include <array>
+#include <vector>
+
 namespace Assimp {
 
 class TestModelFacttory {
@@ -96,6 +100,45 @@ public:
         return scene;
     }
 
+    // A regular grid of gridSize x gridSize quads in the xy plane, split into
+    // triangles facing +z and drawn in a fixed pseudo-random order
+    static aiScene *createShuffledGridModel(unsigned int gridSize) {
+        const unsigned int row = gridSize + 1;
+        aiMesh *mesh = new aiMesh();
+        mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+        mesh->mNumVertices = row * row;
+        mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+        for (unsigned int y = 0; y < row; ++y) {
+            for (unsigned int x = 0; x < row; ++x) {
+                mesh->mVertices[y * row + x] = aiVector3D(static_cast<ai_real>(x), static_cast<ai_real>(y), 0);
+            }
+        }
+
+        std::vector<std::array<unsigned int, 3>> faces;
+        for (unsigned int y = 0; y < gridSize; ++y) {
+            for (unsigned int x = 0; x < gridSize; ++x) {
+                const unsigned int i = y * row + x;
+                faces.push_back({ { i, i + 1, i + row } });
+                faces.push_back({ { i + 1, i + row + 1, i + row } });
+            }
+        }
+        unsigned int seed = 1;
+        for (size_t i = faces.size() - 1; i > 0; --i) {
+            seed = seed * 1103515245u + 12345u;
+            std::swap(faces[i], faces[(seed >> 8) % (i + 1)]);
+        }
+        mesh->AllocateFaces(static_cast<unsigned int>(faces.size()), 3);
+        for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+            std::copy(faces[f].begin(), faces[f].end(), mesh->mFaces[f].mIndices);
+        }
+
+        aiScene *scene = new aiScene();
+        scene->mNumMeshes = 1;
+        scene->mMeshes = new aiMesh *[1];
+        scene->mMeshes[0] = mesh;
+        return scene;
+    }
+
     static void releaseDefaultTestModel( aiScene **scene ) {
         delete *scene;
         *scene = nullptr;
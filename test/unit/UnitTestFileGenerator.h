@@ -45,6 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <gtest/gtest.h>
 
 #if defined(_MSC_VER)
+#include <direct.h>
 #include <io.h>
 #define TMP_PATH "./"
 inline FILE* MakeTmpFile(char* tmplate)
@@ -59,7 +60,22 @@ inline FILE* MakeTmpFile(char* tmplate)
     EXPECT_NE(fs, nullptr);
     return fs;
 }
+inline char* MakeTmpDirectory(char* tmplate)
+{
+    auto pathtemplate = _mktemp(tmplate);
+    EXPECT_NE(pathtemplate, nullptr);
+    if(pathtemplate == nullptr || _mkdir(pathtemplate) != 0)
+    {
+        return nullptr;
+    }
+    return pathtemplate;
+}
+inline bool RemoveTmpDirectory(const char* path)
+{
+    return _rmdir(path) == 0;
+}
 #elif defined(__GNUC__) || defined(__clang__)
+#include <unistd.h>
 #define TMP_PATH "/tmp/"
 inline FILE* MakeTmpFile(char* tmplate)
 {
@@ -73,4 +89,14 @@ inline FILE* MakeTmpFile(char* tmplate)
     EXPECT_NE(nullptr, fs);
     return fs;
 }
+inline char* MakeTmpDirectory(char* tmplate)
+{
+    auto path = mkdtemp(tmplate);
+    EXPECT_NE(nullptr, path);
+    return path;
+}
+inline bool RemoveTmpDirectory(const char* path)
+{
+    return rmdir(path) == 0;
+}
 #endif
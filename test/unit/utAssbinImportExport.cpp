@@ -40,6 +40,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "AbstractImportExportBase.h"
 #include "UnitTestPCH.h"
+#include "AssetLib/Assbin/AssbinFileWriter.h"
+#include <assimp/DefaultIOSystem.h>
+#include <assimp/MemoryMappedIOSystem.h>
 #include <assimp/postprocess.h>
 #include <assimp/Exporter.hpp>
 #include <assimp/Importer.hpp>
@@ -66,4 +69,35 @@ TEST_F(utAssbinImportExport, import3ExportAssbinDFromFileTest) {
     EXPECT_TRUE(importerTest());
 }
 
+TEST_F(utAssbinImportExport, importCompressedTest) {
+    Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+
+    DefaultIOSystem io;
+    DumpSceneToAssbin(ASSIMP_TEST_MODELS_DIR "/OBJ/spider_compressed_out.assbin", "", &io, scene, false, true);
+
+    // inflate from a plain file stream and from a mapped file
+    for (int mapped = 0; mapped < 2; ++mapped) {
+        Importer reader;
+        if (mapped) {
+            reader.SetIOHandler(new MemoryMappedIOSystem());
+        }
+        const aiScene *newScene = reader.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider_compressed_out.assbin", aiProcess_ValidateDataStructure);
+        ASSERT_NE(nullptr, newScene);
+        ASSERT_EQ(scene->mNumMeshes, newScene->mNumMeshes);
+        for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+            const aiMesh *mesh = scene->mMeshes[i], *newMesh = newScene->mMeshes[i];
+            ASSERT_EQ(mesh->mNumVertices, newMesh->mNumVertices);
+            ASSERT_EQ(mesh->mNumFaces, newMesh->mNumFaces);
+            EXPECT_EQ(0, memcmp(mesh->mVertices, newMesh->mVertices, mesh->mNumVertices * sizeof(aiVector3D)));
+            EXPECT_EQ(0, memcmp(mesh->mNormals, newMesh->mNormals, mesh->mNumVertices * sizeof(aiVector3D)));
+            for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+                ASSERT_EQ(mesh->mFaces[f].mNumIndices, newMesh->mFaces[f].mNumIndices);
+                EXPECT_EQ(0, memcmp(mesh->mFaces[f].mIndices, newMesh->mFaces[f].mIndices, mesh->mFaces[f].mNumIndices * sizeof(unsigned int)));
+            }
+        }
+    }
+}
+
 #endif // #ifndef ASSIMP_BUILD_NO_EXPORT
@@ -0,0 +1,133 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <assimp/BatchImporter.hpp>
+#include <assimp/Exceptional.h>
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+using namespace Assimp;
+
+class utBatchImporter : public ::testing::Test {
+protected:
+    static void compareScenes(const aiScene *expected, const aiScene *scene) {
+        ASSERT_NE(nullptr, scene);
+        ASSERT_EQ(expected->mNumMeshes, scene->mNumMeshes);
+        for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+            const aiMesh *a = expected->mMeshes[i], *b = scene->mMeshes[i];
+            ASSERT_EQ(a->mNumVertices, b->mNumVertices);
+            ASSERT_EQ(a->mNumFaces, b->mNumFaces);
+            EXPECT_EQ(0, memcmp(a->mVertices, b->mVertices, a->mNumVertices * sizeof(aiVector3D)));
+        }
+    }
+};
+
+TEST_F(utBatchImporter, importAllTest) {
+    const char *files[] = {
+        ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj",
+        ASSIMP_TEST_MODELS_DIR "/PLY/cube.ply",
+        ASSIMP_TEST_MODELS_DIR "/X/test.x",
+        ASSIMP_TEST_MODELS_DIR "/STL/Spider_ascii.stl",
+        ASSIMP_TEST_MODELS_DIR "/LWS/move_x.lws"
+    };
+    const unsigned int flags = aiProcess_Triangulate | aiProcess_JoinIdenticalVertices;
+
+    BatchImporter batch(4);
+    std::vector<std::future<aiScene *>> results;
+    for (const char *file : files) {
+        ImportRequest request(file, flags);
+        request.SetPropertyBool(AI_CONFIG_PP_FD_REMOVE, true);
+        results.push_back(batch.AddRequest(request));
+    }
+    std::future<aiScene *> missing = batch.AddRequest(ImportRequest(ASSIMP_TEST_MODELS_DIR "/OBJ/missing.obj"));
+    EXPECT_EQ(6U, batch.GetNumPendingRequests());
+
+    batch.ImportAll();
+    EXPECT_EQ(0U, batch.GetNumPendingRequests());
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        Importer importer;
+        importer.SetPropertyBool(AI_CONFIG_PP_FD_REMOVE, true);
+        const aiScene *expected = importer.ReadFile(files[i], flags);
+        ASSERT_NE(nullptr, expected);
+
+        std::unique_ptr<aiScene> scene(results[i].get());
+        compareScenes(expected, scene.get());
+    }
+    EXPECT_THROW(missing.get(), DeadlyImportError);
+}
+
+TEST_F(utBatchImporter, externalFilesWithThreadsTest) {
+    // the LWS importer loads the referenced objects through a BatchLoader, one after another
+    // as its IOSystem need not be thread-safe, so threads must not change the result
+    const char *objects[] = {
+        ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj",
+        ASSIMP_TEST_MODELS_DIR "/PLY/cube.ply",
+        ASSIMP_TEST_MODELS_DIR "/STL/Spider_ascii.stl",
+        ASSIMP_TEST_MODELS_DIR "/LWS/simple_cube.lwo"
+    };
+    const char *file = "batchImporterTest.lws";
+    {
+        std::ofstream out(file);
+        out << "LWSC\n5\n\n";
+        for (const char *object : objects) {
+            out << "LoadObjectLayer 1 1 " << object << "\n";
+        }
+    }
+
+    Importer serial;
+    const aiScene *expected = serial.ReadFile(file, aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, expected);
+    EXPECT_LT(3U, expected->mNumMeshes);
+
+    Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_GLOB_NUM_THREADS, 4);
+    compareScenes(expected, importer.ReadFile(file, aiProcess_ValidateDataStructure));
+
+    std::remove(file);
+}
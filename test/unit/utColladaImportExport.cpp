@@ -225,6 +225,107 @@ TEST_F(utColladaImportExport, importDaeFromFileTest) {
     EXPECT_TRUE(importerTest());
 }
 
+static const char *PolylistDae =
+        "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+        "<COLLADA xmlns=\"http://www.collada.org/2005/11/COLLADASchema\" version=\"1.4.1\">\n"
+        "<library_geometries><geometry id=\"quad\"><mesh>\n"
+        "<source id=\"pos\"><float_array id=\"pos-array\" count=\"15\">\n"
+        "  0 0 0\n  1 0 0\n  1 1 0\n  0 1 0\n  0.5 2 0\n"
+        "</float_array><technique_common><accessor source=\"#pos-array\" count=\"5\" stride=\"3\">"
+        "<param name=\"X\" type=\"float\"/><param name=\"Y\" type=\"float\"/><param name=\"Z\" type=\"float\"/>"
+        "</accessor></technique_common></source>\n"
+        "<vertices id=\"verts\"><input semantic=\"POSITION\" source=\"#pos\"/></vertices>\n"
+        "<polylist count=\"2\"><input semantic=\"VERTEX\" source=\"#verts\" offset=\"0\"/>\n"
+        "<vcount>\n 4 3 </vcount><p>\n 0 1 2 3\n 3 2 4\n</p></polylist>\n"
+        "</mesh></geometry></library_geometries>\n"
+        "<library_visual_scenes><visual_scene id=\"scene\"><node id=\"node\">"
+        "<instance_geometry url=\"#quad\"/></node></visual_scene></library_visual_scenes>\n"
+        "<scene><instance_visual_scene url=\"#scene\"/></scene>\n"
+        "</COLLADA>\n";
+
+TEST_F(utColladaImportExport, importPolylistFromMemoryTest) {
+    // the number arrays are surrounded by line breaks, as CAD exporters tend to write them
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFileFromMemory(PolylistDae, strlen(PolylistDae), aiProcess_ValidateDataStructure, "dae");
+    ASSERT_NE(nullptr, scene);
+    ASSERT_EQ(1u, scene->mNumMeshes);
+
+    const aiMesh *mesh = scene->mMeshes[0];
+    ASSERT_EQ(2u, mesh->mNumFaces);
+    EXPECT_EQ(4u, mesh->mFaces[0].mNumIndices);
+    EXPECT_EQ(3u, mesh->mFaces[1].mNumIndices);
+    ASSERT_EQ(7u, mesh->mNumVertices);
+    EXPECT_EQ(aiVector3D(1, 1, 0), mesh->mVertices[2]);
+    EXPECT_EQ(aiVector3D(0.5f, 2, 0), mesh->mVertices[6]);
+}
+
+// A strip of numQuads quads, so the number arrays are far longer than the window of the stream reader
+static std::string MakeQuadStripDae(unsigned int numQuads, unsigned int numDeclaredValues) {
+    const unsigned int numVertices = 2 * (numQuads + 1);
+    std::string dae = "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+                      "<COLLADA xmlns=\"http://www.collada.org/2005/11/COLLADASchema\" version=\"1.4.1\">\n"
+                      "<!-- a comment with <p>markup</p> -->\n"
+                      "<library_geometries><geometry id=\"strip\"><mesh>\n"
+                      "<source id=\"pos\"><float_array id=\"pos-array\" count=\"" +
+                      std::to_string(numDeclaredValues) + "\">";
+    for (unsigned int i = 0; i < numVertices; ++i) {
+        dae += std::to_string(i / 2) + ".25 " + std::to_string(i % 2) + " -1\n";
+    }
+    dae += "</float_array><technique_common><accessor source=\"#pos-array\" count=\"" + std::to_string(numVertices) + "\" stride=\"3\">"
+           "<param name=\"X\" type=\"float\"/><param name=\"Y\" type=\"float\"/><param name=\"Z\" type=\"float\"/>"
+           "</accessor></technique_common></source>\n"
+           "<vertices id=\"verts\"><input semantic=\"POSITION\" source=\"#pos\"/></vertices>\n"
+           "<polylist count=\"" + std::to_string(numQuads) + "\"><input semantic=\"VERTEX\" source=\"#verts\" offset=\"0\"/>\n<vcount>";
+    for (unsigned int i = 0; i < numQuads; ++i) {
+        dae += "4 ";
+    }
+    dae += "</vcount>\n<p>";
+    for (unsigned int i = 0; i < numQuads; ++i) {
+        const unsigned int v = 2 * i;
+        dae += std::to_string(v) + " " + std::to_string(v + 2) + " " + std::to_string(v + 3) + " " + std::to_string(v + 1) + "\n";
+    }
+    dae += "</p></polylist>\n"
+           "<extra><technique profile=\"test\"><p>not an index list</p></technique></extra>\n"
+           "</mesh></geometry></library_geometries>\n"
+           "<library_visual_scenes><visual_scene id=\"scene\"><node id=\"node\" name=\"a &amp; &lt;b&gt;\">"
+           "<instance_geometry url=\"#strip\"/></node></visual_scene></library_visual_scenes>\n"
+           "<scene><instance_visual_scene url=\"#scene\"/></scene>\n"
+           "</COLLADA>\n";
+    return dae;
+}
+
+TEST_F(utColladaImportExport, importLargeArraysFromMemoryTest) {
+    const unsigned int numQuads = 20000;
+    const std::string dae = MakeQuadStripDae(numQuads, 6 * (numQuads + 1));
+    ASSERT_LT(512u * 1024u, dae.size());
+
+    // streamed and parsed as a whole
+    for (int threshold : { 0, AI_IMPORT_COLLADA_DEFAULT_STREAMING_THRESHOLD }) {
+        Assimp::Importer importer;
+        importer.SetPropertyInteger(AI_CONFIG_IMPORT_COLLADA_USE_COLLADA_NAMES, 1);
+        importer.SetPropertyInteger(AI_CONFIG_IMPORT_COLLADA_STREAMING_THRESHOLD, threshold);
+        const aiScene *scene = importer.ReadFileFromMemory(dae.data(), dae.size(), aiProcess_ValidateDataStructure, "dae");
+        ASSERT_NE(nullptr, scene);
+        ASSERT_EQ(1u, scene->mNumMeshes);
+        EXPECT_NE(nullptr, scene->mRootNode->FindNode("a & <b>"));
+
+        const aiMesh *mesh = scene->mMeshes[0];
+        ASSERT_EQ(numQuads, mesh->mNumFaces);
+        ASSERT_EQ(4 * numQuads, mesh->mNumVertices);
+        for (unsigned int i = 0; i < numQuads; i += 997) {
+            ASSERT_EQ(4u, mesh->mFaces[i].mNumIndices);
+            EXPECT_EQ(aiVector3D(i + 0.25f, 0, -1), mesh->mVertices[mesh->mFaces[i].mIndices[0]]);
+            EXPECT_EQ(aiVector3D(i + 1.25f, 1, -1), mesh->mVertices[mesh->mFaces[i].mIndices[2]]);
+        }
+
+        // an array which holds fewer values than it announces is still rejected
+        const std::string truncated = MakeQuadStripDae(numQuads, 6 * (numQuads + 1) + 3);
+        Assimp::Importer reader;
+        reader.SetPropertyInteger(AI_CONFIG_IMPORT_COLLADA_STREAMING_THRESHOLD, threshold);
+        EXPECT_EQ(nullptr, reader.ReadFileFromMemory(truncated.data(), truncated.size(), aiProcess_ValidateDataStructure, "dae"));
+    }
+}
+
 unsigned int GetMeshUseCount(const aiNode *rootNode) {
     unsigned int result = rootNode->mNumMeshes;
     for (unsigned int i = 0; i < rootNode->mNumChildren; ++i) {
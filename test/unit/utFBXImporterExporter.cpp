@@ -49,6 +49,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/types.h>
 #include <assimp/Importer.hpp>
 
+#include <fstream>
+#include <iterator>
+#include <string>
+
 using namespace Assimp;
 
 class utFBXImporterExporter : public AbstractImportExportBase {
@@ -423,3 +427,167 @@ TEST_F(utFBXImporterExporter, importMaxPbrMaterialsSpecularGloss) {
     ASSERT_EQ(mat->Get("$raw.3dsMax|main|emit_color", aiTextureType_NONE, 0, emitColor), aiReturn_SUCCESS);
     EXPECT_EQ(emitColor, aiColor4D(1, 0, 1, 1));
 }
+
+TEST_F(utFBXImporterExporter, importBinaryWithThreadsTest) {
+    // spider.fbx stores its geometry in compressed arrays. The serial import inflates
+    // them one by one while parsing, the threaded one ahead of parsing in parallel
+    Assimp::Importer serial;
+    const aiScene *expected = serial.ReadFile(ASSIMP_TEST_MODELS_DIR "/FBX/spider.fbx", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, expected);
+
+    Assimp::Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_GLOB_NUM_THREADS, 4);
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/FBX/spider.fbx", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+
+    ASSERT_EQ(expected->mNumMeshes, scene->mNumMeshes);
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        const aiMesh *a = expected->mMeshes[i], *b = scene->mMeshes[i];
+        ASSERT_EQ(a->mNumVertices, b->mNumVertices);
+        EXPECT_EQ(0, memcmp(a->mVertices, b->mVertices, a->mNumVertices * sizeof(aiVector3D)));
+        ASSERT_EQ(a->HasNormals(), b->HasNormals());
+        if (a->HasNormals()) {
+            EXPECT_EQ(0, memcmp(a->mNormals, b->mNormals, a->mNumVertices * sizeof(aiVector3D)));
+        }
+    }
+}
+
+TEST_F(utFBXImporterExporter, importParallelObjectsTest) {
+    Assimp::Importer serial;
+    const aiScene *expected = serial.ReadFile(ASSIMP_TEST_MODELS_DIR "/FBX/spider.fbx", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, expected);
+
+    Assimp::Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_GLOB_NUM_THREADS, 4);
+    importer.SetPropertyBool(AI_CONFIG_IMPORT_FBX_PARALLEL_OBJECTS, true);
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/FBX/spider.fbx", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+
+    ASSERT_EQ(expected->mNumMeshes, scene->mNumMeshes);
+    ASSERT_EQ(expected->mNumMaterials, scene->mNumMaterials);
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        const aiMesh *a = expected->mMeshes[i], *b = scene->mMeshes[i];
+        EXPECT_STREQ(a->mName.C_Str(), b->mName.C_Str());
+        ASSERT_EQ(a->mNumVertices, b->mNumVertices);
+        EXPECT_EQ(a->mMaterialIndex, b->mMaterialIndex);
+        EXPECT_EQ(0, memcmp(a->mVertices, b->mVertices, a->mNumVertices * sizeof(aiVector3D)));
+    }
+    for (unsigned int i = 0; i < scene->mNumMaterials; ++i) {
+        EXPECT_EQ(expected->mMaterials[i]->mNumProperties, scene->mMaterials[i]->mNumProperties);
+    }
+}
+
+TEST_F(utFBXImporterExporter, importAsciiWithCommentsTest) {
+    Assimp::Importer reference;
+    const aiScene *expected = reference.ReadFile(ASSIMP_TEST_MODELS_DIR "/FBX/cubes_with_names.fbx", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, expected);
+
+    // append a comment full of delimiters and a long token to every line, which
+    // must not change what the tokenizer sees
+    std::ifstream file(ASSIMP_TEST_MODELS_DIR "/FBX/cubes_with_names.fbx", std::ios::binary);
+    const std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::string patched;
+    for (char c : text) {
+        if (c == '\n') {
+            patched += "\t; \"quoted\", {braces}: and_a_rather_long_comment_token_0123456789";
+        }
+        patched += c;
+    }
+
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFileFromMemory(patched.data(), patched.size(), aiProcess_ValidateDataStructure, "fbx");
+    ASSERT_NE(nullptr, scene);
+
+    ASSERT_EQ(expected->mNumMeshes, scene->mNumMeshes);
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        const aiMesh *a = expected->mMeshes[i], *b = scene->mMeshes[i];
+        EXPECT_STREQ(a->mName.C_Str(), b->mName.C_Str());
+        ASSERT_EQ(a->mNumVertices, b->mNumVertices);
+        EXPECT_EQ(0, memcmp(a->mVertices, b->mVertices, a->mNumVertices * sizeof(aiVector3D)));
+    }
+    ASSERT_EQ(expected->mRootNode->mNumChildren, scene->mRootNode->mNumChildren);
+    for (unsigned int i = 0; i < scene->mRootNode->mNumChildren; ++i) {
+        EXPECT_STREQ(expected->mRootNode->mChildren[i]->mName.C_Str(), scene->mRootNode->mChildren[i]->mName.C_Str());
+        EXPECT_EQ(expected->mRootNode->mChildren[i]->mTransformation, scene->mRootNode->mChildren[i]->mTransformation);
+    }
+}
+
+namespace {
+
+// A triangle whose skin references a broken cluster and a second skin which
+// references the first one, so object construction runs into a failure and
+// into a cycle.
+const char CyclicSkinFbx[] =
+        "; FBX 7.4.0 project file\n"
+        "FBXHeaderExtension:  {\n"
+        "\tFBXHeaderVersion: 1003\n"
+        "\tFBXVersion: 7400\n"
+        "}\n"
+        "Objects:  {\n"
+        "\tGeometry: 10, \"Geometry::tri\", \"Mesh\" {\n"
+        "\t\tVertices: *9 {\n"
+        "\t\t\ta: 0,0,0,1,0,0,0,1,0\n"
+        "\t\t}\n"
+        "\t\tPolygonVertexIndex: *3 {\n"
+        "\t\t\ta: 0,1,-3\n"
+        "\t\t}\n"
+        "\t}\n"
+        "\tModel: 20, \"Model::tri\", \"Mesh\" {\n"
+        "\t}\n"
+        "\tMaterial: 30, \"Material::mat\", \"\" {\n"
+        "\t}\n"
+        "\tDeformer: 40, \"Deformer::skin\", \"Skin\" {\n"
+        "\t}\n"
+        "\tDeformer: 41, \"Deformer::loop\", \"Skin\" {\n"
+        "\t}\n"
+        "\tDeformer: 50, \"SubDeformer::bad\", \"Cluster\" {\n"
+        "\t\tIndexes: *1 {\n"
+        "\t\t\ta: 0\n"
+        "\t\t}\n"
+        "\t\tWeights: *2 {\n"
+        "\t\t\ta: 1,1\n"
+        "\t\t}\n"
+        "\t}\n"
+        "}\n"
+        "Connections:  {\n"
+        "\tC: \"OO\",20,0\n"
+        "\tC: \"OO\",10,20\n"
+        "\tC: \"OO\",30,20\n"
+        "\tC: \"OO\",40,10\n"
+        "\tC: \"OO\",41,40\n"
+        "\tC: \"OO\",40,41\n"
+        "\tC: \"OO\",50,40\n"
+        "}\n";
+
+const aiScene *ReadCyclicSkin(Assimp::Importer &importer, bool parallel, bool strict) {
+    importer.SetPropertyInteger(AI_CONFIG_GLOB_NUM_THREADS, parallel ? 4 : 0);
+    importer.SetPropertyBool(AI_CONFIG_IMPORT_FBX_PARALLEL_OBJECTS, parallel);
+    importer.SetPropertyBool(AI_CONFIG_IMPORT_FBX_STRICT_MODE, strict);
+    return importer.ReadFileFromMemory(CyclicSkinFbx, sizeof(CyclicSkinFbx) - 1, aiProcess_ValidateDataStructure, "fbx");
+}
+
+} // namespace
+
+TEST_F(utFBXImporterExporter, importParallelObjectsCycleTest) {
+    Assimp::Importer serial;
+    const aiScene *expected = ReadCyclicSkin(serial, false, false);
+    ASSERT_NE(nullptr, expected);
+    ASSERT_EQ(1u, expected->mNumMeshes);
+
+    // failed objects and cycles are left to the converter, so the result
+    // does not depend on the order the threads build the objects in
+    for (int run = 0; run < 20; ++run) {
+        Assimp::Importer importer;
+        const aiScene *scene = ReadCyclicSkin(importer, true, false);
+        ASSERT_NE(nullptr, scene);
+        ASSERT_EQ(expected->mNumMeshes, scene->mNumMeshes);
+        EXPECT_EQ(expected->mMeshes[0]->mNumVertices, scene->mMeshes[0]->mNumVertices);
+        EXPECT_EQ(expected->mMeshes[0]->mNumBones, scene->mMeshes[0]->mNumBones);
+    }
+
+    // strict mode reports the broken cluster either way
+    Assimp::Importer strictSerial, strictParallel;
+    EXPECT_EQ(nullptr, ReadCyclicSkin(strictSerial, false, true));
+    EXPECT_EQ(nullptr, ReadCyclicSkin(strictParallel, true, true));
+    EXPECT_EQ(std::string(strictSerial.GetErrorString()), std::string(strictParallel.GetErrorString()));
+}
@@ -0,0 +1,162 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <assimp/mesh.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/Importer.hpp>
+
+#include <algorithm>
+#include <new>
+#include <vector>
+
+using namespace Assimp;
+
+class utFaceIndexPool : public ::testing::Test {
+    // empty
+};
+
+TEST_F(utFaceIndexPool, allocateFacesTest) {
+    aiMesh mesh;
+    const unsigned int numIndices[] = { 3, 4, 2 };
+    mesh.AllocateFaces(3, numIndices);
+    ASSERT_NE(nullptr, mesh.mFaceIndices);
+    EXPECT_EQ(9U, mesh.mNumFaceIndices);
+    EXPECT_EQ(mesh.mFaceIndices + 3, mesh.mFaces[1].mIndices);
+    EXPECT_EQ(mesh.mFaceIndices + 7, mesh.mFaces[2].mIndices);
+    EXPECT_TRUE(mesh.IsPooledFace(mesh.mFaces[2]));
+    EXPECT_EQ(mesh.mFaceIndices, mesh.GetIndexBuffer());
+
+    // sizes which do not fit into the pool are rejected, the mesh is kept as it is
+    EXPECT_THROW(mesh.AllocateFaces(0x10000, 0x10000), std::bad_array_new_length);
+    const unsigned int tooMany[] = { 0x80000000, 0x80000000 };
+    EXPECT_THROW(mesh.AllocateFaces(2, tooMany), std::bad_array_new_length);
+    EXPECT_EQ(3U, mesh.mNumFaces);
+    EXPECT_EQ(9U, mesh.mNumFaceIndices);
+}
+
+TEST_F(utFaceIndexPool, ownedFacesTest) {
+    // faces which own their indices are moved into a pool
+    aiMesh mesh;
+    mesh.mNumFaces = 2;
+    mesh.mFaces = new aiFace[2];
+    for (unsigned int i = 0; i < 2; ++i) {
+        mesh.mFaces[i].mNumIndices = 3;
+        mesh.mFaces[i].mIndices = new unsigned int[3];
+        for (unsigned int a = 0; a < 3; ++a) {
+            mesh.mFaces[i].mIndices[a] = i * 3 + a;
+        }
+    }
+    const unsigned int *indices = mesh.GetIndexBuffer();
+    ASSERT_NE(nullptr, indices);
+    EXPECT_EQ(6U, mesh.mNumFaceIndices);
+    for (unsigned int i = 0; i < 6; ++i) {
+        EXPECT_EQ(i, indices[i]);
+    }
+}
+
+TEST_F(utFaceIndexPool, mixedOwnershipTest) {
+    aiMesh mesh;
+    mesh.AllocateFaces(3, 3);
+    for (unsigned int i = 0; i < 9; ++i) {
+        mesh.mFaceIndices[i] = i;
+    }
+
+    // a copy of a pooled face owns its indices
+    aiFace copy = mesh.mFaces[0];
+    EXPECT_FALSE(mesh.IsPooledFace(copy));
+    EXPECT_NE(mesh.mFaces[0].mIndices, copy.mIndices);
+    EXPECT_EQ(mesh.mFaces[0], copy);
+
+    // a pooled face is detached from the pool before it is assigned to
+    aiFace quad;
+    quad.mNumIndices = 4;
+    quad.mIndices = new unsigned int[4]{ 9, 10, 11, 12 };
+    mesh.mFaces[1].mIndices = nullptr;
+    mesh.mFaces[1] = quad;
+    EXPECT_FALSE(mesh.IsPooledFace(mesh.mFaces[1]));
+    EXPECT_EQ(3U, mesh.mFaceIndices[3]);
+
+    // packing moves the owned indices into a new pool
+    const unsigned int *indices = mesh.GetIndexBuffer();
+    ASSERT_EQ(10U, mesh.mNumFaceIndices);
+    const unsigned int expected[] = { 0, 1, 2, 9, 10, 11, 12, 6, 7, 8 };
+    EXPECT_TRUE(std::equal(expected, expected + 10, indices));
+    for (unsigned int i = 0; i < 3; ++i) {
+        EXPECT_TRUE(mesh.IsPooledFace(mesh.mFaces[i]));
+    }
+    EXPECT_EQ(indices, mesh.GetIndexBuffer());
+}
+
+TEST_F(utFaceIndexPool, postProcessingTest) {
+    // post-processing keeps the pools and gives the same result
+    const unsigned int flags = aiProcess_Triangulate | aiProcess_JoinIdenticalVertices | aiProcess_SortByPType |
+            aiProcess_SplitLargeMeshes | aiProcess_PreTransformVertices | aiProcess_ValidateDataStructure;
+    const char *files[] = { ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", ASSIMP_TEST_MODELS_DIR "/STL/Spider_binary.stl" };
+    Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_GLOB_FACE_INDEX_POOL, true);
+    for (const char *file : files) {
+        Importer plain;
+        const aiScene *expected = plain.ReadFile(file, flags);
+        ASSERT_NE(nullptr, expected);
+        const aiScene *scene = importer.ReadFile(file, flags);
+        ASSERT_NE(nullptr, scene);
+
+        ASSERT_EQ(expected->mNumMeshes, scene->mNumMeshes);
+        for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+            const aiMesh *a = expected->mMeshes[i];
+            aiMesh *b = scene->mMeshes[i];
+            EXPECT_EQ(nullptr, a->mFaceIndices);
+            ASSERT_NE(nullptr, b->mFaceIndices);
+            ASSERT_EQ(a->mNumFaces, b->mNumFaces);
+
+            std::vector<unsigned int> flat;
+            for (unsigned int f = 0; f < a->mNumFaces; ++f) {
+                EXPECT_EQ(a->mFaces[f], b->mFaces[f]);
+                flat.insert(flat.end(), a->mFaces[f].mIndices, a->mFaces[f].mIndices + a->mFaces[f].mNumIndices);
+            }
+            const unsigned int *buffer = b->GetIndexBuffer();
+            ASSERT_EQ(flat.size(), b->mNumFaceIndices);
+            EXPECT_TRUE(std::equal(flat.begin(), flat.end(), buffer));
+        }
+    }
+}
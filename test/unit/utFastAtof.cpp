@@ -188,3 +188,19 @@ TEST_F(FastAtofTest, FastAtof)
 {
     RunTest<ai_real>(FastAtofWrapper());
 }
+
+TEST_F(FastAtofTest, FastAtorealArray)
+{
+    const char *text = "\n  1.5 -2\t3e2\r\n 4 ";
+    const char *c = text;
+    float values[4] = {};
+    EXPECT_EQ(3u, Assimp::fast_atoreal_array<float>(c, values, 3));
+    EXPECT_EQ(1.5f, values[0]);
+    EXPECT_EQ(-2.f, values[1]);
+    EXPECT_EQ(300.f, values[2]);
+
+    // reading past the last value stops at the terminator
+    EXPECT_EQ(1u, Assimp::fast_atoreal_array<float>(c, values, 4));
+    EXPECT_EQ(4.f, values[0]);
+    EXPECT_EQ('\0', *c);
+}
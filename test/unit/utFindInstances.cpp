@@ -0,0 +1,139 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "PostProcessing/FindInstancesProcess.h"
+#include <assimp/commonMetaData.h>
+#include <assimp/scene.h>
+
+using namespace Assimp;
+
+class utFindInstancesProcess : public ::testing::Test {
+protected:
+    // A scene with one node referencing all meshes, each a single triangle
+    aiScene *CreateScene(const std::vector<aiVector3D> &offsets) {
+        aiScene *scene = new aiScene();
+        scene->mNumMeshes = static_cast<unsigned int>(offsets.size());
+        scene->mMeshes = new aiMesh *[scene->mNumMeshes];
+        scene->mRootNode = new aiNode();
+        scene->mRootNode->mNumMeshes = scene->mNumMeshes;
+        scene->mRootNode->mMeshes = new unsigned int[scene->mNumMeshes];
+
+        for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+            aiMesh *mesh = new aiMesh();
+            mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+            mesh->mNumVertices = 3;
+            mesh->mVertices = new aiVector3D[3];
+            mesh->mVertices[0] = offsets[i];
+            mesh->mVertices[1] = offsets[i] + aiVector3D(1.f, 0.f, 0.f);
+            mesh->mVertices[2] = offsets[i] + aiVector3D(0.f, 1.f, 0.f);
+            mesh->mNumFaces = 1;
+            mesh->mFaces = new aiFace[1];
+            mesh->mFaces[0].mNumIndices = 3;
+            mesh->mFaces[0].mIndices = new unsigned int[3];
+            for (unsigned int a = 0; a < 3; ++a) {
+                mesh->mFaces[0].mIndices[a] = a;
+            }
+            scene->mMeshes[i] = mesh;
+            scene->mRootNode->mMeshes[i] = i;
+        }
+        return scene;
+    }
+
+    uint64_t GetCollapsedInstances(const aiScene *scene) {
+        uint64_t collapsed = 0;
+        if (nullptr != scene->mMetaData) {
+            scene->mMetaData->Get(AI_METADATA_COLLAPSED_INSTANCES, collapsed);
+        }
+        return collapsed;
+    }
+
+    FindInstancesProcess mProcess;
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utFindInstancesProcess, collapseInstancesTest) {
+    std::vector<aiVector3D> offsets;
+    for (unsigned int i = 0; i < 5; ++i) {
+        offsets.push_back(aiVector3D(i * 10.f, 0.f, 0.f));
+    }
+    offsets.push_back(offsets[2]);
+    // within the epsilon
+    offsets.push_back(offsets[0] + aiVector3D(1e-6f, 0.f, 0.f));
+    // too far off
+    offsets.push_back(offsets[4] + aiVector3D(0.01f, 0.f, 0.f));
+
+    std::unique_ptr<aiScene> scene(CreateScene(offsets));
+    mProcess.Execute(scene.get());
+
+    ASSERT_EQ(6u, scene->mNumMeshes);
+    const unsigned int expected[] = { 0, 1, 2, 3, 4, 2, 0, 5 };
+    for (unsigned int i = 0; i < 8; ++i) {
+        EXPECT_EQ(expected[i], scene->mRootNode->mMeshes[i]);
+    }
+    EXPECT_EQ(2u, GetCollapsedInstances(scene.get()));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utFindInstancesProcess, manyMeshesTest) {
+    std::vector<aiVector3D> offsets;
+    for (unsigned int i = 0; i < 20000; ++i) {
+        offsets.push_back(aiVector3D((i % 100) * 2.f, 0.f, 0.f));
+    }
+
+    std::unique_ptr<aiScene> scene(CreateScene(offsets));
+    mProcess.Execute(scene.get());
+
+    ASSERT_EQ(100u, scene->mNumMeshes);
+    for (unsigned int i = 0; i < 20000; ++i) {
+        EXPECT_EQ(i % 100, scene->mRootNode->mMeshes[i]);
+    }
+    EXPECT_EQ(19900u, GetCollapsedInstances(scene.get()));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utFindInstancesProcess, noInstancesTest) {
+    std::unique_ptr<aiScene> scene(CreateScene({ aiVector3D(0.f), aiVector3D(5.f) }));
+    mProcess.Execute(scene.get());
+
+    EXPECT_EQ(2u, scene->mNumMeshes);
+    EXPECT_EQ(0u, GetCollapsedInstances(scene.get()));
+}
@@ -0,0 +1,289 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+#include "UnitTestPCH.h"
+
+#include "PostProcessing/GenMeshletsProcess.h"
+#include <assimp/Exporter.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/SceneCombiner.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+using namespace Assimp;
+
+class utGenMeshletsProcess : public ::testing::Test {
+protected:
+    static const unsigned int GridSize = 30;
+
+    // A regular grid of triangles in the xy plane, facing +z, drawn in random order
+    aiScene *CreateScene() {
+        const unsigned int row = GridSize + 1;
+        aiMesh *mesh = new aiMesh();
+        mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+        mesh->mNumVertices = row * row;
+        mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+        for (unsigned int y = 0; y < row; ++y) {
+            for (unsigned int x = 0; x < row; ++x) {
+                mesh->mVertices[y * row + x] = aiVector3D(static_cast<ai_real>(x), static_cast<ai_real>(y), 0);
+            }
+        }
+
+        std::vector<std::array<unsigned int, 3>> faces;
+        for (unsigned int y = 0; y < GridSize; ++y) {
+            for (unsigned int x = 0; x < GridSize; ++x) {
+                const unsigned int i = y * row + x;
+                faces.push_back({ { i, i + 1, i + row } });
+                faces.push_back({ { i + 1, i + row + 1, i + row } });
+            }
+        }
+        unsigned int seed = 1;
+        for (size_t i = faces.size() - 1; i > 0; --i) {
+            seed = seed * 1103515245u + 12345u;
+            std::swap(faces[i], faces[(seed >> 8) % (i + 1)]);
+        }
+        mesh->AllocateFaces(static_cast<unsigned int>(faces.size()), 3);
+        for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+            std::copy(faces[f].begin(), faces[f].end(), mesh->mFaces[f].mIndices);
+        }
+
+        aiScene *scene = new aiScene();
+        scene->mNumMeshes = 1;
+        scene->mMeshes = new aiMesh *[1];
+        scene->mMeshes[0] = mesh;
+        return scene;
+    }
+
+    std::vector<std::array<unsigned int, 3>> GetFaces(const aiMesh *mesh) {
+        std::vector<std::array<unsigned int, 3>> out;
+        for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+            const unsigned int *idx = mesh->mFaces[f].mIndices;
+            out.push_back({ { idx[0], idx[1], idx[2] } });
+        }
+        std::sort(out.begin(), out.end());
+        return out;
+    }
+
+    void Generate(aiScene *scene, int maxVertices, int maxTriangles) {
+        Importer importer;
+        importer.SetPropertyInteger(AI_CONFIG_PP_GM_MAX_VERTICES, maxVertices);
+        importer.SetPropertyInteger(AI_CONFIG_PP_GM_MAX_TRIANGLES, maxTriangles);
+        GenMeshletsProcess process;
+        process.SetupProperties(&importer);
+        process.Execute(scene);
+    }
+
+    // The meshlets cover the faces in order, stay in their limits and
+    // reproduce the faces from their local indices
+    void CheckMeshlets(const aiMesh *mesh, unsigned int maxVertices, unsigned int maxTriangles) {
+        ASSERT_LT(0u, mesh->mNumMeshlets);
+        ASSERT_NE(nullptr, mesh->mMeshlets);
+        ASSERT_NE(nullptr, mesh->mMeshletVertices);
+        ASSERT_NE(nullptr, mesh->mMeshletTriangles);
+
+        unsigned int numFaces = 0, numVertices = 0;
+        for (unsigned int m = 0; m < mesh->mNumMeshlets; ++m) {
+            const aiMeshlet &meshlet = mesh->mMeshlets[m];
+            EXPECT_EQ(numFaces, meshlet.mFaceOffset);
+            EXPECT_EQ(numVertices, meshlet.mVertexOffset);
+            EXPECT_LT(0u, meshlet.mNumFaces);
+            EXPECT_GE(maxTriangles, meshlet.mNumFaces);
+            EXPECT_GE(maxVertices, meshlet.mNumVertices);
+            numFaces += meshlet.mNumFaces;
+            numVertices += meshlet.mNumVertices;
+            ASSERT_GE(mesh->mNumFaces, numFaces);
+            ASSERT_GE(mesh->mNumMeshletVertices, numVertices);
+
+            const unsigned int *vertices = mesh->mMeshletVertices + meshlet.mVertexOffset;
+            for (unsigned int f = meshlet.mFaceOffset; f < numFaces; ++f) {
+                for (unsigned int i = 0; i < 3; ++i) {
+                    const unsigned char local = mesh->mMeshletTriangles[f * 3 + i];
+                    ASSERT_LT(local, meshlet.mNumVertices);
+                    EXPECT_EQ(mesh->mFaces[f].mIndices[i], vertices[local]);
+                }
+            }
+            for (unsigned int v = 0; v < meshlet.mNumVertices; ++v) {
+                ASSERT_LT(vertices[v], mesh->mNumVertices);
+                const ai_real dist = (mesh->mVertices[vertices[v]] - meshlet.mCenter).Length();
+                EXPECT_LE(dist, meshlet.mRadius * static_cast<ai_real>(1.0001));
+            }
+        }
+        EXPECT_EQ(mesh->mNumFaces, numFaces);
+        EXPECT_EQ(mesh->mNumFaces, mesh->mNumMeshletTriangles);
+        EXPECT_EQ(mesh->mNumMeshletVertices, numVertices);
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utGenMeshletsProcess, gridTest) {
+    std::unique_ptr<aiScene> scene(CreateScene());
+    const std::vector<std::array<unsigned int, 3>> expected = GetFaces(scene->mMeshes[0]);
+
+    Generate(scene.get(), PP_GM_MAX_VERTICES, PP_GM_MAX_TRIANGLES);
+    const aiMesh *mesh = scene->mMeshes[0];
+    EXPECT_TRUE(expected == GetFaces(mesh));
+    CheckMeshlets(mesh, PP_GM_MAX_VERTICES, PP_GM_MAX_TRIANGLES);
+
+    // grown along the adjacency, the meshlets share few vertices
+    EXPECT_GT(mesh->mNumMeshletVertices, mesh->mNumVertices);
+    EXPECT_LT(mesh->mNumMeshletVertices, mesh->mNumVertices * 2);
+
+    // a flat grid can be culled from behind
+    for (unsigned int m = 0; m < mesh->mNumMeshlets; ++m) {
+        const aiMeshlet &meshlet = mesh->mMeshlets[m];
+        EXPECT_NEAR(1.0, meshlet.mConeAxis.z, 1e-5);
+        EXPECT_NEAR(0.0, meshlet.mConeCutoff, 1e-3);
+        EXPECT_NEAR(0.0, meshlet.mConeApex.z, 1e-5);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utGenMeshletsProcess, limitsTest) {
+    std::unique_ptr<aiScene> scene(CreateScene());
+    Generate(scene.get(), 8, 6);
+    CheckMeshlets(scene->mMeshes[0], 8, 6);
+
+    // the vertex indices of a meshlet must fit into a byte
+    scene.reset(CreateScene());
+    Generate(scene.get(), 1000, 1000);
+    CheckMeshlets(scene->mMeshes[0], 256, 512);
+
+    // running the step again replaces the meshlets
+    Generate(scene.get(), 3, 1);
+    EXPECT_EQ(scene->mMeshes[0]->mNumFaces, scene->mMeshes[0]->mNumMeshlets);
+    CheckMeshlets(scene->mMeshes[0], 3, 1);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utGenMeshletsProcess, skipPolygonsTest) {
+    std::unique_ptr<aiScene> scene(CreateScene());
+    aiMesh *mesh = scene->mMeshes[0];
+    mesh->ReleaseFaces();
+    mesh->mPrimitiveTypes = aiPrimitiveType_POLYGON;
+    mesh->AllocateFaces(1, 4);
+    for (unsigned int i = 0; i < 4; ++i) {
+        mesh->mFaces[0].mIndices[i] = i;
+    }
+
+    Generate(scene.get(), PP_GM_MAX_VERTICES, PP_GM_MAX_TRIANGLES);
+    EXPECT_EQ(0u, mesh->mNumMeshlets);
+    EXPECT_EQ(nullptr, mesh->mMeshlets);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utGenMeshletsProcess, importTest) {
+    Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_PP_GENERATE_MESHLETS, true);
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_Triangulate | aiProcess_SortByPType);
+    ASSERT_NE(nullptr, scene);
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        CheckMeshlets(scene->mMeshes[i], PP_GM_MAX_VERTICES, PP_GM_MAX_TRIANGLES);
+    }
+    EXPECT_NE(nullptr, importer.ApplyPostProcessing(aiProcess_ValidateDataStructure));
+
+    // copies take the meshlets along
+    aiScene *copy = nullptr;
+    SceneCombiner::CopyScene(&copy, scene);
+    ASSERT_NE(nullptr, copy);
+    for (unsigned int i = 0; i < copy->mNumMeshes; ++i) {
+        const aiMesh *src = scene->mMeshes[i], *dst = copy->mMeshes[i];
+        ASSERT_EQ(src->mNumMeshlets, dst->mNumMeshlets);
+        EXPECT_NE(src->mMeshlets, dst->mMeshlets);
+        EXPECT_TRUE(std::equal(src->mMeshletTriangles, src->mMeshletTriangles + src->mNumMeshletTriangles * 3, dst->mMeshletTriangles));
+        CheckMeshlets(dst, PP_GM_MAX_VERTICES, PP_GM_MAX_TRIANGLES);
+    }
+    delete copy;
+
+#ifndef ASSIMP_BUILD_NO_EXPORT
+    // the meshlets are part of the scene image
+    Exporter exporter;
+    const aiExportDataBlob *blob = exporter.ExportToBlob(scene, "assimg");
+    ASSERT_NE(nullptr, blob);
+    Importer image;
+    const aiScene *stored = image.ReadFileFromMemory(blob->data, blob->size, 0, "assimg");
+    ASSERT_NE(nullptr, stored);
+    ASSERT_EQ(scene->mNumMeshes, stored->mNumMeshes);
+    for (unsigned int i = 0; i < stored->mNumMeshes; ++i) {
+        ASSERT_EQ(scene->mMeshes[i]->mNumMeshlets, stored->mMeshes[i]->mNumMeshlets);
+        CheckMeshlets(stored->mMeshes[i], PP_GM_MAX_VERTICES, PP_GM_MAX_TRIANGLES);
+    }
+#endif // ASSIMP_BUILD_NO_EXPORT
+
+    // the step has no flag of its own
+    Importer disabled;
+    scene = disabled.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_Triangulate);
+    ASSERT_NE(nullptr, scene);
+    EXPECT_EQ(0u, scene->mMeshes[0]->mNumMeshlets);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utGenMeshletsProcess, laterStepsTest) {
+    Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_PP_GENERATE_MESHLETS, true);
+    ASSERT_NE(nullptr, importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_Triangulate | aiProcess_SortByPType));
+
+    // steps which run later and rewrite the faces drop the meshlets
+    importer.SetPropertyBool(AI_CONFIG_PP_GENERATE_MESHLETS, false);
+    ASSERT_NE(nullptr, importer.ApplyPostProcessing(aiProcess_FlipWindingOrder));
+    const aiScene *scene = importer.ApplyPostProcessing(aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+    EXPECT_EQ(0u, scene->mMeshes[0]->mNumMeshlets);
+    EXPECT_EQ(nullptr, scene->mMeshes[0]->mMeshlets);
+
+    // running the step with the flip regenerates them for the new winding
+    importer.SetPropertyBool(AI_CONFIG_PP_GENERATE_MESHLETS, true);
+    scene = importer.ApplyPostProcessing(aiProcess_FlipWindingOrder);
+    ASSERT_NE(nullptr, scene);
+    CheckMeshlets(scene->mMeshes[0], PP_GM_MAX_VERTICES, PP_GM_MAX_TRIANGLES);
+
+    // the property alone runs the step
+    static const char triangle[] = "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n";
+    Importer plain;
+    plain.SetPropertyBool(AI_CONFIG_PP_GENERATE_MESHLETS, true);
+    scene = plain.ReadFileFromMemory(triangle, sizeof(triangle) - 1, 0, "obj");
+    ASSERT_NE(nullptr, scene);
+    EXPECT_EQ(1u, scene->mMeshes[0]->mNumMeshlets);
+}
@@ -46,6 +46,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/BaseImporter.h>
 #include <assimp/DefaultIOSystem.h>
 #include <assimp/Importer.hpp>
+#include <assimp/SceneCombiner.h>
+#include "Common/ImportCache.h"
+#include "UnitTestFileGenerator.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <vector>
 
 using namespace ::std;
 using namespace ::Assimp;
@@ -275,6 +283,183 @@ TEST_F(ImporterTest, testMultipleReads) {
     //EXPECT_TRUE(pImp->ReadFile(ASSIMP_TEST_MODELS_DIR "/X/dwarf.x",flags)); # is in nonbsd
 }
 
+TEST_F(ImporterTest, multithreadedPostProcessingTest) {
+    const unsigned int flags = aiProcess_Triangulate |
+            aiProcess_JoinIdenticalVertices |
+            aiProcess_GenSmoothNormals |
+            aiProcess_CalcTangentSpace |
+            aiProcess_ImproveCacheLocality;
+
+    Importer serial;
+    const aiScene *expected = serial.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", flags);
+    ASSERT_NE(nullptr, expected);
+
+    pImp->SetPropertyInteger(AI_CONFIG_GLOB_NUM_THREADS, 4);
+    const aiScene *scene = pImp->ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", flags);
+    ASSERT_NE(nullptr, scene);
+    ASSERT_EQ(expected->mNumMeshes, scene->mNumMeshes);
+    EXPECT_LT(1u, scene->mNumMeshes);
+
+    // the output must be bit-identical to the serial run
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        const aiMesh *a = expected->mMeshes[i], *b = scene->mMeshes[i];
+        ASSERT_EQ(a->mNumVertices, b->mNumVertices);
+        ASSERT_EQ(a->mNumFaces, b->mNumFaces);
+        EXPECT_EQ(0, memcmp(a->mVertices, b->mVertices, a->mNumVertices * sizeof(aiVector3D)));
+        EXPECT_EQ(0, memcmp(a->mNormals, b->mNormals, a->mNumVertices * sizeof(aiVector3D)));
+        if (a->mTangents) {
+            ASSERT_NE(nullptr, b->mTangents);
+            EXPECT_EQ(0, memcmp(a->mTangents, b->mTangents, a->mNumVertices * sizeof(aiVector3D)));
+        }
+        for (unsigned int f = 0; f < a->mNumFaces; ++f) {
+            ASSERT_EQ(a->mFaces[f].mNumIndices, b->mFaces[f].mNumIndices);
+            EXPECT_EQ(0, memcmp(a->mFaces[f].mIndices, b->mFaces[f].mIndices, a->mFaces[f].mNumIndices * sizeof(unsigned int)));
+        }
+    }
+}
+
+#ifndef ASSIMP_BUILD_NO_EXPORT
+namespace {
+
+// Get the scene image a cache entry currently names
+std::string GetImportCacheImage(const std::string &cacheKey) {
+    std::ifstream deps(cacheKey + ".deps");
+    std::string image;
+    std::getline(deps, image);
+    EXPECT_FALSE(image.empty());
+    return cacheKey.substr(0, cacheKey.find_last_of('/') + 1) + image;
+}
+
+// Get the files a cache entry depends on
+std::vector<std::string> GetImportCacheDependencies(const std::string &cacheKey) {
+    std::ifstream deps(cacheKey + ".deps");
+    std::vector<std::string> files;
+    std::string line;
+    std::getline(deps, line);
+    while (std::getline(deps, line)) {
+        files.push_back(line.substr(17));
+    }
+    return files;
+}
+
+// Remove the files of an import cache entry
+void RemoveImportCacheEntry(const std::string &cacheKey) {
+    EXPECT_EQ(0, std::remove(GetImportCacheImage(cacheKey).c_str()));
+    EXPECT_EQ(0, std::remove((cacheKey + ".deps").c_str()));
+}
+
+// Write a one-triangle OBJ file with a material of the given diffuse color
+void WriteColoredTriangle(const std::string &dir, const char *diffuse) {
+    std::ofstream obj(dir + "/triangle.obj");
+    obj << "mtllib triangle.mtl\nv 0 0 0\nv 1 0 0\nv 0 1 0\nusemtl color\nf 1 2 3\n";
+    std::ofstream mtl(dir + "/triangle.mtl");
+    mtl << "newmtl color\nKd " << diffuse << "\n";
+}
+
+aiColor3D GetDiffuse(const aiScene *scene) {
+    aiColor3D color;
+    EXPECT_EQ(1U, scene->mNumMeshes);
+    scene->mMaterials[scene->mMeshes[0]->mMaterialIndex]->Get(AI_MATKEY_COLOR_DIFFUSE, color);
+    return color;
+}
+
+} // namespace
+
+TEST_F(ImporterTest, importCacheTest) {
+    const unsigned int flags = aiProcess_Triangulate | aiProcess_JoinIdenticalVertices | aiProcess_GenSmoothNormals;
+    const char *file = ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj";
+
+    Importer serial;
+    const aiScene *expected = serial.ReadFile(file, flags);
+    ASSERT_NE(nullptr, expected);
+
+    char tmpl[] = TMP_PATH "cacheXXXXXX";
+    const char *cacheDir = MakeTmpDirectory(tmpl);
+    ASSERT_NE(nullptr, cacheDir);
+
+    pImp->SetPropertyString(AI_CONFIG_GLOB_IMPORT_CACHE_DIR, cacheDir);
+    const std::string cacheKey = GetImportCacheKey(pImp->Pimpl(), cacheDir, file, flags);
+    ASSERT_FALSE(cacheKey.empty());
+
+    ASSERT_NE(nullptr, pImp->ReadFile(file, flags));
+    EXPECT_EQ(0U, pImp->GetImportCacheHits());
+    EXPECT_EQ(1U, pImp->GetImportCacheMisses());
+
+    // settings which don't change the result share the entry
+    pImp->SetPropertyInteger(AI_CONFIG_GLOB_NUM_THREADS, 4);
+    EXPECT_EQ(cacheKey, GetImportCacheKey(pImp->Pimpl(), cacheDir, file, flags));
+    pImp->SetPropertyBool(AI_CONFIG_GLOB_SCENE_IMAGE_IN_PLACE, true);
+    EXPECT_EQ(cacheKey, GetImportCacheKey(pImp->Pimpl(), cacheDir, file, flags));
+    pImp->SetPropertyBool(AI_CONFIG_GLOB_SCENE_IMAGE_IN_PLACE, false);
+
+    const aiScene *scene = pImp->ReadFile(file, flags);
+    ASSERT_NE(nullptr, scene);
+    EXPECT_EQ(1U, pImp->GetImportCacheHits());
+    EXPECT_EQ(1U, pImp->GetImportCacheMisses());
+    ASSERT_EQ(expected->mNumMeshes, scene->mNumMeshes);
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        const aiMesh *a = expected->mMeshes[i], *b = scene->mMeshes[i];
+        ASSERT_EQ(a->mNumVertices, b->mNumVertices);
+        ASSERT_EQ(a->mNumFaces, b->mNumFaces);
+        EXPECT_EQ(0, memcmp(a->mVertices, b->mVertices, a->mNumVertices * sizeof(aiVector3D)));
+        EXPECT_EQ(0, memcmp(a->mNormals, b->mNormals, a->mNumVertices * sizeof(aiVector3D)));
+    }
+
+    // an entry which does not validate is replaced by a new import
+    aiScene *invalid = nullptr;
+    SceneCombiner::CopyScene(&invalid, scene);
+    invalid->mMeshes[0]->mFaces[0].mIndices[0] = invalid->mMeshes[0]->mNumVertices;
+    const std::string validImage = GetImportCacheImage(cacheKey);
+    DefaultIOSystem io;
+    WriteImportCache(&io, cacheKey, GetImportCacheDependencies(cacheKey), invalid);
+    delete invalid;
+    ASSERT_NE(nullptr, scene = pImp->ReadFile(file, flags));
+    EXPECT_EQ(1U, pImp->GetImportCacheHits());
+    EXPECT_EQ(2U, pImp->GetImportCacheMisses());
+    EXPECT_EQ(expected->mMeshes[0]->mFaces[0].mIndices[0], scene->mMeshes[0]->mFaces[0].mIndices[0]);
+    EXPECT_EQ(validImage, GetImportCacheImage(cacheKey));
+    ASSERT_NE(nullptr, scene = pImp->ReadFile(file, flags));
+    EXPECT_EQ(2U, pImp->GetImportCacheHits());
+
+    // other flags or properties need another entry
+    EXPECT_NE(cacheKey, GetImportCacheKey(pImp->Pimpl(), cacheDir, file, flags | aiProcess_FlipUVs));
+    pImp->SetPropertyFloat(AI_CONFIG_PP_GSN_MAX_SMOOTHING_ANGLE, 30.f);
+    EXPECT_NE(cacheKey, GetImportCacheKey(pImp->Pimpl(), cacheDir, file, flags));
+    RemoveImportCacheEntry(cacheKey);
+
+    // a change of a file opened by the import invalidates the entry
+    WriteColoredTriangle(cacheDir, "1 0 0");
+    const std::string model = std::string(cacheDir) + "/triangle.obj";
+    const std::string modelKey = GetImportCacheKey(pImp->Pimpl(), cacheDir, model, flags);
+    ASSERT_NE(nullptr, scene = pImp->ReadFile(model, flags));
+    EXPECT_EQ(aiColor3D(1, 0, 0), GetDiffuse(scene));
+    ASSERT_NE(nullptr, scene = pImp->ReadFile(model, flags));
+    EXPECT_EQ(aiColor3D(1, 0, 0), GetDiffuse(scene));
+    EXPECT_EQ(3U, pImp->GetImportCacheHits());
+    EXPECT_EQ(3U, pImp->GetImportCacheMisses());
+    const std::string firstImage = GetImportCacheImage(modelKey);
+
+    WriteColoredTriangle(cacheDir, "0 0 1");
+    EXPECT_EQ(modelKey, GetImportCacheKey(pImp->Pimpl(), cacheDir, model, flags));
+    ASSERT_NE(nullptr, scene = pImp->ReadFile(model, flags));
+    EXPECT_EQ(aiColor3D(0, 0, 1), GetDiffuse(scene));
+    EXPECT_EQ(3U, pImp->GetImportCacheHits());
+    EXPECT_EQ(4U, pImp->GetImportCacheMisses());
+    ASSERT_NE(nullptr, scene = pImp->ReadFile(model, flags));
+    EXPECT_EQ(aiColor3D(0, 0, 1), GetDiffuse(scene));
+    EXPECT_EQ(4U, pImp->GetImportCacheHits());
+    pImp->FreeScene();
+
+    // the image made with the first material is left over
+    EXPECT_NE(firstImage, GetImportCacheImage(modelKey));
+    EXPECT_EQ(0, std::remove(firstImage.c_str()));
+    RemoveImportCacheEntry(modelKey);
+    EXPECT_EQ(0, std::remove(model.c_str()));
+    EXPECT_EQ(0, std::remove((std::string(cacheDir) + "/triangle.mtl").c_str()));
+    EXPECT_TRUE(RemoveTmpDirectory(cacheDir));
+}
+#endif // ASSIMP_BUILD_NO_EXPORT
+
 TEST_F(ImporterTest, SearchFileHeaderForTokenTest) {
     //DefaultIOSystem ioSystem;
     //    BaseImporter::SearchFileHeaderForToken( &ioSystem, assetPath, Token, 2 )
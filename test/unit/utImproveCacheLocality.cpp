@@ -40,3 +40,151 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "UnitTestPCH.h"
+#include "TestModelFactory.h"
+
+#include "PostProcessing/ImproveCacheLocality.h"
+#include <assimp/Importer.hpp>
+#include <assimp/commonMetaData.h>
+#include <assimp/scene.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+using namespace Assimp;
+
+class utImproveCacheLocality : public ::testing::Test {
+protected:
+    static const unsigned int GridSize = 30;
+
+    // A regular grid of triangles drawn in random order, the normals repeat
+    // the positions and a bone weights each vertex by its x coordinate
+    aiScene *CreateScene() {
+        aiScene *scene = TestModelFacttory::createShuffledGridModel(GridSize);
+        aiMesh *mesh = scene->mMeshes[0];
+        mesh->mNormals = new aiVector3D[mesh->mNumVertices];
+        std::copy(mesh->mVertices, mesh->mVertices + mesh->mNumVertices, mesh->mNormals);
+
+        mesh->mNumBones = 1;
+        mesh->mBones = new aiBone *[1];
+        mesh->mBones[0] = new aiBone();
+        mesh->mBones[0]->mNumWeights = mesh->mNumVertices;
+        mesh->mBones[0]->mWeights = new aiVertexWeight[mesh->mNumVertices];
+        for (unsigned int v = 0; v < mesh->mNumVertices; ++v) {
+            mesh->mBones[0]->mWeights[v] = aiVertexWeight(v, static_cast<float>(mesh->mVertices[v].x) / GridSize);
+        }
+
+        return scene;
+    }
+
+    // The faces as grid positions, each rotated to start with its smallest
+    // one, so that the winding order is kept
+    std::vector<std::array<unsigned int, 3>> GetFaces(const aiMesh *mesh) {
+        std::vector<std::array<unsigned int, 3>> out;
+        for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+            std::array<unsigned int, 3> face;
+            for (unsigned int i = 0; i < 3; ++i) {
+                const aiVector3D &p = mesh->mVertices[mesh->mFaces[f].mIndices[i]];
+                face[i] = static_cast<unsigned int>(p.y) * (GridSize + 1) + static_cast<unsigned int>(p.x);
+            }
+            std::rotate(face.begin(), std::min_element(face.begin(), face.end()), face.end());
+            out.push_back(face);
+        }
+        std::sort(out.begin(), out.end());
+        return out;
+    }
+
+    void Optimize(aiScene *scene, unsigned int algorithm, float overdraw, bool vertexFetch) {
+        Importer importer;
+        importer.SetPropertyInteger(AI_CONFIG_PP_ICL_ALGORITHM, algorithm);
+        importer.SetPropertyFloat(AI_CONFIG_PP_ICL_OVERDRAW_THRESHOLD, overdraw);
+        importer.SetPropertyBool(AI_CONFIG_PP_ICL_VERTEX_FETCH, vertexFetch);
+        ImproveCacheLocalityProcess process;
+        process.SetupProperties(&importer);
+        process.Execute(scene);
+    }
+
+    void CheckResult(unsigned int algorithm, float overdraw, bool vertexFetch) {
+        std::unique_ptr<aiScene> scene(CreateScene());
+        const std::vector<std::array<unsigned int, 3>> expected = GetFaces(scene->mMeshes[0]);
+        const VertexCacheStatistics in = ComputeVertexCacheStatistics(scene->mMeshes[0], PP_ICL_PTCACHE_SIZE);
+
+        Optimize(scene.get(), algorithm, overdraw, vertexFetch);
+        const aiMesh *mesh = scene->mMeshes[0];
+        EXPECT_TRUE(expected == GetFaces(mesh));
+
+        // the statistics are published with the scene
+        const VertexCacheStatistics out = ComputeVertexCacheStatistics(mesh, PP_ICL_PTCACHE_SIZE);
+        EXPECT_LT(out.GetACMR(), in.GetACMR());
+        ASSERT_NE(nullptr, scene->mMetaData);
+        float acmrIn = 0.f, acmrOut = 0.f, atvrOut = 0.f;
+        EXPECT_TRUE(scene->mMetaData->Get(AI_METADATA_ACMR_IN, acmrIn));
+        EXPECT_TRUE(scene->mMetaData->Get(AI_METADATA_ACMR_OUT, acmrOut));
+        EXPECT_TRUE(scene->mMetaData->Get(AI_METADATA_ATVR_OUT, atvrOut));
+        EXPECT_FLOAT_EQ(static_cast<float>(in.GetACMR()), acmrIn);
+        EXPECT_FLOAT_EQ(static_cast<float>(out.GetACMR()), acmrOut);
+        EXPECT_FLOAT_EQ(static_cast<float>(out.GetATVR()), atvrOut);
+
+        // the vertex data moves together
+        for (unsigned int v = 0; v < mesh->mNumVertices; ++v) {
+            EXPECT_EQ(mesh->mVertices[v], mesh->mNormals[v]);
+            const aiVertexWeight &w = mesh->mBones[0]->mWeights[v];
+            EXPECT_EQ(static_cast<float>(mesh->mVertices[w.mVertexId].x) / GridSize, w.mWeight);
+        }
+
+        if (vertexFetch) {
+            unsigned int next = 0;
+            for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+                for (unsigned int i = 0; i < 3; ++i) {
+                    const unsigned int v = mesh->mFaces[f].mIndices[i];
+                    ASSERT_LE(v, next);
+                    next = std::max(next, v + 1);
+                }
+            }
+        }
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utImproveCacheLocality, statisticsTest) {
+    aiMesh mesh;
+    mesh.mNumVertices = 4;
+    const unsigned int indices[] = { 0, 1, 2, 2, 1, 3, 3, 2, 1 };
+    mesh.AllocateFaces(3, 3);
+    std::copy(indices, indices + 9, mesh.mFaceIndices);
+
+    // the second face reuses two vertices, the third one all of them
+    VertexCacheStatistics stats = ComputeVertexCacheStatistics(&mesh, 3);
+    EXPECT_EQ(4u, stats.mNumMisses);
+    EXPECT_FLOAT_EQ(4.f / 3.f, static_cast<float>(stats.GetACMR()));
+    EXPECT_FLOAT_EQ(1.f, static_cast<float>(stats.GetATVR()));
+
+    // a FIFO cache of three vertices has lost vertex 0 by then
+    mesh.mFaceIndices[6] = 0;
+    mesh.mFaceIndices[7] = 3;
+    mesh.mFaceIndices[8] = 2;
+    stats = ComputeVertexCacheStatistics(&mesh, 3);
+    EXPECT_EQ(5u, stats.mNumMisses);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utImproveCacheLocality, tipsifyTest) {
+    CheckResult(aiVertexCacheAlgorithm_Tipsify, 0.f, false);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utImproveCacheLocality, forsythTest) {
+    CheckResult(aiVertexCacheAlgorithm_Forsyth, 0.f, false);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utImproveCacheLocality, overdrawTest) {
+    CheckResult(aiVertexCacheAlgorithm_Tipsify, 1.05f, false);
+    CheckResult(aiVertexCacheAlgorithm_Forsyth, 1.05f, false);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utImproveCacheLocality, vertexFetchTest) {
+    CheckResult(aiVertexCacheAlgorithm_Tipsify, 0.f, true);
+    CheckResult(aiVertexCacheAlgorithm_Forsyth, 1.05f, true);
+}
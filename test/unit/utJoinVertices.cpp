@@ -140,3 +140,72 @@ TEST_F(utJoinVertices, testProcess) {
     }
     EXPECT_EQ(150.f * 299.f * 3.f, fSum); // gaussian sum equation
 }
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utJoinVertices, testHashedProcessMatchesSpatialSort) {
+    aiMesh *pcCopy = new aiMesh();
+    pcCopy->mNumVertices = pcMesh->mNumVertices;
+    pcCopy->mVertices = new aiVector3D[pcMesh->mNumVertices];
+    pcCopy->mNormals = new aiVector3D[pcMesh->mNumVertices];
+    pcCopy->mTextureCoords[0] = new aiVector3D[pcMesh->mNumVertices];
+    for (unsigned int i = 0; i < pcMesh->mNumVertices; ++i) {
+        // a few attributes differ between otherwise identical positions
+        pcCopy->mVertices[i] = pcMesh->mVertices[i];
+        pcCopy->mNormals[i] = aiVector3D(0.f, (i % 600 == 0) ? 1.f : -0.f, 0.f);
+        pcCopy->mTextureCoords[0][i] = aiVector3D(0.f);
+    }
+    pcCopy->mNumFaces = pcMesh->mNumFaces;
+    pcCopy->mFaces = new aiFace[pcMesh->mNumFaces];
+    for (unsigned int i = 0; i < pcMesh->mNumFaces; ++i) {
+        pcCopy->mFaces[i] = pcMesh->mFaces[i];
+    }
+
+    piProcess->ProcessMesh(pcMesh, 0);
+
+    Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_PP_JIV_METHOD, AI_JIV_METHOD_HASH_EXACT);
+    JoinVerticesProcess hashed;
+    hashed.SetupProperties(&importer);
+    hashed.ProcessMesh(pcCopy, 0);
+
+    // the positions are exact copies, so both engines agree except for the normals
+    ASSERT_EQ(300U, pcMesh->mNumVertices);
+    ASSERT_EQ(301U, pcCopy->mNumVertices);
+    ASSERT_EQ(pcMesh->mNumFaces, pcCopy->mNumFaces);
+    for (unsigned int i = 0; i < 300; ++i) {
+        EXPECT_EQ(pcMesh->mVertices[i], pcCopy->mVertices[i]);
+    }
+    EXPECT_EQ(pcCopy->mVertices[0], pcCopy->mVertices[300]);
+    EXPECT_EQ(1.f, pcCopy->mNormals[0].y);
+    EXPECT_EQ(300U, pcCopy->mFaces[100].mIndices[0]);
+    for (unsigned int i = 0; i < pcCopy->mNumFaces; ++i) {
+        if (i != 100) {
+            for (unsigned int a = 0; a < 3; ++a) {
+                EXPECT_EQ(pcMesh->mFaces[i].mIndices[a], pcCopy->mFaces[i].mIndices[a]);
+            }
+        }
+    }
+
+    delete pcCopy;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utJoinVertices, testQuantizedProcess) {
+    // nudge the copies by more than the spatial sort tolerates, but keep them
+    // in the same grid cell
+    for (unsigned int i = 300; i < 900; ++i) {
+        pcMesh->mVertices[i].x += 2e-4f * (i % 3);
+    }
+
+    Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_PP_JIV_METHOD, AI_JIV_METHOD_HASH_QUANTIZED);
+    importer.SetPropertyFloat(AI_CONFIG_PP_JIV_QUANTIZATION_STEP, 1e-3f);
+    piProcess->SetupProperties(&importer);
+    piProcess->ProcessMesh(pcMesh, 0);
+
+    ASSERT_EQ(300U, pcMesh->mNumFaces);
+    ASSERT_EQ(300U, pcMesh->mNumVertices);
+    for (unsigned int i = 0; i < 300; ++i) {
+        EXPECT_EQ(static_cast<float>(i), pcMesh->mVertices[i].y);
+    }
+}
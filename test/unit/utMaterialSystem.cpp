@@ -135,3 +135,58 @@ TEST_F(MaterialSystemTest, testMaterialNameAccess) {
 
     delete mat;
 }
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(MaterialSystemTest, testManyProperties) {
+    // enough properties to search them through the hash index
+    for (int i = 0; i < 200; ++i) {
+        const std::string key = "testKey" + std::to_string(i % 50);
+        this->pcMat->AddProperty(&i, 1, key.c_str(), i / 50, 0);
+    }
+    EXPECT_EQ(200u, pcMat->mNumProperties);
+
+    // overwriting keeps the number of properties
+    int value = -1;
+    pcMat->AddProperty(&value, 1, "testKey7", 2, 0);
+    EXPECT_EQ(200u, pcMat->mNumProperties);
+
+    for (int i = 0; i < 200; ++i) {
+        const std::string key = "testKey" + std::to_string(i % 50);
+        EXPECT_EQ(AI_SUCCESS, pcMat->Get(key.c_str(), i / 50, 0, value));
+        EXPECT_EQ(i == 107 ? -1 : i, value);
+    }
+    EXPECT_EQ(AI_FAILURE, pcMat->Get("testKey7", 4, 0, value));
+    EXPECT_EQ(AI_FAILURE, pcMat->Get("testKey7", 0, 1, value));
+
+    // wild-cards find the first match
+    EXPECT_EQ(AI_SUCCESS, pcMat->Get("testKey9", UINT_MAX, 0, value));
+    EXPECT_EQ(9, value);
+
+    // removing moves the properties behind
+    EXPECT_EQ(AI_SUCCESS, pcMat->RemoveProperty("testKey0", 0, 0));
+    EXPECT_EQ(AI_FAILURE, pcMat->RemoveProperty("testKey0", 0, 0));
+    EXPECT_EQ(AI_FAILURE, pcMat->Get("testKey0", 0, 0, value));
+    EXPECT_EQ(AI_SUCCESS, pcMat->Get("testKey49", 3, 0, value));
+    EXPECT_EQ(199, value);
+
+    // changes made to the property array directly are picked up as well
+    aiMaterialProperty *prop = pcMat->mProperties[--pcMat->mNumProperties];
+    EXPECT_EQ(AI_FAILURE, pcMat->Get("testKey49", 3, 0, value));
+    pcMat->mProperties[pcMat->mNumProperties++] = prop;
+    EXPECT_EQ(AI_SUCCESS, pcMat->Get("testKey49", 3, 0, value));
+
+    aiMaterialProperty *replacement = new aiMaterialProperty();
+    replacement->mKey.Set("replacedKey");
+    replacement->mType = prop->mType;
+    replacement->mDataLength = prop->mDataLength;
+    replacement->mData = new char[prop->mDataLength];
+    ::memcpy(replacement->mData, prop->mData, prop->mDataLength);
+    pcMat->mProperties[pcMat->mNumProperties - 1] = replacement;
+    delete prop;
+    EXPECT_EQ(AI_FAILURE, pcMat->Get("testKey49", 3, 0, value));
+    EXPECT_EQ(AI_SUCCESS, pcMat->Get("replacedKey", 0, 0, value));
+    EXPECT_EQ(199, value);
+
+    pcMat->Clear();
+    EXPECT_EQ(AI_FAILURE, pcMat->Get("testKey1", 0, 0, value));
+}
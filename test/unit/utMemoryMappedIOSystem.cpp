@@ -0,0 +1,160 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+#include "UnitTestFileGenerator.h"
+
+#include <assimp/DefaultIOSystem.h>
+#include <assimp/Importer.hpp>
+#include <assimp/MemoryMappedIOSystem.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace Assimp;
+
+class utMemoryMappedIOSystem : public ::testing::Test {
+protected:
+    // Import the file once with the default and once with the mapped IO system
+    // and check both give the same geometry
+    void CompareImports(const char *file) {
+        Importer reference;
+        const aiScene *expected = reference.ReadFile(file, aiProcess_ValidateDataStructure);
+        ASSERT_NE(nullptr, expected);
+
+        Importer importer;
+        importer.SetIOHandler(new MemoryMappedIOSystem());
+        const aiScene *scene = importer.ReadFile(file, aiProcess_ValidateDataStructure);
+        ASSERT_NE(nullptr, scene);
+
+        ASSERT_EQ(expected->mNumMeshes, scene->mNumMeshes);
+        for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+            const aiMesh *a = expected->mMeshes[i], *b = scene->mMeshes[i];
+            ASSERT_EQ(a->mNumVertices, b->mNumVertices);
+            ASSERT_EQ(a->mNumFaces, b->mNumFaces);
+            EXPECT_EQ(0, ::memcmp(a->mVertices, b->mVertices, a->mNumVertices * sizeof(aiVector3D)));
+        }
+    }
+};
+
+TEST_F(utMemoryMappedIOSystem, mappedContentsTest) {
+    const char *file = ASSIMP_TEST_MODELS_DIR "/STL/Spider_binary.stl";
+
+    DefaultIOSystem defaultIO;
+    std::unique_ptr<IOStream> reference(defaultIO.Open(file, "rb"));
+    ASSERT_NE(nullptr, reference.get());
+    EXPECT_EQ(nullptr, reference->GetMappedData());
+    std::vector<char> expected(reference->FileSize());
+    ASSERT_EQ(1U, reference->Read(&expected[0], expected.size(), 1));
+
+    MemoryMappedIOSystem mappedIO;
+    std::unique_ptr<IOStream> stream(mappedIO.Open(file, "rb"));
+    ASSERT_NE(nullptr, stream.get());
+    ASSERT_EQ(expected.size(), stream->FileSize());
+    ASSERT_NE(nullptr, stream->GetMappedData());
+    EXPECT_EQ(0, ::memcmp(&expected[0], stream->GetMappedData(), expected.size()));
+
+    // the cursor behaves like the one of any other stream
+    char header[80];
+    EXPECT_EQ(1U, stream->Read(header, sizeof(header), 1));
+    EXPECT_EQ(sizeof(header), stream->Tell());
+    EXPECT_EQ(0, ::memcmp(&expected[0], header, sizeof(header)));
+    EXPECT_EQ(aiReturn_SUCCESS, stream->Seek(4, aiOrigin_END));
+    EXPECT_EQ(expected.size() - 4, stream->Tell());
+    EXPECT_EQ(0U, stream->Read(header, 8, 1));
+    EXPECT_EQ(aiReturn_FAILURE, stream->Seek(expected.size() + 1, aiOrigin_SET));
+    EXPECT_EQ(0U, stream->Write(header, 1, 1));
+}
+
+TEST_F(utMemoryMappedIOSystem, writeFallsBackToDefaultTest) {
+    char fpath[] = { TMP_PATH "mmapfp.XXXXXX" };
+    std::FILE *fs = MakeTmpFile(fpath);
+    ASSERT_NE(nullptr, fs);
+    std::fclose(fs);
+
+    MemoryMappedIOSystem mappedIO;
+    {
+        std::unique_ptr<IOStream> stream(mappedIO.Open(fpath, "wb"));
+        ASSERT_NE(nullptr, stream.get());
+        EXPECT_EQ(nullptr, stream->GetMappedData());
+        EXPECT_EQ(1U, stream->Write("data", 4, 1));
+    }
+    {
+        std::unique_ptr<IOStream> stream(mappedIO.Open(fpath, "rb"));
+        ASSERT_NE(nullptr, stream.get());
+        ASSERT_NE(nullptr, stream->GetMappedData());
+        EXPECT_EQ(4U, stream->FileSize());
+    }
+    std::remove(fpath);
+}
+
+TEST_F(utMemoryMappedIOSystem, missingFileTest) {
+    MemoryMappedIOSystem mappedIO;
+    EXPECT_EQ(nullptr, mappedIO.Open(ASSIMP_TEST_MODELS_DIR "/does_not_exist.stl", "rb"));
+}
+
+TEST_F(utMemoryMappedIOSystem, importBinaryStlTest) {
+    CompareImports(ASSIMP_TEST_MODELS_DIR "/STL/Spider_binary.stl");
+}
+
+TEST_F(utMemoryMappedIOSystem, importBinaryFbxTest) {
+    CompareImports(ASSIMP_TEST_MODELS_DIR "/FBX/spider.fbx");
+}
+
+TEST_F(utMemoryMappedIOSystem, importGlbTest) {
+    CompareImports(ASSIMP_TEST_MODELS_DIR "/glTF2/2CylinderEngine-glTF-Binary/2CylinderEngine.glb");
+}
+
+TEST_F(utMemoryMappedIOSystem, importFromMemoryTest) {
+    const char *file = ASSIMP_TEST_MODELS_DIR "/FBX/spider.fbx";
+    MemoryMappedIOSystem mappedIO;
+    std::unique_ptr<IOStream> stream(mappedIO.Open(file, "rb"));
+    ASSERT_NE(nullptr, stream.get());
+
+    Importer importer;
+    const aiScene *scene = importer.ReadFileFromMemory(stream->GetMappedData(), stream->FileSize(), 0, "fbx");
+    ASSERT_NE(nullptr, scene);
+    EXPECT_LT(0U, scene->mNumMeshes);
+}
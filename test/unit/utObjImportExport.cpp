@@ -477,3 +477,54 @@ TEST_F(utObjImportExport, import_with_line_continuations) {
     EXPECT_NEAR(vertices[2].y, 0.5f, threshold);
     EXPECT_NEAR(vertices[2].z, -0.5f, threshold);
 }
+
+TEST_F(utObjImportExport, import_in_parallel_chunks) {
+    // several megabytes of objects, each with its own vertex data and a mix
+    // of absolute and relative indices, so chunks split objects and faces
+    // refer to vertices of earlier chunks
+    std::string curObjModel = "# generated\nmtllib missing.mtl\n";
+    unsigned int numVertices = 0;
+    for (unsigned int o = 0; o < 24; ++o) {
+        curObjModel += "o object_" + std::to_string(o) + "\n";
+        curObjModel += "usemtl material_" + std::to_string(o % 3) + "\n";
+        for (unsigned int i = 0; i < 2000; ++i) {
+            const std::string x = std::to_string(o + i * 0.001), y = std::to_string(i * 0.5);
+            curObjModel += "v " + x + " " + y + (i % 7 ? " 1.0\n" : " \\\n  1.0\r\n");
+            curObjModel += "vt " + std::to_string(i * 0.0005) + " 0.25\n";
+            curObjModel += "vn 0.0 " + y + " 1.0\n";
+        }
+        for (unsigned int i = 2; i < 2000; i += 2) {
+            if (i % 4) {
+                curObjModel += "f -3/-3/-3 -2/-2/-2 -1/-1/-1\n";
+            } else {
+                const std::string a = std::to_string(numVertices + i - 1), b = std::to_string(numVertices + i), c = std::to_string(numVertices + i + 1);
+                curObjModel += "f " + a + "/" + a + "/" + a + " " + b + "/" + b + "/" + b + " " + c + "/" + c + "/" + c + "\n";
+            }
+        }
+        numVertices += 2000;
+    }
+    ASSERT_LT(1024u * 1024u, curObjModel.size());
+
+    Assimp::Importer serial;
+    const aiScene *expected = serial.ReadFileFromMemory(curObjModel.data(), curObjModel.size(), aiProcess_ValidateDataStructure, "obj");
+    ASSERT_NE(nullptr, expected);
+
+    Assimp::Importer parallel;
+    parallel.SetPropertyInteger(AI_CONFIG_GLOB_NUM_THREADS, 4);
+    const aiScene *scene = parallel.ReadFileFromMemory(curObjModel.data(), curObjModel.size(), aiProcess_ValidateDataStructure, "obj");
+    ASSERT_NE(nullptr, scene);
+
+    ASSERT_EQ(24u, scene->mNumMeshes);
+    ASSERT_EQ(expected->mNumMeshes, scene->mNumMeshes);
+    ASSERT_EQ(expected->mNumMaterials, scene->mNumMaterials);
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        const aiMesh *a = expected->mMeshes[i], *b = scene->mMeshes[i];
+        EXPECT_STREQ(a->mName.C_Str(), b->mName.C_Str());
+        EXPECT_EQ(a->mMaterialIndex, b->mMaterialIndex);
+        ASSERT_EQ(a->mNumVertices, b->mNumVertices);
+        ASSERT_EQ(a->mNumFaces, b->mNumFaces);
+        EXPECT_EQ(0, memcmp(a->mVertices, b->mVertices, a->mNumVertices * sizeof(aiVector3D)));
+        EXPECT_EQ(0, memcmp(a->mNormals, b->mNormals, a->mNumVertices * sizeof(aiVector3D)));
+        EXPECT_EQ(0, memcmp(a->mTextureCoords[0], b->mTextureCoords[0], a->mNumVertices * sizeof(aiVector3D)));
+    }
+}
@@ -180,3 +180,112 @@ TEST_F(utPLYImportExport, parseErrorTest) {
     const aiScene *scene = importer.ReadFileFromMemory(test_file, strlen(test_file), 0);
     EXPECT_NE(nullptr, scene);
 }
+
+// Builds a big-endian binary point cloud which spans several blocks of the stream buffer
+static std::string MakeBinaryPointCloud(unsigned int numPoints) {
+    std::string data = "ply\n"
+                       "format binary_big_endian 1.0\n"
+                       "element vertex " + std::to_string(numPoints) + "\n"
+                       "property float x\n"
+                       "property float y\n"
+                       "property float z\n"
+                       "property uchar red\n"
+                       "property uchar green\n"
+                       "property uchar blue\n"
+                       "property short intensity\n"
+                       "end_header\n";
+    for (unsigned int i = 0; i < numPoints; ++i) {
+        const float xyz[3] = { static_cast<float>(i), 0.5f * i, -1.0f };
+        for (float f : xyz) {
+            uint32_t bits;
+            ::memcpy(&bits, &f, sizeof(bits));
+            for (int shift = 24; shift >= 0; shift -= 8) {
+                data.push_back(static_cast<char>((bits >> shift) & 0xff));
+            }
+        }
+        data.push_back(static_cast<char>(i & 0xff));
+        data.push_back(static_cast<char>(0xff));
+        data.push_back(0);
+        data.push_back(0x12);
+        data.push_back(0x34);
+    }
+    return data;
+}
+
+TEST_F(utPLYImportExport, importBinaryPointCloud) {
+    const unsigned int numPoints = 100000;
+    const std::string data = MakeBinaryPointCloud(numPoints);
+
+    Assimp::Importer serial;
+    const aiScene *expected = serial.ReadFileFromMemory(data.data(), data.size(), 0, "ply");
+    ASSERT_NE(nullptr, expected);
+
+    const aiMesh *mesh = expected->mMeshes[0];
+    ASSERT_EQ(numPoints, mesh->mNumVertices);
+    ASSERT_TRUE(mesh->HasVertexColors(0));
+    EXPECT_FALSE(mesh->HasNormals());
+    for (unsigned int i = 0; i < numPoints; i += 997) {
+        EXPECT_EQ(aiVector3D(static_cast<ai_real>(i), 0.5f * i, -1.0f), mesh->mVertices[i]);
+        EXPECT_EQ(aiColor4D((i & 0xff) / 255.0f, 1.0f, 0.0f, 1.0f), mesh->mColors[0][i]);
+    }
+
+    Assimp::Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_GLOB_NUM_THREADS, 4);
+    const aiScene *scene = importer.ReadFileFromMemory(data.data(), data.size(), 0, "ply");
+    ASSERT_NE(nullptr, scene);
+    ASSERT_EQ(numPoints, scene->mMeshes[0]->mNumVertices);
+    EXPECT_EQ(0, memcmp(mesh->mVertices, scene->mMeshes[0]->mVertices, numPoints * sizeof(aiVector3D)));
+    EXPECT_EQ(0, memcmp(mesh->mColors[0], scene->mMeshes[0]->mColors[0], numPoints * sizeof(aiColor4D)));
+}
+
+// The same two points as ASCII and as binary file, with the given color properties
+static void MakeColoredPoints(const std::vector<std::string> &channels, std::string &ascii, std::string &binary) {
+    std::string header = "element vertex 2\n"
+                         "property float x\n"
+                         "property float y\n"
+                         "property float z\n";
+    for (const std::string &channel : channels) {
+        header += "property uchar " + channel + "\n";
+    }
+    header += "end_header\n";
+    ascii = "ply\nformat ascii 1.0\n" + header;
+    binary = "ply\nformat binary_little_endian 1.0\n" + header;
+
+    for (unsigned int i = 0; i < 2; ++i) {
+        const float xyz[3] = { static_cast<float>(i), 1.0f, 2.0f };
+        ascii += std::to_string(i) + " 1 2";
+        binary.append(reinterpret_cast<const char *>(xyz), sizeof(xyz));
+        for (size_t c = 0; c < channels.size(); ++c) {
+            const unsigned char value = static_cast<unsigned char>(51 * (i + c + 1));
+            ascii += " " + std::to_string(value);
+            binary.push_back(static_cast<char>(value));
+        }
+        ascii += "\n";
+    }
+}
+
+TEST_F(utPLYImportExport, binaryColorsMatchAscii) {
+    const std::vector<std::vector<std::string>> cases = {
+        { "alpha" }, { "red" }, { "green", "blue" }, { "red", "green", "blue", "alpha" }
+    };
+    for (const std::vector<std::string> &channels : cases) {
+        std::string ascii, binary;
+        MakeColoredPoints(channels, ascii, binary);
+
+        Assimp::Importer asciiImporter, binaryImporter;
+        const aiScene *expected = asciiImporter.ReadFileFromMemory(ascii.data(), ascii.size(), 0, "ply");
+        const aiScene *scene = binaryImporter.ReadFileFromMemory(binary.data(), binary.size(), 0, "ply");
+        ASSERT_NE(nullptr, expected);
+        ASSERT_NE(nullptr, scene);
+
+        const aiMesh *a = expected->mMeshes[0], *b = scene->mMeshes[0];
+        ASSERT_EQ(2u, a->mNumVertices);
+        ASSERT_EQ(a->mNumVertices, b->mNumVertices);
+        ASSERT_EQ(a->HasVertexColors(0), b->HasVertexColors(0)) << channels.front();
+        if (a->HasVertexColors(0)) {
+            for (unsigned int i = 0; i < a->mNumVertices; ++i) {
+                EXPECT_EQ(a->mColors[0][i], b->mColors[0][i]) << channels.front();
+            }
+        }
+    }
+}
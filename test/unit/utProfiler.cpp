@@ -44,6 +44,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "UTLogStream.h"
 #include <assimp/Profiler.h>
 #include <assimp/DefaultLogger.hpp>
+#include <assimp/Exceptional.h>
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
 
 using namespace ::Assimp;
 using namespace ::Assimp::Profiling;
@@ -75,3 +79,113 @@ TEST_F( utProfiler, addRegion_success ) {
     //UTLogStream *stream( (UTLogStream*) m_stream );
     //EXPECT_FALSE( stream->m_messages.empty() );
 }
+
+TEST_F( utProfiler, nestedRegions_success ) {
+    Profiler myProfiler;
+    myProfiler.BeginRegion( "outer" );
+    myProfiler.BeginRegion( "inner" );
+    EXPECT_TRUE( myProfiler.HasOpenRegions() );
+    myProfiler.EndRegion( "inner", 100 );
+    myProfiler.AddRegion( "leaf", Profiler::Clock::now(), Profiler::Clock::now() );
+    myProfiler.EndRegion( "outer", 50 );
+    EXPECT_FALSE( myProfiler.HasOpenRegions() );
+
+    const std::vector<Profiler::Region> regions = myProfiler.GetRegions();
+    ASSERT_EQ( 3u, regions.size() );
+    EXPECT_EQ( -1, regions[0].parent );
+    EXPECT_EQ( 0, regions[1].parent );
+    EXPECT_EQ( 1u, regions[1].depth );
+    EXPECT_EQ( 0, regions[2].parent );
+    EXPECT_LE( regions[0].start, regions[1].start );
+    EXPECT_LE( regions[1].end, regions[0].end );
+    EXPECT_EQ( 100u, myProfiler.GetPeakMemory() );
+}
+
+TEST_F( utProfiler, endOuterClosesInner_success ) {
+    Profiler myProfiler;
+    myProfiler.BeginRegion( "outer" );
+    myProfiler.BeginRegion( "inner" );
+    myProfiler.EndRegion( "outer" );
+    EXPECT_FALSE( myProfiler.HasOpenRegions() );
+    for ( const Profiler::Region &r : myProfiler.GetRegions() ) {
+        EXPECT_GE( r.end, r.start );
+    }
+}
+
+TEST_F( utProfiler, export_success ) {
+    Profiler myProfiler;
+    myProfiler.BeginRegion( "a\"b" );
+    myProfiler.EndRegion( "a\"b" );
+
+    const std::string json = myProfiler.ToJson();
+    EXPECT_NE( std::string::npos, json.find( "\"name\":\"a\\\"b\"" ) );
+    EXPECT_NE( std::string::npos, json.find( "\"children\":[]" ) );
+
+    const std::string trace = myProfiler.ToChromeTrace();
+    EXPECT_EQ( 0u, trace.find( "{\"traceEvents\":[{" ) );
+    EXPECT_NE( std::string::npos, trace.find( "\"ph\":\"X\"" ) );
+}
+
+TEST_F( utProfiler, scopedRegion_success ) {
+    Profiler myProfiler;
+    try {
+        ScopedRegion outer( &myProfiler, "outer" );
+        ScopedRegion inner( &myProfiler, "inner" );
+        inner.End( 42 );
+        throw DeadlyImportError( "failed" );
+    } catch ( const DeadlyImportError & ) {
+        // the regions are closed nevertheless
+    }
+    EXPECT_FALSE( myProfiler.HasOpenRegions() );
+    EXPECT_EQ( 42u, myProfiler.GetPeakMemory() );
+
+    const std::string json = myProfiler.ToJson();
+    EXPECT_NE( std::string::npos, json.find( "\"name\":\"outer\"" ) );
+    EXPECT_LT( json.find( "\"name\":\"outer\"" ), json.find( "\"name\":\"inner\"" ) );
+
+    ScopedRegion none( nullptr, "none" );
+    none.End();
+}
+
+TEST_F( utProfiler, failedImportClosesRegions_success ) {
+    Importer importer;
+    importer.SetPropertyBool( AI_CONFIG_GLOB_MEASURE_TIME, true );
+    // a binary FBX header followed by garbage fails while tokenizing
+    const char data[] = "Kaydara FBX Binary  \0\x1a\0\xe8\x1c\0\0garbage";
+    EXPECT_EQ( nullptr, importer.ReadFileFromMemory( data, sizeof( data ), 0, "fbx" ) );
+
+    const Profiler *profiler = importer.GetProfiler();
+    ASSERT_NE( nullptr, profiler );
+    EXPECT_FALSE( profiler->HasOpenRegions() );
+}
+
+TEST_F( utProfiler, importerProfile_success ) {
+    Importer importer;
+    EXPECT_EQ( nullptr, importer.GetProfiler() );
+
+    importer.SetPropertyBool( AI_CONFIG_GLOB_MEASURE_TIME, true );
+    importer.SetPropertyBool( AI_CONFIG_GLOB_MEASURE_TIME_PER_MESH, true );
+    ASSERT_NE( nullptr, importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_JoinIdenticalVertices ) );
+
+    const Profiler *profiler = importer.GetProfiler();
+    ASSERT_NE( nullptr, profiler );
+    EXPECT_FALSE( profiler->HasOpenRegions() );
+    EXPECT_LT( 0u, profiler->GetPeakMemory() );
+
+    bool hasStep = false;
+    unsigned int numMeshRegions = 0;
+    const std::vector<Profiler::Region> regions = profiler->GetRegions();
+    ASSERT_FALSE( regions.empty() );
+    EXPECT_EQ( "total", regions[0].name );
+    for ( const Profiler::Region &r : regions ) {
+        if ( r.name == "JoinVerticesProcess" ) {
+            hasStep = true;
+            EXPECT_EQ( "postprocess", regions[r.parent].name );
+        } else if ( r.name.compare( 0, 5, "mesh " ) == 0 ) {
+            ++numMeshRegions;
+            EXPECT_EQ( "JoinVerticesProcess", regions[r.parent].name );
+        }
+    }
+    EXPECT_TRUE( hasStep );
+    EXPECT_EQ( importer.GetScene()->mNumMeshes, numMeshRegions );
+}
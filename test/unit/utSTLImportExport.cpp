@@ -99,6 +99,71 @@ TEST_F(utSTLImporterExporter, test_with_empty_solid) {
     EXPECT_EQ(nullptr, scene2);
 }
 
+// Builds a binary STL of a grid with two facets per cell. If colored is set,
+// the last facet carries a color.
+static std::vector<char> MakeBinaryGrid(unsigned int cells, bool colored) {
+    const uint32_t numFacets = cells * cells * 2;
+    std::vector<char> data(84 + numFacets * 50, 0);
+    ::memcpy(&data[80], &numFacets, sizeof(numFacets));
+
+    char *facet = &data[84];
+    for (unsigned int y = 0; y < cells; ++y) {
+        for (unsigned int x = 0; x < cells; ++x) {
+            const float fx = static_cast<float>(x), fy = static_cast<float>(y);
+            const float tris[2][12] = {
+                { 0, 0, 1, fx, fy, 0, fx + 1, fy, 0, fx + 1, fy + 1, 0 },
+                { 0, 0, 1, fx, fy, 0, fx + 1, fy + 1, 0, fx, fy + 1, 0 }
+            };
+            for (const float *tri : tris) {
+                ::memcpy(facet, tri, 48);
+                facet += 50;
+            }
+        }
+    }
+    if (colored) {
+        const uint16_t color = (1 << 15) | 0x1f;
+        ::memcpy(&data[data.size() - 2], &color, sizeof(color));
+    }
+    return data;
+}
+
+TEST_F(utSTLImporterExporter, importBinaryWithThreadsTest) {
+    const std::vector<char> data = MakeBinaryGrid(130, true);
+
+    Assimp::Importer serial;
+    const aiScene *expected = serial.ReadFileFromMemory(&data[0], data.size(), aiProcess_ValidateDataStructure, "stl");
+    ASSERT_NE(nullptr, expected);
+
+    Assimp::Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_GLOB_NUM_THREADS, 4);
+    const aiScene *scene = importer.ReadFileFromMemory(&data[0], data.size(), aiProcess_ValidateDataStructure, "stl");
+    ASSERT_NE(nullptr, scene);
+
+    const aiMesh *a = expected->mMeshes[0], *b = scene->mMeshes[0];
+    ASSERT_EQ(130u * 130u * 6u, b->mNumVertices);
+    EXPECT_EQ(0, memcmp(a->mVertices, b->mVertices, a->mNumVertices * sizeof(aiVector3D)));
+    EXPECT_EQ(0, memcmp(a->mNormals, b->mNormals, a->mNumVertices * sizeof(aiVector3D)));
+    ASSERT_TRUE(b->HasVertexColors(0));
+    EXPECT_EQ(0, memcmp(a->mColors[0], b->mColors[0], a->mNumVertices * sizeof(aiColor4D)));
+    EXPECT_EQ(1.0f, b->mColors[0][b->mNumVertices - 1].a);
+}
+
+TEST_F(utSTLImporterExporter, importBinaryWeldVerticesTest) {
+    const std::vector<char> data = MakeBinaryGrid(10, false);
+
+    Assimp::Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_IMPORT_STL_WELD_VERTICES, true);
+    const aiScene *scene = importer.ReadFileFromMemory(&data[0], data.size(), aiProcess_ValidateDataStructure, "stl");
+    ASSERT_NE(nullptr, scene);
+
+    const aiMesh *mesh = scene->mMeshes[0];
+    EXPECT_EQ(11u * 11u, mesh->mNumVertices);
+    EXPECT_EQ(200u, mesh->mNumFaces);
+    EXPECT_FALSE(mesh->HasNormals());
+    EXPECT_EQ(aiVector3D(1, 1, 0), mesh->mVertices[mesh->mFaces[0].mIndices[2]]);
+    EXPECT_EQ(mesh->mFaces[0].mIndices[0], mesh->mFaces[1].mIndices[0]);
+}
+
 #ifndef ASSIMP_BUILD_NO_EXPORT
 
 TEST_F(utSTLImporterExporter, exporterTest) {